@@ -0,0 +1,216 @@
+#include "AlgebraicMultigrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// \brief Coarsening is stopped if a level would keep more than this fraction of unknowns.
+constexpr double MIN_COARSENING_RATIO = 0.9;
+
+/// \brief The number of Jacobi sweeps replacing the direct solve of the coarsest level if its factorization fails.
+constexpr unsigned int N_COARSEST_SMOOTHING_STEPS = 20;
+
+Eigen::Index ComputeAggregates(const AlgebraicMultigrid::RowMajorMatrix& mat, const double& strengthThreshold, std::vector<Eigen::Index>& aggregateIds)
+{
+	const auto nUnknowns = mat.rows();
+	const Eigen::VectorXd diagonal = mat.diagonal();
+	const auto* outerIds = mat.outerIndexPtr();
+	const auto* innerIds = mat.innerIndexPtr();
+	const auto* values = mat.valuePtr();
+
+	// strong connections in CSR format
+	std::vector<Eigen::Index> strongOuterIds(nUnknowns + 1, 0);
+	std::vector<Eigen::Index> strongInnerIds{};
+	strongInnerIds.reserve(mat.nonZeros());
+	for (Eigen::Index i = 0; i < nUnknowns; i++)
+	{
+		for (auto k = outerIds[i]; k < outerIds[i + 1]; k++)
+		{
+			const auto j = static_cast<Eigen::Index>(innerIds[k]);
+			if (j == i)
+				continue;
+			if (std::abs(values[k]) >= strengthThreshold * std::sqrt(std::abs(diagonal[i] * diagonal[j])) && values[k] != 0.0)
+				strongInnerIds.push_back(j);
+		}
+		strongOuterIds[i + 1] = static_cast<Eigen::Index>(strongInnerIds.size());
+	}
+	const auto hasStrongNeighbors = [&](const Eigen::Index& i) { return strongOuterIds[i + 1] > strongOuterIds[i]; };
+
+	constexpr Eigen::Index unaggregated = -1;
+	aggregateIds.assign(nUnknowns, unaggregated);
+	Eigen::Index nAggregates = 0;
+
+	// phase 1: aggregates of whole strong neighborhoods whose unknowns are all free
+	for (Eigen::Index i = 0; i < nUnknowns; i++)
+	{
+		if (aggregateIds[i] != unaggregated || !hasStrongNeighbors(i))
+			continue;
+
+		const bool isNeighborhoodFree = std::all_of(strongInnerIds.begin() + strongOuterIds[i], strongInnerIds.begin() + strongOuterIds[i + 1],
+			[&](const Eigen::Index& j) { return aggregateIds[j] == unaggregated; });
+		if (!isNeighborhoodFree)
+			continue;
+
+		aggregateIds[i] = nAggregates;
+		for (auto k = strongOuterIds[i]; k < strongOuterIds[i + 1]; k++)
+			aggregateIds[strongInnerIds[k]] = nAggregates;
+		nAggregates++;
+	}
+
+	// phase 2: attach remaining unknowns to an aggregate of a strong neighbor
+	std::vector<Eigen::Index> phase2Ids = aggregateIds;
+	for (Eigen::Index i = 0; i < nUnknowns; i++)
+	{
+		if (aggregateIds[i] != unaggregated)
+			continue;
+
+		for (auto k = strongOuterIds[i]; k < strongOuterIds[i + 1]; k++)
+		{
+			const auto j = strongInnerIds[k];
+			if (aggregateIds[j] != unaggregated)
+			{
+				phase2Ids[i] = aggregateIds[j];
+				break;
+			}
+		}
+	}
+	aggregateIds = std::move(phase2Ids);
+
+	// phase 3: new aggregates from the remaining unknowns and their free strong neighbors
+	for (Eigen::Index i = 0; i < nUnknowns; i++)
+	{
+		if (aggregateIds[i] != unaggregated || !hasStrongNeighbors(i))
+			continue;
+
+		aggregateIds[i] = nAggregates;
+		for (auto k = strongOuterIds[i]; k < strongOuterIds[i + 1]; k++)
+		{
+			const auto j = strongInnerIds[k];
+			if (aggregateIds[j] == unaggregated)
+				aggregateIds[j] = nAggregates;
+		}
+		nAggregates++;
+	}
+
+	return nAggregates;
+}
+
+void AlgebraicMultigrid::Setup(const RowMajorMatrix& mat)
+{
+	m_Levels.clear();
+	m_CoarsestSolver.reset();
+	m_Info = Eigen::Success;
+	if (mat.rows() == 0 || mat.rows() != mat.cols())
+	{
+		m_Info = Eigen::InvalidInput;
+		return;
+	}
+
+	m_Levels.push_back({ mat });
+	while (true)
+	{
+		const size_t levelId = m_Levels.size() - 1;
+		const Eigen::VectorXd diagonal = m_Levels[levelId].Matrix.diagonal();
+		if ((diagonal.array() == 0.0).any())
+		{
+			m_Info = Eigen::NumericalIssue;
+			return;
+		}
+		m_Levels[levelId].InvDiagonal = diagonal.cwiseInverse();
+
+		const auto& A = m_Levels[levelId].Matrix;
+		const auto nUnknowns = A.rows();
+		if (nUnknowns <= static_cast<Eigen::Index>(m_Settings.CoarsestSize) || m_Levels.size() >= m_Settings.MaxLevels)
+			break;
+
+		std::vector<Eigen::Index> aggregateIds{};
+		const auto nAggregates = ComputeAggregates(A, m_Settings.StrengthThreshold, aggregateIds);
+		if (nAggregates == 0 || static_cast<double>(nAggregates) > MIN_COARSENING_RATIO * static_cast<double>(nUnknowns))
+			break; // coarsening stagnates
+
+		// tentative (piecewise constant) prolongation
+		std::vector<Eigen::Triplet<double>> triplets{};
+		triplets.reserve(nUnknowns);
+		for (Eigen::Index i = 0; i < nUnknowns; i++)
+		{
+			if (aggregateIds[i] >= 0)
+				triplets.emplace_back(i, aggregateIds[i], 1.0);
+		}
+		RowMajorMatrix prolongation(nUnknowns, nAggregates);
+		prolongation.setFromTriplets(triplets.begin(), triplets.end());
+
+		if (m_Settings.SmoothProlongation)
+		{
+			// P = (I - omega D^-1 A) P_tent with omega = 4/3 / rho(D^-1 A), rho estimated by the max absolute row sum of D^-1 A.
+			const RowMajorMatrix scaledA = m_Levels[levelId].InvDiagonal.asDiagonal() * A;
+			double rho = 0.0;
+			for (Eigen::Index i = 0; i < scaledA.outerSize(); i++)
+			{
+				double rowSum = 0.0;
+				for (RowMajorMatrix::InnerIterator it(scaledA, i); it; ++it)
+					rowSum += std::abs(it.value());
+				rho = std::max(rho, rowSum);
+			}
+			const double omega = (rho > 0.0 ? 4.0 / 3.0 / rho : 0.0);
+			const RowMajorMatrix smoothingTerm = scaledA * prolongation;
+			prolongation = RowMajorMatrix(prolongation - omega * smoothingTerm);
+		}
+
+		RowMajorMatrix restriction = prolongation.transpose();
+		const RowMajorMatrix prolongedA = A * prolongation;
+		RowMajorMatrix coarseMatrix = restriction * prolongedA;
+		coarseMatrix.prune(0.0);
+
+		m_Levels[levelId].Prolongation = std::move(prolongation);
+		m_Levels[levelId].Restriction = std::move(restriction);
+		m_Levels.push_back({ std::move(coarseMatrix) });
+	}
+
+	const Eigen::SparseMatrix<double> coarsestMatrix = m_Levels.back().Matrix;
+	m_CoarsestSolver = std::make_shared<Eigen::SparseLU<Eigen::SparseMatrix<double>>>();
+	m_CoarsestSolver->compute(coarsestMatrix);
+	if (m_CoarsestSolver->info() != Eigen::Success)
+		m_CoarsestSolver.reset(); // the coarsest level will be smoothed instead.
+}
+
+void AlgebraicMultigrid::Smooth(const Level& level, const Eigen::VectorXd& b, Eigen::VectorXd& x, const unsigned int& nSteps) const
+{
+	for (unsigned int s = 0; s < nSteps; s++)
+	{
+		const Eigen::VectorXd residual = b - level.Matrix * x;
+		x += m_Settings.JacobiWeight * level.InvDiagonal.cwiseProduct(residual);
+	}
+}
+
+void AlgebraicMultigrid::Cycle(const size_t& levelId, const Eigen::VectorXd& b, Eigen::VectorXd& x) const
+{
+	const auto& level = m_Levels[levelId];
+	if (levelId + 1 == m_Levels.size())
+	{
+		if (m_CoarsestSolver)
+			x = m_CoarsestSolver->solve(b);
+		else
+			Smooth(level, b, x, N_COARSEST_SMOOTHING_STEPS);
+		return;
+	}
+
+	Smooth(level, b, x, m_Settings.NPreSmoothingSteps);
+
+	const Eigen::VectorXd residual = b - level.Matrix * x;
+	const Eigen::VectorXd coarseRhs = level.Restriction * residual;
+	Eigen::VectorXd coarseX = Eigen::VectorXd::Zero(coarseRhs.size());
+	Cycle(levelId + 1, coarseRhs, coarseX);
+	x += level.Prolongation * coarseX;
+
+	Smooth(level, b, x, m_Settings.NPostSmoothingSteps);
+}
+
+double AlgebraicMultigrid::OperatorComplexity() const
+{
+	if (m_Levels.empty() || m_Levels.front().Matrix.nonZeros() == 0)
+		return 0.0;
+
+	double nNonZeros = 0.0;
+	for (const auto& level : m_Levels)
+		nNonZeros += static_cast<double>(level.Matrix.nonZeros());
+	return nNonZeros / static_cast<double>(m_Levels.front().Matrix.nonZeros());
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+
+#include <memory>
+#include <vector>
+
+/**
+ * \brief A wrapper for settings of the algebraic multigrid hierarchy.
+ * \struct MultigridSettings
+ */
+struct MultigridSettings
+{
+	double StrengthThreshold{ 0.08 }; //>! a_ij is a strong connection if |a_ij| >= StrengthThreshold * sqrt(|a_ii a_jj|).
+	unsigned int MaxLevels{ 12 }; //>! the maximum number of levels of the hierarchy.
+	unsigned int CoarsestSize{ 500 }; //>! the hierarchy stops coarsening once a level has at most this many unknowns (solved directly).
+	unsigned int NPreSmoothingSteps{ 2 }; //>! the number of damped Jacobi sweeps before coarse grid correction.
+	unsigned int NPostSmoothingSteps{ 2 }; //>! the number of damped Jacobi sweeps after coarse grid correction.
+	double JacobiWeight{ 2.0 / 3.0 }; //>! damping of the Jacobi smoother.
+	bool SmoothProlongation{ true }; //>! if true, tentative piecewise-constant prolongation is smoothed by a damped Jacobi step (smoothed aggregation).
+};
+
+/**
+ * \brief An aggregation-based algebraic multigrid V-cycle for the evolution system.
+ * \class AlgebraicMultigrid
+ *
+ * Unknowns are grouped into aggregates of strongly connected neighbors (which, for the evolution system,
+ * are one-rings of the mesh graph, so that the coarsening follows the surface as a geometric hierarchy would),
+ * and coarse operators are Galerkin products P^T A P. Rows without strong connections (frozen boundary/feature
+ * vertices) are not propagated to coarse levels and are resolved by the smoother.
+ * The class satisfies the interface of Eigen preconditioners, so it can be used as the preconditioner of Eigen
+ * iterative solvers, and it can be iterated on its own via Cycle.
+ */
+class AlgebraicMultigrid
+{
+public:
+	using RowMajorMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+	AlgebraicMultigrid() = default;
+
+	explicit AlgebraicMultigrid(const MultigridSettings& settings)
+		: m_Settings(settings)
+	{
+	}
+
+	/// \brief Eigen preconditioner interface: the hierarchy depends on values, so the setup is done in factorize.
+	template <typename MatrixType>
+	AlgebraicMultigrid& analyzePattern(const MatrixType&) { return *this; }
+
+	/// \brief Eigen preconditioner interface: builds the hierarchy.
+	template <typename MatrixType>
+	AlgebraicMultigrid& factorize(const MatrixType& mat)
+	{
+		Setup(RowMajorMatrix(mat));
+		return *this;
+	}
+
+	/// \brief Eigen preconditioner interface: builds the hierarchy.
+	template <typename MatrixType>
+	AlgebraicMultigrid& compute(const MatrixType& mat) { return factorize(mat); }
+
+	/// \brief Eigen preconditioner interface: applies a single V-cycle with zero initial guess (identity if the setup failed).
+	template <typename Rhs>
+	[[nodiscard]] Eigen::VectorXd solve(const Rhs& b) const
+	{
+		if (m_Info != Eigen::Success || m_Levels.empty())
+			return b;
+		Eigen::VectorXd x = Eigen::VectorXd::Zero(b.rows());
+		Cycle(0, b, x);
+		return x;
+	}
+
+	/// \brief Eigen preconditioner interface: status of the setup.
+	[[nodiscard]] Eigen::ComputationInfo info() const { return m_Info; }
+
+	/**
+	 * \brief Builds the multigrid hierarchy for a given matrix.
+	 * \param mat    fine level matrix.
+	 */
+	void Setup(const RowMajorMatrix& mat);
+
+	/**
+	 * \brief Performs a V-cycle on a given level improving x for level matrix * x = b.
+	 * \param levelId    level index (0 = finest).
+	 * \param b          right-hand side.
+	 * \param x          initial guess and result.
+	 */
+	void Cycle(const size_t& levelId, const Eigen::VectorXd& b, Eigen::VectorXd& x) const;
+
+	/// \brief the number of levels getter.
+	[[nodiscard]] size_t NLevels() const { return m_Levels.size(); }
+
+	/// \brief the ratio of the total number of nonzeros of all level matrices to that of the finest one.
+	[[nodiscard]] double OperatorComplexity() const;
+
+	/// \brief the finest level matrix.
+	[[nodiscard]] const RowMajorMatrix& Matrix() const { return m_Levels.front().Matrix; }
+
+private:
+	/// \brief a single level of the hierarchy.
+	struct Level
+	{
+		RowMajorMatrix Matrix{}; //>! level operator.
+		Eigen::VectorXd InvDiagonal{}; //>! inverse diagonal of the level operator (for the Jacobi smoother).
+		RowMajorMatrix Prolongation{}; //>! prolongation from the next coarser level (empty for the coarsest level).
+		RowMajorMatrix Restriction{}; //>! restriction to the next coarser level (= Prolongation^T).
+	};
+
+	/// \brief Performs nSteps of damped Jacobi iterations.
+	void Smooth(const Level& level, const Eigen::VectorXd& b, Eigen::VectorXd& x, const unsigned int& nSteps) const;
+
+	MultigridSettings m_Settings{}; //>! settings.
+	std::vector<Level> m_Levels{}; //>! levels of the hierarchy (finest first).
+	std::shared_ptr<Eigen::SparseLU<Eigen::SparseMatrix<double>>> m_CoarsestSolver{ nullptr }; //>! direct solver of the coarsest level.
+	Eigen::ComputationInfo m_Info{ Eigen::Success }; //>! status of the setup.
+};
+
+/**
+ * \brief Groups the unknowns of a given matrix into aggregates of strongly connected neighbors.
+ * \param mat                  system matrix.
+ * \param strengthThreshold    threshold of strong connections relative to sqrt(|a_ii a_jj|).
+ * \param aggregateIds         resulting aggregate index of each unknown (-1 for unknowns without strong connections).
+ * \return the number of aggregates.
+ */
+[[nodiscard]] Eigen::Index ComputeAggregates(const AlgebraicMultigrid::RowMajorMatrix& mat, const double& strengthThreshold, std::vector<Eigen::Index>& aggregateIds);
@@ -0,0 +1,208 @@
+#include "AsyncSurfaceExporter.h"
+
+#include <algorithm>
+#include <iostream>
+
+/**
+ * \brief Copies a vertex property into the snapshot if it has one of the given value types.
+ * \param mesh        source surface.
+ * \param name        property name.
+ * \param snapshot    snapshot of the source surface (with the same elements).
+ */
+template <typename... Types>
+static void CopyVertexProperty(const pmp::SurfaceMesh& mesh, const std::string& name, pmp::SurfaceMesh& snapshot)
+{
+	const auto copyAs = [&]<typename T>()
+	{
+		const auto prop = mesh.get_vertex_property<T>(name);
+		if (!prop)
+			return false;
+		snapshot.vertex_property<T>(name).vector() = prop.vector();
+		return true;
+	};
+	(copyAs.template operator()<Types>() || ...);
+}
+
+/**
+ * \brief Copies a face property into the snapshot if it has one of the given value types.
+ * \param mesh        source surface.
+ * \param name        property name.
+ * \param snapshot    snapshot of the source surface (with the same elements).
+ */
+template <typename... Types>
+static void CopyFaceProperty(const pmp::SurfaceMesh& mesh, const std::string& name, pmp::SurfaceMesh& snapshot)
+{
+	const auto copyAs = [&]<typename T>()
+	{
+		const auto prop = mesh.get_face_property<T>(name);
+		if (!prop)
+			return false;
+		snapshot.face_property<T>(name).vector() = prop.vector();
+		return true;
+	};
+	(copyAs.template operator()<Types>() || ...);
+}
+
+/**
+ * \brief Copies connectivity, positions and the properties written with given IO flags into a new surface.
+ * \param mesh     surface to be exported.
+ * \param flags    IO flags of the export (selecting the scalar properties written to VTK and PLY files).
+ * \return snapshot of the surface.
+ */
+[[nodiscard]] static std::unique_ptr<pmp::SurfaceMesh> MakeExportSnapshot(const pmp::SurfaceMesh& mesh, const pmp::IOFlags& flags)
+{
+	auto snapshot = std::make_unique<pmp::SurfaceMesh>();
+	snapshot->assign(mesh);
+
+	// scalar properties (all of them unless some are selected by the flags)
+	const bool exportAllProperties = flags.vertex_properties.empty() && flags.face_properties.empty();
+	for (const auto& name : (exportAllProperties ? mesh.vertex_properties() : flags.vertex_properties))
+	{
+		if (!snapshot->has_vertex_property(name))
+			CopyVertexProperty<bool, int, unsigned int, float, double>(mesh, name, *snapshot);
+	}
+	for (const auto& name : (exportAllProperties ? mesh.face_properties() : flags.face_properties))
+	{
+		if (!snapshot->has_face_property(name))
+			CopyFaceProperty<bool, int, unsigned int, float, double>(mesh, name, *snapshot);
+	}
+
+	// attributes used by the OBJ, OFF and STL writers
+	CopyVertexProperty<pmp::Normal>(mesh, "v:normal", *snapshot);
+	CopyVertexProperty<pmp::Color>(mesh, "v:color", *snapshot);
+	CopyVertexProperty<pmp::TexCoord>(mesh, "v:tex", *snapshot);
+	CopyFaceProperty<pmp::Normal>(mesh, "f:normal", *snapshot);
+	if (const auto texCoords = mesh.get_halfedge_property<pmp::TexCoord>("h:tex"))
+		snapshot->halfedge_property<pmp::TexCoord>("h:tex").vector() = texCoords.vector();
+
+	return snapshot;
+}
+
+AsyncSurfaceExporter::AsyncSurfaceExporter(const AsyncExportSettings& settings)
+	: m_Settings(settings)
+{
+	if (m_Settings.MaxQueuedSnapshots == 0)
+		m_Settings.MaxQueuedSnapshots = 1;
+
+	const unsigned int nWriters = std::max(m_Settings.NWriterThreads, 1u);
+	m_Writers.reserve(nWriters);
+	for (unsigned int i = 0; i < nWriters; i++)
+	{
+		m_Writers.emplace_back(&AsyncSurfaceExporter::WriterLoop, this);
+	}
+}
+
+AsyncSurfaceExporter::~AsyncSurfaceExporter()
+{
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_QueueNotEmpty.notify_all();
+	for (auto& writer : m_Writers)
+	{
+		if (writer.joinable())
+			writer.join();
+	}
+
+	if (m_WriterException)
+	{
+		try
+		{
+			std::rethrow_exception(m_WriterException);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "AsyncSurfaceExporter::~AsyncSurfaceExporter: [WARNING] unreported export failure: " << e.what() << "\n";
+		}
+		catch (...)
+		{
+			std::cerr << "AsyncSurfaceExporter::~AsyncSurfaceExporter: [WARNING] unreported export failure!\n";
+		}
+	}
+}
+
+bool AsyncSurfaceExporter::Submit(const pmp::SurfaceMesh& mesh, const std::string& fileName, const std::optional<pmp::mat4>& transform, const pmp::IOFlags& flags)
+{
+	{
+		std::unique_lock lock(m_Mutex);
+		if (m_Queue.size() >= m_Settings.MaxQueuedSnapshots)
+		{
+			if (m_Settings.DropSnapshotsWhenFull)
+			{
+				m_NDroppedSnapshots++;
+				std::cerr << "AsyncSurfaceExporter::Submit: [WARNING] queue full, dropping snapshot " << fileName << "!\n";
+				return false;
+			}
+			m_QueueNotFull.wait(lock, [this] { return m_Queue.size() < m_Settings.MaxQueuedSnapshots; });
+		}
+	}
+
+	// snapshot outside of the lock (the queue slot is guaranteed to the single producer).
+	ExportJob job{ MakeExportSnapshot(mesh, flags), fileName, transform, flags };
+
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Queue.emplace_back(std::move(job));
+	}
+	m_QueueNotEmpty.notify_one();
+	return true;
+}
+
+void AsyncSurfaceExporter::Flush()
+{
+	std::unique_lock lock(m_Mutex);
+	m_AllDone.wait(lock, [this] { return m_Queue.empty() && m_NJobsInProgress == 0; });
+
+	if (m_WriterException)
+	{
+		const auto exception = m_WriterException;
+		m_WriterException = nullptr;
+		std::rethrow_exception(exception);
+	}
+}
+
+size_t AsyncSurfaceExporter::NDroppedSnapshots() const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_NDroppedSnapshots;
+}
+
+void AsyncSurfaceExporter::WriterLoop()
+{
+	while (true)
+	{
+		ExportJob job;
+		{
+			std::unique_lock lock(m_Mutex);
+			m_QueueNotEmpty.wait(lock, [this] { return m_Stopping || !m_Queue.empty(); });
+			if (m_Queue.empty())
+				return; // stopping and drained
+
+			job = std::move(m_Queue.front());
+			m_Queue.pop_front();
+			m_NJobsInProgress++;
+		}
+		m_QueueNotFull.notify_one();
+
+		try
+		{
+			if (job.Transform.has_value())
+				(*job.Snapshot) *= job.Transform.value();
+			job.Snapshot->write(job.FileName, job.Flags);
+		}
+		catch (...)
+		{
+			std::lock_guard lock(m_Mutex);
+			if (!m_WriterException)
+				m_WriterException = std::current_exception();
+		}
+		job.Snapshot.reset(); // release snapshot memory before signaling completion.
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_NJobsInProgress--;
+		}
+		m_AllDone.notify_all();
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief A wrapper for settings of background (asynchronous) surface export.
+ * \struct AsyncExportSettings
+ */
+struct AsyncExportSettings
+{
+	bool Enabled{ false }; //>! if true, per-step surface export is handed over to background writer threads.
+	unsigned int NWriterThreads{ 1 }; //>! the number of writer threads serializing the queued snapshots.
+	unsigned int MaxQueuedSnapshots{ 2 }; //>! capacity of the snapshot queue (back-pressure bound on memory held by pending exports).
+	bool DropSnapshotsWhenFull{ false }; //>! if true, a snapshot submitted to a full queue is dropped instead of blocking the evolution loop.
+};
+
+/**
+ * \brief A bounded producer-consumer queue of surface snapshots serialized by background writer threads.
+ * \class AsyncSurfaceExporter
+ *
+ * The evolution loop submits a snapshot of its evolving surface (positions, connectivity and only the properties
+ * written with the export's IO flags) and continues with the next time step. The transformation to original coordinates and the file IO take place
+ * on writer threads, so that per-step export overlaps with the assembly and the solve of the next step.
+ */
+class AsyncSurfaceExporter
+{
+public:
+	/**
+	 * \brief Constructor. Launches settings.NWriterThreads writer threads.
+	 * \param settings       async export settings.
+	 */
+	explicit AsyncSurfaceExporter(const AsyncExportSettings& settings);
+
+	/// \brief Destructor. Waits for all pending snapshots to be written and joins the writer threads.
+	~AsyncSurfaceExporter();
+
+	AsyncSurfaceExporter(const AsyncSurfaceExporter&) = delete;
+	AsyncSurfaceExporter& operator=(const AsyncSurfaceExporter&) = delete;
+
+	/**
+	 * \brief Enqueues a surface snapshot for export. Blocks while the queue is full unless DropSnapshotsWhenFull is set.
+	 * \param mesh         surface to be exported (its connectivity, positions and exported properties are copied on the calling thread).
+	 * \param fileName     full output file name (including extension).
+	 * \param transform    optional transformation applied to the snapshot by the writer thread prior to export.
+	 * \param flags        IO flags of the export (e.g.: binary format and exported properties, see pmp::IOFlags::vertex_properties).
+	 * \return true if the snapshot was enqueued, false if it was dropped.
+	 */
+	bool Submit(const pmp::SurfaceMesh& mesh, const std::string& fileName, const std::optional<pmp::mat4>& transform = std::nullopt, const pmp::IOFlags& flags = {});
+
+	/**
+	 * \brief Waits until all enqueued snapshots are written.
+	 * \throw the first exception thrown by a writer thread since the last call to Flush.
+	 */
+	void Flush();
+
+	/// \brief the number of snapshots dropped because of a full queue.
+	[[nodiscard]] size_t NDroppedSnapshots() const;
+
+private:
+	/// \brief a single export job.
+	struct ExportJob
+	{
+		std::unique_ptr<pmp::SurfaceMesh> Snapshot{ nullptr };
+		std::string FileName{};
+		std::optional<pmp::mat4> Transform{};
+		pmp::IOFlags Flags{};
+	};
+
+	/// \brief main function of each writer thread.
+	void WriterLoop();
+
+	AsyncExportSettings m_Settings{}; //>! settings.
+
+	std::deque<ExportJob> m_Queue{}; //>! pending export jobs.
+	mutable std::mutex m_Mutex{}; //>! guards m_Queue and all counters.
+	std::condition_variable m_QueueNotEmpty{}; //>! signals writers that a job is available (or that the exporter is stopping).
+	std::condition_variable m_QueueNotFull{}; //>! signals the producer that a queue slot was freed.
+	std::condition_variable m_AllDone{}; //>! signals Flush that no jobs are pending or in progress.
+
+	size_t m_NJobsInProgress{ 0 }; //>! the number of jobs currently being written.
+	size_t m_NDroppedSnapshots{ 0 }; //>! the number of snapshots dropped due to a full queue.
+	bool m_Stopping{ false }; //>! if true, writer threads exit once the queue is drained.
+	std::exception_ptr m_WriterException{ nullptr }; //>! the first exception thrown by a writer thread.
+
+	std::vector<std::thread> m_Writers{}; //>! writer threads.
+};
@@ -13,6 +13,7 @@
 #include "geometry/MeshAnalysis.h"
 
 #include "EvolverUtilsCommon.h"
+#include "EvolutionEngine.h"
 //#include "ConversionUtils.h"
 
 // ================================================================================================
@@ -33,9 +34,6 @@ constexpr double CURVATURE_INTENSITY_FACTOR = 0.5;
 /// \brief if true individual steps of surface evolution will be printed out into a given stream.
 #define REPORT_EVOL_STEPS true // Note: may affect performance
 
-/// \brief if true, upon computing trilinear system solution, new vertices are verified for belonging in the field bounds.
-#define VERIFY_SOLUTION_WITHIN_BOUNDS false // Note: useful for detecting numerical explosions of the solution.
-
 /// \brief repairs infinities and nan values of the input grid.
 #define REPAIR_INPUT_GRID true //Note: very useful! You never know what field we use! Infinities and nans lead to the Eigen::NoConvergence error code whose cause is difficult to find!
 
@@ -46,12 +44,6 @@ BrainSurfaceEvolver::BrainSurfaceEvolver(const Geometry::ScalarGrid& field, cons
 #if REPAIR_INPUT_GRID
 	Geometry::RepairScalarGrid(*m_Field); // repair needed in case of invalid cell values.
 #endif
-	m_ImplicitLaplacianFunction =
-		(m_EvolSettings.LaplacianType == BE_MeshLaplacian::Barycentric ?
-			pmp::laplace_implicit_barycentric : pmp::laplace_implicit_voronoi);
-	m_LaplacianAreaFunction =
-		(m_EvolSettings.LaplacianType == BE_MeshLaplacian::Barycentric ?
-			pmp::voronoi_area_barycentric : pmp::voronoi_area);
 }
 
 // ================================================================================================
@@ -86,8 +78,6 @@ void BrainSurfaceEvolver::Preprocess()
 	m_EvolvingSurfaceRadiusEstimate = static_cast<double>(icoSphereRadius * scalingFactor);
 	//m_EvolSettings.IcoSphereSettings.Radius *= scalingFactor;
 
-	m_UnitNormalToGridScaleFactor = static_cast<float>(m_EvolvingSurfaceRadiusEstimate) / (maxDim * m_ScalingFactor);
-
 	// origin needs to be computed from bet2
 	const auto origin = m_EvolSettings.IcoSphereSettings.Center;
 
@@ -129,8 +119,30 @@ void BrainSurfaceEvolver::UpdateRadiusEstimate()
 	m_EvolvingSurfaceRadiusEstimate = 0.5 * (minDim + maxDim);
 }
 
-void BrainSurfaceEvolver::ComputeNormalIntensities()
+void BrainSurfaceEvolver::ComputeNormalIntensities(const pmp::SurfaceMesh& mesh, const pmp::VertexProperty<pmp::Point>& vNormals, pmp::VertexProperty<pmp::Scalar>& vIntensities) const
 {
+	std::vector<pmp::Point> probeOrigins;
+	std::vector<pmp::Point> probeDirections;
+	probeOrigins.reserve(mesh.n_vertices());
+	probeDirections.reserve(mesh.n_vertices());
+	for (const auto v : mesh.vertices())
+	{
+		probeOrigins.push_back(mesh.position(v));
+		probeDirections.push_back(-vNormals[v]);
+	}
+
+	// the field is scaled by m_ScalingFactor, so samples are taken 1 [mm] apart, starting 1 [mm] below the surface.
+	const auto& thresholds = m_EvolSettings.ThresholdSettings;
+	const Geometry::GridProbeSettings probeSettings{ m_ScalingFactor, m_ScalingFactor, thresholds.MinIntensitySearchDepth, thresholds.MaxIntensitySearchDepth };
+	std::vector<double> minIntensities, maxIntensities;
+	Geometry::SampleGridAlongProbes(*m_Field, probeOrigins, probeDirections, probeSettings, minIntensities, maxIntensities);
+
+	size_t i = 0;
+	for (const auto v : mesh.vertices())
+	{
+		vIntensities[v] = static_cast<pmp::Scalar>(NormalIntensityWeightFunction(minIntensities[i], maxIntensities[i]));
+		i++;
+	}
 }
 
 // ================================================================================================
@@ -145,77 +157,14 @@ double BrainSurfaceEvolver::LaplacianWeightFunction() const
 	//return m_EvolvingSurfaceRadiusEstimate - MAGIC_RADIUS_CONSTANT * bet2Radius;
 }
 
-double BrainSurfaceEvolver::NormalIntensityWeightFunction(const pmp::vec3& vPos, const pmp::vec3& vNormal) const
+double BrainSurfaceEvolver::NormalIntensityWeightFunction(const double& minProbeIntensity, const double& maxProbeIntensity) const
 {
-	const auto cellSize = m_Field->CellSize();
-	const auto& fieldBox = m_Field->Box();
-	const auto fieldOrigin = fieldBox.min();
-	const auto& fieldValues = m_Field->Values();
-	const auto [Nx, Ny, Nz] = m_Field->Dimensions();
-	const auto gridExtent = Nx * Ny * Nz;
-
-	double Imin = m_EvolSettings.ThresholdSettings.ThresholdEffectiveMedian; // tm
-	double Imax = m_EvolSettings.ThresholdSettings.ThresholdEffective; // t
-
-	// need to use scaling factor to access the correct grid voxels from normals
-	const auto vShiftedByNormal = vPos - m_ScalingFactor * vNormal;
-
-	// transform vertex from real space to grid index space
-	const auto ix0 = static_cast<int>(std::floor((vShiftedByNormal[0] - fieldOrigin[0]) / cellSize));
-	const auto iy0 = static_cast<int>(std::floor((vShiftedByNormal[1] - fieldOrigin[1]) / cellSize));
-	const auto iz0 = static_cast<int>(std::floor((vShiftedByNormal[2] - fieldOrigin[2]) / cellSize));
-	if (ix0 < 0 || iy0 < 0 || iz0 < 0 || ix0 >= Nx || iy0 >= Ny || iz0 >= Nz)
-		return 0.0; // Leave if indices are out of bounds.
-	const unsigned int gridPos0 = Nx * Ny * iz0 + Nx * iy0 + ix0;
-	const double im0 = fieldValues[gridPos0];
-
-	if (im0 < Imin) Imin = im0;
-	if (im0 > Imax) Imax = im0;
-
-	const auto d1 = m_EvolSettings.ThresholdSettings.MinIntensitySearchDepth;
-	const auto d2 = m_EvolSettings.ThresholdSettings.MaxIntensitySearchDepth;
-
-	const float normalStepFactor = m_UnitNormalToGridScaleFactor / static_cast<float>(d2 - d1);
-	const auto iNormalStepX = static_cast<int>(std::round(vNormal[0] * normalStepFactor));
-	const auto iNormalStepY = static_cast<int>(std::round(vNormal[1] * normalStepFactor));
-	const auto iNormalStepZ = static_cast<int>(std::round(vNormal[2] * normalStepFactor));
-
-	const auto ix1 = ix0 - (d1 - 1) * iNormalStepX;
-	const auto iy1 = iy0 - (d1 - 1) * iNormalStepY;
-	const auto iz1 = iz0 - (d1 - 1) * iNormalStepZ;
-	if (ix1 < 0 || iy1 < 0 || iz1 < 0 || ix1 >= Nx || iy1 >= Ny || iz1 >= Nz)
-		return 0.0; // Leave if indices are out of bounds.
-	const unsigned int gridPos1 = Nx * Ny * iz1 + Nx * iy1 + ix1;
-	const double im1 = fieldValues[gridPos1];
-
-	if (im1 < Imin) Imin = im1;
-
-	// search further in normal direction
-	auto ix = ix0;
-	auto iy = iy0;
-	auto iz = iz0;
-	//const auto cellSizeCubed = pow(cellSize, 3);
-	for (double gi = 2.0; gi < d1; gi += 1.0)
-	{
-		ix -= iNormalStepX;
-		iy -= iNormalStepY;
-		iz -= iNormalStepZ;
-		// Check bounds to ensure indices are within the grid dimensions.
-		if (ix < 0 || iy < 0 || iz < 0 || ix >= Nx || iy >= Ny || iz >= Nz)
-			break; // Break out of the loop if indices are out of bounds.
-
-		const unsigned int gridPos = Nx * Ny * iz + Nx * iy + ix;
-		if (gridPos >= gridExtent)
-			continue;
-		const double im = fieldValues[gridPos];
-		// Update Imin and Imax based on the intensity value at the current position.
-		Imin = std::min(Imin, im);
-		// Only update Imax within the range specified by d2.
-		if (gi < d2)
-		{
-			Imax = std::max(Imax, im);
-		}
-	}
+	if (std::isnan(minProbeIntensity))
+		return 0.0; // the probe starts outside of the field.
+
+	double Imin = std::min(m_EvolSettings.ThresholdSettings.ThresholdEffectiveMedian, minProbeIntensity); // tm
+	double Imax = (std::isnan(maxProbeIntensity) ? m_EvolSettings.ThresholdSettings.ThresholdEffective :
+		std::max(m_EvolSettings.ThresholdSettings.ThresholdEffective, maxProbeIntensity)); // t
 
 	const auto t2 = m_EvolSettings.ThresholdSettings.Threshold2ndPercentile;
 	const auto tm = m_EvolSettings.ThresholdSettings.ThresholdEffectiveMedian;
@@ -260,262 +209,258 @@ double BrainSurfaceEvolver::NormalIntensityWeightFunction(const pmp::vec3& vPos,
 
 void BrainSurfaceEvolver::ExportSurface(const unsigned int& tId, const bool& isResult, const bool& transformToOriginal) const
 {
+	m_DerivedProperties.UpdateAll(*m_EvolvingSurface);
 	const std::string connectingName = (isResult ? "_BE_Result" : "_BE_Evol_" + std::to_string(tId));
+	if (m_AsyncExporter)
+	{
+		const std::optional<pmp::mat4> transform = (transformToOriginal ? std::optional<pmp::mat4>(m_TransformToOriginal) : std::nullopt);
+		m_AsyncExporter->Submit(*m_EvolvingSurface, m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, transform, m_OutputMeshIOFlags);
+		return;
+	}
 	if (!transformToOriginal)
 	{
-		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 		return;
 	}
 	auto exportedSurface = *m_EvolvingSurface;
 	exportedSurface *= m_TransformToOriginal;
-	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 }
 
-void BrainSurfaceEvolver::ComputeTriangleMetrics() const
+// ================================================================================================
+// .................................. EvolutionEngine policies ....................................
+
+/// \brief Validates the input field and the starting surface of brain extraction.
+class BrainSurfaceEvolver::InitialSurfacePolicy
 {
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
+public:
+	explicit InitialSurfacePolicy(BrainSurfaceEvolver& evolver) : m_Evolver(evolver) {}
+
+	pmp::SurfaceMesh& Prepare()
 	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
+		if (!m_Evolver.m_Field)
+			throw std::invalid_argument("BrainSurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
+		if (!m_Evolver.m_Field->IsValid())
+			throw std::invalid_argument("BrainSurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
 
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
+		m_Evolver.Preprocess();
 
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "SurfaceEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
+		if (!m_Evolver.m_EvolvingSurface)
+			throw std::invalid_argument("BrainSurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+		return *m_Evolver.m_EvolvingSurface;
 	}
-}
 
-// ================================================================================================
+	[[nodiscard]] pmp::BoundingBox SolutionBounds() const { return m_Evolver.m_Field->Box(); }
 
-void BrainSurfaceEvolver::Evolve()
-{
-	if (!m_Field)
-		throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
-	if (!m_Field->IsValid())
-		throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetMatrix("TransformToOriginal", m_Evolver.m_TransformToOriginal);
+		checkpoint.SetValue("ScalingFactor", static_cast<double>(m_Evolver.m_ScalingFactor));
+	}
 
-	const auto& field = *m_Field;
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_Evolver.m_TransformToOriginal = checkpoint.GetMatrix("TransformToOriginal");
+		m_Evolver.m_ScalingFactor = static_cast<pmp::Scalar>(checkpoint.GetValue("ScalingFactor"));
+	}
 
-	Preprocess();
+private:
+	BrainSurfaceEvolver& m_Evolver;
+};
 
-	if (!m_EvolvingSurface)
-		throw std::invalid_argument("SurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
-
-	const auto& NSteps = m_EvolSettings.NSteps;
-	const auto& tStep = m_EvolSettings.TimeStep;
-
-	// ........ evaluate edge lengths for remeshing ....................
-	const float phi = (1.0f + sqrt(5.0f)) / 2.0f; /// golden ratio.
-	const auto subdiv = static_cast<float>(m_EvolSettings.IcoSphereSubdivisionLevel);
-	const float r = m_StartingSurfaceRadius * m_ScalingFactor;
-	const float minEdgeMultiplier = m_EvolSettings.TopoParams.MinEdgeMultiplier;
-	auto minEdgeLength = minEdgeMultiplier * (2.0f * r / (sqrt(phi * sqrt(5.0f)) * subdiv)); // from icosahedron edge length
-	auto maxEdgeLength = 4.0f * minEdgeLength;
-#if REPORT_EVOL_STEPS
-	std::cout << "minEdgeLength for remeshing: " << minEdgeLength << "\n";
-#endif
-	// .................................................................
+/// \brief Evaluates rows of the evolution system with a constant curvature weight and a normal intensity advection weight.
+class BrainSurfaceEvolver::WeightPolicy
+{
+public:
+	explicit WeightPolicy(const BrainSurfaceEvolver& evolver) : m_Evolver(evolver) {}
 
-	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
-	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
-	Eigen::MatrixXd sysRhs(NVertices, 3);
-	auto vIntensity = m_EvolvingSurface->vertex_property<pmp::Scalar>("v:normalIntensity", 0.0f);
-	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
+	void Initialize(pmp::SurfaceMesh& mesh)
+	{
+		m_VIntensity = mesh.vertex_property<pmp::Scalar>("v:normalIntensity", 0.0f);
+		m_VFeature = mesh.vertex_property<bool>(vertexFeaturePropertyKey, false);
 
-	// property container for surface vertex normals
-	pmp::VertexProperty<pmp::Point> vNormalsProp{};
+		// initial normal intensities are evaluated from initial normals (a resumed surface keeps the normals of its last step).
+		if (!mesh.has_vertex_property(vertexNormalPropertyKey))
+			pmp::Normals::compute_vertex_normals(mesh);
+		m_VNormals = mesh.get_vertex_property<pmp::Point>(vertexNormalPropertyKey);
+	}
 
-	// ----------- System fill function --------------------------------
-	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
+	void PrepareStep(const pmp::SurfaceMesh& mesh)
 	{
-		const float meanInterVertexDistance = ComputeMeanInterVertexDistance(*m_EvolvingSurface);
+		m_VNormals = mesh.get_vertex_property<pmp::Point>(vertexNormalPropertyKey);
+		m_MeanInterVertexDistance = ComputeMeanInterVertexDistance(mesh);
+	}
 
-		for (const auto v : m_EvolvingSurface->vertices())
+	[[nodiscard]] EvolutionSystemRow EvaluateRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& tStep) const
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto vPosToUpdate = mesh.position(v);
+
+		if ((settings.IdentityForBoundaryVertices && mesh.is_boundary(v)) ||
+			(settings.IdentityForFeatureVertices && m_VFeature[v]))
 		{
-			const auto vPosToUpdate = m_EvolvingSurface->position(v);
-
-			if ((m_EvolSettings.IdentityForBoundaryVertices && m_EvolvingSurface->is_boundary(v)) ||
-				(m_EvolSettings.IdentityForFeatureVertices && vFeature[v]))
-			{
-				// freeze boundary/feature vertices
-				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
-			}
-			
-			const auto vNormal = vNormalsProp[v]; // vertex unit normal
-
-			//const double absIntensity = std::abs(vIntensity[v]);
-			const double epsilonCtrlWeight = CURVATURE_INTENSITY_FACTOR; // (absIntensity > 0.0 ? absIntensity : 1.0);
-			const double etaCtrlWeight = BET_NORMAL_INTENSITY_FACTOR * meanInterVertexDistance * vIntensity[v];
-
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal /* + tStep * tanRedistWeight * vTanVelocity */;
-			sysRhs.row(v.idx()) = vertexRhs;
-
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
-
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
+			// freeze boundary/feature vertices
+			const Eigen::Vector3d vertexRhs = vPosToUpdate;
+			return { vertexRhs, 0.0, true };
 		}
-	};
-	// -----------------------------------------------------------------
 
-	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-	std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-#endif
-	// set initial surface vertex properties
+		const auto vNormal = m_VNormals[v]; // vertex unit normal
+
+		//const double absIntensity = std::abs(m_VIntensity[v]);
+		const double epsilonCtrlWeight = CURVATURE_INTENSITY_FACTOR; // (absIntensity > 0.0 ? absIntensity : 1.0);
+		const double etaCtrlWeight = BET_NORMAL_INTENSITY_FACTOR * m_MeanInterVertexDistance * m_VIntensity[v];
+
+		const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal /* + tStep * tanRedistWeight * vTanVelocity */;
+		return { vertexRhs, epsilonCtrlWeight, false };
+	}
+
+	void UpdateVertexProperties(pmp::SurfaceMesh& mesh)
 	{
-		pmp::Normals::compute_vertex_normals(*m_EvolvingSurface);
-		vNormalsProp = m_EvolvingSurface->vertex_property<pmp::Point>("v:normal");
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			vIntensity[v] = static_cast<pmp::Scalar>(NormalIntensityWeightFunction(vPos, vNormalsProp[v]));
-		}
+		m_Evolver.ComputeNormalIntensities(mesh, m_VNormals, m_VIntensity);
 	}
-	ComputeTriangleMetrics();
-	if (m_EvolSettings.ExportSurfacePerTimeStep)
-		ExportSurface(0);
-
-	// -------------------------------------------------------------------------------------------------------------
-	// ........................................ main loop ..........................................................
-	// -------------------------------------------------------------------------------------------------------------
-	for (unsigned int ti = 1; ti <= NSteps; ti++)
+
+private:
+	const BrainSurfaceEvolver& m_Evolver;
+	float m_MeanInterVertexDistance{ 0.0f }; //>! mean inter-vertex distance of the evolving surface for the current time step.
+	pmp::VertexProperty<pmp::Scalar> m_VIntensity{};
+	pmp::VertexProperty<bool> m_VFeature{};
+	pmp::VertexProperty<pmp::Point> m_VNormals{};
+};
+
+/// \brief Performs dihedral angle feature detection and remeshing after RemeshingStartTimeFactor * NSteps with a stepwise decay of remeshing lengths.
+class BrainSurfaceEvolver::TopologyPolicy : public DerivedPropertiesTopologyPolicy
+{
+public:
+	explicit TopologyPolicy(BrainSurfaceEvolver& evolver)
+		: DerivedPropertiesTopologyPolicy(evolver.m_DerivedProperties), m_Evolver(evolver) {}
+
+	void Initialize(const pmp::SurfaceMesh& /*mesh*/)
 	{
+		// ........ derived properties (computed only when consumed) .......
+		auto& properties = m_Evolver.m_DerivedProperties;
+		properties.Clear();
+		RegisterTriangleMetrics(properties, m_Evolver.m_EvolSettings.TriMetrics);
+
+		// ........ evaluate edge lengths for remeshing ....................
+		const float phi = (1.0f + sqrt(5.0f)) / 2.0f; /// golden ratio.
+		const auto subdiv = static_cast<float>(m_Evolver.m_EvolSettings.IcoSphereSubdivisionLevel);
+		const float r = m_Evolver.m_StartingSurfaceRadius * m_Evolver.m_ScalingFactor;
+		const float minEdgeMultiplier = m_Evolver.m_EvolSettings.TopoParams.MinEdgeMultiplier;
+		m_MinEdgeLength = minEdgeMultiplier * (2.0f * r / (sqrt(phi * sqrt(5.0f)) * subdiv)); // from icosahedron edge length
+		m_MaxEdgeLength = 4.0f * m_MinEdgeLength;
 #if REPORT_EVOL_STEPS
-		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << tStep * ti << "/" << tStep * NSteps
-			<< ", Procedure Name: " << m_EvolSettings.ProcedureName << "\n";
-		std::cout << "pmp::Normals::compute_vertex_normals ... ";
-#endif
-		pmp::Normals::compute_vertex_normals(*m_EvolvingSurface);
-		vNormalsProp = m_EvolvingSurface->vertex_property<pmp::Point>("v:normal");
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "fillMatrixAndRHSTriplesFromMesh for " << NVertices << " vertices ... ";
+		std::cout << "minEdgeLength for remeshing: " << m_MinEdgeLength << "\n";
 #endif
+	}
 
-		// prepare matrix & rhs
-		fillMatrixAndRHSTriplesFromMesh();
+	bool Apply(pmp::SurfaceMesh& mesh, const unsigned int& ti, double& /*tStep*/)
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto& NSteps = settings.NSteps;
+		if (!settings.DoRemeshing || ti <= NSteps * settings.TopoParams.RemeshingStartTimeFactor)
+			return false;
 
+		// remeshing
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Solving linear system ... ";
+		std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << m_MinEdgeLength << ", maxEdgeLength: " << m_MaxEdgeLength << ") ... ";
+		//std::cout << "pmp::Remeshing::uniform_remeshing(targetEdgeLength: " << targetEdgeLength << ") ... ";
 #endif
-		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
-		Eigen::MatrixXd x = solver.solve(sysRhs);
-		if (solver.info() != Eigen::Success)
+		if (settings.DoFeatureDetection && ti > NSteps * settings.TopoParams.FeatureDetectionStartTimeFactor)
 		{
-			const std::string msg = "\nSurfaceEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
-				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.info()) + "\n";
-			std::cerr << msg;
-			throw std::runtime_error(msg);
+			// detect features
+			const ScopedPhaseTrace featureTrace("FeatureDetection");
+			pmp::Features feat(mesh);
+			const auto minDihedralAngle = static_cast<pmp::Scalar>(settings.TopoParams.MinDihedralAngle);
+			const auto maxDihedralAngle = static_cast<pmp::Scalar>(settings.TopoParams.MaxDihedralAngle);
+			feat.detect_angle_within_bounds(minDihedralAngle, maxDihedralAngle);
 		}
+		const ScopedPhaseTrace remeshingTrace("Remeshing");
+		pmp::Remeshing remeshing(mesh, m_RemeshingReference);
+		remeshing.adaptive_remeshing({
+			m_MinEdgeLength, m_MaxEdgeLength, 2.0f * m_MinEdgeLength,
+			settings.TopoParams.NRemeshingIters,
+			settings.TopoParams.NTanSmoothingIters,
+			settings.TopoParams.UseBackProjection });
+		//remeshing.uniform_remeshing(targetEdgeLength);
 #if REPORT_EVOL_STEPS
 		std::cout << "done\n";
-		std::cout << "Updating vertex positions ... ";
-#endif
-
-		// update vertex positions & verify mesh within bounds
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		size_t nVertsOutOfBounds = 0;
 #endif
-		for (unsigned int i = 0; i < NVertices; i++)
-		{
-			const auto newPos = x.row(i);
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-			if (!fieldBox.Contains(newPos))
-			{
-				if (nVertsOutOfBounds == 0) std::cerr << "\n";
-				std::cerr << "SurfaceEvolver::Evolve: vertex " << i << " out of field bounds!\n";
-				nVertsOutOfBounds++;
-			}
-#endif
-			m_EvolvingSurface->position(pmp::Vertex(i)) = x.row(i);
-		}
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		if ((m_EvolSettings.DoRemeshing && nVertsOutOfBounds > static_cast<double>(NVertices) * m_EvolSettings.MaxFractionOfVerticesOutOfBounds) ||
-			(!m_EvolSettings.DoRemeshing && nVertsOutOfBounds > 0))
+		if (ti % settings.TopoParams.StepStrideForEdgeDecay == 0 &&
+			ti > NSteps * settings.TopoParams.RemeshingSizeDecayStartTimeFactor)
 		{
-			std::cerr << "SurfaceEvolver::Evolve: found " << nVertsOutOfBounds << " vertices out of bounds! Terminating!\n";
-			break;
+			// shorter edges are needed for features close to the target.
+			m_MinEdgeLength *= settings.TopoParams.EdgeLengthDecayFactor;
+			m_MaxEdgeLength *= settings.TopoParams.EdgeLengthDecayFactor;
 		}
-#endif
+		m_Evolver.m_DerivedProperties.Invalidate(MeshPropertyInput::Connectivity);
+		return true;
+	}
 
-		if (m_EvolSettings.DoRemeshing && ti > NSteps * m_EvolSettings.TopoParams.RemeshingStartTimeFactor)
-		{
-			// remeshing
-#if REPORT_EVOL_STEPS
-			std::cout << "done\n";
-			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << minEdgeLength << ", maxEdgeLength: " << maxEdgeLength << ") ... ";
-			//std::cout << "pmp::Remeshing::uniform_remeshing(targetEdgeLength: " << targetEdgeLength << ") ... ";
-#endif
-			if (m_EvolSettings.DoFeatureDetection && ti > NSteps * m_EvolSettings.TopoParams.FeatureDetectionStartTimeFactor)
-			{
-				// detect features
-				pmp::Features feat(*m_EvolvingSurface);
-				const auto minDihedralAngle = static_cast<pmp::Scalar>(m_EvolSettings.TopoParams.MinDihedralAngle);
-				const auto maxDihedralAngle = static_cast<pmp::Scalar>(m_EvolSettings.TopoParams.MaxDihedralAngle);
-				feat.detect_angle_within_bounds(minDihedralAngle, maxDihedralAngle);
-			}
-			pmp::Remeshing remeshing(*m_EvolvingSurface);
-			remeshing.adaptive_remeshing({
-				minEdgeLength, maxEdgeLength, 2.0f * minEdgeLength,
-				m_EvolSettings.TopoParams.NRemeshingIters,
-				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
-			//remeshing.uniform_remeshing(targetEdgeLength);
-#if REPORT_EVOL_STEPS
-			std::cout << "done\n";
-#endif
-			if (ti % m_EvolSettings.TopoParams.StepStrideForEdgeDecay == 0 &&
-				ti > NSteps * m_EvolSettings.TopoParams.RemeshingSizeDecayStartTimeFactor)
-			{
-				// shorter edges are needed for features close to the target.
-				minEdgeLength *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-				maxEdgeLength *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-			}
-		}
+	void UpdateMeshProperties(pmp::SurfaceMesh& mesh, const unsigned int& ti)
+	{
+		DerivedPropertiesTopologyPolicy::UpdateMeshProperties(mesh, ti);
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-#endif
-		// set surface vertex properties
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			vIntensity[v] = static_cast<pmp::Scalar>(NormalIntensityWeightFunction(vPos, vNormalsProp[v]));
-		}
-		ComputeTriangleMetrics();
-		UpdateRadiusEstimate();
+		if (ti > 0)
+			m_Evolver.UpdateRadiusEstimate();
+	}
 
-		if (m_EvolSettings.ExportSurfacePerTimeStep)
-			ExportSurface(ti);
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetValue("MinEdgeLength", static_cast<double>(m_MinEdgeLength));
+		checkpoint.SetValue("MaxEdgeLength", static_cast<double>(m_MaxEdgeLength));
+	}
 
-		// update linear system dims for next time step:
-		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
-		{
-			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
-			sysRhs = Eigen::MatrixXd(NVertices, 3);
-		}
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_MinEdgeLength = static_cast<float>(checkpoint.GetValue("MinEdgeLength"));
+		m_MaxEdgeLength = static_cast<float>(checkpoint.GetValue("MaxEdgeLength"));
+	}
 
-#if REPORT_EVOL_STEPS
-		std::cout << ">>> Time step " << ti << " finished.\n";
-		std::cout << "----------------------------------------------------------------------\n";
-#endif
-	} // end main loop
-	// -------------------------------------------------------------------------------------------------------------
+private:
+	BrainSurfaceEvolver& m_Evolver;
+	std::shared_ptr<pmp::RemeshingReference> m_RemeshingReference{ std::make_shared<pmp::RemeshingReference>() }; //>! back-projection reference reused by subsequent remeshing calls.
+	float m_MinEdgeLength{ 0.0f };
+	float m_MaxEdgeLength{ 0.0f };
+};
+
+// ================================================================================================
+
+void BrainSurfaceEvolver::RunEvolution(const EvolutionCheckpoint* checkpoint)
+{
+	InitialSurfacePolicy initialSurface(*this);
+	WeightPolicy weights(*this);
+	TopologyPolicy topology(*this);
+
+	if (m_EvolSettings.ExportSurfacePerTimeStep && m_EvolSettings.AsyncExport.Enabled)
+		m_AsyncExporter = std::make_shared<AsyncSurfaceExporter>(m_EvolSettings.AsyncExport);
+
+	const auto laplacianType = (m_EvolSettings.LaplacianType == BE_MeshLaplacian::Barycentric ? MeshLaplacian::Barycentric : MeshLaplacian::Voronoi);
+	DispatchLaplacianPolicy(laplacianType, [&](auto laplacianPolicy)
+	{
+		using LaplacianPolicy = decltype(laplacianPolicy);
+		EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy> engine(
+			GetEvolutionEngineSettings(m_EvolSettings), initialSurface, weights, topology);
+		engine.Run([this](const unsigned int& tId, const bool& isResult) { ExportSurface(tId, isResult); }, checkpoint);
+		m_PhaseStatistics = engine.GetPhaseStatistics();
+		m_ConvergenceReport = engine.GetConvergenceReport();
+	});
+
+	if (m_AsyncExporter)
+	{
+		m_AsyncExporter->Flush(); // all exported files need to be complete when Evolve returns.
+		m_AsyncExporter.reset();
+	}
+}
+
+void BrainSurfaceEvolver::Evolve()
+{
+	RunEvolution(nullptr);
+}
+
+void BrainSurfaceEvolver::Resume(const std::string& checkpointPath)
+{
+	const auto checkpoint = ReadCheckpoint(checkpointPath);
+	RunEvolution(&checkpoint);
 }
 
 // ================================================================================================
@@ -533,6 +478,13 @@ void ReportInput(const BrainExtractionSettings& evolSettings, std::ostream& os)
 	os << "......................................................................\n";
 	os << "Export Surface per Time Step: " << (evolSettings.ExportSurfacePerTimeStep ? "true" : "false") << ",\n";
 	os << "Output Path: " << evolSettings.OutputPath << ",\n";
+	os << "Linear Solver: " << LinearSolverTypeToString(evolSettings.LinearSolverParams.Type) << " (preconditioner reused for " << evolSettings.LinearSolverParams.PreconditionerReuseSteps << " steps),\n";
+	os << "Adaptive Time Stepping: " << (evolSettings.TimeStepControl.Enabled ? "true" : "false") << ",\n";
+	os << "Convergence Criterion: " << (evolSettings.Convergence.Enabled ? ConvergenceMeasureToString(evolSettings.Convergence.Measure) + " < " + std::to_string(evolSettings.Convergence.Tolerance) : std::string("none")) << ",\n";
+	os << "Checkpoints: " << (evolSettings.Checkpoint.Enabled ? "every " + std::to_string(evolSettings.Checkpoint.StepStride) + " steps" : std::string("none")) << ",\n";
+	os << "Phase Tracing: " << (evolSettings.Tracing.Enabled ? "true" : "false") << ",\n";
+	os << "Self-Intersection Detection: " << (evolSettings.SelfIntersections.Enabled ? "every " + std::to_string(evolSettings.SelfIntersections.StepStride) + " steps" + (evolSettings.SelfIntersections.TerminateOnDetection ? " (terminating on detection)" : "") : std::string("none")) << ",\n";
+	os << "Mesh Reordering: " << MeshReorderingTypeToString(evolSettings.MeshReordering) << ",\n";
 	os << "Do Remeshing: " << (evolSettings.DoRemeshing ? "true" : "false") << ",\n";
 	os << "----------------------------------------------------------------------\n";
 }
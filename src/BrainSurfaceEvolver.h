@@ -3,6 +3,14 @@
 #include "geometry/Grid.h"
 #include "pmp/SurfaceMesh.h"
 #include "pmp/algorithms/DifferentialGeometry.h"
+#include "AsyncSurfaceExporter.h"
+#include "EvolutionSystemSolver.h"
+#include "TimeStepController.h"
+#include "ConvergenceMonitor.h"
+#include "EvolutionCheckpoint.h"
+#include "EvolutionTracer.h"
+#include "SelfIntersectionMonitor.h"
+#include "DerivedMeshProperties.h"
 
 // [Smith, 2002]: Smith, S. M., Fast Robust Automated Brain Extraction, Human Brain Mapping, 2002
 
@@ -25,8 +33,8 @@ struct BE_ThresholdSettings
 	// ===================================================================================================================================================================================
 	// NOTES:
 	// "t2, tm, and t are used to limit the effect of very dark or very bright voxels, and t is included in the maximum intensity search to limit the effect of very bright voxels."
-	// Imin = max(t2, min(tm, I[0],..., I[d1])), where list { I[0],..., I[d1] } is nearest-neighbor-interpolated from evolving surface normal direction N.
-	// Imax = min(tm, max(t, I[0],..., I[d2])), where list { I[0],..., I[d2] } is nearest-neighbor-interpolated from evolving surface normal direction N.
+	// Imin = max(t2, min(tm, I[0],..., I[d1])), where list { I[0],..., I[d1] } is trilinearly interpolated from evolving surface normal direction N.
+	// Imax = min(tm, max(t, I[0],..., I[d2])), where list { I[0],..., I[d2] } is trilinearly interpolated from evolving surface normal direction N.
 	// t1 = (Imax - t2) * bt + t2
 	// f3 = 2 * (Imin - t1) / (Imax - t2)
 	// ===================================================================================================================================================================================
@@ -111,6 +119,15 @@ struct BrainExtractionSettings
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+
+	AsyncExportSettings AsyncExport{}; //>! settings for background export of per-step surfaces.
+	LinearSolverSettings LinearSolverParams{}; //>! settings of the linear solver for the evolution system.
+	TimeStepControlSettings TimeStepControl{}; //>! settings of adaptive time stepping (disabled by default).
+	ConvergenceSettings Convergence{}; //>! settings of convergence-based early termination (disabled by default).
+	CheckpointSettings Checkpoint{}; //>! settings of periodic checkpoints of the evolution state (disabled by default).
+	TracingSettings Tracing{}; //>! settings of phase tracing into a Chrome trace file (disabled by default).
+	SelfIntersectionSettings SelfIntersections{}; //>! settings of per-step self-intersection detection (disabled by default).
+	MeshReorderingType MeshReordering{ MeshReorderingType::ReverseCuthillMcKee }; //>! renumbering of the evolving surface after remeshing.
 };
 
 /**
@@ -132,6 +149,18 @@ public:
 	 */
 	void Evolve();
 
+	/**
+	 * \brief Resumes the evolution from a checkpoint file written by a previous run with the same settings.
+	 * \param checkpointPath    full name of the checkpoint file.
+	 */
+	void Resume(const std::string& checkpointPath);
+
+	/// \brief Per-phase aggregates of the last evolution (empty unless Tracing is enabled).
+	[[nodiscard]] const std::vector<PhaseStatistics>& GetPhaseStatistics() const { return m_PhaseStatistics; }
+
+	/// \brief Convergence of the last evolution (IsConverged is false unless it stopped early by the convergence criterion).
+	[[nodiscard]] const ConvergenceReport& GetConvergenceReport() const { return m_ConvergenceReport; }
+
 private:
 	/**
 	 * \brief Preprocess for evolution, i.e.: generate m_EvolvingSurface, and transform both m_Field and m_EvolvingSurface for stabilization.
@@ -145,8 +174,15 @@ private:
 	 */
 	void UpdateRadiusEstimate();
 
-	/// \brief computes f3 values according to [Smith, 2002]
-	void ComputeNormalIntensities();
+	/**
+	 * \brief Computes f3 values according to [Smith, 2002] for all vertices of the evolving surface.
+	 * \param mesh            evolving surface.
+	 * \param vNormals        vertex unit normals.
+	 * \param vIntensities    output vertex property of f3 values.
+	 *
+	 * Intensities along inward normals of all vertices are sampled in a single batch by Geometry::SampleGridAlongProbes.
+	 */
+	void ComputeNormalIntensities(const pmp::SurfaceMesh& mesh, const pmp::VertexProperty<pmp::Point>& vNormals, pmp::VertexProperty<pmp::Scalar>& vIntensities) const;
 
 	// ----------------------------------------------------------------
 
@@ -162,11 +198,11 @@ private:
 
 	/**
 	 * \brief Weight function for advection flow term, inspired by [Smith, 2002].
-	 * \param vPos              position of the vertex where the weight function is evaluated.
-	 * \param vNormal           normal of the vertex where the weight function is evaluated.
+	 * \param minProbeIntensity    min intensity of the first d1 samples along the inward vertex normal (NaN if the probe starts outside of the field).
+	 * \param maxProbeIntensity    max intensity of the first d2 samples along the inward vertex normal.
 	 * \return weight function value.
 	 */
-	[[nodiscard]] double NormalIntensityWeightFunction(const pmp::vec3& vPos, const pmp::vec3& vNormal) const;
+	[[nodiscard]] double NormalIntensityWeightFunction(const double& minProbeIntensity, const double& maxProbeIntensity) const;
 
 	// ----------------------------------------------------------------
 
@@ -178,10 +214,20 @@ private:
 	 */
 	void ExportSurface(const unsigned int& tId, const bool& isResult = false, const bool& transformToOriginal = true) const;
 
+	// ----------------------------------------------------------------
+
 	/**
-	 * \brief Computes triangle metrics interpolated to vertices according to list m_EvolSettings.TriMetrics.
+	 * \brief Runs the evolution engine from the initial surface or, if given, from a checkpoint.
+	 * \param checkpoint    checkpoint to resume from (nullptr for a new evolution).
 	 */
-	void ComputeTriangleMetrics() const;
+	void RunEvolution(const EvolutionCheckpoint* checkpoint);
+
+	// ----------------------------------------------------------------
+
+	// policies specializing EvolutionEngine for BrainSurfaceEvolver (defined in BrainSurfaceEvolver.cpp).
+	class InitialSurfacePolicy;
+	class WeightPolicy;
+	class TopologyPolicy;
 
 	// ----------------------------------------------------------------
 
@@ -193,14 +239,14 @@ private:
 	pmp::Scalar m_StartingSurfaceRadius{ 1.0f }; //>! radius of the starting surface.
 	pmp::Scalar m_ScalingFactor{ 1.0f }; //>! stabilization scaling factor value.
 
-	pmp::Scalar m_UnitNormalToGridScaleFactor{ 1.0f }; //>! scaling factor for voxel rasterization of surface unit normals for NormalIntensityWeightFunction.
-
-	std::function<pmp::ImplicitLaplaceInfo(const pmp::SurfaceMesh&, pmp::Vertex)> m_ImplicitLaplacianFunction{}; //>! a Laplacian function chosen from parameter MeshLaplacian.
-	std::function<double(const pmp::SurfaceMesh&, pmp::Vertex)> m_LaplacianAreaFunction{}; //>! a Laplacian area function chosen from parameter MeshLaplacian.
-	
 	// export
 	pmp::mat4 m_TransformToOriginal{}; //>! transformation matrix from stabilized surface to original size (for export).
 	std::string m_OutputMeshExtension = ".vtk"; //>! extension of the exported mesh geometry.
+	pmp::IOFlags m_OutputMeshIOFlags{ .use_binary = true }; //>! flags of the exported mesh geometry (binary, with all scalar vertex and face properties).
+	std::shared_ptr<AsyncSurfaceExporter> m_AsyncExporter{ nullptr }; //>! background writer for per-step surface export (if enabled).
+	std::vector<PhaseStatistics> m_PhaseStatistics{}; //>! per-phase aggregates of the last evolution (if traced).
+	ConvergenceReport m_ConvergenceReport{}; //>! convergence of the last evolution.
+	mutable DerivedMeshProperties m_DerivedProperties{}; //>! lazily updated curvatures, dihedral angles and triangle metrics of m_EvolvingSurface.
 
 	double m_EvolvingSurfaceRadiusEstimate{ 0.0 }; //>! estimate of the radius of the evolving surface, computed from bounds and updated for each time step.
 };
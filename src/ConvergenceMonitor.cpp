@@ -0,0 +1,99 @@
+#include "ConvergenceMonitor.h"
+
+#include "pmp/algorithms/DifferentialGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ConvergenceMonitor::ConvergenceMonitor(const ConvergenceSettings& settings)
+	: m_Settings(settings)
+{
+	if (!m_Settings.Enabled)
+		return;
+	if (m_Settings.Tolerance <= 0.0)
+		throw std::invalid_argument("ConvergenceMonitor::ConvergenceMonitor: Tolerance <= 0.0!\n");
+	if (m_Settings.WindowSize == 0)
+		m_Settings.WindowSize = 1;
+}
+
+void ConvergenceMonitor::Initialize(const pmp::SurfaceMesh& mesh)
+{
+	if (!m_Settings.Enabled)
+		return;
+	m_NStepsBelowTolerance = 0;
+	m_LastValue = 0.0;
+	if (m_Settings.Measure == ConvergenceMeasure::MeanDistanceChange || m_Settings.Measure == ConvergenceMeasure::VolumeChange)
+		m_PreviousQuantity = EvaluateQuantity(mesh);
+}
+
+double ConvergenceMonitor::EvaluateQuantity(const pmp::SurfaceMesh& mesh) const
+{
+	if (m_Settings.Measure == ConvergenceMeasure::VolumeChange)
+		return static_cast<double>(pmp::volume(mesh));
+
+	const auto vDistance = mesh.get_vertex_property<pmp::Scalar>("v:distance");
+	if (!vDistance)
+		throw std::logic_error("ConvergenceMonitor::EvaluateQuantity: MeanDistanceChange requires vertex property v:distance!\n");
+
+	double meanDistance = 0.0;
+	for (const auto v : mesh.vertices())
+		meanDistance += static_cast<double>(vDistance[v]);
+	return meanDistance / static_cast<double>(std::max<size_t>(mesh.n_vertices(), 1));
+}
+
+bool ConvergenceMonitor::Update(const pmp::SurfaceMesh& mesh, const Eigen::MatrixXd& oldPositions, const Eigen::MatrixXd& newPositions, const double& characteristicLength)
+{
+	if (!m_Settings.Enabled)
+		return false;
+
+	const double lengthUnit = (characteristicLength > 0.0 ? characteristicLength : 1.0);
+	if (m_Settings.Measure == ConvergenceMeasure::MaxDisplacement || m_Settings.Measure == ConvergenceMeasure::RMSDisplacement)
+	{
+		const auto nRows = std::min(oldPositions.rows(), newPositions.rows());
+		const Eigen::VectorXd displacements = (newPositions.topRows(nRows) - oldPositions.topRows(nRows)).rowwise().norm();
+		if (nRows == 0)
+			m_LastValue = 0.0;
+		else if (m_Settings.Measure == ConvergenceMeasure::MaxDisplacement)
+			m_LastValue = displacements.maxCoeff() / lengthUnit;
+		else
+			m_LastValue = std::sqrt(displacements.squaredNorm() / static_cast<double>(nRows)) / lengthUnit;
+	}
+	else
+	{
+		const double quantity = EvaluateQuantity(mesh);
+		if (m_Settings.Measure == ConvergenceMeasure::MeanDistanceChange)
+			m_LastValue = std::abs(quantity - m_PreviousQuantity) / lengthUnit;
+		else
+			m_LastValue = (m_PreviousQuantity > 0.0 ? std::abs(quantity - m_PreviousQuantity) / m_PreviousQuantity : 0.0);
+		m_PreviousQuantity = quantity;
+	}
+
+	m_NStepsBelowTolerance = (m_LastValue < m_Settings.Tolerance ? m_NStepsBelowTolerance + 1 : 0);
+	return m_NStepsBelowTolerance >= m_Settings.WindowSize;
+}
+
+void ConvergenceMonitor::SaveState(EvolutionCheckpoint& checkpoint) const
+{
+	checkpoint.SetValue("Convergence.PreviousQuantity", m_PreviousQuantity);
+	checkpoint.SetValue("Convergence.NStepsBelowTolerance", static_cast<double>(m_NStepsBelowTolerance));
+}
+
+void ConvergenceMonitor::LoadState(const EvolutionCheckpoint& checkpoint)
+{
+	if (!checkpoint.HasValue("Convergence.PreviousQuantity"))
+		return; // the monitor starts from the current surface.
+	m_PreviousQuantity = checkpoint.GetValue("Convergence.PreviousQuantity");
+	m_NStepsBelowTolerance = static_cast<unsigned int>(checkpoint.GetValue("Convergence.NStepsBelowTolerance"));
+}
+
+std::string ConvergenceMeasureToString(const ConvergenceMeasure& measure)
+{
+	if (measure == ConvergenceMeasure::RMSDisplacement)
+		return "RMSDisplacement";
+	if (measure == ConvergenceMeasure::MeanDistanceChange)
+		return "MeanDistanceChange";
+	if (measure == ConvergenceMeasure::VolumeChange)
+		return "VolumeChange";
+	return "MaxDisplacement";
+}
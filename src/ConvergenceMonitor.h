@@ -0,0 +1,97 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+
+#include "EvolutionCheckpoint.h"
+
+#include <Eigen/Dense>
+#include <string>
+
+/**
+ * \brief An enumerator for the quantity monitored by the convergence criterion of the evolution.
+ * \enum ConvergenceMeasure
+ */
+enum class [[nodiscard]] ConvergenceMeasure
+{
+	MaxDisplacement = 0, //>! max vertex displacement per step relative to sqrt(mean co-volume).
+	RMSDisplacement = 1, //>! root mean square vertex displacement per step relative to sqrt(mean co-volume).
+	MeanDistanceChange = 2, //>! change of the mean "v:distance" vertex property per step relative to sqrt(mean co-volume).
+	VolumeChange = 3 //>! relative change of the enclosed volume per step (meaningful only for closed surfaces).
+};
+
+/**
+ * \brief A wrapper for settings of convergence-based early termination of the evolution.
+ * \struct ConvergenceSettings
+ */
+struct ConvergenceSettings
+{
+	bool Enabled{ false }; //>! if true, the evolution stops before NSteps once the criterion is met.
+	ConvergenceMeasure Measure{ ConvergenceMeasure::MaxDisplacement }; //>! monitored quantity.
+	double Tolerance{ 1e-3 }; //>! the (dimensionless) monitored quantity needs to stay below this value ...
+	unsigned int WindowSize{ 3 }; //>! ... for this many consecutive time steps.
+};
+
+/**
+ * \brief The outcome of convergence monitoring of an evolution run.
+ * \struct ConvergenceReport
+ */
+struct ConvergenceReport
+{
+	bool IsConverged{ false }; //>! true if the evolution stopped before NSteps because the criterion was met.
+	unsigned int TimeStepId{ 0 }; //>! the time step at which the evolution converged.
+	double MeasureValue{ 0.0 }; //>! the value of the monitored measure at that time step.
+};
+
+/**
+ * \brief Monitors a per-step measure of surface motion and decides whether the evolution has converged.
+ * \class ConvergenceMonitor
+ */
+class ConvergenceMonitor
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param settings    convergence settings.
+	 */
+	explicit ConvergenceMonitor(const ConvergenceSettings& settings);
+
+	/**
+	 * \brief Records the reference state of the evolving surface before the first time step.
+	 * \param mesh    evolving surface (with initialized vertex properties).
+	 */
+	void Initialize(const pmp::SurfaceMesh& mesh);
+
+	/**
+	 * \brief Evaluates the monitored measure after a time step.
+	 * \param mesh                    evolving surface after the time step (with updated vertex properties).
+	 * \param oldPositions            (NVertices x 3) vertex positions before the time step.
+	 * \param newPositions            (NVertices x 3) vertex positions computed by the time step (prior to remeshing).
+	 * \param characteristicLength    length unit of the measures (sqrt of mean co-volume).
+	 * \return true if the measure stayed below tolerance for the whole window.
+	 */
+	[[nodiscard]] bool Update(const pmp::SurfaceMesh& mesh, const Eigen::MatrixXd& oldPositions, const Eigen::MatrixXd& newPositions, const double& characteristicLength);
+
+	/// \brief Stores the state of the monitor (the previous quantity and the number of steps below tolerance) into a checkpoint.
+	void SaveState(EvolutionCheckpoint& checkpoint) const;
+
+	/// \brief Restores the state of the monitor from a checkpoint (to be called after Initialize).
+	void LoadState(const EvolutionCheckpoint& checkpoint);
+
+	/// \brief Enabled flag getter.
+	[[nodiscard]] bool IsEnabled() const { return m_Settings.Enabled; }
+
+	/// \brief the value of the measure from the last call of Update.
+	[[nodiscard]] double LastValue() const { return m_LastValue; }
+
+private:
+	/// \brief Evaluates the quantity whose change is monitored (mean distance or volume).
+	[[nodiscard]] double EvaluateQuantity(const pmp::SurfaceMesh& mesh) const;
+
+	ConvergenceSettings m_Settings{}; //>! settings.
+	double m_PreviousQuantity{ 0.0 }; //>! the value of the monitored quantity after the previous step.
+	double m_LastValue{ 0.0 }; //>! the value of the measure after the last step.
+	unsigned int m_NStepsBelowTolerance{ 0 }; //>! the number of consecutive steps with the measure below tolerance.
+};
+
+/// \brief Converts ConvergenceMeasure to a string.
+[[nodiscard]] std::string ConvergenceMeasureToString(const ConvergenceMeasure& measure);
@@ -1,9 +1,15 @@
 #include "ConversionUtils.h"
 
 #include <fstream>
+#include <bit>
+#include <cstring>
 
 #include "geometry/GridUtil.h"
 
+#include "pmp/Exceptions.h"
+#include "pmp/MappedFile.h"
+#include "pmp/PolygonSoupParser.h"
+
 void ExportToVTI(const std::string& filename, const Geometry::ScalarGrid& scalarGrid)
 {
     if (!scalarGrid.IsValid())
@@ -44,53 +50,73 @@ void ExportToVTI(const std::string& filename, const Geometry::ScalarGrid& scalar
     vti.close();
 }
 
+/// \brief the number of float components per vector grid point.
+constexpr size_t VECTOR_GRID_N_COMPONENTS = 3;
+
+/**
+ * \brief Writes a float value into a buffer in big-endian byte order (required by legacy binary VTK).
+ * \param dst      destination buffer (at least sizeof(float) bytes).
+ * \param value    value to be written.
+ */
+static void WriteBigEndianFloat(char* dst, const float& value)
+{
+    static_assert(sizeof(float) == 4, "WriteBigEndianFloat: 32-bit float expected!");
+    std::memcpy(dst, &value, sizeof(float));
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        std::swap(dst[0], dst[3]);
+        std::swap(dst[1], dst[2]);
+    }
+}
+
 void ExportToVTK(const std::string& filename, const Geometry::VectorGrid& vectorGrid)
 {
     if (!vectorGrid.IsValid())
-        throw std::invalid_argument("ExportToVTI: vectorGrid to be exported is invalid!\n");
+        throw std::invalid_argument("ExportToVTK: vectorGrid to be exported is invalid!\n");
     if (filename.empty())
-        throw std::invalid_argument("ExportToVTI: filename cannot be empty!\n");
+        throw std::invalid_argument("ExportToVTK: filename cannot be empty!\n");
 
-    std::fstream vtk(filename + ".vtk", std::fstream::out);
+    std::ofstream vtk(filename + ".vtk", std::ios::out | std::ios::binary);
+    if (!vtk.is_open())
+        throw std::runtime_error("ExportToVTK: file " + filename + ".vtk could not be opened!\n");
 
     const auto& [Nx, Ny, Nz] = vectorGrid.Dimensions();
-    const auto nx = static_cast<unsigned int>(Nx);
-    const auto ny = static_cast<unsigned int>(Ny);
-    const auto nz = static_cast<unsigned int>(Nz);
     const float dx = vectorGrid.CellSize();
-
     const pmp::vec3 orig = vectorGrid.Box().min();
 
+    // header with implicit geometry (only origin and spacing are needed for STRUCTURED_POINTS)
     vtk << "# vtk DataFile Version 3.0\n";
     vtk << "vtk output\n";
-    vtk << "ASCII\n";
-    vtk << "DATASET STRUCTURED_GRID\n";
-    vtk << "DIMENSIONS " << nx << " " << ny << " " << nz <<"\n";
+    vtk << "BINARY\n";
+    vtk << "DATASET STRUCTURED_POINTS\n";
+    vtk << "DIMENSIONS " << Nx << " " << Ny << " " << Nz << "\n";
+    vtk << "ORIGIN " << orig[0] << " " << orig[1] << " " << orig[2] << "\n";
+    vtk << "SPACING " << dx << " " << dx << " " << dx << "\n";
 
     const size_t nValues = Nx * Ny * Nz;
-    vtk << "POINTS " << nValues << " float" << "\n";
-
-    for (unsigned int iz = 0; iz < nz; iz++) {
-        for (unsigned int iy = 0; iy < ny; iy++) {
-            for (unsigned int ix = 0; ix < nx; ix++) {
-                vtk << 
-                    orig[0] + static_cast<float>(ix) * dx << " " <<
-                    orig[1] + static_cast<float>(iy) * dx << " " <<
-                    orig[2] + static_cast<float>(iz) * dx << "\n";
-            }
-        }
-    }
-
     vtk << "POINT_DATA " << nValues << "\n";
-    vtk << "VECTORS Vectors_ double" << "\n";
+    vtk << "VECTORS Vectors_ float\n";
 
     const auto& valuesX = vectorGrid.ValuesX();
     const auto& valuesY = vectorGrid.ValuesY();
     const auto& valuesZ = vectorGrid.ValuesZ();
 
-    for (unsigned int i = 0; i < nValues; i++) {
-        vtk << valuesX[i] << " " << valuesY[i] << " " << valuesZ[i] << "\n";
+    // stream the Float32 payload in z-slabs, so that the export does not duplicate the whole grid in memory.
+    const size_t slabSize = Nx * Ny;
+    std::vector<char> slabBuffer(slabSize * VECTOR_GRID_N_COMPONENTS * sizeof(float));
+    for (size_t iz = 0; iz < Nz; iz++)
+    {
+        const size_t slabOffset = iz * slabSize;
+        char* dst = slabBuffer.data();
+        for (size_t i = slabOffset; i < slabOffset + slabSize; i++)
+        {
+            WriteBigEndianFloat(dst, static_cast<float>(valuesX[i])); dst += sizeof(float);
+            WriteBigEndianFloat(dst, static_cast<float>(valuesY[i])); dst += sizeof(float);
+            WriteBigEndianFloat(dst, static_cast<float>(valuesZ[i])); dst += sizeof(float);
+        }
+        vtk.write(slabBuffer.data(), static_cast<std::streamsize>(slabBuffer.size()));
     }
+    vtk << "\n";
 
     vtk.close();
 }
@@ -463,13 +489,6 @@ Geometry::ScalarGrid ImportVTI(const std::string& fileName)
 
 Geometry::BaseMeshGeometryData ImportVTK(const std::string& fileName)
 {
-	std::ifstream fileIStream(fileName);
-	if (!fileIStream.is_open())
-	{
-		std::cerr << "ImportVTK: file" + fileName + " could not be opened!\n";
-		throw std::invalid_argument("ImportVTK: file" + fileName + " could not be opened!\n");
-	}
-
 	const auto extensionOrig = fileName.substr(fileName.find(".") + 1);
 	std::string extLower = "";
 	std::ranges::transform(extensionOrig, std::back_inserter(extLower), std::tolower);
@@ -479,45 +498,26 @@ Geometry::BaseMeshGeometryData ImportVTK(const std::string& fileName)
 		throw std::invalid_argument("ImportVTI: file" + fileName + " could not be opened!\n");
 	}
 
-	Geometry::BaseMeshGeometryData meshData;
-	std::string line;
-
-	// Parse line by line
-	while (std::getline(fileIStream, line)) {
-		std::istringstream iss(line);
-		std::string token;
-		iss >> token;
-
-		// Skip comments and empty lines
-		if (token.empty() || token[0] == '#')
-			continue;
-
-		// Read vertex positions
-		if (token == "POINTS") {
-			int nPoints;
-			iss >> nPoints;
-			meshData.Vertices.reserve(nPoints);
-			for (int i = 0; i < nPoints; ++i) {
-				pmp::vec3 point;
-				fileIStream >> point[0] >> point[1] >> point[2];
-				meshData.Vertices.push_back(point);
-			}
-		}
+	pmp::PolygonSoup soup;
+	try
+	{
+		const pmp::MappedFile file(fileName);
+		soup = pmp::PolygonSoupParser::parse_vtk(file.view());
+	}
+	catch (const pmp::IOException& e)
+	{
+		std::cerr << "ImportVTK: file" + fileName + " could not be opened!\n";
+		throw std::invalid_argument("ImportVTK: file" + fileName + " could not be opened! " + e.what() + "\n");
+	}
 
-		// Read polygons
-		else if (token == "POLYGONS") {
-			int nPolygons, totalIndices;
-			iss >> nPolygons >> totalIndices;
-			for (int i = 0; i < nPolygons; ++i) {
-				int nVerts;
-				fileIStream >> nVerts;
-				std::vector<unsigned int> indices(nVerts);
-				for (int j = 0; j < nVerts; ++j) {
-					fileIStream >> indices[j];
-				}
-				meshData.PolyIndices.push_back(indices);
-			}
-		}
+	Geometry::BaseMeshGeometryData meshData;
+	meshData.Vertices = std::move(soup.positions);
+	meshData.PolyIndices.resize(soup.polygon_sizes.size());
+	for (size_t i = 0, offset = 0; i < soup.polygon_sizes.size(); i++)
+	{
+		const auto polyIndicesBegin = soup.polygon_indices.begin() + static_cast<std::ptrdiff_t>(offset);
+		meshData.PolyIndices[i].assign(polyIndicesBegin, polyIndicesBegin + soup.polygon_sizes[i]);
+		offset += soup.polygon_sizes[i];
 	}
 
 	return meshData;
@@ -16,10 +16,11 @@
 void ExportToVTI(const std::string& filename, const Geometry::ScalarGrid& scalarGrid);
 
 /**
- * \brief Exports vector field to .vtk format as a STRUCTURED_GRID of points with assigned vectors.
+ * \brief Exports vector field to binary legacy .vtk format as STRUCTURED_POINTS (origin & spacing) with Float32 vectors.
  * \param filename      in output path.
  * \param vectorGrid    vector grid to be exported.
  * \throw std::invalid_argument if vectorGrid is invalid or an empty filename is given.
+ * \throw std::runtime_error if the output file cannot be opened.
  */
 void ExportToVTK(const std::string& filename, const Geometry::VectorGrid& vectorGrid);
 
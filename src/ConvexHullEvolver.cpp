@@ -6,6 +6,7 @@
 #include "geometry/MeshAnalysis.h"
 #include "sdf/SDF.h"
 #include "ConversionUtils.h"
+#include "EvolutionEngine.h"
 
 #include <fstream>
 
@@ -13,226 +14,181 @@
 /// \brief if true individual steps of surface evolution will be printed out into a given stream.
 #define REPORT_EVOL_STEPS true // Note: may affect performance
 
-/// \brief if true, upon computing trilinear system solution, new vertices are verified for belonging in the field bounds.
-#define VERIFY_SOLUTION_WITHIN_BOUNDS false // Note: useful for detecting numerical explosions of the solution.
-
 ConvexHullEvolver::ConvexHullEvolver(const std::vector<pmp::Point>& pointCloud, const ConvexHullSurfaceEvolutionSettings& settings)
     : m_PointCloud(pointCloud),
 	  m_EvolSettings(settings)
 {
-	m_ImplicitLaplacianFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::laplace_implicit_barycentric : pmp::laplace_implicit_voronoi);
-	m_LaplacianAreaFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::voronoi_area_barycentric : pmp::voronoi_area);
 }
 
-void ConvexHullEvolver::Evolve()
+// ================================================================================================
+// .................................. EvolutionEngine policies ....................................
+
+/// \brief Computes the distance field of the input point cloud and generates the stabilized starting convex hull.
+class ConvexHullEvolver::InitialSurfacePolicy
 {
-	if (m_PointCloud.empty())
-		throw std::invalid_argument("ConvexHullEvolver::Evolve: m_PointCloud.empty()!\n");
+public:
+	explicit InitialSurfacePolicy(ConvexHullEvolver& evolver) : m_Evolver(evolver) {}
 
-    Preprocess();
+	pmp::SurfaceMesh& Prepare()
+	{
+		if (m_Evolver.m_PointCloud.empty())
+			throw std::invalid_argument("ConvexHullEvolver::Evolve: m_PointCloud.empty()!\n");
+
+		m_Evolver.Preprocess();
+
+		if (!m_Evolver.m_Field)
+			throw std::invalid_argument("ConvexHullEvolver::Evolve: m_Field not set! Terminating!\n");
+		if (!m_Evolver.m_Field->IsValid())
+			throw std::invalid_argument("ConvexHullEvolver::Evolve: m_Field is invalid! Terminating!\n");
+		if (!m_Evolver.m_Remesher)
+			throw std::invalid_argument("ConvexHullEvolver::Evolve: m_Remesher not set! Terminating!\n");
+		if (!m_Evolver.m_EvolvingSurface)
+			throw std::invalid_argument("ConvexHullEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+		return *m_Evolver.m_EvolvingSurface;
+	}
 
-	if (!m_Field)
-		throw std::invalid_argument("ConvexHullEvolver::Evolve: m_Field not set! Terminating!\n");
-	if (!m_Field->IsValid())
-		throw std::invalid_argument("ConvexHullEvolver::Evolve: m_Field is invalid! Terminating!\n");
-	if (!m_Remesher)
-		throw std::invalid_argument("ConvexHullEvolver::Evolve: m_Remesher not set! Terminating!\n");
-	if (!m_EvolvingSurface)
-		throw std::invalid_argument("ConvexHullEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
-    
-	const auto& field = *m_Field;
+	[[nodiscard]] pmp::BoundingBox SolutionBounds() const { return m_Evolver.m_Field->Box(); }
 
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-	const auto& fieldBox = field.Box();
-#endif
-	const auto fieldNegGradient = Geometry::ComputeNormalizedNegativeGradient(field);
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetMatrix("TransformToOriginal", m_Evolver.m_TransformToOriginal);
+		checkpoint.SetValue("ScalingFactor", static_cast<double>(m_Evolver.m_ScalingFactor));
+	}
 
-	const auto& NSteps = m_EvolSettings.NSteps;
-	auto tStep = m_EvolSettings.TimeStep;
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_Evolver.m_TransformToOriginal = checkpoint.GetMatrix("TransformToOriginal");
+		m_Evolver.m_ScalingFactor = static_cast<pmp::Scalar>(checkpoint.GetValue("ScalingFactor"));
+		m_Evolver.m_Remesher = std::make_shared<pmp::Remeshing>(*m_Evolver.m_EvolvingSurface); // bound to the restored surface.
+	}
 
-	// compute mesh sizings from the percentage within the total mesh dimensions
-	const auto [remeshedLengthMin, remeshedLengthMean, remeshedLengthMax] = Geometry::ComputeEdgeLengthMinAverageAndMax(*m_EvolvingSurface);
-#if REPORT_EVOL_STEPS
-	std::cout << "minEdgeLength is: " << (remeshedLengthMin / (m_EvolSettings.MaxDim * m_ScalingFactor)) * 100 << " % of MaxDim.\n";
-#endif
-	auto minEdgeLength = 4.0f * remeshedLengthMin;
-	auto maxEdgeLength = 8.0f * minEdgeLength;
-	auto approxError = 0.5f * minEdgeLength;
+private:
+	ConvexHullEvolver& m_Evolver;
+};
 
-#if REPORT_EVOL_STEPS
-	std::cout << "minEdgeLength for remeshing: " << minEdgeLength << "\n";
-#endif
-	// .................................................................
-	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
-
-	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
-	Eigen::MatrixXd sysRhs(NVertices, 3);
-	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
-	if (!m_EvolvingSurface->has_vertex_property("v:feature"))
-		throw std::logic_error("ConvexHullEvolver::Evolve: vertex property \"v:feature\" not found in m_EvolvingSurface!\n");
-	auto vFeature = m_EvolvingSurface->get_vertex_property<bool>("v:feature");
-	auto vIsFeatureVal = m_EvolvingSurface->vertex_property<pmp::Scalar>("v:isFeature", -1.0f);
-
-	// property container for surface vertex normals
-	pmp::VertexProperty<pmp::Point> vNormalsProp{};
-
-	// ----------- System fill function --------------------------------
-	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
-	{
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPosToUpdate = m_EvolvingSurface->position(v);
-
-			if ((m_EvolSettings.IdentityForBoundaryVertices && m_EvolvingSurface->is_boundary(v)) ||
-				(m_EvolSettings.IdentityForFeatureVertices && vFeature[v]))
-			{
-				// freeze boundary/feature vertices
-				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
-			}
-
-			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
-			const auto vNormal = vNormalsProp[v]; // vertex unit normal
-
-			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
-			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
-
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
-			const float tanRedistWeight = m_EvolSettings.TangentialVelocityWeight * epsilonCtrlWeight;
-			if (tanRedistWeight > 0.0f)
-			{
-				// compute tangential velocity
-				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
-			}
-
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
-
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
-		}
-	};
-	// -----------------------------------------------------------------
-	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
-	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
-	std::ofstream fileOStreamMaxes(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMaxes.txt");
-	std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-	fileOStreamMins << coVolStats.Min << ", ";
-	fileOStreamMeans << coVolStats.Mean << ", ";
-	fileOStreamMaxes << coVolStats.Max << ", ";
-#endif
-	// set initial surface vertex properties
-	for (const auto v : m_EvolvingSurface->vertices())
+/// \brief Evaluates distance-weighted advection-diffusion rows of the evolution system.
+class ConvexHullEvolver::WeightPolicy
+{
+public:
+	explicit WeightPolicy(const ConvexHullEvolver& evolver) : m_Evolver(evolver) {}
+
+	void Initialize(pmp::SurfaceMesh& mesh)
 	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-		vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
+		m_FieldNegGradient = std::make_shared<Geometry::VectorGrid>(Geometry::ComputeNormalizedNegativeGradient(*m_Evolver.m_Field));
+		m_VDistance = mesh.vertex_property<pmp::Scalar>(vertexDistancePropertyKey); // vertex property for distance field values (restored if resuming).
+		if (!mesh.has_vertex_property(vertexFeaturePropertyKey))
+			throw std::logic_error("ConvexHullEvolver::Evolve: vertex property \"v:feature\" not found in m_EvolvingSurface!\n");
+		m_VFeature = mesh.get_vertex_property<bool>(vertexFeaturePropertyKey);
+		m_VIsFeatureVal = mesh.vertex_property<pmp::Scalar>("v:isFeature", -1.0f);
 	}
-	ComputeTriangleMetrics();
-	if (m_EvolSettings.ExportSurfacePerTimeStep)
-		ExportSurface(0);
-
-	// -------------------------------------------------------------------------------------------------------------
-	// ........................................ main loop ..........................................................
-	// -------------------------------------------------------------------------------------------------------------
-	for (unsigned int ti = 1; ti <= NSteps; ti++)
+
+	void PrepareStep(const pmp::SurfaceMesh& mesh)
 	{
-#if REPORT_EVOL_STEPS
-		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << tStep * ti << " "
-			<< ", Procedure Name: " << m_EvolSettings.ProcedureName << "\n";
-		std::cout << "pmp::Normals::compute_vertex_normals ... ";
-#endif
-		pmp::Normals::compute_vertex_normals(*m_EvolvingSurface);
-		vNormalsProp = m_EvolvingSurface->vertex_property<pmp::Point>("v:normal");
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "fillMatrixAndRHSTriplesFromMesh for " << NVertices << " vertices ... ";
-#endif
+		m_VNormals = mesh.get_vertex_property<pmp::Point>(vertexNormalPropertyKey);
+	}
 
-		// prepare matrix & rhs
-		fillMatrixAndRHSTriplesFromMesh();
+	[[nodiscard]] EvolutionSystemRow EvaluateRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& tStep) const
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto vPosToUpdate = mesh.position(v);
 
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Solving linear system ... ";
-#endif
-		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
-		Eigen::MatrixXd x = solver.solve(sysRhs);
-		if (solver.info() != Eigen::Success)
+		if ((settings.IdentityForBoundaryVertices && mesh.is_boundary(v)) ||
+			(settings.IdentityForFeatureVertices && m_VFeature[v]))
 		{
-			const std::string msg = "\nSurfaceEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
-				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.info()) + "\n";
-			std::cerr << msg;
-			throw std::runtime_error(msg);
+			// freeze boundary/feature vertices
+			const Eigen::Vector3d vertexRhs = vPosToUpdate;
+			return { vertexRhs, 0.0, true };
 		}
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Updating vertex positions ... ";
-#endif
 
-		// update vertex positions & verify mesh within bounds
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		size_t nVertsOutOfBounds = 0;
-#endif
-		for (unsigned int i = 0; i < NVertices; i++)
+		const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, *m_FieldNegGradient);
+		const auto vNormal = m_VNormals[v]; // vertex unit normal
+
+		const double epsilonCtrlWeight = m_Evolver.LaplacianDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel);
+		const double etaCtrlWeight = m_Evolver.AdvectionDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
+
+		Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
+		const float tanRedistWeight = settings.TangentialVelocityWeight * epsilonCtrlWeight;
+		if (tanRedistWeight > 0.0f)
 		{
-			const auto newPos = x.row(i);
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-			if (!fieldBox.Contains(newPos))
-			{
-				if (nVertsOutOfBounds == 0) std::cerr << "\n";
-				std::cerr << "SurfaceEvolver::Evolve: vertex " << i << " out of field bounds!\n";
-				nVertsOutOfBounds++;
-			}
-#endif
-			m_EvolvingSurface->position(pmp::Vertex(i)) = x.row(i);
+			// compute tangential velocity
+			const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(mesh, v, vNormal, tanRedistWeight);
+			vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 		}
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		if ((m_EvolSettings.DoRemeshing && nVertsOutOfBounds > static_cast<double>(NVertices) * m_EvolSettings.MaxFractionOfVerticesOutOfBounds) ||
-			(!m_EvolSettings.DoRemeshing && nVertsOutOfBounds > 0))
+		return { vertexRhs, epsilonCtrlWeight, false };
+	}
+
+	void UpdateVertexProperties(pmp::SurfaceMesh& mesh)
+	{
+		const auto& field = *m_Evolver.m_Field;
+		for (const auto v : mesh.vertices())
 		{
-			std::cerr << "SurfaceEvolver::Evolve: found " << nVertsOutOfBounds << " vertices out of bounds! Terminating!\n";
-			break;
+			const auto vPos = mesh.position(v);
+			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
+			m_VDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+			m_VIsFeatureVal[v] = (m_VFeature[v] ? 1.0f : -1.0f);
 		}
-#endif
+	}
+
+private:
+	const ConvexHullEvolver& m_Evolver;
+	std::shared_ptr<Geometry::VectorGrid> m_FieldNegGradient{ nullptr }; //>! normalized negative gradient of the distance field.
+	pmp::VertexProperty<pmp::Scalar> m_VDistance{};
+	pmp::VertexProperty<bool> m_VFeature{};
+	pmp::VertexProperty<pmp::Scalar> m_VIsFeatureVal{};
+	pmp::VertexProperty<pmp::Point> m_VNormals{};
+};
+
+/// \brief Performs remeshing of non-feature regions (keeping locked convex hull vertices) and the decay of remeshing lengths and time step.
+class ConvexHullEvolver::TopologyPolicy : public DerivedPropertiesTopologyPolicy
+{
+public:
+	explicit TopologyPolicy(ConvexHullEvolver& evolver)
+		: DerivedPropertiesTopologyPolicy(evolver.m_DerivedProperties), m_Evolver(evolver) {}
+
+	void Initialize(const pmp::SurfaceMesh& mesh)
+	{
+		// ........ derived properties (computed only when consumed) .......
+		auto& properties = m_Evolver.m_DerivedProperties;
+		properties.Clear();
+		RegisterTriangleMetrics(properties, m_Evolver.m_EvolSettings.TriMetrics);
+
+		// compute mesh sizings from the percentage within the total mesh dimensions
+		const auto [remeshedLengthMin, remeshedLengthMean, remeshedLengthMax] = Geometry::ComputeEdgeLengthMinAverageAndMax(mesh);
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
+		std::cout << "minEdgeLength is: " << (remeshedLengthMin / (m_Evolver.m_EvolSettings.MaxDim * m_Evolver.m_ScalingFactor)) * 100 << " % of MaxDim.\n";
 #endif
+		m_MinEdgeLength = 4.0f * remeshedLengthMin;
+		m_MaxEdgeLength = 8.0f * m_MinEdgeLength;
+		m_ApproxError = 0.5f * m_MinEdgeLength;
 
-		// --------------------------------------------------------------------
+#if REPORT_EVOL_STEPS
+		std::cout << "minEdgeLength for remeshing: " << m_MinEdgeLength << "\n";
+#endif
+	}
 
-		//const auto meshQualityProp = m_EvolvingSurface->get_vertex_property<float>("v:equilateralJacobianCondition");
-		//if (m_EvolSettings.DoRemeshing && IsRemeshingNecessary(meshQualityProp.vector()))
-		if (m_EvolSettings.DoRemeshing && IsNonFeatureRemeshingNecessary(*m_EvolvingSurface))
+	bool Apply(pmp::SurfaceMesh& mesh, const unsigned int& ti, double& tStep)
+	{
+		auto& settings = m_Evolver.m_EvolSettings;
+
+		bool isRemeshed = false;
+		if (settings.DoRemeshing)
+			m_Evolver.m_DerivedProperties.Update("equilateralJacobianCondition", mesh);
+		//const auto meshQualityProp = mesh.get_vertex_property<float>("v:equilateralJacobianCondition");
+		//if (settings.DoRemeshing && IsRemeshingNecessary(meshQualityProp.vector()))
+		if (settings.DoRemeshing && IsNonFeatureRemeshingNecessary(mesh))
 		{
 			// remeshing
 #if REPORT_EVOL_STEPS
-			std::cout << "Remeshing ...";
+			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << m_MinEdgeLength << ", maxEdgeLength: " << m_MaxEdgeLength << ", approxError: " << m_ApproxError << ") ... ";
 #endif
-#if REPORT_EVOL_STEPS
-			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << minEdgeLength << ", maxEdgeLength: " << maxEdgeLength << ", approxError: " << approxError << ") ... ";
-#endif
-			m_Remesher->adaptive_remeshing({
-				minEdgeLength, maxEdgeLength, approxError,
-				m_EvolSettings.TopoParams.NRemeshingIters,
-				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+			const ScopedPhaseTrace remeshingTrace("Remeshing");
+			m_Evolver.m_Remesher->adaptive_remeshing({
+				m_MinEdgeLength, m_MaxEdgeLength, m_ApproxError,
+				settings.TopoParams.NRemeshingIters,
+				settings.TopoParams.NTanSmoothingIters,
+				settings.TopoParams.UseBackProjection });
+			isRemeshed = true;
+			m_Evolver.m_DerivedProperties.Invalidate(MeshPropertyInput::Connectivity);
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
 #endif
@@ -243,74 +199,89 @@ void ConvexHullEvolver::Evolve()
 		if (ShouldAdjustRemeshingLengths(ti))
 		{
 			// shorter edges are needed for features close to the target.
-			AdjustRemeshingLengths(m_EvolSettings.TopoParams.EdgeLengthDecayFactor, minEdgeLength, maxEdgeLength, approxError);
+			AdjustRemeshingLengths(settings.TopoParams.EdgeLengthDecayFactor, m_MinEdgeLength, m_MaxEdgeLength, m_ApproxError);
 #if REPORT_EVOL_STEPS
 			std::cout << "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv\n";
 			std::cout << "Lengths for adaptive remeshing adjusted to:\n";
-			std::cout << "min: " << minEdgeLength << ", max: " << maxEdgeLength << ", error: " << approxError << "\n";
-			std::cout << "by a factor of " << m_EvolSettings.TopoParams.EdgeLengthDecayFactor << ".\n";
+			std::cout << "min: " << m_MinEdgeLength << ", max: " << m_MaxEdgeLength << ", error: " << m_ApproxError << "\n";
+			std::cout << "by a factor of " << settings.TopoParams.EdgeLengthDecayFactor << ".\n";
 			std::cout << "time step adjustment: " << tStep << " -> ";
 #endif
-			tStep *= pow(m_EvolSettings.TopoParams.EdgeLengthDecayFactor, 2);
+			tStep *= pow(settings.TopoParams.EdgeLengthDecayFactor, 2);
 #if REPORT_EVOL_STEPS
 			std::cout << tStep << ".\n";
-			std::cout << "AdvectionMultiplier adjustment: " << m_EvolSettings.ADParams.AdvectionMultiplier << " -> ";
+			std::cout << "AdvectionMultiplier adjustment: " << settings.ADParams.AdvectionMultiplier << " -> ";
 #endif
-			m_EvolSettings.ADParams.AdvectionMultiplier /= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-			//m_EvolSettings.ADParams.AdvectionSineMultiplier /= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
+			settings.ADParams.AdvectionMultiplier /= settings.TopoParams.EdgeLengthDecayFactor;
+			//settings.ADParams.AdvectionSineMultiplier /= settings.TopoParams.EdgeLengthDecayFactor;
 #if REPORT_EVOL_STEPS
-			std::cout << m_EvolSettings.ADParams.AdvectionMultiplier << "\n";
+			std::cout << settings.ADParams.AdvectionMultiplier << "\n";
 			std::cout << "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\n";
 #endif
 		}
+		return isRemeshed;
+	}
 
-		// --------------------------------------------------------------------
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetValue("MinEdgeLength", static_cast<double>(m_MinEdgeLength));
+		checkpoint.SetValue("MaxEdgeLength", static_cast<double>(m_MaxEdgeLength));
+		checkpoint.SetValue("ApproxError", static_cast<double>(m_ApproxError));
+		checkpoint.SetValue("ADParams.AdvectionMultiplier", m_Evolver.m_EvolSettings.ADParams.AdvectionMultiplier); // adjusted with remeshing lengths.
+	}
+
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_MinEdgeLength = static_cast<float>(checkpoint.GetValue("MinEdgeLength"));
+		m_MaxEdgeLength = static_cast<float>(checkpoint.GetValue("MaxEdgeLength"));
+		m_ApproxError = static_cast<float>(checkpoint.GetValue("ApproxError"));
+		m_Evolver.m_EvolSettings.ADParams.AdvectionMultiplier = checkpoint.GetValue("ADParams.AdvectionMultiplier");
+	}
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+private:
+	ConvexHullEvolver& m_Evolver;
+	float m_MinEdgeLength{ 0.0f };
+	float m_MaxEdgeLength{ 0.0f };
+	float m_ApproxError{ 0.0f };
+};
 
-#if REPORT_EVOL_STEPS
-		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-		fileOStreamMins << coVolStats.Min << (ti < NSteps ? ", " : "");
-		fileOStreamMeans << coVolStats.Mean << (ti < NSteps ? ", " : "");
-		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
-#endif
-		// set surface vertex properties
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-			vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
-		}
-		ComputeTriangleMetrics();
+// ================================================================================================
 
-		if (m_EvolSettings.ExportSurfacePerTimeStep)
-			ExportSurface(ti);
+void ConvexHullEvolver::RunEvolution(const EvolutionCheckpoint* checkpoint)
+{
+	InitialSurfacePolicy initialSurface(*this);
+	WeightPolicy weights(*this);
+	TopologyPolicy topology(*this);
 
-		// update linear system dims for next time step:
-		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
-		{
-			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
-			sysRhs = Eigen::MatrixXd(NVertices, 3);
-		}
+	if (m_EvolSettings.ExportSurfacePerTimeStep && m_EvolSettings.AsyncExport.Enabled)
+		m_AsyncExporter = std::make_shared<AsyncSurfaceExporter>(m_EvolSettings.AsyncExport);
 
-#if REPORT_EVOL_STEPS
-		std::cout << ">>> Time step " << ti << " finished.\n";
-		std::cout << "----------------------------------------------------------------------\n";
-#endif
+	DispatchLaplacianPolicy(m_EvolSettings.LaplacianType, [&](auto laplacianPolicy)
+	{
+		using LaplacianPolicy = decltype(laplacianPolicy);
+		EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy> engine(
+			GetEvolutionEngineSettings(m_EvolSettings), initialSurface, weights, topology);
+		engine.Run([this](const unsigned int& tId, const bool& isResult) { ExportSurface(tId, isResult); }, checkpoint);
+		m_PhaseStatistics = engine.GetPhaseStatistics();
+		m_ConvergenceReport = engine.GetConvergenceReport();
+	});
 
-	} // end main loop
-	// -------------------------------------------------------------------------------------------------------------
-	
-	if (m_EvolSettings.ExportResultSurface)
-		ExportSurface(NSteps, true);
+	if (m_AsyncExporter)
+	{
+		m_AsyncExporter->Flush(); // all exported files need to be complete when Evolve returns.
+		m_AsyncExporter.reset();
+	}
+}
 
-#if REPORT_EVOL_STEPS
-	fileOStreamMins.close();
-	fileOStreamMaxes.close();
-	fileOStreamMeans.close();
-#endif
+void ConvexHullEvolver::Evolve()
+{
+	RunEvolution(nullptr);
+}
+
+void ConvexHullEvolver::Resume(const std::string& checkpointPath)
+{
+	const auto checkpoint = ReadCheckpoint(checkpointPath);
+	RunEvolution(&checkpoint);
 }
 
 // ================================================================================================
@@ -344,15 +315,22 @@ void ConvexHullEvolver::ExportSurface(const unsigned int& tId, const bool& isRes
 		std::cerr << "ConvexHullEvolver::ExportSurface: m_EvolvingSurface == nullptr!\n";
 		return;
 	}
+	m_DerivedProperties.UpdateAll(*m_EvolvingSurface);
 	const std::string connectingName = (isResult ? "_Result" : "_Evol_" + std::to_string(tId));
+	if (m_AsyncExporter)
+	{
+		const std::optional<pmp::mat4> transform = (transformToOriginal ? std::optional<pmp::mat4>(m_TransformToOriginal) : std::nullopt);
+		m_AsyncExporter->Submit(*m_EvolvingSurface, m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, transform, m_OutputMeshIOFlags);
+		return;
+	}
 	if (!transformToOriginal)
 	{
-		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 		return;
 	}
 	auto exportedSurface = *m_EvolvingSurface;
 	exportedSurface *= m_TransformToOriginal;
-	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 }
 
 void ConvexHullEvolver::ExportField(const bool& transformToOriginal) const
@@ -372,22 +350,6 @@ void ConvexHullEvolver::ExportField(const bool& transformToOriginal) const
 	ExportToVTI(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_SDF", exportedField);
 }
 
-void ConvexHullEvolver::ComputeTriangleMetrics() const
-{
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
-	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
-
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
-
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "SurfaceEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
-	}
-}
-
 // ================================================================================================
 
 void ConvexHullEvolver::Preprocess()
@@ -412,7 +374,10 @@ void ConvexHullEvolver::Preprocess()
 
 	// transform mesh and grid
 	// >>> uniform scale to ensure numerical method's stability.
-	const float scalingFactor = GetConvexHullStabilizationScalingFactor(m_EvolSettings.TimeStep, *m_EvolvingSurface, m_LaplacianAreaFunction);
+	const AreaFunction laplacianAreaFunction =
+		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
+			pmp::voronoi_area_barycentric : pmp::voronoi_area);
+	const float scalingFactor = GetConvexHullStabilizationScalingFactor(m_EvolSettings.TimeStep, *m_EvolvingSurface, laplacianAreaFunction);
 	m_ScalingFactor = scalingFactor;
 	m_EvolSettings.FieldIsoLevel *= static_cast<double>(scalingFactor);
 	const auto origin = m_EvolSettings.TargetOrigin;
@@ -504,6 +469,13 @@ void ReportCHEvolverInput(const ConvexHullSurfaceEvolutionSettings& evolSettings
 	os << "Target Origin: " << evolSettings.TargetOrigin << ",\n";
 	os << "Export Surface per Time Step: " << (evolSettings.ExportSurfacePerTimeStep ? "true" : "false") << ",\n";
 	os << "Output Path: " << evolSettings.OutputPath << ",\n";
+	os << "Linear Solver: " << LinearSolverTypeToString(evolSettings.LinearSolverParams.Type) << " (preconditioner reused for " << evolSettings.LinearSolverParams.PreconditionerReuseSteps << " steps),\n";
+	os << "Adaptive Time Stepping: " << (evolSettings.TimeStepControl.Enabled ? "true" : "false") << ",\n";
+	os << "Convergence Criterion: " << (evolSettings.Convergence.Enabled ? ConvergenceMeasureToString(evolSettings.Convergence.Measure) + " < " + std::to_string(evolSettings.Convergence.Tolerance) : std::string("none")) << ",\n";
+	os << "Checkpoints: " << (evolSettings.Checkpoint.Enabled ? "every " + std::to_string(evolSettings.Checkpoint.StepStride) + " steps" : std::string("none")) << ",\n";
+	os << "Phase Tracing: " << (evolSettings.Tracing.Enabled ? "true" : "false") << ",\n";
+	os << "Self-Intersection Detection: " << (evolSettings.SelfIntersections.Enabled ? "every " + std::to_string(evolSettings.SelfIntersections.StepStride) + " steps" + (evolSettings.SelfIntersections.TerminateOnDetection ? " (terminating on detection)" : "") : std::string("none")) << ",\n";
+	os << "Mesh Reordering: " << MeshReorderingTypeToString(evolSettings.MeshReordering) << ",\n";
 	os << "Do Remeshing: " << (evolSettings.DoRemeshing ? "true" : "false") << ",\n";
 	os << "Do Feature Detection: " << (evolSettings.DoFeatureDetection ? "true" : "false") << ",\n";
 	os << "----------------------------------------------------------------------\n";
@@ -6,6 +6,14 @@
 #include "pmp/SurfaceMesh.h"
 #include "pmp/algorithms/Remeshing.h"
 #include "pmp/algorithms/DifferentialGeometry.h"
+#include "AsyncSurfaceExporter.h"
+#include "EvolutionSystemSolver.h"
+#include "TimeStepController.h"
+#include "ConvergenceMonitor.h"
+#include "EvolutionCheckpoint.h"
+#include "EvolutionTracer.h"
+#include "SelfIntersectionMonitor.h"
+#include "DerivedMeshProperties.h"
 
 /**
  * \brief A wrapper for surface evolution settings.
@@ -41,6 +49,15 @@ struct ConvexHullSurfaceEvolutionSettings
 	bool IdentityForBoundaryVertices{ true }; //>! if true, boundary vertices give rise to: updated vertex = previous vertex.
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+
+	AsyncExportSettings AsyncExport{}; //>! settings for background export of per-step surfaces.
+	LinearSolverSettings LinearSolverParams{}; //>! settings of the linear solver for the evolution system.
+	TimeStepControlSettings TimeStepControl{}; //>! settings of adaptive time stepping (disabled by default).
+	ConvergenceSettings Convergence{}; //>! settings of convergence-based early termination (disabled by default).
+	CheckpointSettings Checkpoint{}; //>! settings of periodic checkpoints of the evolution state (disabled by default).
+	TracingSettings Tracing{}; //>! settings of phase tracing into a Chrome trace file (disabled by default).
+	SelfIntersectionSettings SelfIntersections{}; //>! settings of per-step self-intersection detection (disabled by default).
+	MeshReorderingType MeshReordering{ MeshReorderingType::ReverseCuthillMcKee }; //>! renumbering of the evolving surface after remeshing.
 };
 
 class ConvexHullEvolver
@@ -52,6 +69,15 @@ public:
     // Main functionality
     void Evolve();
 
+    // Resume the evolution from a checkpoint file
+    void Resume(const std::string& checkpointPath);
+
+    // Per-phase aggregates of the last evolution (empty unless Tracing is enabled)
+    [[nodiscard]] const std::vector<PhaseStatistics>& GetPhaseStatistics() const { return m_PhaseStatistics; }
+
+    // Convergence of the last evolution (IsConverged is false unless it stopped early by the convergence criterion)
+    [[nodiscard]] const ConvergenceReport& GetConvergenceReport() const { return m_ConvergenceReport; }
+
 private:
 	/**
 	 * \brief Preprocess for evolution, i.e.: generate m_EvolvingSurface, and transform both m_Field and m_EvolvingSurface for stabilization.
@@ -99,10 +125,20 @@ private:
 
 	void ExportField(const bool& transformToOriginal = true) const;
 
+	// ----------------------------------------------------------------
+
 	/**
-	 * \brief Computes triangle metrics interpolated to vertices according to list m_EvolSettings.TriMetrics.
+	 * \brief Runs the evolution engine from the initial surface or, if given, from a checkpoint.
+	 * \param checkpoint    checkpoint to resume from (nullptr for a new evolution).
 	 */
-	void ComputeTriangleMetrics() const;
+	void RunEvolution(const EvolutionCheckpoint* checkpoint);
+
+	// ----------------------------------------------------------------
+
+	// policies specializing EvolutionEngine for ConvexHullEvolver (defined in ConvexHullEvolver.cpp).
+	class InitialSurfacePolicy;
+	class WeightPolicy;
+	class TopologyPolicy;
 
 	// ----------------------------------------------------------------
 
@@ -116,12 +152,15 @@ private:
 
 	pmp::Scalar m_ScalingFactor{ 1.0f }; //>! stabilization scaling factor value.
 
-	std::function<pmp::ImplicitLaplaceInfo(const pmp::SurfaceMesh&, pmp::Vertex)> m_ImplicitLaplacianFunction{}; //>! a Laplacian function chosen from parameter MeshLaplacian.
-	std::function<double(const pmp::SurfaceMesh&, pmp::Vertex)> m_LaplacianAreaFunction{}; //>! a Laplacian area function chosen from parameter MeshLaplacian.
 	std::function<size_t(const pmp::Scalar&, const bool&)> m_FeatureFunction{}; //>! a function for detecting mesh features.
 
 	// export
 	std::string m_OutputMeshExtension = ".vtk"; //>! extension of the exported mesh geometry.
+	pmp::IOFlags m_OutputMeshIOFlags{ .use_binary = true }; //>! flags of the exported mesh geometry (binary, with all scalar vertex and face properties).
+	std::shared_ptr<AsyncSurfaceExporter> m_AsyncExporter{ nullptr }; //>! background writer for per-step surface export (if enabled).
+	std::vector<PhaseStatistics> m_PhaseStatistics{}; //>! per-phase aggregates of the last evolution (if traced).
+	ConvergenceReport m_ConvergenceReport{}; //>! convergence of the last evolution.
+	mutable DerivedMeshProperties m_DerivedProperties{}; //>! lazily updated curvatures, dihedral angles and triangle metrics of m_EvolvingSurface.
 	pmp::mat4 m_TransformToOriginal{}; //>! transformation matrix from stabilized surface to original size (for export).
 
 };
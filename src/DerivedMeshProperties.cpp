@@ -0,0 +1,127 @@
+#include "DerivedMeshProperties.h"
+
+#include "geometry/MeshAnalysis.h"
+
+#include "EvolutionTracer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+void DerivedMeshProperties::Register(const std::string& name, const unsigned int& inputs, const std::vector<std::string>& dependencies, ComputeFunction compute)
+{
+	if (!compute)
+		throw std::invalid_argument("DerivedMeshProperties::Register: empty compute function for " + name + "!\n");
+	if (IsRegistered(name))
+		throw std::invalid_argument("DerivedMeshProperties::Register: property " + name + " is already registered!\n");
+
+	Node node{ name, inputs, {}, std::move(compute) };
+	for (const auto& dependency : dependencies)
+	{
+		// dependencies need to be registered first, so the graph stays acyclic.
+		const auto dependencyId = FindNode(dependency);
+		if (dependencyId == m_Nodes.size())
+			throw std::invalid_argument("DerivedMeshProperties::Register: dependency " + dependency + " of " + name + " is not registered!\n");
+		node.DependencyIds.push_back(dependencyId);
+	}
+	m_Nodes.push_back(std::move(node));
+}
+
+void DerivedMeshProperties::Invalidate(const MeshPropertyInput& input)
+{
+	m_Clock++;
+	if (input == MeshPropertyInput::Positions)
+		m_PositionsChangedAt = m_Clock;
+	else
+		m_ConnectivityChangedAt = m_Clock;
+}
+
+void DerivedMeshProperties::InvalidateAll()
+{
+	for (auto& node : m_Nodes)
+		node.ComputedAt = 0;
+}
+
+bool DerivedMeshProperties::Update(const std::string& name, pmp::SurfaceMesh& mesh)
+{
+	const auto nodeId = FindNode(name);
+	if (nodeId == m_Nodes.size())
+		return false;
+
+	UpdateNode(nodeId, mesh);
+	return true;
+}
+
+void DerivedMeshProperties::UpdateAll(pmp::SurfaceMesh& mesh)
+{
+	for (size_t i = 0; i < m_Nodes.size(); i++)
+		UpdateNode(i, mesh);
+}
+
+bool DerivedMeshProperties::IsUpToDate(const std::string& name) const
+{
+	const auto nodeId = FindNode(name);
+	if (nodeId == m_Nodes.size())
+		return false;
+
+	const auto& node = m_Nodes[nodeId];
+	if (IsOutdated(node))
+		return false;
+	return std::all_of(node.DependencyIds.begin(), node.DependencyIds.end(),
+		[this](const size_t& dependencyId) { return IsUpToDate(m_Nodes[dependencyId].Name); });
+}
+
+void DerivedMeshProperties::Clear()
+{
+	m_Nodes.clear();
+}
+
+size_t DerivedMeshProperties::FindNode(const std::string& name) const
+{
+	const auto it = std::find_if(m_Nodes.begin(), m_Nodes.end(), [&name](const Node& node) { return node.Name == name; });
+	return static_cast<size_t>(it - m_Nodes.begin());
+}
+
+bool DerivedMeshProperties::IsOutdated(const Node& node) const
+{
+	if (node.ComputedAt == 0)
+		return true;
+	if ((node.Inputs & static_cast<unsigned int>(MeshPropertyInput::Positions)) && m_PositionsChangedAt > node.ComputedAt)
+		return true;
+	if ((node.Inputs & static_cast<unsigned int>(MeshPropertyInput::Connectivity)) && m_ConnectivityChangedAt > node.ComputedAt)
+		return true;
+	return std::any_of(node.DependencyIds.begin(), node.DependencyIds.end(),
+		[this, &node](const size_t& dependencyId) { return m_Nodes[dependencyId].ComputedAt > node.ComputedAt; });
+}
+
+void DerivedMeshProperties::UpdateNode(const size_t& nodeId, pmp::SurfaceMesh& mesh)
+{
+	for (const auto dependencyId : m_Nodes[nodeId].DependencyIds)
+		UpdateNode(dependencyId, mesh);
+
+	auto& node = m_Nodes[nodeId];
+	if (!IsOutdated(node))
+		return;
+
+	const ScopedPhaseTrace trace("Metrics");
+	node.Compute(mesh);
+	node.ComputedAt = ++m_Clock;
+}
+
+void RegisterTriangleMetrics(DerivedMeshProperties& properties, const std::vector<std::string>& metrics)
+{
+	for (const auto& metricName : metrics)
+	{
+		if (!Geometry::IsMetricRegistered(metricName) || properties.IsRegistered(metricName))
+			continue;
+
+		properties.Register(metricName, MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {},
+			[metricName, metricFunction = Geometry::IdentifyMetricFunction(metricName)](pmp::SurfaceMesh& mesh)
+			{
+				if (!metricFunction(mesh))
+				{
+					std::cerr << "RegisterTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
+				}
+			});
+	}
+}
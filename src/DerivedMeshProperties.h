@@ -0,0 +1,109 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Inputs of derived mesh properties whose changes are tracked (combinable as bit flags).
+ * \enum MeshPropertyInput
+ */
+enum class MeshPropertyInput : unsigned int
+{
+	Positions = 1, //>! vertex positions.
+	Connectivity = 2 //>! mesh connectivity (e.g.: changed by remeshing).
+};
+
+/// \brief combines mesh property inputs.
+[[nodiscard]] constexpr unsigned int operator|(const MeshPropertyInput& a, const MeshPropertyInput& b)
+{
+	return static_cast<unsigned int>(a) | static_cast<unsigned int>(b);
+}
+
+/**
+ * \brief A dependency graph of mesh properties derived from the evolving surface (e.g.: curvatures, dihedral angles,
+ *        triangle metrics), each of which is recomputed lazily.
+ * \class DerivedMeshProperties
+ *
+ * Each registered property depends on a set of mesh inputs and on previously registered properties. Changes of the
+ * inputs are only recorded by Invalidate, and a property is recomputed by Update only if one of its inputs changed
+ * or one of its dependencies was recomputed since its last computation. The consumers (remeshing triggers, export)
+ * call Update for the properties they need, so that time steps whose properties are not consumed skip their
+ * computation entirely.
+ */
+class DerivedMeshProperties
+{
+public:
+	/// \brief Computes a derived property (or a group of properties) of the mesh.
+	using ComputeFunction = std::function<void(pmp::SurfaceMesh&)>;
+
+	/**
+	 * \brief Registers a derived property.
+	 * \param name            unique name of the property.
+	 * \param inputs          MeshPropertyInput flags of the inputs the property depends on.
+	 * \param dependencies    names of already registered properties this property depends on.
+	 * \param compute         computation of the property.
+	 * \throw std::invalid_argument if the name is already registered or a dependency is not registered.
+	 */
+	void Register(const std::string& name, const unsigned int& inputs, const std::vector<std::string>& dependencies, ComputeFunction compute);
+
+	/// \brief Marks all properties depending on a given input as outdated.
+	void Invalidate(const MeshPropertyInput& input);
+
+	/// \brief Marks all properties as outdated (e.g.: if the mesh was replaced).
+	void InvalidateAll();
+
+	/**
+	 * \brief Recomputes a property (and its dependencies) if it is outdated.
+	 * \param name    property name.
+	 * \param mesh    the mesh whose properties are computed.
+	 * \return true if the property is registered (and up to date after the call).
+	 */
+	bool Update(const std::string& name, pmp::SurfaceMesh& mesh);
+
+	/// \brief Recomputes all outdated properties (e.g.: before export).
+	void UpdateAll(pmp::SurfaceMesh& mesh);
+
+	/// \brief Returns true if a property of a given name is registered.
+	[[nodiscard]] bool IsRegistered(const std::string& name) const { return FindNode(name) != m_Nodes.size(); }
+
+	/// \brief Returns true if a registered property is up to date.
+	[[nodiscard]] bool IsUpToDate(const std::string& name) const;
+
+	/// \brief Removes all registered properties.
+	void Clear();
+
+private:
+	/// \brief a registered property.
+	struct Node
+	{
+		std::string Name{};
+		unsigned int Inputs{ 0 };
+		std::vector<size_t> DependencyIds{};
+		ComputeFunction Compute{};
+		size_t ComputedAt{ 0 }; //>! clock value of the last computation (0 = never computed).
+	};
+
+	/// \brief Returns the index of a property (m_Nodes.size() if not registered).
+	[[nodiscard]] size_t FindNode(const std::string& name) const;
+
+	/// \brief Returns true if the node needs to be recomputed, assuming its dependencies are up to date.
+	[[nodiscard]] bool IsOutdated(const Node& node) const;
+
+	/// \brief Recomputes dependencies and the node itself if outdated.
+	void UpdateNode(const size_t& nodeId, pmp::SurfaceMesh& mesh);
+
+	std::vector<Node> m_Nodes{}; //>! registered properties (dependencies always precede their dependants).
+	size_t m_PositionsChangedAt{ 0 }; //>! clock value of the last change of vertex positions.
+	size_t m_ConnectivityChangedAt{ 0 }; //>! clock value of the last change of connectivity.
+	size_t m_Clock{ 0 }; //>! incremented by each input change and each computation.
+};
+
+/**
+ * \brief Registers triangle metrics (see Geometry::IdentifyMetricFunction) as derived properties depending on vertex positions and connectivity.
+ * \param properties    derived property graph.
+ * \param metrics       names of metrics (unknown and repeated metric names are skipped).
+ */
+void RegisterTriangleMetrics(DerivedMeshProperties& properties, const std::vector<std::string>& metrics);
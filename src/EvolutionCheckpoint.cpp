@@ -0,0 +1,160 @@
+#include "EvolutionCheckpoint.h"
+
+#include "pmp/SurfaceMeshIO.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+/// \brief identifies checkpoint files.
+constexpr std::array<char, 8> CHECKPOINT_MAGIC{ 'L', 'S', 'W', 'C', 'K', 'P', 'T', '\0' };
+
+/// \brief version of the checkpoint format (to be incremented upon format changes).
+constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+
+double EvolutionCheckpoint::GetValue(const std::string& name) const
+{
+	const auto it = Values.find(name);
+	if (it == Values.end() || it->second.empty())
+		throw std::runtime_error("EvolutionCheckpoint::GetValue: value " + name + " not found!\n");
+	return it->second.front();
+}
+
+void EvolutionCheckpoint::SetMatrix(const std::string& name, const pmp::mat4& matrix)
+{
+	auto& values = Values[name];
+	values.resize(16);
+	for (unsigned int i = 0; i < 16; i++)
+		values[i] = static_cast<double>(matrix[i]);
+}
+
+pmp::mat4 EvolutionCheckpoint::GetMatrix(const std::string& name) const
+{
+	const auto it = Values.find(name);
+	if (it == Values.end() || it->second.size() != 16)
+		throw std::runtime_error("EvolutionCheckpoint::GetMatrix: matrix " + name + " not found!\n");
+	pmp::mat4 matrix;
+	for (unsigned int i = 0; i < 16; i++)
+		matrix[i] = static_cast<pmp::Scalar>(it->second[i]);
+	return matrix;
+}
+
+namespace
+{
+	template <typename T>
+	void WriteBinary(std::ostream& os, const T& value)
+	{
+		os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	void ReadBinary(std::istream& is, T& value)
+	{
+		if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+			throw std::runtime_error("ReadCheckpoint: unexpected end of file!\n");
+	}
+
+	void WriteString(std::ostream& os, const std::string& str)
+	{
+		WriteBinary(os, static_cast<std::uint32_t>(str.size()));
+		os.write(str.data(), static_cast<std::streamsize>(str.size()));
+	}
+
+	[[nodiscard]] std::string ReadString(std::istream& is)
+	{
+		std::uint32_t size = 0;
+		ReadBinary(is, size);
+		std::string str(size, '\0');
+		if (size > 0 && !is.read(str.data(), size))
+			throw std::runtime_error("ReadCheckpoint: unexpected end of file!\n");
+		return str;
+	}
+} // anonymous namespace
+
+void WriteCheckpoint(const EvolutionCheckpoint& checkpoint, const std::string& fileName)
+{
+	const std::string tmpFileName = fileName + ".tmp";
+	{
+		std::ofstream os(tmpFileName, std::ios::binary | std::ios::trunc);
+		if (!os.is_open())
+			throw std::runtime_error("WriteCheckpoint: failed to open " + tmpFileName + "!\n");
+
+		os.write(CHECKPOINT_MAGIC.data(), CHECKPOINT_MAGIC.size());
+		WriteBinary(os, CHECKPOINT_VERSION);
+		WriteString(os, checkpoint.ProcedureName);
+		WriteBinary(os, static_cast<std::uint32_t>(checkpoint.TimeStepId));
+		WriteBinary(os, checkpoint.TimeStep);
+
+		WriteBinary(os, static_cast<std::uint32_t>(checkpoint.Values.size()));
+		for (const auto& [name, values] : checkpoint.Values)
+		{
+			WriteString(os, name);
+			WriteBinary(os, static_cast<std::uint32_t>(values.size()));
+			os.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+		}
+
+		pmp::SurfaceMeshIO::write_binary_snapshot(checkpoint.Surface, os);
+		os.flush();
+		if (!os)
+			throw std::runtime_error("WriteCheckpoint: failed to write " + tmpFileName + "!\n");
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tmpFileName, fileName, errorCode);
+	if (errorCode)
+		throw std::runtime_error("WriteCheckpoint: failed to replace " + fileName + ": " + errorCode.message() + "!\n");
+}
+
+EvolutionCheckpoint ReadCheckpoint(const std::string& fileName)
+{
+	std::ifstream is(fileName, std::ios::binary);
+	if (!is.is_open())
+		throw std::runtime_error("ReadCheckpoint: failed to open " + fileName + "!\n");
+
+	std::array<char, CHECKPOINT_MAGIC.size()> magic{};
+	if (!is.read(magic.data(), magic.size()) || magic != CHECKPOINT_MAGIC)
+		throw std::runtime_error("ReadCheckpoint: " + fileName + " is not a checkpoint file!\n");
+	std::uint32_t version = 0;
+	ReadBinary(is, version);
+	if (version != CHECKPOINT_VERSION)
+		throw std::runtime_error("ReadCheckpoint: unsupported checkpoint version " + std::to_string(version) + "!\n");
+
+	EvolutionCheckpoint checkpoint;
+	checkpoint.ProcedureName = ReadString(is);
+	std::uint32_t timeStepId = 0;
+	ReadBinary(is, timeStepId);
+	checkpoint.TimeStepId = timeStepId;
+	ReadBinary(is, checkpoint.TimeStep);
+
+	std::uint32_t nValues = 0;
+	ReadBinary(is, nValues);
+	for (std::uint32_t i = 0; i < nValues; i++)
+	{
+		const auto name = ReadString(is);
+		std::uint32_t size = 0;
+		ReadBinary(is, size);
+		auto& values = checkpoint.Values[name];
+		values.resize(size);
+		if (size > 0 && !is.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(double))))
+			throw std::runtime_error("ReadCheckpoint: unexpected end of file!\n");
+	}
+
+	try
+	{
+		pmp::SurfaceMeshIO::read_binary_snapshot(checkpoint.Surface, is);
+	}
+	catch (const pmp::IOException& e)
+	{
+		throw std::runtime_error("ReadCheckpoint: " + std::string(e.what()) + " in " + fileName + "!\n");
+	}
+	return checkpoint;
+}
+
+std::string GetCheckpointFileName(const CheckpointSettings& settings, const std::string& outputPath, const std::string& procedureName)
+{
+	if (!settings.FileName.empty())
+		return settings.FileName;
+	return outputPath + procedureName + "_Checkpoint.bin";
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * \brief A wrapper for settings of periodic checkpoints of the evolution state.
+ * \struct CheckpointSettings
+ */
+struct CheckpointSettings
+{
+	bool Enabled{ false }; //>! if true, the evolution state is written to a binary checkpoint file periodically.
+	unsigned int StepStride{ 5 }; //>! a checkpoint is written after every StepStride-th time step.
+	std::string FileName{}; //>! full checkpoint file name. If empty, OutputPath + ProcedureName + "_Checkpoint.bin" is used.
+};
+
+/**
+ * \brief The state of an evolution after a completed time step, from which the evolution can be resumed.
+ * \struct EvolutionCheckpoint
+ *
+ * Besides the evolving surface (with connectivity and all vertex, edge and face properties of basic types),
+ * the checkpoint holds named arrays of values saved by the engine and its policies (e.g.: remeshing lengths,
+ * adjusted advection-diffusion parameters, stabilization transform).
+ */
+struct EvolutionCheckpoint
+{
+	std::string ProcedureName{}; //>! name of the evolution procedure which wrote the checkpoint.
+	unsigned int TimeStepId{ 0 }; //>! index of the last completed time step.
+	double TimeStep{ 0.0 }; //>! time step size for the next time step.
+	pmp::SurfaceMesh Surface{}; //>! (stabilized) evolving surface after time step TimeStepId.
+	std::map<std::string, std::vector<double>> Values{}; //>! named state values of the engine and its policies.
+
+	/// \brief Stores a named scalar value.
+	void SetValue(const std::string& name, const double& value) { Values[name] = { value }; }
+
+	/// \brief Retrieves a named scalar value. Throws std::runtime_error if the value is missing.
+	[[nodiscard]] double GetValue(const std::string& name) const;
+
+	/// \brief Stores a named 4x4 matrix (column-major).
+	void SetMatrix(const std::string& name, const pmp::mat4& matrix);
+
+	/// \brief Retrieves a named 4x4 matrix. Throws std::runtime_error if the value is missing.
+	[[nodiscard]] pmp::mat4 GetMatrix(const std::string& name) const;
+
+	/// \brief Returns true if a value of a given name is stored.
+	[[nodiscard]] bool HasValue(const std::string& name) const { return Values.contains(name); }
+};
+
+/**
+ * \brief Writes a checkpoint to a binary file.
+ * \param checkpoint    checkpoint to be written.
+ * \param fileName      full file name.
+ *
+ * The checkpoint is written into a temporary file which then replaces fileName, so that a run terminated
+ * during the write never leaves a corrupt checkpoint behind.
+ */
+void WriteCheckpoint(const EvolutionCheckpoint& checkpoint, const std::string& fileName);
+
+/**
+ * \brief Reads a checkpoint from a binary file written by WriteCheckpoint.
+ * \param fileName      full file name.
+ * \return the checkpoint.
+ * \throw std::runtime_error if the file cannot be read or is not a valid checkpoint.
+ */
+[[nodiscard]] EvolutionCheckpoint ReadCheckpoint(const std::string& fileName);
+
+/**
+ * \brief Evaluates the checkpoint file name for given settings.
+ * \param settings         checkpoint settings.
+ * \param outputPath       output path of the evolution.
+ * \param procedureName    name of the evolution procedure.
+ * \return settings.FileName, or outputPath + procedureName + "_Checkpoint.bin" if settings.FileName is empty.
+ */
+[[nodiscard]] std::string GetCheckpointFileName(const CheckpointSettings& settings, const std::string& outputPath, const std::string& procedureName);
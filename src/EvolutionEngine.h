@@ -0,0 +1,599 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+#include "pmp/algorithms/DifferentialGeometry.h"
+#include "pmp/algorithms/Normals.h"
+
+#include "EvolverUtilsCommon.h"
+#include "DerivedMeshProperties.h"
+#include "EvolutionSystemSolver.h"
+#include "TimeStepController.h"
+#include "ConvergenceMonitor.h"
+#include "EvolutionCheckpoint.h"
+#include "EvolutionTracer.h"
+#include "SelfIntersectionMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+/// \brief if true individual steps of surface evolution will be printed out into a given stream.
+#define REPORT_EVOL_ENGINE_STEPS false // Note: may affect performance
+
+/// \brief if true, upon computing linear system solution, new vertices are verified for belonging in the field bounds.
+#define VERIFY_SOLUTION_WITHIN_BOUNDS false // Note: useful for detecting numerical explosions of the solution.
+
+/**
+ * \brief Laplacian policy of EvolutionEngine: co-volumes generated from a true Voronoi neighborhood of each vertex.
+ * \struct VoronoiLaplacianPolicy
+ */
+struct VoronoiLaplacianPolicy
+{
+	/// \brief Computes implicit Laplacian weights of the whole mesh.
+	static void ComputeWeights(const pmp::SurfaceMesh& mesh, pmp::ImplicitLaplaceWeights& weights)
+	{
+		pmp::laplace_implicit_weights_voronoi(mesh, weights);
+	}
+
+	/// \brief Computes the co-volume measure of vertex v.
+	static double CoVolumeArea(const pmp::SurfaceMesh& mesh, pmp::Vertex v)
+	{
+		return pmp::voronoi_area(mesh, v);
+	}
+};
+
+/**
+ * \brief Laplacian policy of EvolutionEngine: co-volumes generated from face barycenters.
+ * \struct BarycentricLaplacianPolicy
+ */
+struct BarycentricLaplacianPolicy
+{
+	/// \brief Computes implicit Laplacian weights of the whole mesh.
+	static void ComputeWeights(const pmp::SurfaceMesh& mesh, pmp::ImplicitLaplaceWeights& weights)
+	{
+		pmp::laplace_implicit_weights_barycentric(mesh, weights);
+	}
+
+	/// \brief Computes the co-volume measure of vertex v.
+	static double CoVolumeArea(const pmp::SurfaceMesh& mesh, pmp::Vertex v)
+	{
+		return pmp::voronoi_area_barycentric(mesh, v);
+	}
+};
+
+/**
+ * \brief Calls function with a Laplacian policy instance corresponding to a given MeshLaplacian type.
+ * \param type        mesh Laplacian type.
+ * \param function    a generic callable taking VoronoiLaplacianPolicy or BarycentricLaplacianPolicy.
+ */
+template <typename Function>
+void DispatchLaplacianPolicy(const MeshLaplacian& type, Function&& function)
+{
+	if (type == MeshLaplacian::Barycentric)
+	{
+		function(BarycentricLaplacianPolicy{});
+		return;
+	}
+	function(VoronoiLaplacianPolicy{});
+}
+
+/**
+ * \brief A base of topology policies of EvolutionEngine whose mesh properties are lazily updated DerivedMeshProperties.
+ * \class DerivedPropertiesTopologyPolicy
+ *
+ * After each step, the properties depending on vertex positions are only marked as outdated, and their consumers
+ * (remeshing triggers, export) recompute them on demand.
+ */
+class DerivedPropertiesTopologyPolicy
+{
+public:
+	/// \brief Constructor from the derived properties of the evolving surface.
+	explicit DerivedPropertiesTopologyPolicy(DerivedMeshProperties& properties) : m_Properties(properties) {}
+
+	/// \brief Marks the properties depending on vertex positions as outdated.
+	void UpdateMeshProperties(pmp::SurfaceMesh& /*mesh*/, const unsigned int& /*ti*/)
+	{
+		m_Properties.Invalidate(MeshPropertyInput::Positions);
+	}
+
+private:
+	DerivedMeshProperties& m_Properties;
+};
+
+/**
+ * \brief A row of the evolution system evaluated by the weight policy for a single vertex.
+ * \struct EvolutionSystemRow
+ */
+struct EvolutionSystemRow
+{
+	Eigen::Vector3d Rhs{}; //>! right-hand side of the vertex row.
+	double LaplacianWeight{ 0.0 }; //>! the weight (epsilon) of the Laplacian term at the vertex.
+	bool IsFixed{ false }; //>! if true, the vertex row is an identity row (the vertex moves explicitly by Rhs).
+};
+
+/**
+ * \brief A wrapper for the settings shared by all evolvers which are relevant for the evolution loop.
+ * \struct EvolutionEngineSettings
+ */
+struct EvolutionEngineSettings
+{
+	std::string ProcedureName{}; //>! name for the evolution procedure.
+	unsigned int NSteps{ 20 };   //>! number of time steps for surface evolution.
+	double TimeStep{ 0.01 };     //>! (initial) time step size.
+
+	bool ExportSurfacePerTimeStep{ false }; //>! whether to export evolving surface for each time step.
+	bool ExportResultSurface{ true }; //>! whether to export resulting evolving surface.
+	std::string OutputPath{}; //>! path where output surfaces are to be exported.
+
+	bool DoRemeshing{ true }; //>! if true, adaptive remeshing is expected to take place.
+	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+
+	LinearSolverSettings LinearSolverParams{}; //>! settings of the linear solver for the evolution system.
+	TimeStepControlSettings TimeStepControl{}; //>! settings of adaptive time stepping.
+	ConvergenceSettings Convergence{}; //>! settings of convergence-based early termination.
+	CheckpointSettings Checkpoint{}; //>! settings of periodic checkpoints of the evolution state.
+	TracingSettings Tracing{}; //>! settings of phase tracing.
+	SelfIntersectionSettings SelfIntersections{}; //>! settings of self-intersection detection.
+	MeshReorderingType MeshReordering{ MeshReorderingType::ReverseCuthillMcKee }; //>! renumbering of the evolving surface after topology adjustments.
+};
+
+/// \brief Extracts EvolutionEngineSettings from the settings of a particular evolver.
+template <typename EvolverSettings>
+[[nodiscard]] EvolutionEngineSettings GetEvolutionEngineSettings(const EvolverSettings& settings)
+{
+	return {
+		settings.ProcedureName, settings.NSteps, settings.TimeStep,
+		settings.ExportSurfacePerTimeStep, settings.ExportResultSurface, settings.OutputPath,
+		settings.DoRemeshing, settings.MaxFractionOfVerticesOutOfBounds,
+		settings.LinearSolverParams, settings.TimeStepControl, settings.Convergence, settings.Checkpoint, settings.Tracing, settings.SelfIntersections,
+		settings.MeshReordering };
+}
+
+/**
+ * \brief The time-stepping loop of the implicit advection-diffusion surface evolution, specialized at compile time
+ *        by the policies of a particular evolver.
+ * \class EvolutionEngine
+ *
+ * The engine owns the evolution system (cached sparsity pattern, rhs, Laplacian weights and the linear solver)
+ * and performs: normals -> system assembly -> solve -> position update -> topology adjustments -> property updates
+ * -> export for each time step. If adaptive time stepping is enabled, assembly and solve are repeated with a shrunk
+ * time step until TimeStepController accepts the new positions (its bounds are rescaled whenever the topology policy
+ * rescales the time step, so that growth does not undo the decay). If a convergence criterion is enabled, the evolution
+ * stops (and exports its result) as soon as ConvergenceMonitor detects that the surface stopped moving.
+ * If checkpoints are enabled, the evolving surface and the state of the engine and its policies are written into
+ * a binary EvolutionCheckpoint every Checkpoint.StepStride steps, and Run can continue the evolution from it.
+ * If tracing is enabled, the phases of each time step (including those traced by the policies via ScopedPhaseTrace)
+ * and counters such as the vertex count and solver iterations are recorded, written into a Chrome trace file,
+ * and aggregated by GetPhaseStatistics.
+ * If self-intersection detection is enabled, self-intersecting faces are marked by SelfIntersectionMonitor after
+ * every SelfIntersections.StepStride steps, and the evolution optionally stops at the first detected self-intersection.
+ * After every topology adjustment (e.g.: remeshing), the vertices and faces of the evolving surface are renumbered
+ * by ReorderSurfaceMesh according to MeshReordering, so that the system matrix has a small bandwidth.
+ * The policies are expected to provide:
+ *
+ * InitialSurfacePolicy:
+ *   pmp::SurfaceMesh& Prepare();                 validates input, preprocesses and returns the (stabilized) evolving surface.
+ *   pmp::BoundingBox SolutionBounds() const;     bounds of the evolution domain (used if VERIFY_SOLUTION_WITHIN_BOUNDS).
+ *   void SaveState(EvolutionCheckpoint& checkpoint) const;     stores the stabilization transform.
+ *   void LoadState(const EvolutionCheckpoint& checkpoint);     restores it (called after Prepare, once the surface is replaced by the checkpoint surface).
+ *
+ * WeightPolicy:
+ *   void Initialize(pmp::SurfaceMesh& mesh);                 adds vertex properties and precomputes field data.
+ *   void PrepareStep(const pmp::SurfaceMesh& mesh);          called after vertex normals are computed for each time step.
+ *   EvolutionSystemRow EvaluateRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& tStep) const;
+ *                                                            evaluated concurrently for all vertices (needs to be thread-safe).
+ *   void UpdateVertexProperties(pmp::SurfaceMesh& mesh);     resamples per-vertex field data after a step.
+ *
+ * LaplacianPolicy: VoronoiLaplacianPolicy or BarycentricLaplacianPolicy.
+ *
+ * TopologyPolicy:
+ *   void Initialize(const pmp::SurfaceMesh& mesh);                                  computes remeshing lengths.
+ *   bool Apply(pmp::SurfaceMesh& mesh, const unsigned int& ti, double& tStep);      feature detection & remeshing (may adjust tStep), returns true if connectivity changed.
+ *   void UpdateMeshProperties(pmp::SurfaceMesh& mesh, const unsigned int& ti);      recomputes curvatures, metrics, etc. after a step (see DerivedPropertiesTopologyPolicy).
+ *   void SaveState(EvolutionCheckpoint& checkpoint) const;                          stores remeshing lengths and adjusted parameters.
+ *   void LoadState(const EvolutionCheckpoint& checkpoint);                          restores them (called after Initialize).
+ */
+template <typename InitialSurfacePolicy, typename WeightPolicy, typename LaplacianPolicy, typename TopologyPolicy>
+class EvolutionEngine
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param settings          engine settings.
+	 * \param initialSurface    initial surface policy.
+	 * \param weights           weight policy.
+	 * \param topology          topology policy.
+	 */
+	EvolutionEngine(const EvolutionEngineSettings& settings, InitialSurfacePolicy& initialSurface, WeightPolicy& weights, TopologyPolicy& topology)
+		: m_Settings(settings), m_InitialSurface(initialSurface), m_Weights(weights), m_Topology(topology), m_Tracer(settings.ProcedureName)
+	{
+	}
+
+	/**
+	 * \brief Performs the evolution.
+	 * \param exportSurface    a callable exportSurface(tId, isResult) writing the evolving surface.
+	 * \param checkpoint       if not null, the evolution continues from the state stored in this checkpoint.
+	 */
+	template <typename ExportFunction>
+	void Run(const ExportFunction& exportSurface, const EvolutionCheckpoint* checkpoint = nullptr);
+
+	/// \brief Per-phase aggregates of the last Run (empty unless tracing is enabled).
+	[[nodiscard]] std::vector<PhaseStatistics> GetPhaseStatistics() const { return m_Tracer.GetPhaseStatistics(); }
+
+	/// \brief Convergence of the last Run (IsConverged is false unless it stopped early by the convergence criterion).
+	[[nodiscard]] const ConvergenceReport& GetConvergenceReport() const { return m_ConvergenceReport; }
+
+private:
+	/// \brief Fills m_SystemMatrix and m_SystemRhs from the current state of mesh.
+	void FillSystem(const pmp::SurfaceMesh& mesh, const double& tStep);
+
+	/// \brief Writes the state after time step ti into the checkpoint file.
+	void SaveCheckpoint(const pmp::SurfaceMesh& mesh, const unsigned int& ti, const double& tStep, const TimeStepController& timeStepController, const ConvergenceMonitor& convergenceMonitor) const;
+
+	EvolutionEngineSettings m_Settings{}; //>! settings.
+
+	InitialSurfacePolicy& m_InitialSurface; //>! initial surface policy.
+	WeightPolicy& m_Weights; //>! weight policy.
+	TopologyPolicy& m_Topology; //>! topology policy.
+
+	CachedSystemMatrix m_SystemMatrix{}; //>! system matrix whose sparsity pattern is rebuilt only when mesh connectivity changes.
+	Eigen::MatrixXd m_SystemRhs{}; //>! (NVertices x 3) right-hand side.
+	pmp::ImplicitLaplaceWeights m_LaplaceWeights{}; //>! whole-mesh Laplacian weights (buffers reused between time steps).
+
+	EvolutionTracer m_Tracer; //>! records phases and counters if tracing is enabled.
+	ConvergenceReport m_ConvergenceReport{}; //>! convergence of the last Run.
+};
+
+template <typename InitialSurfacePolicy, typename WeightPolicy, typename LaplacianPolicy, typename TopologyPolicy>
+void EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy>::FillSystem(const pmp::SurfaceMesh& mesh, const double& tStep)
+{
+	m_SystemMatrix.UpdatePattern(mesh);
+	LaplacianPolicy::ComputeWeights(mesh, m_LaplaceWeights);
+	m_Weights.PrepareStep(mesh);
+
+	// each vertex writes only its own row of m_SystemRhs and its own nonzeros of m_SystemMatrix, so rows are filled concurrently.
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < static_cast<int>(mesh.vertices_size()); i++)
+	{
+		const pmp::Vertex v(i);
+		if (mesh.is_deleted(v))
+			continue;
+
+		const auto row = m_Weights.EvaluateRow(mesh, v, tStep);
+		m_SystemRhs.row(v.idx()) = row.Rhs;
+		if (row.IsFixed)
+		{
+			m_SystemMatrix.SetIdentityRow(mesh, v);
+			continue;
+		}
+
+		const double laplaceWeightSum = static_cast<double>(m_LaplaceWeights.vertexWeightSums[v.idx()]);
+		m_SystemMatrix.SetRow(mesh, v, 1.0 + tStep * row.LaplacianWeight * laplaceWeightSum, -1.0 * tStep * row.LaplacianWeight, m_LaplaceWeights);
+	}
+}
+
+template <typename InitialSurfacePolicy, typename WeightPolicy, typename LaplacianPolicy, typename TopologyPolicy>
+void EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy>::SaveCheckpoint(
+	const pmp::SurfaceMesh& mesh, const unsigned int& ti, const double& tStep, const TimeStepController& timeStepController, const ConvergenceMonitor& convergenceMonitor) const
+{
+	EvolutionCheckpoint checkpoint{ m_Settings.ProcedureName, ti, tStep, mesh };
+	checkpoint.SetValue("ReferenceTimeStep", timeStepController.ReferenceTimeStep());
+	m_InitialSurface.SaveState(checkpoint);
+	m_Topology.SaveState(checkpoint);
+	convergenceMonitor.SaveState(checkpoint);
+	WriteCheckpoint(checkpoint, GetCheckpointFileName(m_Settings.Checkpoint, m_Settings.OutputPath, m_Settings.ProcedureName));
+}
+
+template <typename InitialSurfacePolicy, typename WeightPolicy, typename LaplacianPolicy, typename TopologyPolicy>
+template <typename ExportFunction>
+void EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy>::Run(const ExportFunction& exportSurface, const EvolutionCheckpoint* checkpoint)
+{
+	if (checkpoint && checkpoint->ProcedureName != m_Settings.ProcedureName)
+	{
+		throw std::invalid_argument("EvolutionEngine::Run: checkpoint of procedure " + checkpoint->ProcedureName
+			+ " cannot be used to resume procedure " + m_Settings.ProcedureName + "!\n");
+	}
+
+	m_ConvergenceReport = {};
+
+	// phases of the engine and its policies are recorded while the tracer is active for this thread.
+	m_Tracer.Clear();
+	std::optional<EvolutionTracer::ActivationScope> tracingScope{};
+	if (m_Settings.Tracing.Enabled)
+		tracingScope.emplace(m_Tracer);
+	ScopedPhaseTrace prepareTrace("Prepare");
+
+	// Prepare is needed even when resuming, because it also stabilizes the field.
+	auto& mesh = m_InitialSurface.Prepare();
+	if (checkpoint)
+	{
+		mesh = checkpoint->Surface;
+		m_InitialSurface.LoadState(*checkpoint);
+	}
+
+#if VERIFY_SOLUTION_WITHIN_BOUNDS
+	const auto solutionBounds = m_InitialSurface.SolutionBounds();
+#endif
+	const auto& NSteps = m_Settings.NSteps;
+	const unsigned int startStepId = (checkpoint ? checkpoint->TimeStepId : 0);
+	auto tStep = (checkpoint ? checkpoint->TimeStep : m_Settings.TimeStep);
+	TimeStepController timeStepController(m_Settings.TimeStepControl, m_Settings.TimeStep);
+	if (checkpoint && checkpoint->HasValue("ReferenceTimeStep"))
+		timeStepController.SetReferenceTimeStep(checkpoint->GetValue("ReferenceTimeStep"));
+	ConvergenceMonitor convergenceMonitor(m_Settings.Convergence);
+	SelfIntersectionMonitor selfIntersectionMonitor(m_Settings.SelfIntersections);
+	const unsigned int checkpointStride = std::max(m_Settings.Checkpoint.StepStride, 1u);
+
+	m_Topology.Initialize(mesh);
+	if (checkpoint)
+		m_Topology.LoadState(*checkpoint);
+	m_Weights.Initialize(mesh);
+	prepareTrace.End();
+
+	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
+	auto NVertices = static_cast<unsigned int>(mesh.n_vertices());
+	const auto linearSolver = CreateEvolutionSystemSolver(m_Settings.LinearSolverParams); // keeps preconditioners/factorizations between time steps.
+	m_SystemMatrix.InvalidatePattern();
+	m_SystemRhs = Eigen::MatrixXd(NVertices, 3);
+
+	// write initial surface
+	m_Tracer.SetStepId(startStepId);
+	auto coVolStats = [&mesh]()
+	{
+		const ScopedPhaseTrace trace("CoVolumeStats");
+		return AnalyzeMeshCoVolumes(mesh, LaplacianPolicy::CoVolumeArea);
+	}();
+#if REPORT_EVOL_ENGINE_STEPS
+	std::ofstream fileOStreamMins(m_Settings.OutputPath + m_Settings.ProcedureName + "_CoVolMins.txt");
+	std::ofstream fileOStreamMeans(m_Settings.OutputPath + m_Settings.ProcedureName + "_CoVolMeans.txt");
+	std::ofstream fileOStreamMaxes(m_Settings.OutputPath + m_Settings.ProcedureName + "_CoVolMaxes.txt");
+	std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
+	fileOStreamMins << coVolStats.Min << ", ";
+	fileOStreamMeans << coVolStats.Mean << ", ";
+	fileOStreamMaxes << coVolStats.Max << ", ";
+#endif
+	// set initial surface vertex properties
+	{
+		const ScopedPhaseTrace trace("VertexProperties");
+		m_Weights.UpdateVertexProperties(mesh);
+	}
+	{
+		const ScopedPhaseTrace trace("MeshProperties");
+		m_Topology.UpdateMeshProperties(mesh, startStepId);
+	}
+	convergenceMonitor.Initialize(mesh);
+	if (checkpoint)
+		convergenceMonitor.LoadState(*checkpoint);
+	TraceCounter("NVertices", static_cast<double>(NVertices));
+	if (m_Settings.ExportSurfacePerTimeStep && !checkpoint)
+	{
+		const ScopedPhaseTrace trace("Export");
+		exportSurface(0, false);
+	}
+
+	// -------------------------------------------------------------------------------------------------------------
+	// ........................................ main loop ..........................................................
+	// -------------------------------------------------------------------------------------------------------------
+	for (unsigned int ti = startStepId + 1; ti <= NSteps; ti++)
+	{
+		m_Tracer.SetStepId(ti);
+		TraceCounter("TimeStep", tStep);
+#if REPORT_EVOL_ENGINE_STEPS
+		std::cout << "time step id: " << ti << "/" << NSteps << ", time step: " << tStep
+			<< ", Procedure Name: " << m_Settings.ProcedureName << "\n";
+		std::cout << "pmp::Normals::compute_vertex_normals ... ";
+#endif
+		{
+			const ScopedPhaseTrace trace("Normals");
+			pmp::Normals::compute_vertex_normals(mesh);
+		}
+#if REPORT_EVOL_ENGINE_STEPS
+		std::cout << "done\n";
+		std::cout << "FillSystem for " << NVertices << " vertices ... ";
+#endif
+
+		// prepare matrix & rhs, solve, and retry with a shorter time step if the step is rejected
+		const Eigen::MatrixXd oldPositions = GetVertexPositionMatrix(mesh);
+		Eigen::MatrixXd x;
+		LinearSolverReport solverReport{};
+		double nextTStep = tStep;
+		for (unsigned int nRetries = 0; ; nRetries++)
+		{
+			{
+				const ScopedPhaseTrace trace("Assembly");
+				FillSystem(mesh, tStep);
+			}
+#if REPORT_EVOL_ENGINE_STEPS
+			std::cout << "done\n";
+			std::cout << "Solving linear system ... ";
+#endif
+			{
+				const ScopedPhaseTrace trace("Solve");
+				solverReport = linearSolver->Solve(m_SystemMatrix, m_SystemRhs, oldPositions, x);
+			}
+			TraceCounter("SolverIterations", static_cast<double>(solverReport.NIterations));
+#if REPORT_EVOL_ENGINE_STEPS
+			std::cout << "(" << solverReport.NIterations << " iterations, relative residual: " << solverReport.RelativeResidual
+				<< ", solve time: " << solverReport.SolveTimeSeconds << " s" << (solverReport.IsPreconditionerRecomputed ? ", preconditioner recomputed" : "") << ") ";
+			std::cout << "done\n";
+#endif
+			if (!timeStepController.IsEnabled())
+				break;
+
+			TimeStepEvaluation evaluation{ solverReport.Info == Eigen::Success, solverReport.NIterations, 0.0, coVolStats.Min, 0.0 };
+			if (evaluation.IsSolverConverged)
+			{
+				evaluation.MaxDisplacement = ComputeMaxDisplacement(oldPositions, x);
+				SetVertexPositions(mesh, x);
+				evaluation.CoVolumeMinAfter = AnalyzeMeshCoVolumes(mesh, LaplacianPolicy::CoVolumeArea).Min;
+			}
+			const auto decision = timeStepController.Evaluate(tStep, evaluation, nRetries);
+			if (decision.IsAccepted)
+			{
+#if REPORT_EVOL_ENGINE_STEPS
+				std::cout << "Time step " << tStep << " accepted (max displacement: " << evaluation.MaxDisplacement
+					<< ", min co-volume: " << evaluation.CoVolumeMinBefore << " -> " << evaluation.CoVolumeMinAfter << "), next time step: " << decision.NextTimeStep << ".\n";
+#endif
+				nextTStep = decision.NextTimeStep;
+				break;
+			}
+			if (!evaluation.IsSolverConverged && nRetries >= timeStepController.MaxRetries())
+				break;
+
+#if REPORT_EVOL_ENGINE_STEPS
+			std::cout << "Time step " << tStep << " rejected (" << (evaluation.IsSolverConverged ? "" : "solver failed, ")
+				<< "max displacement: " << evaluation.MaxDisplacement << ", min co-volume: " << evaluation.CoVolumeMinBefore << " -> " << evaluation.CoVolumeMinAfter
+				<< "), retrying with time step: " << decision.NextTimeStep << ".\n";
+			std::cout << "FillSystem for " << NVertices << " vertices ... ";
+#endif
+			if (evaluation.IsSolverConverged)
+				SetVertexPositions(mesh, oldPositions);
+			tStep = decision.NextTimeStep;
+		}
+		if (solverReport.Info != Eigen::Success)
+		{
+			const std::string msg = "\nEvolutionEngine::Run: solverReport.Info != Eigen::Success for time step id: "
+				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solverReport.Info) + "\n";
+			std::cerr << msg;
+			throw std::runtime_error(msg);
+		}
+#if REPORT_EVOL_ENGINE_STEPS
+		std::cout << "Updating vertex positions ... ";
+#endif
+
+		// update vertex positions & verify mesh within bounds
+		ScopedPhaseTrace updateTrace("Update");
+#if VERIFY_SOLUTION_WITHIN_BOUNDS
+		size_t nVertsOutOfBounds = 0;
+#endif
+		for (unsigned int i = 0; i < NVertices; i++)
+		{
+#if VERIFY_SOLUTION_WITHIN_BOUNDS
+			const pmp::Point newPos{ static_cast<pmp::Scalar>(x(i, 0)), static_cast<pmp::Scalar>(x(i, 1)), static_cast<pmp::Scalar>(x(i, 2)) };
+			if (!solutionBounds.Contains(newPos))
+			{
+				if (nVertsOutOfBounds == 0) std::cerr << "\n";
+				std::cerr << "EvolutionEngine::Run: vertex " << i << " out of field bounds!\n";
+				nVertsOutOfBounds++;
+			}
+#endif
+			mesh.position(pmp::Vertex(i)) = x.row(i);
+		}
+		updateTrace.End();
+#if VERIFY_SOLUTION_WITHIN_BOUNDS
+		if ((m_Settings.DoRemeshing && nVertsOutOfBounds > static_cast<double>(NVertices) * m_Settings.MaxFractionOfVerticesOutOfBounds) ||
+			(!m_Settings.DoRemeshing && nVertsOutOfBounds > 0))
+		{
+			std::cerr << "EvolutionEngine::Run: found " << nVertsOutOfBounds << " vertices out of bounds! Terminating!\n";
+			break;
+		}
+#endif
+#if REPORT_EVOL_ENGINE_STEPS
+		std::cout << "done\n";
+#endif
+
+		// --------------------------------------------------------------------
+
+		tStep = nextTStep;
+		const double tStepBeforeTopology = tStep;
+		const bool isConnectivityChanged = m_Topology.Apply(mesh, ti, tStep);
+		if (tStep != tStepBeforeTopology)
+		{
+			// the topology policy rescaled the time step (e.g.: with remeshing lengths), so the bounds are rescaled as well.
+			timeStepController.SetReferenceTimeStep(timeStepController.ReferenceTimeStep() * tStep / tStepBeforeTopology);
+		}
+		if (isConnectivityChanged)
+		{
+			m_SystemMatrix.InvalidatePattern();
+			const ScopedPhaseTrace trace("Reordering");
+			ReorderSurfaceMesh(mesh, m_Settings.MeshReordering);
+		}
+
+		// --------------------------------------------------------------------
+
+		{
+			const ScopedPhaseTrace trace("CoVolumeStats");
+			coVolStats = AnalyzeMeshCoVolumes(mesh, LaplacianPolicy::CoVolumeArea);
+		}
+#if REPORT_EVOL_ENGINE_STEPS
+		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
+		fileOStreamMins << coVolStats.Min << (ti < NSteps ? ", " : "");
+		fileOStreamMeans << coVolStats.Mean << (ti < NSteps ? ", " : "");
+		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
+#endif
+		// set surface vertex properties
+		{
+			const ScopedPhaseTrace trace("VertexProperties");
+			m_Weights.UpdateVertexProperties(mesh);
+		}
+		{
+			const ScopedPhaseTrace trace("MeshProperties");
+			m_Topology.UpdateMeshProperties(mesh, ti);
+		}
+		const bool isConverged = convergenceMonitor.Update(mesh, oldPositions, x, std::sqrt(coVolStats.Mean));
+		TraceCounter("NVertices", static_cast<double>(mesh.n_vertices()));
+		size_t nSelfIntersectingFaces = 0;
+		if (selfIntersectionMonitor.IsDue(ti))
+		{
+			const ScopedPhaseTrace trace("SelfIntersections");
+			nSelfIntersectingFaces = selfIntersectionMonitor.Detect(mesh);
+			TraceCounter("SelfIntersectingFaces", static_cast<double>(nSelfIntersectingFaces));
+#if REPORT_EVOL_ENGINE_STEPS
+			std::cout << "Self-intersecting faces: " << nSelfIntersectingFaces << "\n";
+#endif
+		}
+
+		if (m_Settings.ExportSurfacePerTimeStep)
+		{
+			const ScopedPhaseTrace trace("Export");
+			exportSurface(ti, false);
+		}
+
+		if (isConverged)
+		{
+			m_ConvergenceReport = { true, ti, convergenceMonitor.LastValue() };
+			std::cout << "EvolutionEngine::Run: " << m_Settings.ProcedureName << " converged at time step " << ti << "/" << NSteps
+				<< " (" << ConvergenceMeasureToString(m_Settings.Convergence.Measure) << ": " << convergenceMonitor.LastValue() << ").\n";
+			break;
+		}
+
+		if (nSelfIntersectingFaces > 0 && m_Settings.SelfIntersections.TerminateOnDetection)
+		{
+			std::cerr << "EvolutionEngine::Run: " << m_Settings.ProcedureName << " has " << nSelfIntersectingFaces
+				<< " self-intersecting faces at time step " << ti << "/" << NSteps << ". Terminating!\n";
+			break;
+		}
+
+		if (m_Settings.Checkpoint.Enabled && ti % checkpointStride == 0 && ti < NSteps)
+		{
+			const ScopedPhaseTrace trace("Checkpoint");
+			SaveCheckpoint(mesh, ti, tStep, timeStepController, convergenceMonitor);
+		}
+
+		// update linear system dims for next time step:
+		if (ti < NSteps && NVertices != mesh.n_vertices())
+		{
+			NVertices = static_cast<unsigned int>(mesh.n_vertices());
+			m_SystemRhs = Eigen::MatrixXd(NVertices, 3);
+		}
+
+#if REPORT_EVOL_ENGINE_STEPS
+		std::cout << ">>> Time step " << ti << " finished.\n";
+		std::cout << "----------------------------------------------------------------------\n";
+#endif
+	} // end main loop
+	// -------------------------------------------------------------------------------------------------------------
+
+	if (m_Settings.ExportResultSurface)
+	{
+		const ScopedPhaseTrace trace("Export");
+		exportSurface(NSteps, true);
+	}
+
+	if (m_Settings.Tracing.Enabled)
+		m_Tracer.WriteChromeTrace(GetTraceFileName(m_Settings.Tracing, m_Settings.OutputPath, m_Settings.ProcedureName));
+}
@@ -0,0 +1,295 @@
+#include "EvolutionJobScheduler.h"
+
+#include "pmp/BoundingBox.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/// \brief estimated bytes per evolving surface vertex: mesh connectivity & properties, evolution system row, solver buffers.
+constexpr size_t SURFACE_VERTEX_MEMORY_ESTIMATE = 2048;
+
+/// \brief the factor by which remeshing may increase the vertex count of the starting ico-sphere.
+constexpr size_t REMESHING_VERTEX_COUNT_FACTOR = 4;
+
+EvolutionJobScheduler::EvolutionJobScheduler(const EvolutionSchedulerSettings& settings)
+	: m_Settings(settings)
+{
+	unsigned int nWorkers = m_Settings.NWorkerThreads;
+	if (nWorkers == 0)
+		nWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+
+	m_Queues.reserve(nWorkers);
+	for (unsigned int i = 0; i < nWorkers; i++)
+		m_Queues.emplace_back(std::make_unique<WorkerQueue>());
+
+	m_Workers.reserve(nWorkers);
+	for (unsigned int i = 0; i < nWorkers; i++)
+		m_Workers.emplace_back(&EvolutionJobScheduler::WorkerLoop, this, i);
+}
+
+EvolutionJobScheduler::~EvolutionJobScheduler()
+{
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_StateChanged.notify_all();
+	for (auto& worker : m_Workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+}
+
+size_t EvolutionJobScheduler::Submit(const std::string& name, const size_t& memoryEstimateBytes, JobFunction job)
+{
+	if (!job)
+		throw std::invalid_argument("EvolutionJobScheduler::Submit: empty job function!\n");
+
+	size_t jobId = 0;
+	{
+		std::lock_guard lock(m_Mutex);
+		jobId = m_Results.size();
+		m_Results.emplace_back();
+
+		auto& queue = *m_Queues[m_NextQueueId];
+		m_NextQueueId = (m_NextQueueId + 1) % m_Queues.size();
+		{
+			std::lock_guard queueLock(queue.Mutex);
+			queue.Jobs.push_back(std::make_shared<Job>(Job{ jobId, name, memoryEstimateBytes, std::move(job), std::chrono::steady_clock::now() }));
+		}
+		m_NQueuedJobs++;
+	}
+	m_StateChanged.notify_all();
+	return jobId;
+}
+
+size_t EvolutionJobScheduler::SubmitSurfaceEvolution(const std::shared_ptr<const Geometry::ScalarGrid>& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
+{
+	if (!field)
+		throw std::invalid_argument("EvolutionJobScheduler::SubmitSurfaceEvolution: field == nullptr!\n");
+
+	return Submit(settings.ProcedureName, EstimateSurfaceEvolutionMemory(*field, settings),
+		[field, fieldExpansionFactor, settings]()
+		{
+			SurfaceEvolver evolver(*field, fieldExpansionFactor, settings);
+			evolver.Evolve();
+			return EvolutionJobOutput{ evolver.GetResultSurface(), evolver.GetConvergenceReport() };
+		});
+}
+
+size_t EvolutionJobScheduler::SubmitSurfaceEvolution(const std::shared_ptr<const StabilizedEvolutionField>& field, const SurfaceEvolutionSettings& settings)
+{
+	if (!field)
+		throw std::invalid_argument("EvolutionJobScheduler::SubmitSurfaceEvolution: field == nullptr!\n");
+
+	// validated before submission, so that an incompatible variant is reported to the caller right away.
+	if (!IsStabilizationCompatible(*field, settings))
+		throw std::invalid_argument("EvolutionJobScheduler::SubmitSurfaceEvolution: settings of " + settings.ProcedureName + " are not compatible with the stabilization of the shared field!\n");
+
+	return Submit(settings.ProcedureName, EstimateSurfaceEvolutionMemory(settings),
+		[field, settings]()
+		{
+			SurfaceEvolver evolver(field, settings);
+			evolver.Evolve();
+			return EvolutionJobOutput{ evolver.GetResultSurface(), evolver.GetConvergenceReport() };
+		});
+}
+
+size_t EvolutionJobScheduler::SubmitIcoSphereEvolution(const std::shared_ptr<const std::vector<pmp::Point>>& pointCloud, const IcoSphereEvolutionSettings& settings)
+{
+	if (!pointCloud)
+		throw std::invalid_argument("EvolutionJobScheduler::SubmitIcoSphereEvolution: pointCloud == nullptr!\n");
+
+	return Submit(settings.ProcedureName, EstimateIcoSphereEvolutionMemory(*pointCloud, settings),
+		[pointCloud, settings]()
+		{
+			IcoSphereEvolver evolver(*pointCloud, settings);
+			evolver.Evolve();
+			return EvolutionJobOutput{ evolver.GetResultSurface(), evolver.GetConvergenceReport() };
+		});
+}
+
+std::vector<EvolutionJobResult> EvolutionJobScheduler::WaitAll()
+{
+	std::unique_lock lock(m_Mutex);
+	m_StateChanged.wait(lock, [this] { return m_NQueuedJobs == 0 && m_NRunningJobs == 0; });
+	return std::exchange(m_Results, {});
+}
+
+std::shared_ptr<EvolutionJobScheduler::Job> EvolutionJobScheduler::TakeJob(const unsigned int& workerId)
+{
+	std::shared_ptr<Job> job{ nullptr };
+	const auto nQueues = static_cast<unsigned int>(m_Queues.size());
+	for (unsigned int i = 0; i < nQueues && !job; i++)
+	{
+		auto& queue = *m_Queues[(workerId + i) % nQueues];
+		std::lock_guard queueLock(queue.Mutex);
+		if (queue.Jobs.empty())
+			continue;
+
+		if (i == 0)
+		{
+			// own deque: oldest job first
+			job = std::move(queue.Jobs.front());
+			queue.Jobs.pop_front();
+		}
+		else
+		{
+			// steal from the other end
+			job = std::move(queue.Jobs.back());
+			queue.Jobs.pop_back();
+		}
+	}
+	if (!job)
+		return nullptr;
+
+	std::lock_guard lock(m_Mutex);
+	m_NQueuedJobs--;
+	m_NRunningJobs++;
+	return job;
+}
+
+void EvolutionJobScheduler::WorkerLoop(const unsigned int& workerId)
+{
+#ifdef _OPENMP
+	// OpenMP thread count is a per-thread setting, so concurrent jobs do not oversubscribe the cores.
+	omp_set_num_threads(static_cast<int>(std::max(m_Settings.NThreadsPerJob, 1u)));
+#endif
+
+	while (true)
+	{
+		{
+			std::unique_lock lock(m_Mutex);
+			m_StateChanged.wait(lock, [this] { return m_NQueuedJobs > 0 || m_Stopping; });
+			if (m_NQueuedJobs == 0 && m_Stopping)
+				return;
+		}
+
+		const auto job = TakeJob(workerId);
+		if (!job)
+			continue; // taken by another worker in the meantime.
+
+		RunJob(*job, workerId);
+	}
+}
+
+void EvolutionJobScheduler::RunJob(Job& job, const unsigned int& workerId)
+{
+	{
+		// reserve memory (a job exceeding the budget is allowed to run alone)
+		std::unique_lock lock(m_Mutex);
+		m_StateChanged.wait(lock, [this, &job]
+		{
+			return m_Settings.MemoryBudgetBytes == 0 || m_NActiveJobs == 0 ||
+				m_ReservedMemoryBytes + job.MemoryEstimateBytes <= m_Settings.MemoryBudgetBytes;
+		});
+		m_NActiveJobs++;
+		m_ReservedMemoryBytes += job.MemoryEstimateBytes;
+	}
+
+	const auto startTime = std::chrono::steady_clock::now();
+	EvolutionJobResult result;
+	result.Name = job.Name;
+	result.MemoryEstimateBytes = job.MemoryEstimateBytes;
+	result.WorkerId = workerId;
+	result.QueueTimeSeconds = std::chrono::duration<double>(startTime - job.SubmitTime).count();
+	try
+	{
+		auto output = job.Function();
+		result.ResultSurface = std::move(output.ResultSurface);
+		result.Convergence = output.Convergence;
+		result.Succeeded = true;
+	}
+	catch (const std::exception& e)
+	{
+		result.ErrorMessage = e.what();
+	}
+	catch (...)
+	{
+		result.ErrorMessage = "unknown exception";
+	}
+	job.Function = nullptr; // releases the shared inputs captured by the job.
+	result.RunTimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	{
+		std::lock_guard lock(m_Mutex);
+		m_NActiveJobs--;
+		m_ReservedMemoryBytes -= job.MemoryEstimateBytes;
+		m_NRunningJobs--;
+		m_Results[job.Id] = std::move(result);
+	}
+	m_StateChanged.notify_all();
+}
+
+// ================================================================================================
+
+/// \brief Estimates the memory of the evolving surface generated from an ico-sphere of a given subdivision level.
+[[nodiscard]] static size_t EstimateIcoSphereSurfaceMemory(const unsigned int& subdivisionLevel)
+{
+	const size_t nVertices = 10 * (static_cast<size_t>(1) << (2 * subdivisionLevel)) + 2;
+	return REMESHING_VERTEX_COUNT_FACTOR * nVertices * SURFACE_VERTEX_MEMORY_ESTIMATE;
+}
+
+size_t EstimateSurfaceEvolutionMemory(const Geometry::ScalarGrid& field, const SurfaceEvolutionSettings& settings)
+{
+	// working copy of the field and its normalized negative gradient (3 components).
+	const size_t nCells = field.Values().size();
+	const size_t fieldBytes = nCells * (sizeof(double) + 3 * sizeof(double));
+	return fieldBytes + EstimateIcoSphereSurfaceMemory(settings.IcoSphereSubdivisionLevel);
+}
+
+size_t EstimateSurfaceEvolutionMemory(const SurfaceEvolutionSettings& settings)
+{
+	return EstimateIcoSphereSurfaceMemory(settings.IcoSphereSubdivisionLevel);
+}
+
+size_t EstimateIcoSphereEvolutionMemory(const std::vector<pmp::Point>& pointCloud, const IcoSphereEvolutionSettings& settings)
+{
+	// the distance field spans the point cloud bounds expanded by their min dimension on each side.
+	const pmp::BoundingBox ptCloudBBox(pointCloud);
+	const auto ptCloudBBoxSize = ptCloudBBox.max() - ptCloudBBox.min();
+	const float minSize = std::min({ ptCloudBBoxSize[0], ptCloudBBoxSize[1], ptCloudBBoxSize[2] });
+	const auto nVoxelsPerMinDim = static_cast<double>(std::max(settings.NVoxelsPerMinDimension, 1u));
+	double nCells = 1.0;
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		const double relativeSize = (minSize > 0.0f ? static_cast<double>(ptCloudBBoxSize[i] / minSize) : 1.0);
+		nCells *= std::ceil(nVoxelsPerMinDim * (relativeSize + 2.0));
+	}
+	const size_t fieldBytes = static_cast<size_t>(nCells) * (sizeof(double) + 3 * sizeof(double));
+	const size_t pointCloudBytes = pointCloud.size() * sizeof(pmp::Point);
+	return fieldBytes + pointCloudBytes + EstimateIcoSphereSurfaceMemory(settings.IcoSphereSubdivisionLevel);
+}
+
+void ReportJobResults(const std::vector<EvolutionJobResult>& results, std::ostream& os)
+{
+	os << "======================================================================\n";
+	os << "> > > > > > > > > > > Evolution Job Results: < < < < < < < < < < < < <\n";
+	size_t nSucceeded = 0;
+	size_t nConverged = 0;
+	double totalRunTime = 0.0;
+	for (const auto& result : results)
+	{
+		os << result.Name << ": " << (result.Succeeded ? "done" : "FAILED (" + result.ErrorMessage + ")");
+		if (result.Convergence.IsConverged)
+			os << ", converged at time step " << result.Convergence.TimeStepId << " (measure: " << result.Convergence.MeasureValue << ")";
+		os << ", run time: " << result.RunTimeSeconds << " s, queue time: " << result.QueueTimeSeconds << " s"
+			<< ", memory estimate: " << std::fixed << std::setprecision(1) << static_cast<double>(result.MemoryEstimateBytes) / (1024.0 * 1024.0) << " MB"
+			<< std::defaultfloat << std::setprecision(6) << ", worker: " << result.WorkerId << ",\n";
+		nSucceeded += (result.Succeeded ? 1 : 0);
+		nConverged += (result.Convergence.IsConverged ? 1 : 0);
+		totalRunTime += result.RunTimeSeconds;
+	}
+	os << "......................................................................\n";
+	os << nSucceeded << "/" << results.size() << " jobs succeeded (" << nConverged << " converged early), total run time: " << totalRunTime << " s.\n";
+	os << "----------------------------------------------------------------------\n";
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+
+#include "geometry/Grid.h"
+
+#include "SurfaceEvolver.h"
+#include "IcoSphereEvolver.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief A wrapper for settings of the evolution job scheduler.
+ * \struct EvolutionSchedulerSettings
+ */
+struct EvolutionSchedulerSettings
+{
+	unsigned int NWorkerThreads{ 0 }; //>! the number of concurrently running jobs (0 = hardware concurrency).
+	unsigned int NThreadsPerJob{ 1 }; //>! the number of OpenMP threads used within each job (for the parallel assembly of its evolution system).
+	size_t MemoryBudgetBytes{ 0 }; //>! upper bound of the summed memory estimates of concurrently running jobs (0 = unlimited).
+};
+
+/**
+ * \brief The outcome of a single evolution job.
+ * \struct EvolutionJobResult
+ */
+struct EvolutionJobResult
+{
+	std::string Name{}; //>! name of the job.
+	bool Succeeded{ false }; //>! false if the job has thrown an exception.
+	std::string ErrorMessage{}; //>! what() of the exception thrown by the job (if any).
+	std::optional<pmp::SurfaceMesh> ResultSurface{}; //>! resulting surface (transformed to original coordinates).
+	ConvergenceReport Convergence{}; //>! convergence of the evolution (IsConverged is false if it ran all of its steps).
+	double QueueTimeSeconds{ 0.0 }; //>! time from submission to the start of the job.
+	double RunTimeSeconds{ 0.0 }; //>! run time of the job.
+	size_t MemoryEstimateBytes{ 0 }; //>! memory estimate the job was scheduled with.
+	unsigned int WorkerId{ 0 }; //>! index of the worker thread which ran the job.
+};
+
+/**
+ * \brief The output of a single evolution job.
+ * \struct EvolutionJobOutput
+ */
+struct EvolutionJobOutput
+{
+	pmp::SurfaceMesh ResultSurface{}; //>! resulting surface (transformed to original coordinates).
+	ConvergenceReport Convergence{}; //>! convergence of the evolution.
+};
+
+/**
+ * \brief A thread pool running evolution jobs concurrently.
+ * \class EvolutionJobScheduler
+ *
+ * Each worker owns a deque of jobs. Submitted jobs are distributed among the workers round-robin, a worker takes
+ * jobs from the front of its own deque and steals from the back of the other deques once its own is empty.
+ * Before a job starts, its memory estimate is reserved from MemoryBudgetBytes, and the worker waits until enough of
+ * the budget is released by running jobs (a job is always allowed to run if no other job is running, so that a job
+ * larger than the budget runs alone). Inputs are held by shared_ptr<const>, so that jobs evolving towards the same
+ * target share a single read-only copy of its field (or point cloud), and each job makes its working copy only once it starts.
+ */
+class EvolutionJobScheduler
+{
+public:
+	/// \brief A job returns its result surface with its convergence (or throws).
+	using JobFunction = std::function<EvolutionJobOutput()>;
+
+	/**
+	 * \brief Constructor. Launches the worker threads.
+	 * \param settings    scheduler settings.
+	 */
+	explicit EvolutionJobScheduler(const EvolutionSchedulerSettings& settings);
+
+	/// \brief Destructor. Waits for all submitted jobs to finish and joins the worker threads.
+	~EvolutionJobScheduler();
+
+	EvolutionJobScheduler(const EvolutionJobScheduler&) = delete;
+	EvolutionJobScheduler& operator=(const EvolutionJobScheduler&) = delete;
+
+	/**
+	 * \brief Submits a generic job.
+	 * \param name                   name of the job.
+	 * \param memoryEstimateBytes    estimated peak memory of the job.
+	 * \param job                    job function.
+	 * \return index of the job's result in the vector returned by WaitAll.
+	 */
+	size_t Submit(const std::string& name, const size_t& memoryEstimateBytes, JobFunction job);
+
+	/**
+	 * \brief Submits a SurfaceEvolver job.
+	 * \param field                  shared read-only distance field of the target (copied by the evolver once the job starts).
+	 * \param fieldExpansionFactor   the factor by which target bounds are expanded.
+	 * \param settings               surface evolution settings.
+	 * \return index of the job's result in the vector returned by WaitAll.
+	 */
+	size_t SubmitSurfaceEvolution(const std::shared_ptr<const Geometry::ScalarGrid>& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings);
+
+	/**
+	 * \brief Submits a SurfaceEvolver job evolving within a shared stabilized field (the job only pays for its own surface).
+	 * \param field       shared stabilized field (see PrepareStabilizedEvolutionField).
+	 * \param settings    surface evolution settings (compatible with the stabilization of the field).
+	 * \return index of the job's result in the vector returned by WaitAll.
+	 */
+	size_t SubmitSurfaceEvolution(const std::shared_ptr<const StabilizedEvolutionField>& field, const SurfaceEvolutionSettings& settings);
+
+	/**
+	 * \brief Submits an IcoSphereEvolver job.
+	 * \param pointCloud    shared read-only target point cloud.
+	 * \param settings      ico-sphere evolution settings.
+	 * \return index of the job's result in the vector returned by WaitAll.
+	 */
+	size_t SubmitIcoSphereEvolution(const std::shared_ptr<const std::vector<pmp::Point>>& pointCloud, const IcoSphereEvolutionSettings& settings);
+
+	/**
+	 * \brief Waits until all submitted jobs are finished.
+	 * \return results of all jobs submitted since the last call of WaitAll (in the order of submission).
+	 */
+	[[nodiscard]] std::vector<EvolutionJobResult> WaitAll();
+
+	/// \brief the number of worker threads.
+	[[nodiscard]] size_t NWorkers() const { return m_Workers.size(); }
+
+private:
+	/// \brief a submitted job.
+	struct Job
+	{
+		size_t Id{ 0 };
+		std::string Name{};
+		size_t MemoryEstimateBytes{ 0 };
+		JobFunction Function{};
+		std::chrono::steady_clock::time_point SubmitTime{};
+	};
+
+	/// \brief a job deque owned by a single worker.
+	struct WorkerQueue
+	{
+		std::mutex Mutex{};
+		std::deque<std::shared_ptr<Job>> Jobs{};
+	};
+
+	/// \brief main function of each worker thread.
+	void WorkerLoop(const unsigned int& workerId);
+
+	/// \brief Takes a job from the front of the worker's own deque, or steals one from the back of another deque.
+	[[nodiscard]] std::shared_ptr<Job> TakeJob(const unsigned int& workerId);
+
+	/// \brief Runs a job and stores its result.
+	void RunJob(Job& job, const unsigned int& workerId);
+
+	EvolutionSchedulerSettings m_Settings{}; //>! settings.
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_Queues{}; //>! per-worker job deques.
+	size_t m_NextQueueId{ 0 }; //>! the deque which receives the next submitted job.
+
+	std::mutex m_Mutex{}; //>! guards the counters, the memory budget and the results.
+	std::condition_variable m_StateChanged{}; //>! signals submitted jobs, released memory, finished jobs and stopping.
+	size_t m_NQueuedJobs{ 0 }; //>! the number of jobs waiting in the deques.
+	size_t m_NRunningJobs{ 0 }; //>! the number of jobs being run (including those waiting for memory).
+	size_t m_NActiveJobs{ 0 }; //>! the number of jobs holding a memory reservation.
+	size_t m_ReservedMemoryBytes{ 0 }; //>! the sum of memory estimates of active jobs.
+	bool m_Stopping{ false }; //>! if true, workers exit once the deques are drained.
+	std::vector<EvolutionJobResult> m_Results{}; //>! results of submitted jobs (indexed by job id).
+
+	std::vector<std::thread> m_Workers{}; //>! worker threads.
+};
+
+/**
+ * \brief Estimates the peak memory of a SurfaceEvolver job: the working copy of the field with its gradient,
+ *        and the evolving surface with its evolution system.
+ * \param field       target distance field.
+ * \param settings    surface evolution settings.
+ * \return estimated memory in bytes.
+ */
+[[nodiscard]] size_t EstimateSurfaceEvolutionMemory(const Geometry::ScalarGrid& field, const SurfaceEvolutionSettings& settings);
+
+/**
+ * \brief Estimates the peak memory of a SurfaceEvolver job within a shared stabilized field: the evolving surface with its evolution system.
+ * \param settings    surface evolution settings.
+ * \return estimated memory in bytes.
+ */
+[[nodiscard]] size_t EstimateSurfaceEvolutionMemory(const SurfaceEvolutionSettings& settings);
+
+/**
+ * \brief Estimates the peak memory of an IcoSphereEvolver job: the distance field of the point cloud with its gradient,
+ *        and the evolving surface with its evolution system.
+ * \param pointCloud    target point cloud.
+ * \param settings      ico-sphere evolution settings.
+ * \return estimated memory in bytes.
+ */
+[[nodiscard]] size_t EstimateIcoSphereEvolutionMemory(const std::vector<pmp::Point>& pointCloud, const IcoSphereEvolutionSettings& settings);
+
+/**
+ * \brief Reports results of evolution jobs to a given stream.
+ * \param results    job results.
+ * \param os         output stream.
+ */
+void ReportJobResults(const std::vector<EvolutionJobResult>& results, std::ostream& os);
@@ -0,0 +1,629 @@
+#include "EvolutionSystemSolver.h"
+
+#include "pmp/SurfaceMesh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <queue>
+
+/**
+ * \brief A wrapper of an Eigen preconditioner whose (re)computation can be skipped, so that one preconditioner
+ *        can be shared by consecutive solves with matrices of the same sparsity pattern.
+ */
+template <typename Preconditioner>
+class ReusablePreconditioner
+{
+public:
+	ReusablePreconditioner() = default;
+
+	template <typename MatrixType>
+	ReusablePreconditioner& analyzePattern(const MatrixType& mat)
+	{
+		if (m_ShouldRecompute)
+			m_Preconditioner.analyzePattern(mat);
+		return *this;
+	}
+
+	template <typename MatrixType>
+	ReusablePreconditioner& factorize(const MatrixType& mat)
+	{
+		if (m_ShouldRecompute)
+			m_Preconditioner.factorize(mat);
+		return *this;
+	}
+
+	template <typename MatrixType>
+	ReusablePreconditioner& compute(const MatrixType& mat)
+	{
+		if (m_ShouldRecompute)
+			m_Preconditioner.compute(mat);
+		return *this;
+	}
+
+	template <typename Rhs>
+	auto solve(const Rhs& b) const { return m_Preconditioner.solve(b); }
+
+	[[nodiscard]] Eigen::ComputationInfo info() const { return m_Preconditioner.info(); }
+
+	/// \brief if false, subsequent calls to compute keep the current preconditioner.
+	void SetShouldRecompute(const bool& shouldRecompute) { m_ShouldRecompute = shouldRecompute; }
+
+	/// \brief the wrapped preconditioner.
+	[[nodiscard]] Preconditioner& Wrapped() { return m_Preconditioner; }
+
+private:
+	Preconditioner m_Preconditioner{};
+	bool m_ShouldRecompute{ true };
+};
+
+/// \brief Evaluates max ||A x - b|| / ||b|| over all columns.
+[[nodiscard]] static double ComputeMaxRelativeResidual(const SparseMatrix& mat, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& x)
+{
+	const Eigen::MatrixXd residual = mat * x - rhs;
+	double maxRelResidual = 0.0;
+	for (Eigen::Index j = 0; j < rhs.cols(); j++)
+	{
+		const double rhsNorm = rhs.col(j).norm();
+		const double relResidual = residual.col(j).norm() / (rhsNorm > 0.0 ? rhsNorm : 1.0);
+		maxRelResidual = std::max(maxRelResidual, relResidual);
+	}
+	return maxRelResidual;
+}
+
+/**
+ * \brief Transforms the evolution system into an equivalent symmetric system.
+ *
+ * Rows with zero off-diagonal entries (frozen boundary/feature vertices, or vertices with zero diffusion weight)
+ * are treated as Dirichlet conditions: their known values are moved to the rhs of the remaining rows.
+ * The remaining rows have the form (1 + k_v sum_w c_vw) x_v - k_v sum_w c_vw x_w with symmetric cotan weights c_vw,
+ * so the row scaling s_v ~ 1 / k_v, propagated over the one-ring connectivity as s_w = s_v a_vw / a_wv,
+ * makes the system matrix symmetric.
+ */
+class SymmetrizedSystem
+{
+public:
+	/// \brief Recomputes the symmetric system. Returns false if the system cannot be symmetrized by row scaling.
+	[[nodiscard]] bool Update(const CachedSystemMatrix& sysMat, const Eigen::MatrixXd& rhs)
+	{
+		const auto& mat = sysMat.Matrix();
+		if (m_PatternVersion != sysMat.PatternVersion())
+		{
+			m_Matrix = mat;
+			UpdateTransposeIds();
+			m_PatternVersion = sysMat.PatternVersion();
+		}
+		else
+		{
+			std::copy_n(mat.valuePtr(), mat.nonZeros(), m_Matrix.valuePtr());
+		}
+		m_Rhs = rhs;
+
+		const auto nVertices = m_Matrix.outerSize();
+		const auto* outerIds = m_Matrix.outerIndexPtr();
+		const auto* innerIds = m_Matrix.innerIndexPtr();
+		auto* values = m_Matrix.valuePtr();
+
+		// column v of the symmetric pattern holds the entries a_rv, and their transposed positions hold a_vr.
+		m_IsDirichlet.assign(nVertices, true);
+		for (Eigen::Index v = 0; v < nVertices; v++)
+		{
+			for (auto k = outerIds[v]; k < outerIds[v + 1]; k++)
+			{
+				if (innerIds[k] != v && values[m_TransposeIds[k]] != 0.0)
+				{
+					m_IsDirichlet[v] = false;
+					break;
+				}
+			}
+		}
+
+		// eliminate Dirichlet columns
+		for (Eigen::Index v = 0; v < nVertices; v++)
+		{
+			if (!m_IsDirichlet[v])
+				continue;
+
+			const Eigen::RowVector3d xDirichlet = m_Rhs.row(v) / values[m_DiagonalIds[v]];
+			for (auto k = outerIds[v]; k < outerIds[v + 1]; k++)
+			{
+				if (innerIds[k] == v)
+					continue;
+				m_Rhs.row(innerIds[k]) -= values[k] * xDirichlet;
+				values[k] = 0.0;
+			}
+		}
+
+		// propagate row scales over connected components
+		m_RowScales.assign(nVertices, 0.0);
+		std::queue<Eigen::Index> vertexQueue{};
+		for (Eigen::Index seed = 0; seed < nVertices; seed++)
+		{
+			if (m_RowScales[seed] != 0.0)
+				continue;
+
+			m_RowScales[seed] = 1.0 / std::abs(values[m_DiagonalIds[seed]]);
+			if (m_IsDirichlet[seed])
+				continue;
+
+			vertexQueue.push(seed);
+			while (!vertexQueue.empty())
+			{
+				const auto v = vertexQueue.front();
+				vertexQueue.pop();
+				for (auto k = outerIds[v]; k < outerIds[v + 1]; k++)
+				{
+					const auto w = innerIds[k];
+					if (w == v || m_IsDirichlet[w] || m_RowScales[w] != 0.0)
+						continue;
+
+					const double a_wv = values[k];
+					const double a_vw = values[m_TransposeIds[k]];
+					if (a_wv == 0.0 || a_vw == 0.0)
+						continue;
+
+					m_RowScales[w] = m_RowScales[v] * a_vw / a_wv;
+					if (m_RowScales[w] <= 0.0)
+						return false;
+					vertexQueue.push(w);
+				}
+			}
+		}
+
+		for (Eigen::Index v = 0; v < nVertices; v++)
+		{
+			for (auto k = outerIds[v]; k < outerIds[v + 1]; k++)
+				values[k] *= m_RowScales[innerIds[k]];
+			m_Rhs.row(v) *= m_RowScales[v];
+		}
+
+		// verify symmetry up to the single precision of Laplacian weights, and remove the remaining round-off asymmetry.
+		constexpr double relTolerance = 1e-4;
+		for (Eigen::Index k = 0; k < m_Matrix.nonZeros(); k++)
+		{
+			const double a = values[k];
+			const double aT = values[m_TransposeIds[k]];
+			if (std::abs(a - aT) > relTolerance * std::max(std::abs(a), std::abs(aT)))
+				return false;
+			values[k] = values[m_TransposeIds[k]] = 0.5 * (a + aT);
+		}
+		return true;
+	}
+
+	/// \brief the symmetrized matrix.
+	[[nodiscard]] const SparseMatrix& Matrix() const { return m_Matrix; }
+
+	/// \brief the rhs of the symmetrized system.
+	[[nodiscard]] const Eigen::MatrixXd& Rhs() const { return m_Rhs; }
+
+	/// \brief the pattern version of the last system matrix.
+	[[nodiscard]] size_t PatternVersion() const { return m_PatternVersion; }
+
+private:
+	/// \brief Computes the positions of transposed entries and diagonal entries within the value array.
+	void UpdateTransposeIds()
+	{
+		const auto nVertices = m_Matrix.outerSize();
+		const auto* outerIds = m_Matrix.outerIndexPtr();
+		const auto* innerIds = m_Matrix.innerIndexPtr();
+		const auto findNonzeroId = [&](const Eigen::Index& row, const Eigen::Index& col)
+		{
+			const auto* colBegin = innerIds + outerIds[col];
+			const auto* colEnd = innerIds + outerIds[col + 1];
+			return static_cast<Eigen::Index>(std::lower_bound(colBegin, colEnd, row) - innerIds);
+		};
+
+		m_TransposeIds.assign(m_Matrix.nonZeros(), 0);
+		m_DiagonalIds.assign(nVertices, 0);
+		for (Eigen::Index col = 0; col < nVertices; col++)
+		{
+			for (auto k = outerIds[col]; k < outerIds[col + 1]; k++)
+				m_TransposeIds[k] = findNonzeroId(col, innerIds[k]);
+			m_DiagonalIds[col] = findNonzeroId(col, col);
+		}
+	}
+
+	SparseMatrix m_Matrix{}; //>! symmetrized matrix (same pattern as the system matrix).
+	Eigen::MatrixXd m_Rhs{}; //>! symmetrized rhs.
+	std::vector<Eigen::Index> m_TransposeIds{}; //>! position of entry (c, r) for each nonzero (r, c).
+	std::vector<Eigen::Index> m_DiagonalIds{}; //>! position of the diagonal entry of each column.
+	std::vector<bool> m_IsDirichlet{}; //>! whether the row of each vertex has zero off-diagonal entries.
+	std::vector<double> m_RowScales{}; //>! symmetrizing row scales.
+	size_t m_PatternVersion{ std::numeric_limits<size_t>::max() }; //>! pattern version of the last system matrix.
+};
+
+// ================================================================================================
+
+/// \brief Elapsed wall time in seconds.
+[[nodiscard]] static double SecondsSince(const std::chrono::high_resolution_clock::time_point& startTime)
+{
+	return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+/**
+ * \brief Solves mat * x = rhs column by column with an Eigen iterative solver using a ReusablePreconditioner.
+ * \param solver                     Eigen iterative solver.
+ * \param mat                        system matrix.
+ * \param recomputePreconditioner    if false, the preconditioner from the previous solve is kept.
+ * \param maxIterations              iteration limit for each column (a negative value means the Eigen default).
+ * \param rhs                        right-hand side.
+ * \param guess                      initial guess (used if useWarmStart == true).
+ * \param useWarmStart               if true, iterations start from guess instead of zero.
+ * \param x                          solution.
+ * \return solve report without residual and timing.
+ */
+template <typename IterativeSolver>
+[[nodiscard]] static LinearSolverReport SolveColumnsIteratively(IterativeSolver& solver, const SparseMatrix& mat, const bool& recomputePreconditioner, const int& maxIterations,
+	const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, const bool& useWarmStart, Eigen::MatrixXd& x)
+{
+	LinearSolverReport report{};
+	solver.setMaxIterations(maxIterations);
+	report.IsPreconditionerRecomputed = recomputePreconditioner;
+	solver.preconditioner().SetShouldRecompute(recomputePreconditioner);
+	solver.compute(mat);
+	if (solver.info() != Eigen::Success || solver.preconditioner().info() != Eigen::Success)
+	{
+		report.Info = (solver.info() != Eigen::Success ? solver.info() : solver.preconditioner().info());
+		return report;
+	}
+
+	x.resize(rhs.rows(), rhs.cols());
+	for (Eigen::Index j = 0; j < rhs.cols(); j++)
+	{
+		if (useWarmStart)
+			x.col(j) = solver.solveWithGuess(rhs.col(j), guess.col(j));
+		else
+			x.col(j) = solver.solve(rhs.col(j));
+
+		report.NIterations = std::max(report.NIterations, static_cast<unsigned int>(solver.iterations()));
+		if (solver.info() != Eigen::Success)
+			report.Info = solver.info();
+	}
+	return report;
+}
+
+/// \brief A solve with a reused preconditioner may take at most this multiple of the iterations needed right after its computation.
+constexpr unsigned int STALE_PRECONDITIONER_ITERATION_FACTOR = 4;
+/// \brief Minimum iteration limit for a solve with a reused preconditioner.
+constexpr unsigned int MIN_STALE_PRECONDITIONER_ITERATIONS = 20;
+
+/**
+ * \brief Evaluates the iteration limit of a solve, so that a reused preconditioner which became too stale
+ *        fails early and gets recomputed instead of running up to the full iteration limit.
+ */
+[[nodiscard]] static int GetIterationLimit(const bool& recomputePreconditioner, const unsigned int& nFreshPreconditionerIterations, const int& maxIterations)
+{
+	if (recomputePreconditioner)
+		return maxIterations;
+
+	const auto staleLimit = static_cast<int>(std::max(STALE_PRECONDITIONER_ITERATION_FACTOR * nFreshPreconditionerIterations, MIN_STALE_PRECONDITIONER_ITERATIONS));
+	return (maxIterations > 0 ? std::min(staleLimit, maxIterations) : staleLimit);
+}
+
+/// \brief Passes settings to a preconditioner (no settings by default).
+template <typename Preconditioner>
+static void ConfigurePreconditioner(Preconditioner& /*preconditioner*/, const LinearSolverSettings& /*settings*/)
+{
+}
+
+/// \brief Passes multigrid settings to a multigrid preconditioner.
+static void ConfigurePreconditioner(AlgebraicMultigrid& preconditioner, const LinearSolverSettings& settings)
+{
+	preconditioner = AlgebraicMultigrid(settings.MultigridParams);
+}
+
+/// \brief BiCGSTAB + a given preconditioner on the original system with optional warm start and preconditioner reuse.
+template <typename Preconditioner>
+class PreconditionedBiCGSTABSystemSolver : public EvolutionSystemSolver
+{
+public:
+	explicit PreconditionedBiCGSTABSystemSolver(const LinearSolverSettings& settings)
+		: m_Settings(settings)
+	{
+		if (m_Settings.Tolerance > 0.0)
+			m_Solver.setTolerance(m_Settings.Tolerance);
+		ConfigurePreconditioner(m_Solver.preconditioner().Wrapped(), m_Settings);
+	}
+
+	[[nodiscard]] LinearSolverReport Solve(const CachedSystemMatrix& sysMat, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, Eigen::MatrixXd& x) override
+	{
+		const auto startTime = std::chrono::high_resolution_clock::now();
+
+		const bool shouldRecompute = (m_PatternVersion != sysMat.PatternVersion() || m_NSolvesSinceRecompute >= m_Settings.PreconditionerReuseSteps);
+		auto report = SolveColumnsIteratively(m_Solver, sysMat.Matrix(), shouldRecompute,
+			GetIterationLimit(shouldRecompute, m_NFreshPreconditionerIterations, m_Settings.MaxIterations), rhs, guess, m_Settings.UseWarmStart, x);
+		if (report.Info != Eigen::Success && !shouldRecompute)
+		{
+			// the reused preconditioner is too far from the current system
+			report = SolveColumnsIteratively(m_Solver, sysMat.Matrix(), true, m_Settings.MaxIterations, rhs, guess, m_Settings.UseWarmStart, x);
+		}
+
+		if (report.IsPreconditionerRecomputed)
+		{
+			m_PatternVersion = (report.Info == Eigen::Success ? sysMat.PatternVersion() : std::numeric_limits<size_t>::max());
+			m_NSolvesSinceRecompute = 0;
+			m_NFreshPreconditionerIterations = report.NIterations;
+		}
+		m_NSolvesSinceRecompute++;
+
+		if (report.Info == Eigen::Success)
+			report.RelativeResidual = ComputeMaxRelativeResidual(sysMat.Matrix(), rhs, x);
+		report.SolveTimeSeconds = SecondsSince(startTime);
+		return report;
+	}
+
+private:
+	LinearSolverSettings m_Settings{}; //>! solver settings.
+	Eigen::BiCGSTAB<SparseMatrix, ReusablePreconditioner<Preconditioner>> m_Solver{}; //>! solver with a reusable preconditioner.
+	size_t m_PatternVersion{ std::numeric_limits<size_t>::max() }; //>! pattern version of the matrix for which the preconditioner was computed.
+	unsigned int m_NSolvesSinceRecompute{ 0 }; //>! the number of solves since the last preconditioner computation.
+	unsigned int m_NFreshPreconditionerIterations{ 0 }; //>! the number of iterations of the last solve with a recomputed preconditioner.
+};
+
+/// \brief BiCGSTAB + incomplete LUT.
+using BiCGSTABSystemSolver = PreconditionedBiCGSTABSystemSolver<Eigen::IncompleteLUT<double>>;
+
+/// \brief BiCGSTAB + algebraic multigrid V-cycle.
+using BiCGSTABMultigridSystemSolver = PreconditionedBiCGSTABSystemSolver<AlgebraicMultigrid>;
+
+/// \brief Conjugate gradient + incomplete Cholesky on the symmetrized system. Falls back to BiCGSTAB if the symmetrized solve fails.
+class ConjugateGradientSystemSolver : public EvolutionSystemSolver
+{
+public:
+	explicit ConjugateGradientSystemSolver(const LinearSolverSettings& settings)
+		: m_Settings(settings), m_FallbackSolver(settings)
+	{
+		if (m_Settings.Tolerance > 0.0)
+			m_Solver.setTolerance(m_Settings.Tolerance);
+	}
+
+	[[nodiscard]] LinearSolverReport Solve(const CachedSystemMatrix& sysMat, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, Eigen::MatrixXd& x) override
+	{
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		const auto lastPatternVersion = m_System.PatternVersion();
+		if (!m_System.Update(sysMat, rhs))
+		{
+			std::cerr << "ConjugateGradientSystemSolver::Solve: [WARNING] system could not be symmetrized! Using BiCGSTAB instead.\n";
+			m_ForceRecompute = true;
+			return m_FallbackSolver.Solve(sysMat, rhs, guess, x);
+		}
+
+		const bool shouldRecompute = (lastPatternVersion != m_System.PatternVersion() || m_ForceRecompute || m_NSolvesSinceRecompute >= m_Settings.PreconditionerReuseSteps);
+		auto report = SolveColumnsIteratively(m_Solver, m_System.Matrix(), shouldRecompute,
+			GetIterationLimit(shouldRecompute, m_NFreshPreconditionerIterations, m_Settings.MaxIterations), m_System.Rhs(), guess, m_Settings.UseWarmStart, x);
+		if (report.Info != Eigen::Success && !shouldRecompute)
+		{
+			// the reused preconditioner is too far from the current system
+			report = SolveColumnsIteratively(m_Solver, m_System.Matrix(), true, m_Settings.MaxIterations, m_System.Rhs(), guess, m_Settings.UseWarmStart, x);
+		}
+
+		if (report.IsPreconditionerRecomputed)
+		{
+			m_NSolvesSinceRecompute = 0;
+			m_NFreshPreconditionerIterations = report.NIterations;
+		}
+		m_NSolvesSinceRecompute++;
+
+		m_ForceRecompute = (report.Info != Eigen::Success);
+		if (m_ForceRecompute)
+		{
+			std::cerr << "ConjugateGradientSystemSolver::Solve: [WARNING] " << InterpretSolverErrorCode(report.Info) << " for the symmetrized system! Using BiCGSTAB instead.\n";
+			return m_FallbackSolver.Solve(sysMat, rhs, guess, x);
+		}
+
+		report.RelativeResidual = ComputeMaxRelativeResidual(sysMat.Matrix(), rhs, x);
+		report.SolveTimeSeconds = SecondsSince(startTime);
+		return report;
+	}
+
+private:
+	LinearSolverSettings m_Settings{}; //>! solver settings.
+	SymmetrizedSystem m_System{}; //>! symmetrized evolution system.
+	Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper, ReusablePreconditioner<Eigen::IncompleteCholesky<double>>> m_Solver{}; //>! solver with a reusable preconditioner.
+	BiCGSTABSystemSolver m_FallbackSolver; //>! solver for systems which cannot be solved in symmetrized form.
+	unsigned int m_NSolvesSinceRecompute{ 0 }; //>! the number of solves since the last preconditioner computation.
+	unsigned int m_NFreshPreconditionerIterations{ 0 }; //>! the number of iterations of the last solve with a recomputed preconditioner.
+	bool m_ForceRecompute{ false }; //>! if true, the preconditioner is recomputed for the next solve.
+};
+
+/// \brief Sparse LDLT factorization of the symmetrized system. The symbolic analysis is redone only when the pattern changes. Falls back to BiCGSTAB if the factorization fails.
+class LDLTSystemSolver : public EvolutionSystemSolver
+{
+public:
+	explicit LDLTSystemSolver(const LinearSolverSettings& settings)
+		: m_FallbackSolver(settings)
+	{
+	}
+
+	[[nodiscard]] LinearSolverReport Solve(const CachedSystemMatrix& sysMat, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, Eigen::MatrixXd& x) override
+	{
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		const auto lastPatternVersion = m_System.PatternVersion();
+		if (!m_System.Update(sysMat, rhs))
+		{
+			std::cerr << "LDLTSystemSolver::Solve: [WARNING] system could not be symmetrized! Using BiCGSTAB instead.\n";
+			return m_FallbackSolver.Solve(sysMat, rhs, guess, x);
+		}
+
+		LinearSolverReport report{};
+		report.IsPreconditionerRecomputed = (lastPatternVersion != m_System.PatternVersion() || !m_IsPatternAnalyzed);
+		if (report.IsPreconditionerRecomputed)
+		{
+			m_Solver.analyzePattern(m_System.Matrix());
+			m_IsPatternAnalyzed = (m_Solver.info() == Eigen::Success);
+		}
+		if (m_IsPatternAnalyzed)
+			m_Solver.factorize(m_System.Matrix());
+		if (m_IsPatternAnalyzed && m_Solver.info() == Eigen::Success)
+			x = m_Solver.solve(m_System.Rhs());
+
+		report.Info = (m_IsPatternAnalyzed ? m_Solver.info() : Eigen::NumericalIssue);
+		if (report.Info != Eigen::Success)
+		{
+			std::cerr << "LDLTSystemSolver::Solve: [WARNING] " << InterpretSolverErrorCode(report.Info) << " for the symmetrized system! Using BiCGSTAB instead.\n";
+			return m_FallbackSolver.Solve(sysMat, rhs, guess, x);
+		}
+
+		report.RelativeResidual = ComputeMaxRelativeResidual(sysMat.Matrix(), rhs, x);
+		report.SolveTimeSeconds = SecondsSince(startTime);
+		return report;
+	}
+
+private:
+	SymmetrizedSystem m_System{}; //>! symmetrized evolution system.
+	Eigen::SimplicialLDLT<SparseMatrix> m_Solver{}; //>! direct solver.
+	BiCGSTABSystemSolver m_FallbackSolver; //>! solver for systems which cannot be solved in symmetrized form.
+	bool m_IsPatternAnalyzed{ false }; //>! whether the symbolic analysis is valid.
+};
+
+/// \brief Default relative residual tolerance of standalone multigrid iterations.
+constexpr double DEFAULT_MULTIGRID_TOLERANCE = 1e-10;
+/// \brief Default maximum number of V-cycles of standalone multigrid iterations.
+constexpr int DEFAULT_MAX_MULTIGRID_CYCLES = 100;
+
+/**
+ * \brief Standalone algebraic multigrid: defect correction x += V-cycle(b - A x) on the original system.
+ *        The hierarchy is reused for PreconditionerReuseSteps solves. Falls back to BiCGSTAB if the cycles do not converge.
+ */
+class MultigridSystemSolver : public EvolutionSystemSolver
+{
+public:
+	explicit MultigridSystemSolver(const LinearSolverSettings& settings)
+		: m_Settings(settings), m_Multigrid(settings.MultigridParams), m_FallbackSolver(settings)
+	{
+	}
+
+	[[nodiscard]] LinearSolverReport Solve(const CachedSystemMatrix& sysMat, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, Eigen::MatrixXd& x) override
+	{
+		const auto startTime = std::chrono::high_resolution_clock::now();
+
+		const bool shouldRecompute = (m_PatternVersion != sysMat.PatternVersion() || m_NSolvesSinceRecompute >= m_Settings.PreconditionerReuseSteps);
+		auto report = SolveWithCycles(sysMat.Matrix(), shouldRecompute, rhs, guess, x);
+		if (report.Info != Eigen::Success && !shouldRecompute)
+		{
+			// the reused hierarchy is too far from the current system
+			report = SolveWithCycles(sysMat.Matrix(), true, rhs, guess, x);
+		}
+
+		if (report.IsPreconditionerRecomputed)
+		{
+			m_PatternVersion = (report.Info == Eigen::Success ? sysMat.PatternVersion() : std::numeric_limits<size_t>::max());
+			m_NSolvesSinceRecompute = 0;
+		}
+		m_NSolvesSinceRecompute++;
+
+		if (report.Info != Eigen::Success)
+		{
+			std::cerr << "MultigridSystemSolver::Solve: [WARNING] " << InterpretSolverErrorCode(report.Info) << " for multigrid cycles! Using BiCGSTAB instead.\n";
+			return m_FallbackSolver.Solve(sysMat, rhs, guess, x);
+		}
+
+		report.RelativeResidual = ComputeMaxRelativeResidual(sysMat.Matrix(), rhs, x);
+		report.SolveTimeSeconds = SecondsSince(startTime);
+		return report;
+	}
+
+private:
+	/// \brief Iterates V-cycles for each column of rhs until the relative residual drops below tolerance.
+	[[nodiscard]] LinearSolverReport SolveWithCycles(const SparseMatrix& mat, const bool& recomputeHierarchy, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, Eigen::MatrixXd& x)
+	{
+		LinearSolverReport report{};
+		report.IsPreconditionerRecomputed = recomputeHierarchy;
+		if (recomputeHierarchy)
+			m_Multigrid.compute(mat);
+		if (m_Multigrid.info() != Eigen::Success)
+		{
+			report.Info = m_Multigrid.info();
+			return report;
+		}
+
+		const double tolerance = (m_Settings.Tolerance > 0.0 ? m_Settings.Tolerance : DEFAULT_MULTIGRID_TOLERANCE);
+		const int maxCycles = (m_Settings.MaxIterations > 0 ? m_Settings.MaxIterations : DEFAULT_MAX_MULTIGRID_CYCLES);
+		x.resize(rhs.rows(), rhs.cols());
+		for (Eigen::Index j = 0; j < rhs.cols(); j++)
+		{
+			const Eigen::VectorXd b = rhs.col(j);
+			const double rhsNorm = (b.norm() > 0.0 ? b.norm() : 1.0);
+			Eigen::VectorXd xCol = (m_Settings.UseWarmStart ? Eigen::VectorXd(guess.col(j)) : Eigen::VectorXd::Zero(b.rows()));
+			Eigen::VectorXd residual = b - mat * xCol;
+			int nCycles = 0;
+			while (residual.norm() / rhsNorm > tolerance && nCycles < maxCycles)
+			{
+				Eigen::VectorXd correction = Eigen::VectorXd::Zero(b.rows());
+				m_Multigrid.Cycle(0, residual, correction);
+				xCol += correction;
+				residual = b - mat * xCol;
+				nCycles++;
+			}
+			x.col(j) = xCol;
+
+			report.NIterations = std::max(report.NIterations, static_cast<unsigned int>(nCycles));
+			if (!residual.allFinite() || residual.norm() / rhsNorm > tolerance)
+				report.Info = Eigen::NoConvergence;
+		}
+		return report;
+	}
+
+	LinearSolverSettings m_Settings{}; //>! solver settings.
+	AlgebraicMultigrid m_Multigrid{}; //>! multigrid hierarchy.
+	BiCGSTABSystemSolver m_FallbackSolver; //>! solver for systems on which multigrid cycles do not converge.
+	size_t m_PatternVersion{ std::numeric_limits<size_t>::max() }; //>! pattern version of the matrix for which the hierarchy was computed.
+	unsigned int m_NSolvesSinceRecompute{ 0 }; //>! the number of solves since the last hierarchy computation.
+};
+
+// ================================================================================================
+
+std::unique_ptr<EvolutionSystemSolver> CreateEvolutionSystemSolver(const LinearSolverSettings& settings)
+{
+	if (settings.Type == LinearSolverType::CG_IC)
+		return std::make_unique<ConjugateGradientSystemSolver>(settings);
+
+	if (settings.Type == LinearSolverType::SimplicialLDLT)
+		return std::make_unique<LDLTSystemSolver>(settings);
+
+	if (settings.Type == LinearSolverType::BiCGSTAB_AMG)
+		return std::make_unique<BiCGSTABMultigridSystemSolver>(settings);
+
+	if (settings.Type == LinearSolverType::AMG)
+		return std::make_unique<MultigridSystemSolver>(settings);
+
+	return std::make_unique<BiCGSTABSystemSolver>(settings);
+}
+
+Eigen::MatrixXd GetVertexPositionMatrix(const pmp::SurfaceMesh& mesh)
+{
+	Eigen::MatrixXd positions(mesh.n_vertices(), 3);
+	for (const auto v : mesh.vertices())
+	{
+		const auto& p = mesh.position(v);
+		positions.row(v.idx()) = Eigen::RowVector3d(p[0], p[1], p[2]);
+	}
+	return positions;
+}
+
+void SetVertexPositions(pmp::SurfaceMesh& mesh, const Eigen::MatrixXd& positions)
+{
+	for (const auto v : mesh.vertices())
+	{
+		const auto row = positions.row(v.idx());
+		mesh.position(v) = pmp::Point(static_cast<pmp::Scalar>(row(0)), static_cast<pmp::Scalar>(row(1)), static_cast<pmp::Scalar>(row(2)));
+	}
+}
+
+std::string LinearSolverTypeToString(const LinearSolverType& type)
+{
+	if (type == LinearSolverType::CG_IC)
+		return "CG_IC";
+
+	if (type == LinearSolverType::SimplicialLDLT)
+		return "SimplicialLDLT";
+
+	if (type == LinearSolverType::BiCGSTAB_AMG)
+		return "BiCGSTAB_AMG";
+
+	if (type == LinearSolverType::AMG)
+		return "AMG";
+
+	return "BiCGSTAB_ILUT";
+}
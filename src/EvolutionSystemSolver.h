@@ -0,0 +1,81 @@
+#pragma once
+
+#include "EvolverUtilsCommon.h"
+#include "AlgebraicMultigrid.h"
+
+#include <memory>
+
+/**
+ * \brief An enumerator for the linear solver backend of the evolution system.
+ * \enum LinearSolverType
+ */
+enum class [[nodiscard]] LinearSolverType
+{
+	BiCGSTAB_ILUT = 0, //>! BiCGSTAB with incomplete LUT preconditioner on the original (non-symmetric) system.
+	CG_IC = 1, //>! conjugate gradient with incomplete Cholesky preconditioner on the symmetrized system.
+	SimplicialLDLT = 2, //>! sparse direct LDLT factorization of the symmetrized system with cached symbolic analysis.
+	BiCGSTAB_AMG = 3, //>! BiCGSTAB with an algebraic multigrid V-cycle preconditioner on the original system.
+	AMG = 4 //>! standalone algebraic multigrid V-cycle iterations on the original system.
+};
+
+/**
+ * \brief A wrapper for linear solver settings of the evolution system.
+ * \struct LinearSolverSettings
+ */
+struct LinearSolverSettings
+{
+	LinearSolverType Type{ LinearSolverType::BiCGSTAB_ILUT }; //>! linear solver backend.
+	bool UseWarmStart{ true }; //>! if true, iterative solvers start from the provided initial guess (current vertex positions) instead of zero.
+	unsigned int PreconditionerReuseSteps{ 1 }; //>! the number of consecutive solves sharing one preconditioner (1 = recompute for each solve). A pattern change always forces recomputation.
+	double Tolerance{ -1.0 }; //>! relative residual tolerance of iterative solvers (a negative value keeps the Eigen default).
+	int MaxIterations{ -1 }; //>! maximum number of iterations of iterative solvers (a negative value keeps the Eigen default).
+	MultigridSettings MultigridParams{}; //>! settings of the multigrid hierarchy (used by BiCGSTAB_AMG and AMG).
+};
+
+/**
+ * \brief A summary of a single solve of the evolution system.
+ * \struct LinearSolverReport
+ */
+struct LinearSolverReport
+{
+	Eigen::ComputationInfo Info{ Eigen::Success }; //>! solver status.
+	unsigned int NIterations{ 0 }; //>! the maximum number of iterations (or V-cycles) over all rhs columns (0 for direct solvers).
+	double RelativeResidual{ 0.0 }; //>! max ||A x - b|| / ||b|| over all rhs columns.
+	bool IsPreconditionerRecomputed{ false }; //>! true if the preconditioner (or symbolic analysis for direct solvers) was recomputed for this solve.
+	double SolveTimeSeconds{ 0.0 }; //>! wall time of the solve including preconditioner/factorization setup.
+};
+
+/**
+ * \brief An interface of linear solvers for the (NVertices x NVertices) evolution system with an (NVertices x 3) rhs.
+ * \class EvolutionSystemSolver
+ *
+ * A solver instance lives for the whole evolution, so that it can keep preconditioners, factorizations
+ * and symbolic analyses between time steps while the sparsity pattern of the system stays the same.
+ */
+class EvolutionSystemSolver
+{
+public:
+	/**
+	 * \brief Solves sysMat * x = rhs.
+	 * \param sysMat    system matrix with a cached sparsity pattern.
+	 * \param rhs       right-hand side (one column per coordinate).
+	 * \param guess     initial guess for iterative solvers with warm start (typically the current vertex positions).
+	 * \param x         solution.
+	 * \return solve report.
+	 */
+	virtual [[nodiscard]] LinearSolverReport Solve(const CachedSystemMatrix& sysMat, const Eigen::MatrixXd& rhs, const Eigen::MatrixXd& guess, Eigen::MatrixXd& x) = 0;
+
+	virtual ~EvolutionSystemSolver() = default;
+};
+
+/// \brief Creates a linear solver for the evolution system from given settings.
+[[nodiscard]] std::unique_ptr<EvolutionSystemSolver> CreateEvolutionSystemSolver(const LinearSolverSettings& settings);
+
+/// \brief Fills a (NVertices x 3) matrix with vertex positions of a given mesh.
+[[nodiscard]] Eigen::MatrixXd GetVertexPositionMatrix(const pmp::SurfaceMesh& mesh);
+
+/// \brief Sets vertex positions of a given mesh from rows of a (NVertices x 3) matrix.
+void SetVertexPositions(pmp::SurfaceMesh& mesh, const Eigen::MatrixXd& positions);
+
+/// \brief Converts LinearSolverType to a string.
+[[nodiscard]] std::string LinearSolverTypeToString(const LinearSolverType& type);
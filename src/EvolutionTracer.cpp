@@ -0,0 +1,155 @@
+#include "EvolutionTracer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+/// \brief the number of phases reserved upfront (avoids reallocations during the first time steps).
+constexpr size_t N_RESERVED_PHASE_EVENTS = 1024;
+
+/// \brief the tracer active for the calling thread.
+thread_local EvolutionTracer* g_CurrentTracer = nullptr;
+
+EvolutionTracer::EvolutionTracer(const std::string& processName)
+	: m_ProcessName(processName), m_StartTime(Clock::now())
+{
+	m_Phases.reserve(N_RESERVED_PHASE_EVENTS);
+	m_Counters.reserve(N_RESERVED_PHASE_EVENTS);
+}
+
+EvolutionTracer::ActivationScope::ActivationScope(EvolutionTracer& tracer)
+	: m_PreviousTracer(g_CurrentTracer)
+{
+	g_CurrentTracer = &tracer;
+}
+
+EvolutionTracer::ActivationScope::~ActivationScope()
+{
+	g_CurrentTracer = m_PreviousTracer;
+}
+
+EvolutionTracer* EvolutionTracer::Current()
+{
+	return g_CurrentTracer;
+}
+
+void EvolutionTracer::RecordPhase(const char* name, const Clock::time_point& start, const Clock::time_point& end)
+{
+	m_Phases.push_back({ name, start, end, m_StepId });
+}
+
+void EvolutionTracer::RecordCounter(const char* name, const double& value)
+{
+	m_Counters.push_back({ name, Clock::now(), value });
+}
+
+void EvolutionTracer::Clear()
+{
+	m_Phases.clear();
+	m_Counters.clear();
+	m_StepId = 0;
+	m_StartTime = Clock::now();
+}
+
+std::vector<PhaseStatistics> EvolutionTracer::GetPhaseStatistics() const
+{
+	std::vector<PhaseStatistics> statistics{};
+	for (const auto& phase : m_Phases)
+	{
+		const double duration = std::chrono::duration<double>(phase.End - phase.Start).count();
+		// the number of distinct phases is small, so a linear search is faster than a map.
+		auto it = std::find_if(statistics.begin(), statistics.end(),
+			[&phase](const PhaseStatistics& stats) { return std::strcmp(stats.Name.c_str(), phase.Name) == 0; });
+		if (it == statistics.end())
+		{
+			statistics.push_back({ phase.Name, 1, duration, duration, duration });
+			continue;
+		}
+		it->Count++;
+		it->TotalSeconds += duration;
+		it->MinSeconds = std::min(it->MinSeconds, duration);
+		it->MaxSeconds = std::max(it->MaxSeconds, duration);
+	}
+	return statistics;
+}
+
+namespace
+{
+	/// \brief Writes a string as a JSON string literal.
+	void WriteJsonString(std::ostream& os, const std::string& str)
+	{
+		os << '"';
+		for (const char c : str)
+		{
+			if (c == '"' || c == '\\')
+				os << '\\' << c;
+			else if (static_cast<unsigned char>(c) < 0x20)
+				os << ' ';
+			else
+				os << c;
+		}
+		os << '"';
+	}
+} // anonymous namespace
+
+void EvolutionTracer::WriteChromeTrace(const std::string& fileName) const
+{
+	std::ofstream os(fileName);
+	if (!os.is_open())
+		throw std::runtime_error("EvolutionTracer::WriteChromeTrace: failed to open " + fileName + "!\n");
+
+	const auto toMicroseconds = [this](const Clock::time_point& time)
+	{
+		return std::chrono::duration<double, std::micro>(time - m_StartTime).count();
+	};
+
+	os << std::fixed << std::setprecision(3);
+	os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":";
+	WriteJsonString(os, m_ProcessName);
+	os << "}}";
+	for (const auto& phase : m_Phases)
+	{
+		os << ",\n{\"name\":\"" << phase.Name << "\",\"cat\":\"evolution\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+			<< ",\"ts\":" << toMicroseconds(phase.Start) << ",\"dur\":" << toMicroseconds(phase.End) - toMicroseconds(phase.Start)
+			<< ",\"args\":{\"step\":" << phase.StepId << "}}";
+	}
+	for (const auto& counter : m_Counters)
+	{
+		os << ",\n{\"name\":\"" << counter.Name << "\",\"ph\":\"C\",\"pid\":1,\"tid\":1"
+			<< ",\"ts\":" << std::fixed << std::setprecision(3) << toMicroseconds(counter.Time)
+			<< std::defaultfloat << std::setprecision(9) << ",\"args\":{\"value\":";
+		// JSON has no literals for NaN and infinity
+		if (std::isfinite(counter.Value))
+			os << counter.Value;
+		else
+			os << "null";
+		os << "}}";
+	}
+	os << "\n]}\n";
+	if (!os)
+		throw std::runtime_error("EvolutionTracer::WriteChromeTrace: failed to write " + fileName + "!\n");
+}
+
+void ReportPhaseStatistics(const std::vector<PhaseStatistics>& statistics, std::ostream& os)
+{
+	os << "======================================================================\n";
+	os << "> > > > > > > > > > > > > Phase Statistics: < < < < < < < < < < < < <\n";
+	for (const auto& stats : statistics)
+	{
+		os << stats.Name << ": " << stats.Count << "x, total: " << stats.TotalSeconds << " s, mean: " << stats.MeanSeconds()
+			<< " s, min: " << stats.MinSeconds << " s, max: " << stats.MaxSeconds << " s,\n";
+	}
+	os << "----------------------------------------------------------------------\n";
+}
+
+std::string GetTraceFileName(const TracingSettings& settings, const std::string& outputPath, const std::string& procedureName)
+{
+	if (!settings.FileName.empty())
+		return settings.FileName;
+	return outputPath + procedureName + "_Trace.json";
+}
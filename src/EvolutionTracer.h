@@ -0,0 +1,190 @@
+#pragma once
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * \brief A wrapper for settings of phase tracing of an evolution.
+ * \struct TracingSettings
+ */
+struct TracingSettings
+{
+	bool Enabled{ false }; //>! if true, phases and counters of each time step are recorded and written into a Chrome trace (JSON) file.
+	std::string FileName{}; //>! full trace file name. If empty, OutputPath + ProcedureName + "_Trace.json" is used.
+};
+
+/**
+ * \brief Aggregated durations of all recorded occurrences of a phase.
+ * \struct PhaseStatistics
+ */
+struct PhaseStatistics
+{
+	std::string Name{}; //>! phase name.
+	size_t Count{ 0 }; //>! the number of recorded occurrences.
+	double TotalSeconds{ 0.0 }; //>! summed duration.
+	double MinSeconds{ 0.0 }; //>! shortest duration.
+	double MaxSeconds{ 0.0 }; //>! longest duration.
+
+	/// \brief mean duration.
+	[[nodiscard]] double MeanSeconds() const { return (Count > 0 ? TotalSeconds / static_cast<double>(Count) : 0.0); }
+};
+
+/**
+ * \brief Records scoped phases and counters of an evolution into memory.
+ * \class EvolutionTracer
+ *
+ * Recording only stores a phase name (a string literal), time points and the current step id, and nothing is
+ * formatted until the trace is written, so the overhead of an enabled tracer is negligible compared to a time step.
+ * Phases are recorded via ScopedPhaseTrace and counters via TraceCounter from anywhere within the thread running the
+ * evolution (including evolver policies) while the tracer is activated for that thread by an ActivationScope.
+ * If no tracer is active, both reduce to a check of a thread-local pointer.
+ */
+class EvolutionTracer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * \brief Constructor.
+	 * \param processName    name shown for the traced process in the trace viewer (e.g.: the evolution procedure name).
+	 */
+	explicit EvolutionTracer(const std::string& processName = "");
+
+	/// \brief Activates a tracer for the calling thread for the lifetime of the scope (restoring the previously active tracer).
+	class ActivationScope
+	{
+	public:
+		explicit ActivationScope(EvolutionTracer& tracer);
+		~ActivationScope();
+		ActivationScope(const ActivationScope&) = delete;
+		ActivationScope& operator=(const ActivationScope&) = delete;
+	private:
+		EvolutionTracer* m_PreviousTracer{ nullptr };
+	};
+
+	/// \brief Returns the tracer active for the calling thread (nullptr if tracing is off).
+	[[nodiscard]] static EvolutionTracer* Current();
+
+	/// \brief Sets the time step id attached to subsequently recorded phases.
+	void SetStepId(const unsigned int& stepId) { m_StepId = stepId; }
+
+	/**
+	 * \brief Records a phase.
+	 * \param name     phase name (needs to outlive the tracer, e.g.: a string literal).
+	 * \param start    start of the phase.
+	 * \param end      end of the phase.
+	 */
+	void RecordPhase(const char* name, const Clock::time_point& start, const Clock::time_point& end);
+
+	/**
+	 * \brief Records the value of a counter.
+	 * \param name     counter name (needs to outlive the tracer, e.g.: a string literal).
+	 * \param value    counter value.
+	 */
+	void RecordCounter(const char* name, const double& value);
+
+	/// \brief Removes all recorded phases and counters.
+	void Clear();
+
+	/// \brief Computes per-phase aggregates (in the order of the first occurrence of each phase).
+	[[nodiscard]] std::vector<PhaseStatistics> GetPhaseStatistics() const;
+
+	/**
+	 * \brief Writes all recorded phases and counters in the Chrome trace event format (chrome://tracing, Perfetto).
+	 * \param fileName    full file name.
+	 * \throw std::runtime_error if the file cannot be written.
+	 */
+	void WriteChromeTrace(const std::string& fileName) const;
+
+private:
+	/// \brief a recorded phase.
+	struct PhaseEvent
+	{
+		const char* Name{ nullptr };
+		Clock::time_point Start{};
+		Clock::time_point End{};
+		unsigned int StepId{ 0 };
+	};
+
+	/// \brief a recorded counter value.
+	struct CounterEvent
+	{
+		const char* Name{ nullptr };
+		Clock::time_point Time{};
+		double Value{ 0.0 };
+	};
+
+	std::string m_ProcessName{}; //>! name of the traced process.
+	Clock::time_point m_StartTime{}; //>! time origin of the trace.
+	unsigned int m_StepId{ 0 }; //>! current time step id.
+	std::vector<PhaseEvent> m_Phases{}; //>! recorded phases.
+	std::vector<CounterEvent> m_Counters{}; //>! recorded counter values.
+};
+
+/**
+ * \brief Records the lifetime of this object as a phase of the tracer active for the calling thread (if any).
+ * \class ScopedPhaseTrace
+ */
+class ScopedPhaseTrace
+{
+public:
+	/// \brief Constructor. Starts the phase with a given name (needs to be a string literal).
+	explicit ScopedPhaseTrace(const char* name)
+		: m_Tracer(EvolutionTracer::Current()), m_Name(name)
+	{
+		if (m_Tracer)
+			m_Start = EvolutionTracer::Clock::now();
+	}
+
+	/// \brief Destructor. Ends the phase (unless ended already).
+	~ScopedPhaseTrace()
+	{
+		End();
+	}
+
+	/// \brief Ends the phase before the end of the scope.
+	void End()
+	{
+		if (!m_Tracer)
+			return;
+		m_Tracer->RecordPhase(m_Name, m_Start, EvolutionTracer::Clock::now());
+		m_Tracer = nullptr;
+	}
+
+	ScopedPhaseTrace(const ScopedPhaseTrace&) = delete;
+	ScopedPhaseTrace& operator=(const ScopedPhaseTrace&) = delete;
+
+private:
+	EvolutionTracer* m_Tracer{ nullptr }; //>! active tracer (nullptr if tracing is off).
+	const char* m_Name{ nullptr }; //>! phase name.
+	EvolutionTracer::Clock::time_point m_Start{}; //>! start of the phase.
+};
+
+/**
+ * \brief Records a counter value into the tracer active for the calling thread (if any).
+ * \param name     counter name (needs to be a string literal).
+ * \param value    counter value.
+ */
+inline void TraceCounter(const char* name, const double& value)
+{
+	if (auto* tracer = EvolutionTracer::Current())
+		tracer->RecordCounter(name, value);
+}
+
+/**
+ * \brief Reports per-phase aggregates to a given stream.
+ * \param statistics    phase statistics.
+ * \param os            output stream.
+ */
+void ReportPhaseStatistics(const std::vector<PhaseStatistics>& statistics, std::ostream& os);
+
+/**
+ * \brief Evaluates the trace file name for given settings.
+ * \param settings         tracing settings.
+ * \param outputPath       output path of the evolution.
+ * \param procedureName    name of the evolution procedure.
+ * \return settings.FileName, or outputPath + procedureName + "_Trace.json" if settings.FileName is empty.
+ */
+[[nodiscard]] std::string GetTraceFileName(const TracingSettings& settings, const std::string& outputPath, const std::string& procedureName);
@@ -1,8 +1,12 @@
 #include "EvolverUtilsCommon.h"
 
 #include "pmp/SurfaceMesh.h"
+#include "pmp/algorithms/DifferentialGeometry.h"
+#include "pmp/algorithms/Reordering.h"
 #include "geometry/IcoSphereBuilder.h"
 
+#include <algorithm>
+
 CoVolumeStats AnalyzeMeshCoVolumes(pmp::SurfaceMesh& mesh, const AreaFunction& areaFunction)
 {
 	// vertex property for co-volume measures.
@@ -51,10 +55,74 @@ std::string InterpretSolverErrorCode(const Eigen::ComputationInfo& cInfo)
 	return "Eigen::InvalidInput";
 }
 
+bool CachedSystemMatrix::UpdatePattern(const pmp::SurfaceMesh& mesh)
+{
+	if (m_IsPatternValid && m_NVertices == mesh.n_vertices())
+		return false;
+
+	m_NVertices = mesh.n_vertices();
+	const auto nVertices = static_cast<Eigen::Index>(m_NVertices);
+
+	// the pattern is symmetric, so column v holds the diagonal entry and the one-ring neighbors of vertex v.
+	std::vector<Eigen::Triplet<double>> patternTriplets;
+	patternTriplets.reserve(m_NVertices + mesh.n_halfedges());
+	for (const auto v : mesh.vertices())
+	{
+		patternTriplets.emplace_back(v.idx(), v.idx(), 0.0);
+		for (const auto h : mesh.halfedges(v))
+			patternTriplets.emplace_back(v.idx(), mesh.to_vertex(h).idx(), 0.0);
+	}
+	m_Matrix = SparseMatrix(nVertices, nVertices);
+	m_Matrix.setFromTriplets(patternTriplets.begin(), patternTriplets.end());
+	m_Matrix.makeCompressed();
+
+	const auto* outerIds = m_Matrix.outerIndexPtr();
+	const auto* innerIds = m_Matrix.innerIndexPtr();
+	const auto findNonzeroId = [&](const Eigen::Index& row, const Eigen::Index& col)
+	{
+		const auto* colBegin = innerIds + outerIds[col];
+		const auto* colEnd = innerIds + outerIds[col + 1];
+		return static_cast<Eigen::Index>(std::lower_bound(colBegin, colEnd, row) - innerIds);
+	};
+
+	m_DiagonalNonzeroIds.assign(m_NVertices, 0);
+	m_HalfedgeNonzeroIds.assign(mesh.halfedges_size(), 0);
+	for (const auto v : mesh.vertices())
+	{
+		m_DiagonalNonzeroIds[v.idx()] = findNonzeroId(v.idx(), v.idx());
+		for (const auto h : mesh.halfedges(v))
+			m_HalfedgeNonzeroIds[h.idx()] = findNonzeroId(v.idx(), mesh.to_vertex(h).idx());
+	}
+
+	m_IsPatternValid = true;
+	m_PatternVersion++;
+	return true;
+}
+
+void CachedSystemMatrix::SetIdentityRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v)
+{
+	auto* values = m_Matrix.valuePtr();
+	values[m_DiagonalNonzeroIds[v.idx()]] = 1.0;
+	for (const auto h : mesh.halfedges(v))
+		values[m_HalfedgeNonzeroIds[h.idx()]] = 0.0;
+}
+
+void CachedSystemMatrix::SetRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& diagonalValue, const double& offDiagonalFactor, const pmp::ImplicitLaplaceWeights& laplaceWeights)
+{
+	auto* values = m_Matrix.valuePtr();
+	values[m_DiagonalNonzeroIds[v.idx()]] = diagonalValue;
+	const auto areaNorm = laplaceWeights.vertexAreaNorms[v.idx()];
+	for (const auto h : mesh.halfedges(v))
+	{
+		const auto weight = laplaceWeights.edgeWeights[mesh.edge(h).idx()] / areaNorm;
+		values[m_HalfedgeNonzeroIds[h.idx()]] = offDiagonalFactor * static_cast<double>(weight);
+	}
+}
+
 pmp::vec3 ComputeTangentialUpdateVelocityAtVertex(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const pmp::vec3& vNormal, const float& weight)
 {
 	pmp::vec3 result{};
-	if (!mesh.has_vertex_property("v:normal"))
+	if (!mesh.has_vertex_property(vertexNormalPropertyKey))
 		return result;
 
 	auto vCirculator = mesh.vertices(v);
@@ -87,6 +155,27 @@ AdvectionDiffusionParameters PreComputeAdvectionDiffusionParams(const double& di
 	return { distanceMultiplier, distanceVariance, distanceMultiplier, 1.0 };
 }
 
+std::string MeshReorderingTypeToString(const MeshReorderingType& type)
+{
+	if (type == MeshReorderingType::Morton)
+		return "Morton";
+
+	if (type == MeshReorderingType::ReverseCuthillMcKee)
+		return "ReverseCuthillMcKee";
+
+	return "None";
+}
+
+void ReorderSurfaceMesh(pmp::SurfaceMesh& mesh, const MeshReorderingType& type)
+{
+	if (type == MeshReorderingType::None)
+		return;
+
+	const auto vertexOrder = (type == MeshReorderingType::Morton ?
+		pmp::Reordering::morton_vertex_order(mesh) : pmp::Reordering::reverse_cuthill_mckee_vertex_order(mesh));
+	mesh.reorder(vertexOrder);
+}
+
 bool IsRemeshingNecessary(const CoVolumeStats& stats, const double& tStep)
 {
 	return stats.Max > 1.2 * tStep;
@@ -113,7 +202,7 @@ bool IsNonFeatureRemeshingNecessary(const pmp::SurfaceMesh& mesh)
 	float minVal = FLT_MAX;
 	float maxVal = -FLT_MAX;
 	const auto vQualityProp = mesh.get_vertex_property<float>("v:equilateralJacobianCondition");
-	const auto vIsFeature = mesh.get_vertex_property<bool>("v:feature");
+	const auto vIsFeature = mesh.get_vertex_property<bool>(vertexFeaturePropertyKey);
 
 	for (const auto v : mesh.vertices())
 	{
@@ -128,6 +217,43 @@ bool IsNonFeatureRemeshingNecessary(const pmp::SurfaceMesh& mesh)
 		(maxVal > JACOBIAN_COND_MIN && maxVal < JACOBIAN_COND_MAX));
 }
 
+std::vector<pmp::Vertex> GetLowQualityRegion(const pmp::SurfaceMesh& mesh, const unsigned int& nRings)
+{
+	const auto vQualityProp = mesh.get_vertex_property<float>("v:equilateralJacobianCondition");
+	if (!vQualityProp)
+		return {};
+
+	std::vector<pmp::Vertex> region{};
+	std::vector<bool> isInRegion(mesh.vertices_size(), false);
+	for (const auto v : mesh.vertices())
+	{
+		const auto& val = vQualityProp[v];
+		if (val > JACOBIAN_COND_MIN && val < JACOBIAN_COND_MAX)
+			continue;
+		region.push_back(v);
+		isInRegion[v.idx()] = true;
+	}
+
+	// grow the region ring by ring
+	size_t ringStart = 0;
+	for (unsigned int ring = 0; ring < nRings; ring++)
+	{
+		const size_t ringEnd = region.size();
+		for (size_t i = ringStart; i < ringEnd; i++)
+		{
+			for (const auto vv : mesh.vertices(region[i]))
+			{
+				if (isInRegion[vv.idx()])
+					continue;
+				region.push_back(vv);
+				isInRegion[vv.idx()] = true;
+			}
+		}
+		ringStart = ringEnd;
+	}
+	return region;
+}
+
 bool ShouldDetectFeatures(const std::vector<float>& distancePerVertexValues)
 {
 	const float minDist = *std::min(distancePerVertexValues.begin(), distancePerVertexValues.end());
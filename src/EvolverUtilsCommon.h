@@ -1,16 +1,19 @@
 #pragma once
 
 #include "pmp/MatVec.h"
+#include "pmp/Properties.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 #include <functional>
 #include <unordered_set>
+#include <vector>
 
 namespace pmp
 {
 	class SurfaceMesh;
 	class Vertex;
+	struct ImplicitLaplaceWeights;
 }
 
 /// \brief a stats wrapper for co-volume measures affecting the stability of the finite volume method.
@@ -23,6 +26,11 @@ struct CoVolumeStats
 
 const std::string coVolMeasureVertexPropertyName{ "v:coVolumeMeasure" };
 
+/// \brief interned keys of vertex properties looked up in every time step or per vertex (no string compares, see pmp::PropertyKey).
+const pmp::PropertyKey vertexNormalPropertyKey{ "v:normal" };
+const pmp::PropertyKey vertexFeaturePropertyKey{ "v:feature" };
+const pmp::PropertyKey vertexDistancePropertyKey{ "v:distance" };
+
 /// \brief a co-volume area evaluator.
 using AreaFunction = std::function<double(const pmp::SurfaceMesh&, pmp::Vertex)>;
 
@@ -50,6 +58,57 @@ using SparseMatrix = Eigen::SparseMatrix<double>;
 /// \brief A utility for converting Eigen::ComputationInfo to a string message.
 [[nodiscard]] std::string InterpretSolverErrorCode(const Eigen::ComputationInfo& cInfo);
 
+/**
+ * \brief The (NVertices x NVertices) system matrix of an evolving surface with a cached sparsity pattern.
+ * \class CachedSystemMatrix
+ *
+ * The pattern (diagonal + one-ring neighbors of each vertex) and the map from vertices and halfedges to the positions
+ * of matrix nonzeros are computed once per mesh connectivity. Each time step then writes the values of the compressed
+ * matrix in place, instead of sorting and compressing a list of triplets.
+ * Rows of distinct vertices occupy disjoint nonzeros, so SetRow and SetIdentityRow can be called concurrently
+ * for distinct vertices once the pattern is up to date.
+ */
+class CachedSystemMatrix
+{
+public:
+	/**
+	 * \brief Rebuilds the sparsity pattern if the pattern was invalidated or if the mesh size changed.
+	 * \param mesh    evolving surface mesh.
+	 * \return true if the pattern was rebuilt.
+	 */
+	bool UpdatePattern(const pmp::SurfaceMesh& mesh);
+
+	/// \brief Marks the pattern for rebuild. Needs to be called whenever the mesh connectivity changes (e.g.: remeshing).
+	void InvalidatePattern() { m_IsPatternValid = false; }
+
+	/// \brief Sets the row of vertex v to the corresponding row of the identity matrix.
+	void SetIdentityRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v);
+
+	/**
+	 * \brief Fills the row of vertex v with Laplacian weights.
+	 * \param mesh                evolving surface mesh.
+	 * \param v                   vertex whose row is to be filled.
+	 * \param diagonalValue       the diagonal entry of the row.
+	 * \param offDiagonalFactor   multiplier of the Laplacian weight of each one-ring neighbor.
+	 * \param laplaceWeights      implicit Laplacian weights of the whole mesh.
+	 */
+	void SetRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& diagonalValue, const double& offDiagonalFactor, const pmp::ImplicitLaplaceWeights& laplaceWeights);
+
+	/// \brief the system matrix.
+	[[nodiscard]] const SparseMatrix& Matrix() const { return m_Matrix; }
+
+	/// \brief the number of pattern rebuilds so far. Solvers caching pattern-dependent data compare it between solves.
+	[[nodiscard]] size_t PatternVersion() const { return m_PatternVersion; }
+
+private:
+	SparseMatrix m_Matrix{}; //>! compressed system matrix.
+	std::vector<Eigen::Index> m_DiagonalNonzeroIds{}; //>! position of the diagonal entry of each vertex row within the value array.
+	std::vector<Eigen::Index> m_HalfedgeNonzeroIds{}; //>! position of entry (from_vertex(h), to_vertex(h)) of each halfedge h within the value array.
+	size_t m_NVertices{ 0 }; //>! the number of vertices of the mesh for which the pattern was built.
+	size_t m_PatternVersion{ 0 }; //>! incremented with each pattern rebuild.
+	bool m_IsPatternValid{ false }; //>! if false, the pattern is rebuilt during the next call to UpdatePattern.
+};
+
 /**
  * \brief Computes angle-based tangential update velocity for a mesh vertex with a given weight.
  * \param mesh       a surface mesh to whom the vertex belongs.
@@ -69,6 +128,20 @@ enum class [[nodiscard]] MeshLaplacian
 	Barycentric = 1 //>! the finite volume for mesh Laplacian is generated from face barycenters.
 };
 
+/**
+ * \brief An enumerator for the renumbering of mesh vertices (and faces) after topology adjustments.
+ * \enum MeshReorderingType
+ */
+enum class [[nodiscard]] MeshReorderingType
+{
+	None = 0, //>! vertices keep the order left by remeshing.
+	Morton = 1, //>! vertices are sorted along the Morton (Z-order) curve of their positions.
+	ReverseCuthillMcKee = 2 //>! vertices are ordered by the reverse Cuthill-McKee algorithm (reduces the bandwidth of the system matrix).
+};
+
+/// \brief Returns the name of a MeshReorderingType value.
+[[nodiscard]] std::string MeshReorderingTypeToString(const MeshReorderingType& type);
+
 /// \brief a list of triangle metrics to be computed.
 using TriangleMetrics = std::vector<std::string>;
 
@@ -127,6 +200,10 @@ struct MeshTopologySettings
 	float PrincipalCurvatureFactor{ 2.0f }; //>! vertices with |Kmax| > \p principalCurvatureFactor * |Kmin| are marked as feature.
 	float CriticalMeanCurvatureAngle{ 1.0f * static_cast<float>(M_PI_2) }; //>! vertices with curvature angles smaller than this value are feature vertices. 
 	bool ExcludeEdgesWithoutBothFeaturePts{ false }; //>! if true, edges with only one vertex detected as feature will not be marked as feature.
+
+	bool UseLocalRemeshing{ false }; //>! if true, only low quality vertices and their LocalRemeshingRings-ring are remeshed (see GetLowQualityRegion).
+	unsigned int LocalRemeshingRings{ 2 }; //>! the number of rings around low quality vertices included in local remeshing.
+	float MaxLocalRemeshingFraction{ 0.3f }; //>! if the low quality region contains a larger fraction of mesh vertices, the whole mesh is remeshed.
 };
 
 /**
@@ -146,6 +223,24 @@ struct MeshTopologySettings
 /// \brief Evaluates whether remeshing is necessary from the condition number metric for equilateral triangles that do not have a feature vertex.
 [[nodiscard]] bool IsNonFeatureRemeshingNecessary(const pmp::SurfaceMesh& mesh);
 
+/**
+ * \brief Collects the vertices whose condition number metric for equilateral triangles lies outside of the range accepted
+ *        by IsRemeshingNecessary, together with their k-ring.
+ * \param mesh      mesh with "v:equilateralJacobianCondition" vertex property.
+ * \param nRings    the number of rings around low quality vertices added to the region.
+ * \return vertices of the region (empty if there are no low quality vertices or the property is missing).
+ */
+[[nodiscard]] std::vector<pmp::Vertex> GetLowQualityRegion(const pmp::SurfaceMesh& mesh, const unsigned int& nRings);
+
+/**
+ * \brief Renumbers the vertices and faces of a mesh without garbage (e.g.: after remeshing) for memory locality
+ *        of neighboring vertices, and for a smaller bandwidth of the system matrix. Faces are ordered by their
+ *        smallest new vertex index. All mesh properties are permuted consistently (see pmp::SurfaceMesh::reorder).
+ * \param mesh      mesh to be reordered.
+ * \param type      reordering type (nothing happens for MeshReorderingType::None).
+ */
+void ReorderSurfaceMesh(pmp::SurfaceMesh& mesh, const MeshReorderingType& type);
+
 /// \brief A (one-time) evaluation whether the distance to target reaches a lower bound.
 ///	\param distancePerVertexValues    a vector of distance values on the evolving surface.
 ///	\return true if the conditions for feature detection are satisfied.
@@ -13,15 +13,13 @@
 
 #include "ConversionUtils.h"
 #include "geometry/GeometryConversionUtils.h"
+#include "EvolutionEngine.h"
 
 // ================================================================================================
 
 /// \brief if true individual steps of surface evolution will be printed out into a given stream.
 #define REPORT_EVOL_STEPS true // Note: may affect performance
 
-/// \brief if true, upon computing trilinear system solution, new vertices are verified for belonging in the field bounds.
-#define VERIFY_SOLUTION_WITHIN_BOUNDS false // Note: useful for detecting numerical explosions of the solution.
-
 /// \brief repairs infinities and nan values of the input grid.
 #define REPAIR_INPUT_GRID true //Note: very useful! You never know what field we use! Infinities and nans lead to the Eigen::NoConvergence error code whose cause is difficult to find!
 
@@ -64,12 +62,6 @@ IsoSurfaceEvolver::IsoSurfaceEvolver(const Geometry::ScalarGrid& field, const fl
 #if REPAIR_INPUT_GRID
 	Geometry::RepairScalarGrid(*m_Field); // repair needed in case of invalid cell values.
 #endif
-	m_ImplicitLaplacianFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::laplace_implicit_barycentric : pmp::laplace_implicit_voronoi);
-	m_LaplacianAreaFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::voronoi_area_barycentric : pmp::voronoi_area);
 }
 
 // ================================================================================================
@@ -165,296 +157,265 @@ double IsoSurfaceEvolver::AdvectionDistanceWeightFunction(const double& distance
 
 void IsoSurfaceEvolver::ExportSurface(const unsigned int& tId, const bool& isResult, const bool& transformToOriginal) const
 {
+	m_DerivedProperties.UpdateAll(*m_EvolvingSurface);
 	const std::string connectingName = (isResult ? "_Result" : "_Evol_" + std::to_string(tId));
+	if (m_AsyncExporter)
+	{
+		const std::optional<pmp::mat4> transform = (transformToOriginal ? std::optional<pmp::mat4>(m_TransformToOriginal) : std::nullopt);
+		m_AsyncExporter->Submit(*m_EvolvingSurface, m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, transform, m_OutputMeshIOFlags);
+		return;
+	}
 	if (!transformToOriginal)
 	{
-		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 		return;
 	}
 	auto exportedSurface = *m_EvolvingSurface;
 	exportedSurface *= m_TransformToOriginal;
-	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 }
 
-void IsoSurfaceEvolver::ComputeTriangleMetrics() const
+// ================================================================================================
+// .................................. EvolutionEngine policies ....................................
+
+/// \brief Validates the input field and generates the stabilized starting iso-surface.
+class IsoSurfaceEvolver::InitialSurfacePolicy
 {
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
+public:
+	explicit InitialSurfacePolicy(IsoSurfaceEvolver& evolver) : m_Evolver(evolver) {}
+
+	pmp::SurfaceMesh& Prepare()
 	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
+		if (!m_Evolver.m_Field)
+			throw std::invalid_argument("IsoSurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
+		if (!m_Evolver.m_Field->IsValid())
+			throw std::invalid_argument("IsoSurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
 
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
+		m_Evolver.Preprocess();
 
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "IsoSurfaceEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
+		if (!m_Evolver.m_EvolvingSurface)
+			throw std::invalid_argument("IsoSurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+		return *m_Evolver.m_EvolvingSurface;
 	}
-}
 
-// ================================================================================================
+	[[nodiscard]] pmp::BoundingBox SolutionBounds() const { return m_Evolver.m_Field->Box(); }
 
-void IsoSurfaceEvolver::Evolve()
-{
-	if (!m_Field)
-		throw std::invalid_argument("IsoSurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
-	if (!m_Field->IsValid())
-		throw std::invalid_argument("IsoSurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetMatrix("TransformToOriginal", m_Evolver.m_TransformToOriginal);
+		checkpoint.SetValue("ScalingFactor", static_cast<double>(m_Evolver.m_ScalingFactor));
+	}
 
-	const auto& field = *m_Field;
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_Evolver.m_TransformToOriginal = checkpoint.GetMatrix("TransformToOriginal");
+		m_Evolver.m_ScalingFactor = static_cast<pmp::Scalar>(checkpoint.GetValue("ScalingFactor"));
+	}
 
-	Preprocess();
+private:
+	IsoSurfaceEvolver& m_Evolver;
+};
 
-	if (!m_EvolvingSurface)
-		throw std::invalid_argument("IsoSurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+/// \brief Evaluates distance-weighted advection-diffusion rows of the evolution system.
+class IsoSurfaceEvolver::WeightPolicy
+{
+public:
+	explicit WeightPolicy(const IsoSurfaceEvolver& evolver) : m_Evolver(evolver) {}
 
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-	const auto& fieldBox = field.Box();
-#endif
-	const auto fieldNegGradient = Geometry::ComputeNormalizedNegativeGradient(field);
+	void Initialize(pmp::SurfaceMesh& mesh)
+	{
+		m_FieldNegGradient = std::make_shared<Geometry::VectorGrid>(Geometry::ComputeNormalizedNegativeGradient(*m_Evolver.m_Field));
+		m_VDistance = mesh.vertex_property<pmp::Scalar>(vertexDistancePropertyKey); // vertex property for distance field values (restored if resuming).
+		m_VFeature = mesh.vertex_property<bool>(vertexFeaturePropertyKey, false);
+	}
 
-	const auto& NSteps = m_EvolSettings.NSteps;
-	const auto& tStep = m_EvolSettings.TimeStep;
+	void PrepareStep(const pmp::SurfaceMesh& mesh)
+	{
+		m_VNormals = mesh.get_vertex_property<pmp::Point>(vertexNormalPropertyKey);
+	}
 
-	// ........ evaluate edge lengths for remeshing ....................
-	const float cellSize = m_EvolSettings.ReSampledGridCellSize * m_ScalingFactor;
-	float minEdgeLength = static_cast<float>(M_SQRT2) * cellSize * m_EvolSettings.TopoParams.MinEdgeMultiplier;
-	float maxEdgeLength = 4.0f * minEdgeLength;
-	float approxError = 0.25f * (minEdgeLength + maxEdgeLength);
-	//auto approxError = 2.0f * minEdgeLength;
-#if REPORT_EVOL_STEPS
-	std::cout << "minEdgeLength for remeshing: " << minEdgeLength << "\n";
-#endif
-	// .................................................................
+	[[nodiscard]] EvolutionSystemRow EvaluateRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& tStep) const
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto vPosToUpdate = mesh.position(v);
+
+		if ((settings.IdentityForBoundaryVertices && mesh.is_boundary(v)) ||
+			(settings.IdentityForFeatureVertices && m_VFeature[v]))
+		{
+			// freeze boundary/feature vertices
+			const Eigen::Vector3d vertexRhs = vPosToUpdate;
+			return { vertexRhs, 0.0, true };
+		}
 
-	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
-	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
-	Eigen::MatrixXd sysRhs(NVertices, 3);
-	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
-	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
+		const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, *m_FieldNegGradient);
+		const auto vNormal = m_VNormals[v]; // vertex unit normal
 
-	// property container for surface vertex normals
-	pmp::VertexProperty<pmp::Point> vNormalsProp{};
+		const double epsilonCtrlWeight = m_Evolver.LaplacianDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel);
+		const double etaCtrlWeight = m_Evolver.AdvectionDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
 
-	// ----------- System fill function --------------------------------
-	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
-	{
-		for (const auto v : m_EvolvingSurface->vertices())
+		Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
+		const float tanRedistWeight = settings.TangentialVelocityWeight * epsilonCtrlWeight;
+		if (tanRedistWeight > 0.0f)
 		{
-			const auto vPosToUpdate = m_EvolvingSurface->position(v);
-
-			if ((m_EvolSettings.IdentityForBoundaryVertices && m_EvolvingSurface->is_boundary(v)) ||
-				(m_EvolSettings.IdentityForFeatureVertices && vFeature[v]))
-			{
-				// freeze boundary/feature vertices
-				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
-			}
-
-			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
-			const auto vNormal = vNormalsProp[v]; // vertex unit normal
-
-			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
-			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
-
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
-			const float tanRedistWeight = m_EvolSettings.TangentialVelocityWeight * epsilonCtrlWeight;
-			if (tanRedistWeight > 0.0f)
-			{
-				// compute tangential velocity
-				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
-			}
-
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
-
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
+			// compute tangential velocity
+			const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(mesh, v, vNormal, tanRedistWeight);
+			vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 		}
-	};
-	// -----------------------------------------------------------------
+		return { vertexRhs, epsilonCtrlWeight, false };
+	}
 
-	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
-	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
-	std::ofstream fileOStreamMaxes(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMaxes.txt");
-	std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-	fileOStreamMins << coVolStats.Min << ", ";
-	fileOStreamMeans << coVolStats.Mean << ", ";
-	fileOStreamMaxes << coVolStats.Max << ", ";
-#endif
-	// set initial surface vertex properties
-	for (const auto v : m_EvolvingSurface->vertices())
+	void UpdateVertexProperties(pmp::SurfaceMesh& mesh)
 	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+		const auto& field = *m_Evolver.m_Field;
+		for (const auto v : mesh.vertices())
+		{
+			const auto vPos = mesh.position(v);
+			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
+			m_VDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+		}
 	}
-	Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-	Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface);
-	ComputeTriangleMetrics();
-	if (m_EvolSettings.ExportSurfacePerTimeStep)
-		ExportSurface(0);
-
-	// -------------------------------------------------------------------------------------------------------------
-	// ........................................ main loop ..........................................................
-	// -------------------------------------------------------------------------------------------------------------
-	for (unsigned int ti = 1; ti <= NSteps; ti++)
+
+private:
+	const IsoSurfaceEvolver& m_Evolver;
+	std::shared_ptr<Geometry::VectorGrid> m_FieldNegGradient{ nullptr }; //>! normalized negative gradient of the distance field.
+	pmp::VertexProperty<pmp::Scalar> m_VDistance{};
+	pmp::VertexProperty<bool> m_VFeature{};
+	pmp::VertexProperty<pmp::Point> m_VNormals{};
+};
+
+/// \brief Performs feature detection and remeshing in each time step with a stepwise decay of remeshing lengths.
+class IsoSurfaceEvolver::TopologyPolicy : public DerivedPropertiesTopologyPolicy
+{
+public:
+	explicit TopologyPolicy(IsoSurfaceEvolver& evolver)
+		: DerivedPropertiesTopologyPolicy(evolver.m_DerivedProperties), m_Evolver(evolver) {}
+
+	void Initialize(const pmp::SurfaceMesh& /*mesh*/)
 	{
+		// ........ derived properties (computed only when consumed) .......
+		auto& properties = m_Evolver.m_DerivedProperties;
+		properties.Clear();
+		properties.Register("dihedralAngles", MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {}, Geometry::ComputeEdgeDihedralAngles);
+		properties.Register("curvatures", MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {}, [](pmp::SurfaceMesh& m) { Geometry::ComputeVertexCurvaturesAndRelatedProperties(m); });
+		RegisterTriangleMetrics(properties, m_Evolver.m_EvolSettings.TriMetrics);
+
+		// ........ evaluate edge lengths for remeshing ....................
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const float cellSize = settings.ReSampledGridCellSize * m_Evolver.m_ScalingFactor;
+		m_MinEdgeLength = static_cast<float>(M_SQRT2) * cellSize * settings.TopoParams.MinEdgeMultiplier;
+		m_MaxEdgeLength = 4.0f * m_MinEdgeLength;
+		m_ApproxError = 0.25f * (m_MinEdgeLength + m_MaxEdgeLength);
+		//m_ApproxError = 2.0f * m_MinEdgeLength;
 #if REPORT_EVOL_STEPS
-		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << tStep * ti << "/" << tStep * NSteps
-			<< ", Procedure Name: " << m_EvolSettings.ProcedureName << "\n";
-		std::cout << "pmp::Normals::compute_vertex_normals ... ";
-#endif
-		pmp::Normals::compute_vertex_normals(*m_EvolvingSurface);
-		vNormalsProp = m_EvolvingSurface->vertex_property<pmp::Point>("v:normal");
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "fillMatrixAndRHSTriplesFromMesh for " << NVertices << " vertices ... ";
+		std::cout << "minEdgeLength for remeshing: " << m_MinEdgeLength << "\n";
 #endif
+	}
 
-		// prepare matrix & rhs
-		fillMatrixAndRHSTriplesFromMesh();
+	bool Apply(pmp::SurfaceMesh& mesh, const unsigned int& ti, double& /*tStep*/)
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto& NSteps = settings.NSteps;
+		if (!settings.DoRemeshing /* || ti <= NSteps * settings.TopoParams.RemeshingStartTimeFactor*/)
+			return false;
 
+		// remeshing
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Solving linear system ... ";
+		std::cout << "Detecting Features ...";
 #endif
-		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
-		Eigen::MatrixXd x = solver.solve(sysRhs);
-		if (solver.info() != Eigen::Success)
+		if (settings.DoFeatureDetection && ti > NSteps * settings.TopoParams.FeatureDetectionStartTimeFactor)
 		{
-			const std::string msg = "\nIsoSurfaceEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
-				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.info()) + "\n";
-			std::cerr << msg;
-			throw std::runtime_error(msg);
-		}
+			const ScopedPhaseTrace featureTrace("FeatureDetection");
+			const auto nEdges = m_Evolver.DetectFeatures(settings.TopoParams.FeatureType);
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Updating vertex positions ... ";
-#endif
-
-		// update vertex positions & verify mesh within bounds
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		size_t nVertsOutOfBounds = 0;
-#endif
-		for (unsigned int i = 0; i < NVertices; i++)
-		{
-			const auto newPos = x.row(i);
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-			if (!fieldBox.Contains(newPos))
-			{
-				if (nVertsOutOfBounds == 0) std::cerr << "\n";
-				std::cerr << "IsoSurfaceEvolver::Evolve: vertex " << i << " out of field bounds!\n";
-				nVertsOutOfBounds++;
-			}
+			std::cout << "done. " << nEdges << " feature edges detected.\n";
 #endif
-			m_EvolvingSurface->position(pmp::Vertex(i)) = x.row(i);
-		}
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		if ((m_EvolSettings.DoRemeshing && nVertsOutOfBounds > static_cast<double>(NVertices) * m_EvolSettings.MaxFractionOfVerticesOutOfBounds) ||
-			(!m_EvolSettings.DoRemeshing && nVertsOutOfBounds > 0))
-		{
-			std::cerr << "IsoSurfaceEvolver::Evolve: found " << nVertsOutOfBounds << " vertices out of bounds! Terminating!\n";
-			break;
 		}
+#if REPORT_EVOL_STEPS
+		std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << m_MinEdgeLength << ", maxEdgeLength: " << m_MaxEdgeLength << ") ... ";
 #endif
+		//std::cout << "pmp::Remeshing::uniform_remeshing(targetEdgeLength: " << targetEdgeLength << ") ... ";
+		const ScopedPhaseTrace remeshingTrace("Remeshing");
+		pmp::Remeshing remeshing(mesh, m_RemeshingReference);
+		remeshing.adaptive_remeshing({
+			m_MinEdgeLength, m_MaxEdgeLength, m_ApproxError,
+			settings.TopoParams.NRemeshingIters,
+			settings.TopoParams.NTanSmoothingIters,
+			settings.TopoParams.UseBackProjection });
+		//remeshing.uniform_remeshing(targetEdgeLength);
 #if REPORT_EVOL_STEPS
 		std::cout << "done\n";
 #endif
-
-		if (m_EvolSettings.DoRemeshing /* && ti > NSteps * m_EvolSettings.TopoParams.RemeshingStartTimeFactor*/)
+		if (ti % settings.TopoParams.StepStrideForEdgeDecay == 0 &&
+			ti > NSteps * settings.TopoParams.RemeshingSizeDecayStartTimeFactor)
 		{
-			// remeshing
-#if REPORT_EVOL_STEPS
-			std::cout << "Detecting Features ...";
-#endif
-			if (m_EvolSettings.DoFeatureDetection && ti > NSteps * m_EvolSettings.TopoParams.FeatureDetectionStartTimeFactor)
-			{
-				const auto nEdges = DetectFeatures(m_EvolSettings.TopoParams.FeatureType);
-#if REPORT_EVOL_STEPS
-				std::cout << "done. " << nEdges << " feature edges detected.\n";
-#endif
-			}
-#if REPORT_EVOL_STEPS
-			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << minEdgeLength << ", maxEdgeLength: " << maxEdgeLength << ") ... ";
-#endif
-			//std::cout << "pmp::Remeshing::uniform_remeshing(targetEdgeLength: " << targetEdgeLength << ") ... ";
-			pmp::Remeshing remeshing(*m_EvolvingSurface);
-			remeshing.adaptive_remeshing({
-				minEdgeLength, maxEdgeLength, approxError,
-				m_EvolSettings.TopoParams.NRemeshingIters,
-				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
-			//remeshing.uniform_remeshing(targetEdgeLength);
-#if REPORT_EVOL_STEPS
-			std::cout << "done\n";
-#endif
-			if (ti % m_EvolSettings.TopoParams.StepStrideForEdgeDecay == 0 &&
-				ti > NSteps * m_EvolSettings.TopoParams.RemeshingSizeDecayStartTimeFactor)
-			{
-				// shorter edges are needed for features close to the target.
-				minEdgeLength *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-				maxEdgeLength *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-				//approxError *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-			}
+			// shorter edges are needed for features close to the target.
+			m_MinEdgeLength *= settings.TopoParams.EdgeLengthDecayFactor;
+			m_MaxEdgeLength *= settings.TopoParams.EdgeLengthDecayFactor;
+			//m_ApproxError *= settings.TopoParams.EdgeLengthDecayFactor;
 		}
+		m_Evolver.m_DerivedProperties.Invalidate(MeshPropertyInput::Connectivity);
+		return true;
+	}
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-		fileOStreamMins << coVolStats.Min << (ti < NSteps ? ", " : "");
-		fileOStreamMeans << coVolStats.Mean << (ti < NSteps ? ", " : "");
-		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
-#endif
-		// set surface vertex properties
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-		}
-		Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-		Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface);
-		ComputeTriangleMetrics();
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetValue("MinEdgeLength", static_cast<double>(m_MinEdgeLength));
+		checkpoint.SetValue("MaxEdgeLength", static_cast<double>(m_MaxEdgeLength));
+		checkpoint.SetValue("ApproxError", static_cast<double>(m_ApproxError));
+	}
 
-		if (m_EvolSettings.ExportSurfacePerTimeStep)
-			ExportSurface(ti);
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_MinEdgeLength = static_cast<float>(checkpoint.GetValue("MinEdgeLength"));
+		m_MaxEdgeLength = static_cast<float>(checkpoint.GetValue("MaxEdgeLength"));
+		m_ApproxError = static_cast<float>(checkpoint.GetValue("ApproxError"));
+	}
 
-		// update linear system dims for next time step:
-		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
-		{
-			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
-			sysRhs = Eigen::MatrixXd(NVertices, 3);
-		}
+private:
+	IsoSurfaceEvolver& m_Evolver;
+	std::shared_ptr<pmp::RemeshingReference> m_RemeshingReference{ std::make_shared<pmp::RemeshingReference>() }; //>! back-projection reference reused by subsequent remeshing calls.
+	float m_MinEdgeLength{ 0.0f };
+	float m_MaxEdgeLength{ 0.0f };
+	float m_ApproxError{ 0.0f };
+};
 
-#if REPORT_EVOL_STEPS
-		std::cout << ">>> Time step " << ti << " finished.\n";
-		std::cout << "----------------------------------------------------------------------\n";
-#endif
+// ================================================================================================
 
-	} // end main loop
-	// -------------------------------------------------------------------------------------------------------------
+void IsoSurfaceEvolver::RunEvolution(const EvolutionCheckpoint* checkpoint)
+{
+	InitialSurfacePolicy initialSurface(*this);
+	WeightPolicy weights(*this);
+	TopologyPolicy topology(*this);
 
-	if (m_EvolSettings.ExportResultSurface)
-		ExportSurface(NSteps, true);
+	if (m_EvolSettings.ExportSurfacePerTimeStep && m_EvolSettings.AsyncExport.Enabled)
+		m_AsyncExporter = std::make_shared<AsyncSurfaceExporter>(m_EvolSettings.AsyncExport);
 
-#if REPORT_EVOL_STEPS
-	fileOStreamMins.close();
-	fileOStreamMaxes.close();
-	fileOStreamMeans.close();
-#endif
+	DispatchLaplacianPolicy(m_EvolSettings.LaplacianType, [&](auto laplacianPolicy)
+	{
+		using LaplacianPolicy = decltype(laplacianPolicy);
+		EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy> engine(
+			GetEvolutionEngineSettings(m_EvolSettings), initialSurface, weights, topology);
+		engine.Run([this](const unsigned int& tId, const bool& isResult) { ExportSurface(tId, isResult); }, checkpoint);
+		m_PhaseStatistics = engine.GetPhaseStatistics();
+		m_ConvergenceReport = engine.GetConvergenceReport();
+	});
+
+	if (m_AsyncExporter)
+	{
+		m_AsyncExporter->Flush(); // all exported files need to be complete when Evolve returns.
+		m_AsyncExporter.reset();
+	}
+}
+
+void IsoSurfaceEvolver::Evolve()
+{
+	RunEvolution(nullptr);
+}
+
+void IsoSurfaceEvolver::Resume(const std::string& checkpointPath)
+{
+	const auto checkpoint = ReadCheckpoint(checkpointPath);
+	RunEvolution(&checkpoint);
 }
 
 void ReportInput(const IsoSurfaceEvolutionSettings& evolSettings, std::ostream& os)
@@ -476,6 +437,13 @@ void ReportInput(const IsoSurfaceEvolutionSettings& evolSettings, std::ostream&
 	os << "......................................................................\n";
 	os << "Export Surface per Time Step: " << (evolSettings.ExportSurfacePerTimeStep ? "true" : "false") << ",\n";
 	os << "Output Path: " << evolSettings.OutputPath << ",\n";
+	os << "Linear Solver: " << LinearSolverTypeToString(evolSettings.LinearSolverParams.Type) << " (preconditioner reused for " << evolSettings.LinearSolverParams.PreconditionerReuseSteps << " steps),\n";
+	os << "Adaptive Time Stepping: " << (evolSettings.TimeStepControl.Enabled ? "true" : "false") << ",\n";
+	os << "Convergence Criterion: " << (evolSettings.Convergence.Enabled ? ConvergenceMeasureToString(evolSettings.Convergence.Measure) + " < " + std::to_string(evolSettings.Convergence.Tolerance) : std::string("none")) << ",\n";
+	os << "Checkpoints: " << (evolSettings.Checkpoint.Enabled ? "every " + std::to_string(evolSettings.Checkpoint.StepStride) + " steps" : std::string("none")) << ",\n";
+	os << "Phase Tracing: " << (evolSettings.Tracing.Enabled ? "true" : "false") << ",\n";
+	os << "Self-Intersection Detection: " << (evolSettings.SelfIntersections.Enabled ? "every " + std::to_string(evolSettings.SelfIntersections.StepStride) + " steps" + (evolSettings.SelfIntersections.TerminateOnDetection ? " (terminating on detection)" : "") : std::string("none")) << ",\n";
+	os << "Mesh Reordering: " << MeshReorderingTypeToString(evolSettings.MeshReordering) << ",\n";
 	os << "Do Remeshing: " << (evolSettings.DoRemeshing ? "true" : "false") << ",\n";
 	os << "Do Feature Detection: " << (evolSettings.DoFeatureDetection ? "true" : "false") << ",\n";
 	os << "----------------------------------------------------------------------\n";
@@ -5,6 +5,8 @@
 #include "SheetMembraneEvolver.h"
 #include "ConvexHullEvolver.h"
 #include "IcoSphereEvolver.h"
+#include "EvolutionJobScheduler.h"
+#include "SurfaceEvolutionSweep.h"
 #include "SphereTest.h"
 
 #include "geometry/GridUtil.h"
@@ -40,6 +42,7 @@ const std::string dataOutPath = fsDataOutPath.string();
 constexpr bool performSDFTests = false;
 constexpr bool performSphereTest = false;
 constexpr bool performEvolverTests = false;
+constexpr bool performEvolverParameterSweep = false;
 constexpr bool performOldArmadilloLSWTest = false;
 constexpr bool performIsosurfaceEvolverTests = false;
 constexpr bool performSheetEvolverTest = false;
@@ -68,6 +71,7 @@ constexpr bool performConvexHullTests = false;
 constexpr bool performConvexHullRemeshingTests = false;
 constexpr bool performConvexHullEvolverTests = false;
 constexpr bool performIcoSphereEvolverTests = false;
+constexpr bool performMeshReorderingBenchmark = false;
 
 int main()
 {
@@ -227,6 +231,9 @@ int main()
 			{ "spot", 0.05 }
 		};
 
+		// evolutions run concurrently (one core per job) while the next distance fields are computed.
+		EvolutionJobScheduler scheduler({});
+
 		for (const auto& name : meshNames)
 		{
 			pmp::SurfaceMesh mesh;
@@ -284,18 +291,73 @@ int main()
 				true
 			};
 			ReportInput(seSettings, std::cout);
-			SurfaceEvolver evolver(sdf, volExpansionFactor, seSettings);
+			scheduler.SubmitSurfaceEvolution(std::make_shared<const Geometry::ScalarGrid>(sdf), volExpansionFactor, seSettings);
+		}
 
-			try
-			{
-				evolver.Evolve();
-			}
-			catch (...)
+		ReportJobResults(scheduler.WaitAll(), std::cout);
+	} // endif performEvolverTests
+
+	if (performEvolverParameterSweep)
+	{
+		const std::string name = "bunny";
+		constexpr unsigned int nVoxelsPerMinDimension = 40;
+		pmp::SurfaceMesh mesh;
+		mesh.read(dataDirPath + name + ".obj");
+		const auto meshBBox = mesh.bounds();
+		const auto meshBBoxSize = meshBBox.max() - meshBBox.min();
+		const float minSize = std::min({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+		const float maxSize = std::max({ meshBBoxSize[0], meshBBoxSize[1], meshBBoxSize[2] });
+		const float cellSize = minSize / nVoxelsPerMinDimension;
+		constexpr float volExpansionFactor = 1.0f;
+		const SDF::DistanceFieldSettings sdfSettings{
+			cellSize,
+				volExpansionFactor,
+				Geometry::DEFAULT_SCALAR_GRID_INIT_VAL,
+				SDF::KDTreeSplitType::Center,
+				SDF::SignComputation::VoxelFloodFill,
+				SDF::BlurPostprocessingType::None,
+				SDF::PreprocessingType::Octree
+		};
+		const Geometry::PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
+		const auto sdf = SDF::DistanceFieldGenerator::Generate(meshAdapter, sdfSettings);
+
+		const auto& sdfBox = sdf.Box();
+		const auto sdfBoxSize = sdfBox.max() - sdfBox.min();
+		const auto sdfBoxMaxDim = std::max<double>({ sdfBoxSize[0], sdfBoxSize[1], sdfBoxSize[2] });
+
+		const SurfaceEvolutionSettings baseSettings{
+			name + "_Sweep",
+			80,
+			0.0025,
+			sqrt(3.0) / 2.0 * static_cast<double>(cellSize),
+			3, // IcoSphereSubdivisionLevel
+			PreComputeAdvectionDiffusionParams(0.5 * sdfBoxMaxDim, minSize),
+			{},
+			minSize, maxSize,
+			meshBBox.center(),
+			false, true,
+			dataOutPath,
+			MeshLaplacian::Voronoi,
+			{"minAngle", "maxAngle", "jacobianConditionNumber", "equilateralJacobianCondition"},
+			0.05f,
+			true
+		};
+
+		// MCF and advection multipliers scaled by {0.5, 1, 2}. The field and its gradient are prepared only once.
+		std::vector<AdvectionDiffusionParameters> adParamsVariants{};
+		for (const double mcfScale : { 0.5, 1.0, 2.0 })
+		{
+			for (const double advectionScale : { 0.5, 1.0, 2.0 })
 			{
-				std::cerr << "> > > > > > > > > > > > > > SurfaceEvolver::Evolve has thrown an exception! Continue... < < < < < \n";
+				auto adParams = baseSettings.ADParams;
+				adParams.MCFMultiplier *= mcfScale;
+				adParams.AdvectionMultiplier *= advectionScale;
+				adParamsVariants.push_back(adParams);
 			}
 		}
-	} // endif performEvolverTests
+		const auto variants = CreateSurfaceEvolutionVariants(baseSettings, adParamsVariants, {});
+		ReportJobResults(RunSurfaceEvolutionSweep(sdf, volExpansionFactor, variants, {}), std::cout);
+	} // endif performEvolverParameterSweep
 
 	if (performOldArmadilloLSWTest)
 	{
@@ -2080,4 +2142,78 @@ int main()
 			}
 		}
 	} // endif performIcoSphereEvolverTests
+
+	if (performMeshReorderingBenchmark)
+	{
+		const std::vector<std::string> benchmarkMeshNames{
+			"bunny",
+			"armadillo"
+		};
+		constexpr unsigned int nRuns = 10;
+		constexpr double tStep = 0.01;
+		const auto secondsSince = [](const std::chrono::high_resolution_clock::time_point& start)
+		{
+			const std::chrono::duration<double> timeDiff = std::chrono::high_resolution_clock::now() - start;
+			return timeDiff.count();
+		};
+
+		for (const auto& name : benchmarkMeshNames)
+		{
+			// remeshing leaves vertices in the order of splits and collapses.
+			pmp::SurfaceMesh remeshedMesh;
+			remeshedMesh.read(dataDirPath + name + ".obj");
+			const auto [lengthMin, lengthMean, lengthMax] = Geometry::ComputeEdgeLengthMinAverageAndMax(remeshedMesh);
+			pmp::Remeshing remeshing(remeshedMesh);
+			remeshing.adaptive_remeshing({
+				0.5f * lengthMean, 2.0f * lengthMean, 0.25f * lengthMean,
+				2, 5, true });
+			std::cout << "-------------------------------------------------------------\n";
+			std::cout << name << " remeshed: " << remeshedMesh.n_vertices() << " vertices, " << remeshedMesh.n_faces() << " faces.\n";
+
+			for (const auto& type : { MeshReorderingType::None, MeshReorderingType::Morton, MeshReorderingType::ReverseCuthillMcKee })
+			{
+				auto mesh = remeshedMesh;
+				const auto startReorder = std::chrono::high_resolution_clock::now();
+				ReorderSurfaceMesh(mesh, type);
+				const double reorderTime = secondsSince(startReorder);
+
+				size_t bandwidth = 0;
+				for (const auto e : mesh.edges())
+				{
+					const auto i0 = mesh.vertex(e, 0).idx();
+					const auto i1 = mesh.vertex(e, 1).idx();
+					bandwidth = std::max<size_t>(bandwidth, i0 > i1 ? i0 - i1 : i1 - i0);
+				}
+
+				const Eigen::MatrixXd rhs = GetVertexPositionMatrix(mesh);
+				Eigen::MatrixXd x(rhs.rows(), rhs.cols());
+				CachedSystemMatrix sysMat;
+				pmp::ImplicitLaplaceWeights laplaceWeights;
+				double assemblyTime = 0.0, solveTime = 0.0;
+				unsigned int nIterations = 0;
+				for (unsigned int run = 0; run < nRuns; run++)
+				{
+					// the same system as in EvolutionEngine::FillSystem with unit weights (i.e.: mean curvature flow).
+					const auto startAssembly = std::chrono::high_resolution_clock::now();
+					sysMat.InvalidatePattern();
+					sysMat.UpdatePattern(mesh);
+					pmp::laplace_implicit_weights_voronoi(mesh, laplaceWeights);
+#pragma omp parallel for schedule(static)
+					for (int i = 0; i < static_cast<int>(mesh.vertices_size()); i++)
+					{
+						const pmp::Vertex v(i);
+						sysMat.SetRow(mesh, v, 1.0 + tStep * static_cast<double>(laplaceWeights.vertexWeightSums[i]), -1.0 * tStep, laplaceWeights);
+					}
+					assemblyTime += secondsSince(startAssembly);
+
+					const auto solver = CreateEvolutionSystemSolver(LinearSolverSettings{});
+					const auto report = solver->Solve(sysMat, rhs, rhs, x);
+					solveTime += report.SolveTimeSeconds;
+					nIterations = report.NIterations;
+				}
+				std::cout << MeshReorderingTypeToString(type) << ": reordering: " << reorderTime << " s, bandwidth: " << bandwidth
+					<< ", assembly: " << assemblyTime / nRuns << " s, solve: " << solveTime / nRuns << " s (" << nIterations << " iterations).\n";
+			}
+		}
+	} // endif performMeshReorderingBenchmark
 }
@@ -0,0 +1,28 @@
+#include "SelfIntersectionMonitor.h"
+
+#include <algorithm>
+
+SelfIntersectionMonitor::SelfIntersectionMonitor(const SelfIntersectionSettings& settings)
+	: m_Settings(settings)
+{
+}
+
+bool SelfIntersectionMonitor::IsDue(const unsigned int& ti) const
+{
+	return m_Settings.Enabled && ti % std::max(m_Settings.StepStride, 1u) == 0;
+}
+
+size_t SelfIntersectionMonitor::Detect(pmp::SurfaceMesh& mesh)
+{
+	if (m_BVH && m_BVH->IsCompatible(mesh))
+	{
+		m_BVH->Refit(mesh);
+		m_NRefits++;
+	}
+	else
+	{
+		m_BVH = std::make_unique<Geometry::SurfaceMeshBVH>(mesh);
+		m_NRebuilds++;
+	}
+	return Geometry::CountSelfIntersectingFaces(mesh, *m_BVH, true);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+
+#include "geometry/SurfaceMeshBVH.h"
+
+#include <memory>
+
+/**
+ * \brief A wrapper for settings of self-intersection detection during the evolution.
+ * \struct SelfIntersectionSettings
+ */
+struct SelfIntersectionSettings
+{
+	bool Enabled{ false }; //>! if true, self-intersecting faces of the evolving surface are detected and marked by the "f:isSelfIntersecting" face property.
+	unsigned int StepStride{ 1 }; //>! the number of time steps between two detections.
+	bool TerminateOnDetection{ false }; //>! if true, the evolution stops (and exports its result) at the first time step with a self-intersection.
+};
+
+/**
+ * \brief Detects self-intersections of the evolving surface after time steps.
+ * \class SelfIntersectionMonitor
+ *
+ * A Geometry::SurfaceMeshBVH of the evolving surface is kept between detections. As long as the connectivity of
+ * the surface is unchanged (i.e.: between remeshings), the hierarchy is only refitted to the new vertex positions,
+ * so a detection costs an O(n) refit and a parallel self-collision traversal instead of a tree construction.
+ */
+class SelfIntersectionMonitor
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param settings    self-intersection detection settings.
+	 */
+	explicit SelfIntersectionMonitor(const SelfIntersectionSettings& settings);
+
+	/// \brief Returns true if a detection is due after time step ti.
+	[[nodiscard]] bool IsDue(const unsigned int& ti) const;
+
+	/**
+	 * \brief Detects self-intersecting faces of the evolving surface, refitting the hierarchy if the connectivity
+	 *        of mesh is unchanged since the last detection and rebuilding it otherwise.
+	 * \param mesh    evolving surface (a triangle mesh).
+	 * \return the number of self-intersecting faces (marked by the "f:isSelfIntersecting" face property).
+	 */
+	size_t Detect(pmp::SurfaceMesh& mesh);
+
+	/// \brief the number of hierarchy (re)builds.
+	[[nodiscard]] size_t NRebuilds() const { return m_NRebuilds; }
+
+	/// \brief the number of hierarchy refits.
+	[[nodiscard]] size_t NRefits() const { return m_NRefits; }
+
+private:
+	SelfIntersectionSettings m_Settings{}; //>! settings.
+	std::unique_ptr<Geometry::SurfaceMeshBVH> m_BVH{ nullptr }; //>! hierarchy of the evolving surface from the last detection.
+	size_t m_NRebuilds{ 0 }; //>! the number of hierarchy (re)builds.
+	size_t m_NRefits{ 0 }; //>! the number of hierarchy refits.
+};
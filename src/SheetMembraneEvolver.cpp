@@ -8,20 +8,19 @@
 #include "geometry/GridUtil.h"
 #include "geometry/MeshAnalysis.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include "ConversionUtils.h"
 #include "geometry/GeometryConversionUtils.h"
 #include "geometry/PlaneBuilder.h"
+#include "EvolutionEngine.h"
 
 // ================================================================================================
 
 /// \brief if true individual steps of surface evolution will be printed out into a given stream.
 #define REPORT_EVOL_STEPS true // Note: may affect performance
 
-/// \brief if true, upon computing trilinear system solution, new vertices are verified for belonging in the field bounds.
-#define VERIFY_SOLUTION_WITHIN_BOUNDS false // Note: useful for detecting numerical explosions of the solution.
-
 /// \brief repairs infinities and nan values of the input grid.
 #define REPAIR_INPUT_GRID true //Note: very useful! You never know what field we use! Infinities and nans lead to the Eigen::NoConvergence error code whose cause is difficult to find!
 
@@ -64,20 +63,23 @@ SheetMembraneEvolver::SheetMembraneEvolver(const Geometry::ScalarGrid& field, co
 #if REPAIR_INPUT_GRID
 	Geometry::RepairScalarGrid(*m_Field); // repair needed in case of invalid cell values.
 #endif
-	m_ImplicitLaplacianFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::laplace_implicit_barycentric : pmp::laplace_implicit_voronoi);
-	m_LaplacianAreaFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::voronoi_area_barycentric : pmp::voronoi_area);
+}
+
+SheetMembraneEvolver::SheetMembraneEvolver(const SupportColumnField& columnField, const SheetMembraneEvolutionSettings& settings)
+	: m_EvolSettings(settings), m_ColumnField(std::make_shared<SupportColumnField>(columnField))
+{
+}
+
+const pmp::BoundingBox& SheetMembraneEvolver::FieldBox() const
+{
+	return (m_ColumnField ? m_ColumnField->Box() : m_Field->Box());
 }
 
 // ================================================================================================
 
 void SheetMembraneEvolver::Preprocess()
 {
-	auto& field = *m_Field;
-	const auto& fieldBox = field.Box();
+	const auto fieldBox = FieldBox();
 
 	const float startZHeight = m_EvolSettings.StartZHeight;
 	const float endZHeight = m_EvolSettings.EndZHeight;
@@ -137,6 +139,12 @@ void SheetMembraneEvolver::Preprocess()
 	m_TransformToOriginal = inverse(transfMatrixFull);
 
 	(*m_EvolvingSurface) *= transfMatrixFull; // ico sphere is already centered at (0,0,0).
+	if (m_ColumnField)
+	{
+		m_ColumnField->Transform(transfMatrixFull); // analytic distance values scale with the columns.
+		return;
+	}
+	auto& field = *m_Field;
 	field *= transfMatrixFull; // field needs to be moved to (0,0,0) and also scaled.
 	field *= static_cast<double>(scalingFactor); // scale also distance values.
 
@@ -166,304 +174,290 @@ double SheetMembraneEvolver::AdvectionDistanceWeightFunction(const double& dista
 		return 0.0;
 	const auto& d1 = m_EvolSettings.ADParams.AdvectionMultiplier;
 	const auto& d2 = m_EvolSettings.ADParams.AdvectionSineMultiplier;
-	const auto negGradDotNormal = pmp::ddot(negDistanceGradient, vertexNormal);
+	// exactly unit gradients (e.g.: from the analytic column field) can exceed 1 in the dot product with a float normal.
+	const auto negGradDotNormal = std::clamp(pmp::ddot(negDistanceGradient, vertexNormal), -1.0, 1.0);
 	return d1 * distanceAtVertex * (negGradDotNormal - d2 * sqrt(1.0 - negGradDotNormal * negGradDotNormal));
 }
 
 void SheetMembraneEvolver::ExportSurface(const unsigned int& tId, const bool& isResult, const bool& transformToOriginal) const
 {
+	m_DerivedProperties.UpdateAll(*m_EvolvingSurface);
 	const std::string connectingName = (isResult ? "_Result" : "_Evol_" + std::to_string(tId));
+	if (m_AsyncExporter)
+	{
+		const std::optional<pmp::mat4> transform = (transformToOriginal ? std::optional<pmp::mat4>(m_TransformToOriginal) : std::nullopt);
+		m_AsyncExporter->Submit(*m_EvolvingSurface, m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, transform, m_OutputMeshIOFlags);
+		return;
+	}
 	if (!transformToOriginal)
 	{
-		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 		return;
 	}
 	auto exportedSurface = *m_EvolvingSurface;
 	exportedSurface *= m_TransformToOriginal;
-	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
-}
-
-void SheetMembraneEvolver::ComputeTriangleMetrics() const
-{
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
-	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
-
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
-
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "SheetMembraneEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
-	}
+	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 }
 
 // ================================================================================================
+// .................................. EvolutionEngine policies ....................................
 
-void SheetMembraneEvolver::Evolve()
+/// \brief Validates the input field and generates the stabilized starting plane sheet.
+class SheetMembraneEvolver::InitialSurfacePolicy
 {
-	if (!m_Field)
-		throw std::invalid_argument("SheetMembraneEvolver::Evolve: m_Field not set! Terminating!\n");
-	if (!m_Field->IsValid())
-		throw std::invalid_argument("SheetMembraneEvolver::Evolve: m_Field is invalid! Terminating!\n");
-
-	const auto& field = *m_Field;
-
-	Preprocess();
+public:
+	explicit InitialSurfacePolicy(SheetMembraneEvolver& evolver) : m_Evolver(evolver) {}
 
-	if (!m_EvolvingSurface)
-		throw std::invalid_argument("SheetMembraneEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
-
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-	const auto& fieldBox = field.Box();
-#endif
-	const auto fieldNegGradient = Geometry::ComputeNormalizedNegativeGradient(field);
+	pmp::SurfaceMesh& Prepare()
+	{
+		if (!m_Evolver.m_Field && !m_Evolver.m_ColumnField)
+			throw std::invalid_argument("SheetMembraneEvolver::Evolve: m_Field not set! Terminating!\n");
+		if (m_Evolver.m_Field && !m_Evolver.m_Field->IsValid())
+			throw std::invalid_argument("SheetMembraneEvolver::Evolve: m_Field is invalid! Terminating!\n");
 
-	const auto& NSteps = m_EvolSettings.NSteps;
-	const auto& tStep = m_EvolSettings.TimeStep;
+		m_Evolver.Preprocess();
 
-	// ........ evaluate edge lengths for remeshing ....................
-	float minEdgeLength = m_MeanEdgeLength * m_EvolSettings.TopoParams.MinEdgeMultiplier;
-	float maxEdgeLength = 4.0f * minEdgeLength;
-	float approxError = 0.25f * (minEdgeLength + maxEdgeLength);
-	//auto approxError = 2.0f * minEdgeLength;
-#if REPORT_EVOL_STEPS
-	std::cout << "minEdgeLength for remeshing: " << minEdgeLength << "\n";
-#endif
-	// .................................................................
+		if (!m_Evolver.m_EvolvingSurface)
+			throw std::invalid_argument("SheetMembraneEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+		return *m_Evolver.m_EvolvingSurface;
+	}
 
-	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
-	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
-	Eigen::MatrixXd sysRhs(NVertices, 3);
-	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
-	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
+	[[nodiscard]] pmp::BoundingBox SolutionBounds() const { return m_Evolver.FieldBox(); }
 
-	// property container for surface vertex normals
-	pmp::VertexProperty<pmp::Point> vNormalsProp{};
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetMatrix("TransformToOriginal", m_Evolver.m_TransformToOriginal);
+		checkpoint.SetValue("ScalingFactor", static_cast<double>(m_Evolver.m_ScalingFactor));
+	}
 
-	// ----------- System fill function --------------------------------
-	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
+	void LoadState(const EvolutionCheckpoint& checkpoint)
 	{
-		const Eigen::Vector3d downVec{ 0.0, 0.0, -1.0 };
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPosToUpdate = m_EvolvingSurface->position(v);
+		m_Evolver.m_TransformToOriginal = checkpoint.GetMatrix("TransformToOriginal");
+		m_Evolver.m_ScalingFactor = static_cast<pmp::Scalar>(checkpoint.GetValue("ScalingFactor"));
+	}
 
-			if ((m_EvolSettings.IdentityForBoundaryVertices && m_EvolvingSurface->is_boundary(v)) ||
-				(m_EvolSettings.IdentityForFeatureVertices && vFeature[v]))
-			{
-				// move boundary/feature vertices along downVec
-				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs + tStep * m_SheetSurfaceVelocity * downVec;
-				sysMat.coeffRef(v.idx(), v.idx()) = 1.0;
-				continue;
-			}
+private:
+	SheetMembraneEvolver& m_Evolver;
+};
 
-			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
-			const auto vNormal = vNormalsProp[v]; // vertex unit normal
+/// \brief Evaluates distance-weighted advection-diffusion rows of the evolution system. Boundary/feature vertices move down with the sheet velocity.
+class SheetMembraneEvolver::WeightPolicy
+{
+public:
+	explicit WeightPolicy(const SheetMembraneEvolver& evolver) : m_Evolver(evolver) {}
 
-			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
-			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
+	void Initialize(pmp::SurfaceMesh& mesh)
+	{
+		// the analytic column field evaluates its gradient at the vertices, so no gradient grid is needed.
+		if (!m_Evolver.m_ColumnField)
+			m_FieldNegGradient = std::make_shared<Geometry::VectorGrid>(Geometry::ComputeNormalizedNegativeGradient(*m_Evolver.m_Field));
+		m_VDistance = mesh.vertex_property<pmp::Scalar>(vertexDistancePropertyKey); // vertex property for distance field values (restored if resuming).
+		m_VFeature = mesh.vertex_property<bool>(vertexFeaturePropertyKey, false);
+	}
 
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
-			const float tanRedistWeight = m_EvolSettings.TangentialVelocityWeight * epsilonCtrlWeight;
-			if (tanRedistWeight > 0.0f)
-			{
-				// compute tangential velocity
-				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
-			}
+	void PrepareStep(const pmp::SurfaceMesh& mesh)
+	{
+		m_VNormals = mesh.get_vertex_property<pmp::Point>(vertexNormalPropertyKey);
+	}
 
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			sysMat.coeffRef(v.idx(), v.idx()) = 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum);
+	[[nodiscard]] EvolutionSystemRow EvaluateRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& tStep) const
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto vPosToUpdate = mesh.position(v);
 
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				sysMat.coeffRef(v.idx(), w.idx()) = -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight);
-			}
+		if ((settings.IdentityForBoundaryVertices && mesh.is_boundary(v)) ||
+			(settings.IdentityForFeatureVertices && m_VFeature[v]))
+		{
+			// move boundary/feature vertices along downVec
+			const Eigen::Vector3d downVec{ 0.0, 0.0, -1.0 };
+			const Eigen::Vector3d vertexRhs = vPosToUpdate;
+			return { vertexRhs + tStep * m_Evolver.m_SheetSurfaceVelocity * downVec, 0.0, true };
 		}
-	};
-	// -----------------------------------------------------------------
 
-	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
-	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
-	std::ofstream fileOStreamMaxes(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMaxes.txt");
-	std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-	fileOStreamMins << coVolStats.Min << ", ";
-	fileOStreamMeans << coVolStats.Mean << ", ";
-	fileOStreamMaxes << coVolStats.Max << ", ";
-#endif
-	// set initial surface vertex properties
-	for (const auto v : m_EvolvingSurface->vertices())
-	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-	}
-	// Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-	Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface);
-	Geometry::ComputeZLevelElevations(*m_EvolvingSurface);
-	// ComputeTriangleMetrics();
-	if (m_EvolSettings.ExportSurfacePerTimeStep)
-		ExportSurface(0);
-
-	// -------------------------------------------------------------------------------------------------------------
-	// ........................................ main loop ..........................................................
-	// -------------------------------------------------------------------------------------------------------------
-	for (unsigned int ti = 1; ti <= NSteps; ti++)
-	{
-#if REPORT_EVOL_STEPS
-		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << tStep * ti << "/" << tStep * NSteps
-			<< ", Procedure Name: " << m_EvolSettings.ProcedureName << "\n";
-		std::cout << "pmp::Normals::compute_vertex_normals ... ";
-#endif
-		pmp::Normals::compute_vertex_normals(*m_EvolvingSurface);
-		vNormalsProp = m_EvolvingSurface->vertex_property<pmp::Point>("v:normal");
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "fillMatrixAndRHSTriplesFromMesh for " << NVertices << " vertices ... ";
-#endif
+		const auto vNegGradDistanceToTarget = (m_Evolver.m_ColumnField ?
+			m_Evolver.m_ColumnField->NegativeNormalizedGradient(vPosToUpdate) :
+			Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, *m_FieldNegGradient));
+		const auto vNormal = m_VNormals[v]; // vertex unit normal
 
-		// prepare matrix & rhs
-		fillMatrixAndRHSTriplesFromMesh();
+		const double epsilonCtrlWeight = m_Evolver.LaplacianDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel);
+		const double etaCtrlWeight = m_Evolver.AdvectionDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
 
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Solving linear system ... ";
-#endif
-		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
-		Eigen::MatrixXd x = solver.solve(sysRhs);
-		if (solver.info() != Eigen::Success)
+		Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
+		const float tanRedistWeight = settings.TangentialVelocityWeight * epsilonCtrlWeight;
+		if (tanRedistWeight > 0.0f)
 		{
-			const std::string msg = "\nSheetMembraneEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
-				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.info()) + "\n";
-			std::cerr << msg;
-			throw std::runtime_error(msg);
+			// compute tangential velocity
+			const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(mesh, v, vNormal, tanRedistWeight);
+			vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 		}
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Updating vertex positions ... ";
-#endif
+		return { vertexRhs, epsilonCtrlWeight, false };
+	}
 
-		// update vertex positions & verify mesh within bounds
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		size_t nVertsOutOfBounds = 0;
-#endif
-		for (unsigned int i = 0; i < NVertices; i++)
+	void UpdateVertexProperties(pmp::SurfaceMesh& mesh)
+	{
+		if (m_Evolver.m_ColumnField)
 		{
-			const auto newPos = x.row(i);
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-			if (!fieldBox.Contains(newPos))
+			const auto& columnField = *m_Evolver.m_ColumnField;
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < static_cast<int>(mesh.vertices_size()); i++)
 			{
-				if (nVertsOutOfBounds == 0) std::cerr << "\n";
-				std::cerr << "SheetMembraneEvolver::Evolve: vertex " << i << " out of field bounds!\n";
-				nVertsOutOfBounds++;
+				const pmp::Vertex v(i);
+				if (mesh.is_deleted(v))
+					continue;
+				m_VDistance[v] = static_cast<pmp::Scalar>(columnField.Distance(mesh.position(v)));
 			}
-#endif
-			m_EvolvingSurface->position(pmp::Vertex(i)) = x.row(i);
+			return;
 		}
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		if ((m_EvolSettings.DoRemeshing && nVertsOutOfBounds > static_cast<double>(NVertices) * m_EvolSettings.MaxFractionOfVerticesOutOfBounds) ||
-			(!m_EvolSettings.DoRemeshing && nVertsOutOfBounds > 0))
+
+		const auto& field = *m_Evolver.m_Field;
+		for (const auto v : mesh.vertices())
 		{
-			std::cerr << "SheetMembraneEvolver::Evolve: found " << nVertsOutOfBounds << " vertices out of bounds! Terminating!\n";
-			break;
+			const auto vPos = mesh.position(v);
+			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
+			m_VDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
 		}
-#endif
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-#endif
+	}
 
-		if (m_EvolSettings.DoRemeshing /* && ti > NSteps * m_EvolSettings.TopoParams.RemeshingStartTimeFactor*/)
-		{
-			// remeshing
+private:
+	const SheetMembraneEvolver& m_Evolver;
+	std::shared_ptr<Geometry::VectorGrid> m_FieldNegGradient{ nullptr }; //>! normalized negative gradient of the distance field.
+	pmp::VertexProperty<pmp::Scalar> m_VDistance{};
+	pmp::VertexProperty<bool> m_VFeature{};
+	pmp::VertexProperty<pmp::Point> m_VNormals{};
+};
+
+/// \brief Performs feature detection and remeshing in each time step with a stepwise decay of remeshing lengths.
+class SheetMembraneEvolver::TopologyPolicy : public DerivedPropertiesTopologyPolicy
+{
+public:
+	explicit TopologyPolicy(SheetMembraneEvolver& evolver)
+		: DerivedPropertiesTopologyPolicy(evolver.m_DerivedProperties), m_Evolver(evolver) {}
+
+	void Initialize(const pmp::SurfaceMesh& /*mesh*/)
+	{
+		// ........ derived properties (computed only when consumed) .......
+		auto& properties = m_Evolver.m_DerivedProperties;
+		properties.Clear();
+		// properties.Register("dihedralAngles", MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {}, Geometry::ComputeEdgeDihedralAngles);
+		properties.Register("curvatures", MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {}, [](pmp::SurfaceMesh& m) { Geometry::ComputeVertexCurvaturesAndRelatedProperties(m); });
+		properties.Register("zLevelElevations", static_cast<unsigned int>(MeshPropertyInput::Positions), {}, Geometry::ComputeZLevelElevations);
+		// RegisterTriangleMetrics(properties, m_Evolver.m_EvolSettings.TriMetrics);
+
+		// ........ evaluate edge lengths for remeshing ....................
+		m_MinEdgeLength = m_Evolver.m_MeanEdgeLength * m_Evolver.m_EvolSettings.TopoParams.MinEdgeMultiplier;
+		m_MaxEdgeLength = 4.0f * m_MinEdgeLength;
+		m_ApproxError = 0.25f * (m_MinEdgeLength + m_MaxEdgeLength);
+		//m_ApproxError = 2.0f * m_MinEdgeLength;
 #if REPORT_EVOL_STEPS
-			std::cout << "Detecting Features ...";
+		std::cout << "minEdgeLength for remeshing: " << m_MinEdgeLength << "\n";
 #endif
-			if (m_EvolSettings.DoFeatureDetection && ti > NSteps * m_EvolSettings.TopoParams.FeatureDetectionStartTimeFactor)
-			{
-				const auto nEdges = DetectFeatures(m_EvolSettings.TopoParams.FeatureType);
+	}
+
+	bool Apply(pmp::SurfaceMesh& mesh, const unsigned int& ti, double& /*tStep*/)
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto& NSteps = settings.NSteps;
+		if (!settings.DoRemeshing /* || ti <= NSteps * settings.TopoParams.RemeshingStartTimeFactor*/)
+			return false;
+
+		// remeshing
 #if REPORT_EVOL_STEPS
-				std::cout << "done. " << nEdges << " feature edges detected.\n";
+		std::cout << "Detecting Features ...";
 #endif
-			}
+		if (settings.DoFeatureDetection && ti > NSteps * settings.TopoParams.FeatureDetectionStartTimeFactor)
+		{
+			const ScopedPhaseTrace featureTrace("FeatureDetection");
+			const auto nEdges = m_Evolver.DetectFeatures(settings.TopoParams.FeatureType);
 #if REPORT_EVOL_STEPS
-			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << minEdgeLength << ", maxEdgeLength: " << maxEdgeLength << ") ... ";
+			std::cout << "done. " << nEdges << " feature edges detected.\n";
 #endif
-			//std::cout << "pmp::Remeshing::uniform_remeshing(targetEdgeLength: " << targetEdgeLength << ") ... ";
-			pmp::Remeshing remeshing(*m_EvolvingSurface);
-			remeshing.adaptive_remeshing({
-				minEdgeLength, maxEdgeLength, approxError,
-				m_EvolSettings.TopoParams.NRemeshingIters,
-				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
-			//remeshing.uniform_remeshing(targetEdgeLength);
+		}
 #if REPORT_EVOL_STEPS
-			std::cout << "done\n";
+		std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << m_MinEdgeLength << ", maxEdgeLength: " << m_MaxEdgeLength << ") ... ";
 #endif
-			if (ti % m_EvolSettings.TopoParams.StepStrideForEdgeDecay == 0 &&
-				ti > NSteps * m_EvolSettings.TopoParams.RemeshingSizeDecayStartTimeFactor)
-			{
-				// shorter edges are needed for features close to the target.
-				minEdgeLength *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-				maxEdgeLength *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-				//approxError *= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-			}
-		}
-
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+		//std::cout << "pmp::Remeshing::uniform_remeshing(targetEdgeLength: " << targetEdgeLength << ") ... ";
+		const ScopedPhaseTrace remeshingTrace("Remeshing");
+		pmp::Remeshing remeshing(mesh, m_RemeshingReference);
+		remeshing.adaptive_remeshing({
+			m_MinEdgeLength, m_MaxEdgeLength, m_ApproxError,
+			settings.TopoParams.NRemeshingIters,
+			settings.TopoParams.NTanSmoothingIters,
+			settings.TopoParams.UseBackProjection });
+		//remeshing.uniform_remeshing(targetEdgeLength);
 #if REPORT_EVOL_STEPS
-		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-		fileOStreamMins << coVolStats.Min << (ti < NSteps ? ", " : "");
-		fileOStreamMeans << coVolStats.Mean << (ti < NSteps ? ", " : "");
-		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
+		std::cout << "done\n";
 #endif
-		// set surface vertex properties
-		for (const auto v : m_EvolvingSurface->vertices())
+		if (ti % settings.TopoParams.StepStrideForEdgeDecay == 0 &&
+			ti > NSteps * settings.TopoParams.RemeshingSizeDecayStartTimeFactor)
 		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+			// shorter edges are needed for features close to the target.
+			m_MinEdgeLength *= settings.TopoParams.EdgeLengthDecayFactor;
+			m_MaxEdgeLength *= settings.TopoParams.EdgeLengthDecayFactor;
+			//m_ApproxError *= settings.TopoParams.EdgeLengthDecayFactor;
 		}
-		// Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-		Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface);
-		Geometry::ComputeZLevelElevations(*m_EvolvingSurface);
-		// ComputeTriangleMetrics();
+		m_Evolver.m_DerivedProperties.Invalidate(MeshPropertyInput::Connectivity);
+		return true;
+	}
 
-		if (m_EvolSettings.ExportSurfacePerTimeStep)
-			ExportSurface(ti);
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetValue("MinEdgeLength", static_cast<double>(m_MinEdgeLength));
+		checkpoint.SetValue("MaxEdgeLength", static_cast<double>(m_MaxEdgeLength));
+		checkpoint.SetValue("ApproxError", static_cast<double>(m_ApproxError));
+	}
 
-		// update linear system dims for next time step:
-		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
-		{
-			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
-			sysRhs = Eigen::MatrixXd(NVertices, 3);
-		}
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_MinEdgeLength = static_cast<float>(checkpoint.GetValue("MinEdgeLength"));
+		m_MaxEdgeLength = static_cast<float>(checkpoint.GetValue("MaxEdgeLength"));
+		m_ApproxError = static_cast<float>(checkpoint.GetValue("ApproxError"));
+	}
 
-#if REPORT_EVOL_STEPS
-		std::cout << ">>> Time step " << ti << " finished.\n";
-		std::cout << "----------------------------------------------------------------------\n";
-#endif
+private:
+	SheetMembraneEvolver& m_Evolver;
+	std::shared_ptr<pmp::RemeshingReference> m_RemeshingReference{ std::make_shared<pmp::RemeshingReference>() }; //>! back-projection reference reused by subsequent remeshing calls.
+	float m_MinEdgeLength{ 0.0f };
+	float m_MaxEdgeLength{ 0.0f };
+	float m_ApproxError{ 0.0f };
+};
 
-	} // end main loop
-	// -------------------------------------------------------------------------------------------------------------
+// ================================================================================================
 
-	if (m_EvolSettings.ExportResultSurface)
-		ExportSurface(NSteps, true);
+void SheetMembraneEvolver::RunEvolution(const EvolutionCheckpoint* checkpoint)
+{
+	InitialSurfacePolicy initialSurface(*this);
+	WeightPolicy weights(*this);
+	TopologyPolicy topology(*this);
 
-#if REPORT_EVOL_STEPS
-	fileOStreamMins.close();
-	fileOStreamMaxes.close();
-	fileOStreamMeans.close();
-#endif
+	if (m_EvolSettings.ExportSurfacePerTimeStep && m_EvolSettings.AsyncExport.Enabled)
+		m_AsyncExporter = std::make_shared<AsyncSurfaceExporter>(m_EvolSettings.AsyncExport);
+
+	DispatchLaplacianPolicy(m_EvolSettings.LaplacianType, [&](auto laplacianPolicy)
+	{
+		using LaplacianPolicy = decltype(laplacianPolicy);
+		EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy> engine(
+			GetEvolutionEngineSettings(m_EvolSettings), initialSurface, weights, topology);
+		engine.Run([this](const unsigned int& tId, const bool& isResult) { ExportSurface(tId, isResult); }, checkpoint);
+		m_PhaseStatistics = engine.GetPhaseStatistics();
+		m_ConvergenceReport = engine.GetConvergenceReport();
+	});
+
+	if (m_AsyncExporter)
+	{
+		m_AsyncExporter->Flush(); // all exported files need to be complete when Evolve returns.
+		m_AsyncExporter.reset();
+	}
+}
+
+void SheetMembraneEvolver::Evolve()
+{
+	RunEvolution(nullptr);
+}
+
+void SheetMembraneEvolver::Resume(const std::string& checkpointPath)
+{
+	const auto checkpoint = ReadCheckpoint(checkpointPath);
+	RunEvolution(&checkpoint);
 }
 
 void ReportInput(const SheetMembraneEvolutionSettings& evolSettings, std::ostream& os)
@@ -487,6 +481,13 @@ void ReportInput(const SheetMembraneEvolutionSettings& evolSettings, std::ostrea
 	os << "......................................................................\n";
 	os << "Export Surface per Time Step: " << (evolSettings.ExportSurfacePerTimeStep ? "true" : "false") << ",\n";
 	os << "Output Path: " << evolSettings.OutputPath << ",\n";
+	os << "Linear Solver: " << LinearSolverTypeToString(evolSettings.LinearSolverParams.Type) << " (preconditioner reused for " << evolSettings.LinearSolverParams.PreconditionerReuseSteps << " steps),\n";
+	os << "Adaptive Time Stepping: " << (evolSettings.TimeStepControl.Enabled ? "true" : "false") << ",\n";
+	os << "Convergence Criterion: " << (evolSettings.Convergence.Enabled ? ConvergenceMeasureToString(evolSettings.Convergence.Measure) + " < " + std::to_string(evolSettings.Convergence.Tolerance) : std::string("none")) << ",\n";
+	os << "Checkpoints: " << (evolSettings.Checkpoint.Enabled ? "every " + std::to_string(evolSettings.Checkpoint.StepStride) + " steps" : std::string("none")) << ",\n";
+	os << "Phase Tracing: " << (evolSettings.Tracing.Enabled ? "true" : "false") << ",\n";
+	os << "Self-Intersection Detection: " << (evolSettings.SelfIntersections.Enabled ? "every " + std::to_string(evolSettings.SelfIntersections.StepStride) + " steps" + (evolSettings.SelfIntersections.TerminateOnDetection ? " (terminating on detection)" : "") : std::string("none")) << ",\n";
+	os << "Mesh Reordering: " << MeshReorderingTypeToString(evolSettings.MeshReordering) << ",\n";
 	os << "Do Remeshing: " << (evolSettings.DoRemeshing ? "true" : "false") << ",\n";
 	os << "Do Feature Detection: " << (evolSettings.DoFeatureDetection ? "true" : "false") << ",\n";
 	os << "----------------------------------------------------------------------\n";
@@ -507,26 +508,6 @@ float GetStabilizationScalingFactor(const double& timeStep, const float& cellSiz
 // ============================================================================================================
 //
 
-/**
- * \brief A verification function for the column 2D position within field box.
- * \param fieldBox      bounding box of the scalar field
- * \param pos           2D position in the x,y-plane
- * \return true if pos is within box's x,y-range
- */
-static [[nodiscard]] bool IsColumnInField(const pmp::BoundingBox& fieldBox, const pmp::vec2& pos)
-{
-	if (pos[0] < fieldBox.min()[0])
-		return false;
-
-	if (pos[0] > fieldBox.max()[0])
-		return false;
-
-	if (pos[1] < fieldBox.min()[1])
-		return false;
-
-	return pos[1] <= fieldBox.max()[1];
-}
-
 Geometry::ScalarGrid GetDistanceFieldWithSupportColumns(
 	const float& cellSize, const pmp::BoundingBox& box, 
 	const std::vector<WeightedColumnPosition>& weightedColumnPositions, const float& supportZLevel)
@@ -545,42 +526,12 @@ Geometry::ScalarGrid GetDistanceFieldWithSupportColumns(
 		std::cerr << "GetDistanceFieldWithSupportColumns: cellSize too large!\n";
 		throw std::logic_error("GetDistanceFieldWithSupportColumns: cellSize too large!\n");
 	}
-	if (supportZLevel < 0.0f || supportZLevel > 1.0f)
-	{
-		std::cerr << "GetDistanceFieldWithSupportColumns: supportZLevel must be a value between 0 and 1!\n";
-		throw std::logic_error("GetDistanceFieldWithSupportColumns: supportZLevel must be a value between 0 and 1!\n");
-	}
-
-	const float maxColumnRadius = 0.5f * std::fmaxf(boxSize[0], boxSize[1]);
-	const float preferredColumnRadius = 0.05f * maxColumnRadius;
-	const float columnZPosition = box.min()[2] + (supportZLevel - 0.1f) * boxSize[2];
-	const float maxColumnHeight = box.max()[2] - columnZPosition;
 
+	// the columns are generated (and supportZLevel verified) by GetSupportColumnCapsules.
 	constexpr double initVal = Geometry::DEFAULT_SCALAR_GRID_INIT_VAL;
 	Geometry::ScalarGrid result(cellSize, box, initVal);
-	Geometry::CapsuleParams cp{};
-	cp.Radius = preferredColumnRadius;
-	cp.BoolOpFunction = Geometry::DistanceUnion;
-
-	for (const auto& wPos : weightedColumnPositions)
-	{
-		const auto& pos = wPos.Position;
-		if (!IsColumnInField(box, pos))
-			continue;
-
-		const auto& weight = wPos.Weight;
-		if (weight < 0.0f || weight > 1.0f)
-		{
-			std::cerr << "GetDistanceFieldWithSupportColums: Weight must be a value between 0 and 1!\n";
-			continue;
-		}
-
-		cp.Position = pmp::vec3{ pos[0], pos[1], columnZPosition };
-		const auto capsuleHeight = maxColumnHeight * weight;
-		cp.Height = capsuleHeight;
-
+	for (const auto& cp : GetSupportColumnCapsules(box, weightedColumnPositions, supportZLevel))
 		ApplyCapsuleDistanceFieldToGrid(result, cp);
-	}
 
 	return result;
 }
@@ -6,6 +6,15 @@
 #include "geometry/Grid.h"
 
 #include "EvolverUtilsCommon.h"
+#include "AsyncSurfaceExporter.h"
+#include "EvolutionSystemSolver.h"
+#include "TimeStepController.h"
+#include "ConvergenceMonitor.h"
+#include "EvolutionCheckpoint.h"
+#include "EvolutionTracer.h"
+#include "SelfIntersectionMonitor.h"
+#include "DerivedMeshProperties.h"
+#include "SupportColumnField.h"
 
 /**
  * \brief A wrapper for sheet membrane surface evolution settings.
@@ -42,6 +51,15 @@ struct SheetMembraneEvolutionSettings
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+
+	AsyncExportSettings AsyncExport{}; //>! settings for background export of per-step surfaces.
+	LinearSolverSettings LinearSolverParams{}; //>! settings of the linear solver for the evolution system.
+	TimeStepControlSettings TimeStepControl{}; //>! settings of adaptive time stepping (disabled by default).
+	ConvergenceSettings Convergence{}; //>! settings of convergence-based early termination (disabled by default).
+	CheckpointSettings Checkpoint{}; //>! settings of periodic checkpoints of the evolution state (disabled by default).
+	TracingSettings Tracing{}; //>! settings of phase tracing into a Chrome trace file (disabled by default).
+	SelfIntersectionSettings SelfIntersections{}; //>! settings of per-step self-intersection detection (disabled by default).
+	MeshReorderingType MeshReordering{ MeshReorderingType::ReverseCuthillMcKee }; //>! renumbering of the evolving surface after remeshing.
 };
 
 /**
@@ -58,17 +76,39 @@ public:
 	 */
 	SheetMembraneEvolver(const Geometry::ScalarGrid& field, const SheetMembraneEvolutionSettings& settings);
 
+	/**
+	 * \brief Constructor. Initialize with an analytic support column field (no dense grid is sampled).
+	 * \param columnField              support column field.
+	 * \param settings                 surface evolution settings.
+	 */
+	SheetMembraneEvolver(const SupportColumnField& columnField, const SheetMembraneEvolutionSettings& settings);
+
 	/**
 	 * \brief Main functionality.
 	 */
 	void Evolve();
 
+	/**
+	 * \brief Resumes the evolution from a checkpoint file written by a previous run with the same settings.
+	 * \param checkpointPath    full name of the checkpoint file.
+	 */
+	void Resume(const std::string& checkpointPath);
+
+	/// \brief Per-phase aggregates of the last evolution (empty unless Tracing is enabled).
+	[[nodiscard]] const std::vector<PhaseStatistics>& GetPhaseStatistics() const { return m_PhaseStatistics; }
+
+	/// \brief Convergence of the last evolution (IsConverged is false unless it stopped early by the convergence criterion).
+	[[nodiscard]] const ConvergenceReport& GetConvergenceReport() const { return m_ConvergenceReport; }
+
 private:
 	/**
 	 * \brief Preprocess for evolution, i.e.: generate m_EvolvingSurface, and transform both m_Field and m_EvolvingSurface for stabilization.
 	 */
 	void Preprocess();
 
+	/// \brief bounds of the field environment (m_ColumnField's if set, otherwise m_Field's).
+	[[nodiscard]] const pmp::BoundingBox& FieldBox() const;
+
 	// ----------------------------------------------------------------
 
 	/** // TODO: it's a design smell. Try to use a function object with a relevant number of parameters, or a variable-parameter function.
@@ -105,10 +145,20 @@ private:
 	 */
 	void ExportSurface(const unsigned int& tId, const bool& isResult = false, const bool& transformToOriginal = true) const;
 
+	// ----------------------------------------------------------------
+
 	/**
-	 * \brief Computes triangle metrics interpolated to vertices according to list m_EvolSettings.TriMetrics.
+	 * \brief Runs the evolution engine from the initial surface or, if given, from a checkpoint.
+	 * \param checkpoint    checkpoint to resume from (nullptr for a new evolution).
 	 */
-	void ComputeTriangleMetrics() const;
+	void RunEvolution(const EvolutionCheckpoint* checkpoint);
+
+	// ----------------------------------------------------------------
+
+	// policies specializing EvolutionEngine for SheetMembraneEvolver (defined in SheetMembraneEvolver.cpp).
+	class InitialSurfacePolicy;
+	class WeightPolicy;
+	class TopologyPolicy;
 
 	// ----------------------------------------------------------------
 
@@ -118,16 +168,20 @@ private:
 	float m_MeanEdgeLength{ 0.3f }; //>! mean edge length for adaptive remeshing
 
 	std::shared_ptr<Geometry::ScalarGrid> m_Field{ nullptr }; //>! scalar field environment.
+	std::shared_ptr<SupportColumnField> m_ColumnField{ nullptr }; //>! analytic support column field (evaluated instead of m_Field if set).
 	std::shared_ptr<pmp::SurfaceMesh> m_EvolvingSurface{ nullptr }; //>! (stabilized) evolving surface.
 
 	pmp::Scalar m_ScalingFactor{ 1.0f }; //>! stabilization scaling factor value.
 
-	std::function<pmp::ImplicitLaplaceInfo(const pmp::SurfaceMesh&, pmp::Vertex)> m_ImplicitLaplacianFunction{}; //>! a Laplacian function chosen from parameter MeshLaplacian.
-	std::function<double(const pmp::SurfaceMesh&, pmp::Vertex)> m_LaplacianAreaFunction{}; //>! a Laplacian area function chosen from parameter MeshLaplacian.
 	std::function<size_t(const pmp::Scalar&, const bool&)> m_FeatureFunction{}; //>! a function for detecting mesh features.
 
 	// export
 	std::string m_OutputMeshExtension = ".vtk"; //>! extension of the exported mesh geometry.
+	pmp::IOFlags m_OutputMeshIOFlags{ .use_binary = true }; //>! flags of the exported mesh geometry (binary, with all scalar vertex and face properties).
+	std::shared_ptr<AsyncSurfaceExporter> m_AsyncExporter{ nullptr }; //>! background writer for per-step surface export (if enabled).
+	std::vector<PhaseStatistics> m_PhaseStatistics{}; //>! per-phase aggregates of the last evolution (if traced).
+	ConvergenceReport m_ConvergenceReport{}; //>! convergence of the last evolution.
+	mutable DerivedMeshProperties m_DerivedProperties{}; //>! lazily updated curvatures, dihedral angles and triangle metrics of m_EvolvingSurface.
 	pmp::mat4 m_TransformToOriginal{}; //>! transformation matrix from stabilized surface to original size (for export).
 
 };
@@ -149,16 +203,6 @@ void ReportInput(const SheetMembraneEvolutionSettings& evolSettings, std::ostrea
  */
 [[nodiscard]] float GetStabilizationScalingFactor(const double& timeStep, const float& cellSizeX, const float& cellSizeY, const float& stabilizationFactor = 1.0f);
 
-/**
- * \brief A wrapper for the 2D position and weight of a support column
- * \struct WeightedColumnPosition
- */
-struct WeightedColumnPosition
-{
-	pmp::vec2 Position{}; //>! 2D position of this column
-	float Weight{ 1.0f }; //>! weight of this column
-};
-
 /**
  * \brief Computes a scalar field representing volumetric columns placed within the bounding box.
  * \param cellSize                      cell size of the produced field.
@@ -0,0 +1,213 @@
+#include "SupportColumnField.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * \brief A verification function for the column 2D position within field box.
+ * \param fieldBox      bounding box of the scalar field
+ * \param pos           2D position in the x,y-plane
+ * \return true if pos is within box's x,y-range
+ */
+static [[nodiscard]] bool IsColumnInField(const pmp::BoundingBox& fieldBox, const pmp::vec2& pos)
+{
+	if (pos[0] < fieldBox.min()[0])
+		return false;
+
+	if (pos[0] > fieldBox.max()[0])
+		return false;
+
+	if (pos[1] < fieldBox.min()[1])
+		return false;
+
+	return pos[1] <= fieldBox.max()[1];
+}
+
+std::vector<Geometry::CapsuleParams> GetSupportColumnCapsules(const pmp::BoundingBox& box,
+	const std::vector<WeightedColumnPosition>& weightedColumnPositions, const float& supportZLevel)
+{
+	if (box.is_empty())
+	{
+		std::cerr << "GetSupportColumnCapsules: box.is_empty()!\n";
+		throw std::logic_error("GetSupportColumnCapsules: box.is_empty()!\n");
+	}
+	if (supportZLevel < 0.0f || supportZLevel > 1.0f)
+	{
+		std::cerr << "GetSupportColumnCapsules: supportZLevel must be a value between 0 and 1!\n";
+		throw std::logic_error("GetSupportColumnCapsules: supportZLevel must be a value between 0 and 1!\n");
+	}
+
+	const auto boxSize = box.max() - box.min();
+	const float maxColumnRadius = 0.5f * std::fmaxf(boxSize[0], boxSize[1]);
+	const float preferredColumnRadius = 0.05f * maxColumnRadius;
+	const float columnZPosition = box.min()[2] + (supportZLevel - 0.1f) * boxSize[2];
+	const float maxColumnHeight = box.max()[2] - columnZPosition;
+
+	std::vector<Geometry::CapsuleParams> result;
+	result.reserve(weightedColumnPositions.size());
+	Geometry::CapsuleParams cp{};
+	cp.Radius = preferredColumnRadius;
+	cp.BoolOpFunction = Geometry::DistanceUnion;
+
+	for (const auto& wPos : weightedColumnPositions)
+	{
+		const auto& pos = wPos.Position;
+		if (!IsColumnInField(box, pos))
+			continue;
+
+		const auto& weight = wPos.Weight;
+		if (weight < 0.0f || weight > 1.0f)
+		{
+			std::cerr << "GetSupportColumnCapsules: Weight must be a value between 0 and 1!\n";
+			continue;
+		}
+
+		cp.Position = pmp::vec3{ pos[0], pos[1], columnZPosition };
+		cp.Height = maxColumnHeight * weight;
+		result.push_back(cp);
+	}
+
+	return result;
+}
+
+// ================================================================================================
+
+SupportColumnField::SupportColumnField(const pmp::BoundingBox& box, const std::vector<WeightedColumnPosition>& weightedColumnPositions, const float& supportZLevel)
+	: m_Box(box), m_Columns(GetSupportColumnCapsules(box, weightedColumnPositions, supportZLevel))
+{
+	BuildColumnHash();
+}
+
+void SupportColumnField::BuildColumnHash()
+{
+	m_ColumnHash.clear();
+	m_MaxColumnRadius = 0.0f;
+	for (const auto& column : m_Columns)
+		m_MaxColumnRadius = std::max(m_MaxColumnRadius, column.Radius);
+
+	// about one column per hash cell, but cells need to be wider than the columns.
+	const auto boxSize = m_Box.max() - m_Box.min();
+	const float boxArea = std::max(boxSize[0] * boxSize[1], FLT_EPSILON);
+	m_HashCellSize = std::max(std::sqrt(boxArea / static_cast<float>(std::max<size_t>(m_Columns.size(), 1))), 2.0f * m_MaxColumnRadius);
+	m_HashOrigin = pmp::vec2{ m_Box.min()[0], m_Box.min()[1] };
+
+	m_MinHashIx = m_MinHashIy = std::numeric_limits<int>::max();
+	m_MaxHashIx = m_MaxHashIy = std::numeric_limits<int>::lowest();
+	for (unsigned int i = 0; i < m_Columns.size(); i++)
+	{
+		const auto& pos = m_Columns[i].Position;
+		const auto ix = static_cast<int>(std::floor((pos[0] - m_HashOrigin[0]) / m_HashCellSize));
+		const auto iy = static_cast<int>(std::floor((pos[1] - m_HashOrigin[1]) / m_HashCellSize));
+		m_ColumnHash[HashKey(ix, iy)].push_back(i);
+		m_MinHashIx = std::min(m_MinHashIx, ix);
+		m_MaxHashIx = std::max(m_MaxHashIx, ix);
+		m_MinHashIy = std::min(m_MinHashIy, iy);
+		m_MaxHashIy = std::max(m_MaxHashIy, iy);
+	}
+}
+
+uint64_t SupportColumnField::HashKey(const int& ix, const int& iy)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(iy));
+}
+
+pmp::vec3 SupportColumnField::ColumnAxisOffset(const size_t& columnId, const pmp::Point& pt) const
+{
+	// the same clamping as in Geometry::ApplyCapsuleDistanceFieldToGrid.
+	const auto& column = m_Columns[columnId];
+	const auto posVect = pt - column.Position;
+	return pmp::vec3{ posVect[0], posVect[1], posVect[2] - std::clamp<float>(posVect[2], 0.0f, column.Height + column.Radius) };
+}
+
+size_t SupportColumnField::FindClosestColumn(const pmp::Point& pt, double& distance) const
+{
+	distance = Geometry::DEFAULT_SCALAR_GRID_INIT_VAL;
+	size_t closestColumnId = m_Columns.size();
+	if (m_Columns.empty())
+		return closestColumnId;
+
+	const auto cx = static_cast<int>(std::floor((pt[0] - m_HashOrigin[0]) / m_HashCellSize));
+	const auto cy = static_cast<int>(std::floor((pt[1] - m_HashOrigin[1]) / m_HashCellSize));
+	const int maxRing = std::max({ std::abs(cx - m_MinHashIx), std::abs(cx - m_MaxHashIx), std::abs(cy - m_MinHashIy), std::abs(cy - m_MaxHashIy) });
+
+	const auto visitCell = [&](const int& ix, const int& iy)
+	{
+		if (ix < m_MinHashIx || ix > m_MaxHashIx || iy < m_MinHashIy || iy > m_MaxHashIy)
+			return;
+		const auto it = m_ColumnHash.find(HashKey(ix, iy));
+		if (it == m_ColumnHash.end())
+			return;
+		for (const auto columnId : it->second)
+		{
+			const double columnDistance = static_cast<double>(norm(ColumnAxisOffset(columnId, pt))) - static_cast<double>(m_Columns[columnId].Radius);
+			if (columnDistance >= distance)
+				continue;
+			distance = columnDistance;
+			closestColumnId = columnId;
+		}
+	};
+
+	for (int ring = 0; ring <= maxRing; ring++)
+	{
+		// columns in ring cells are at least (ring - 1) cells away horizontally.
+		if (ring > 1 && static_cast<double>((ring - 1) * m_HashCellSize - m_MaxColumnRadius) >= distance)
+			break;
+
+		if (ring == 0)
+		{
+			visitCell(cx, cy);
+			continue;
+		}
+		for (int ix = cx - ring; ix <= cx + ring; ix++)
+		{
+			visitCell(ix, cy - ring);
+			visitCell(ix, cy + ring);
+		}
+		for (int iy = cy - ring + 1; iy <= cy + ring - 1; iy++)
+		{
+			visitCell(cx - ring, iy);
+			visitCell(cx + ring, iy);
+		}
+	}
+	return closestColumnId;
+}
+
+double SupportColumnField::Distance(const pmp::Point& pt) const
+{
+	double distance;
+	FindClosestColumn(pt, distance);
+	return distance;
+}
+
+pmp::dvec3 SupportColumnField::NegativeNormalizedGradient(const pmp::Point& pt) const
+{
+	double distance;
+	const auto columnId = FindClosestColumn(pt, distance);
+	if (columnId == m_Columns.size())
+		return pmp::dvec3(0.0, 0.0, 0.0);
+
+	const auto offset = ColumnAxisOffset(columnId, pt);
+	const double offsetLength = norm(offset);
+	if (offsetLength < FLT_EPSILON)
+		return pmp::dvec3(0.0, 0.0, 0.0);
+	return pmp::dvec3(-offset[0] / offsetLength, -offset[1] / offsetLength, -offset[2] / offsetLength);
+}
+
+void SupportColumnField::Transform(const pmp::mat4& transform)
+{
+	const pmp::Scalar scale = norm(pmp::vec3{ transform(0, 0), transform(1, 0), transform(2, 0) });
+	for (auto& column : m_Columns)
+	{
+		column.Position = affine_transform(transform, column.Position);
+		column.Height *= scale;
+		column.Radius *= scale;
+	}
+	const auto transformedMin = affine_transform(transform, m_Box.min());
+	const auto transformedMax = affine_transform(transform, m_Box.max());
+	m_Box = pmp::BoundingBox(min(transformedMin, transformedMax), max(transformedMin, transformedMax));
+	BuildColumnHash();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "pmp/BoundingBox.h"
+#include "pmp/MatVec.h"
+
+#include "geometry/GridUtil.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief A wrapper for the 2D position and weight of a support column
+ * \struct WeightedColumnPosition
+ */
+struct WeightedColumnPosition
+{
+	pmp::vec2 Position{}; //>! 2D position of this column
+	float Weight{ 1.0f }; //>! weight of this column
+};
+
+/**
+ * \brief Generates capsule parameters of support columns placed within the bounding box.
+ * \param box                           bounds of the support column environment.
+ * \param weightedColumnPositions       weighted 2D positions of columns in the x,y-plane (columns outside of box, or with a weight outside of [0, 1] are skipped).
+ * \param supportZLevel                 Z-level height factor for the column positions. The produced columns will be slightly lower than this within the box.
+ * \return capsule parameters of the columns.
+ * \throw std::logic_error if box is empty or supportZLevel is not within [0, 1].
+ */
+[[nodiscard]] std::vector<Geometry::CapsuleParams> GetSupportColumnCapsules(const pmp::BoundingBox& box,
+	const std::vector<WeightedColumnPosition>& weightedColumnPositions, const float& supportZLevel = 0.5f);
+
+/**
+ * \brief An implicit signed distance field of vertical support columns, evaluated analytically at query points.
+ * \class SupportColumnField
+ *
+ * The field is the distance union of the capsules produced by GetSupportColumnCapsules, i.e.: the same field as the
+ * one rasterized by GetDistanceFieldWithSupportColumns, but without a dense 3D grid. Columns are registered in a 2D
+ * spatial hash over their x,y-positions, and a query visits rings of hash cells around the query point only until the
+ * horizontal distance of the next ring exceeds the closest column found so far. The distance gradient is the
+ * (normalized) direction from the closest point of the closest column.
+ */
+class SupportColumnField
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param box                           bounds of the support column environment (also the solution bounds of the evolution).
+	 * \param weightedColumnPositions       weighted 2D positions of columns in the x,y-plane.
+	 * \param supportZLevel                 Z-level height factor for the column positions.
+	 */
+	SupportColumnField(const pmp::BoundingBox& box, const std::vector<WeightedColumnPosition>& weightedColumnPositions, const float& supportZLevel = 0.5f);
+
+	/// \brief signed distance to the closest column (Geometry::DEFAULT_SCALAR_GRID_INIT_VAL if there are no columns).
+	[[nodiscard]] double Distance(const pmp::Point& pt) const;
+
+	/// \brief normalized negative gradient of the distance field (zero vector if there are no columns or pt is on a column axis).
+	[[nodiscard]] pmp::dvec3 NegativeNormalizedGradient(const pmp::Point& pt) const;
+
+	/**
+	 * \brief Transforms the columns and their bounds by a similarity transformation (uniform scale and translation).
+	 * \param transform    transformation matrix.
+	 *
+	 * NOTE: Distance values scale together with the geometry.
+	 */
+	void Transform(const pmp::mat4& transform);
+
+	/// \brief bounds of the support column environment.
+	[[nodiscard]] const pmp::BoundingBox& Box() const { return m_Box; }
+
+	/// \brief the number of columns.
+	[[nodiscard]] size_t NColumns() const { return m_Columns.size(); }
+
+private:
+	/// \brief (Re)builds m_ColumnHash from m_Columns.
+	void BuildColumnHash();
+
+	/// \brief Returns the hash key of a 2D hash cell.
+	[[nodiscard]] static uint64_t HashKey(const int& ix, const int& iy);
+
+	/**
+	 * \brief Finds the closest column to a given point.
+	 * \param pt           query point.
+	 * \param distance     signed distance to the closest column.
+	 * \return index of the closest column (m_Columns.size() if there are no columns).
+	 */
+	size_t FindClosestColumn(const pmp::Point& pt, double& distance) const;
+
+	/// \brief Returns the vector from the closest point of the axis of a column to pt.
+	[[nodiscard]] pmp::vec3 ColumnAxisOffset(const size_t& columnId, const pmp::Point& pt) const;
+
+	pmp::BoundingBox m_Box{}; //>! bounds of the support column environment.
+	std::vector<Geometry::CapsuleParams> m_Columns{}; //>! capsules of the columns.
+	float m_MaxColumnRadius{ 0.0f }; //>! max radius of all columns.
+
+	float m_HashCellSize{ 1.0f }; //>! size of a 2D hash cell.
+	pmp::vec2 m_HashOrigin{}; //>! origin of hash cell indices.
+	int m_MinHashIx{ 0 }, m_MaxHashIx{ -1 }, m_MinHashIy{ 0 }, m_MaxHashIy{ -1 }; //>! index range of occupied hash cells.
+	std::unordered_map<uint64_t, std::vector<unsigned int>> m_ColumnHash{}; //>! column indices of occupied hash cells.
+};
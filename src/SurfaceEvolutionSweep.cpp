@@ -0,0 +1,45 @@
+#include "SurfaceEvolutionSweep.h"
+
+#include <stdexcept>
+#include <string>
+
+std::vector<SurfaceEvolutionSettings> CreateSurfaceEvolutionVariants(const SurfaceEvolutionSettings& baseSettings,
+	const std::vector<AdvectionDiffusionParameters>& adParamsVariants, const std::vector<MeshTopologySettings>& topoParamsVariants)
+{
+	const auto& adParamsList = (adParamsVariants.empty() ? std::vector{ baseSettings.ADParams } : adParamsVariants);
+	const auto& topoParamsList = (topoParamsVariants.empty() ? std::vector{ baseSettings.TopoParams } : topoParamsVariants);
+
+	std::vector<SurfaceEvolutionSettings> variants{};
+	variants.reserve(adParamsList.size() * topoParamsList.size());
+	for (size_t i = 0; i < adParamsList.size(); i++)
+	{
+		for (size_t j = 0; j < topoParamsList.size(); j++)
+		{
+			auto& variant = variants.emplace_back(baseSettings);
+			variant.ProcedureName = baseSettings.ProcedureName + "_AD" + std::to_string(i) + "_Topo" + std::to_string(j);
+			variant.ADParams = adParamsList[i];
+			variant.TopoParams = topoParamsList[j];
+		}
+	}
+	return variants;
+}
+
+std::vector<EvolutionJobResult> RunSurfaceEvolutionSweep(const Geometry::ScalarGrid& field, const float& fieldExpansionFactor,
+	const std::vector<SurfaceEvolutionSettings>& variants, const EvolutionSchedulerSettings& schedulerSettings)
+{
+	if (variants.empty())
+		throw std::invalid_argument("RunSurfaceEvolutionSweep: no variants to evolve!\n");
+
+	const auto stabilizedField = PrepareStabilizedEvolutionField(field, fieldExpansionFactor, variants.front());
+	for (const auto& variant : variants)
+	{
+		// all variants are verified before any of them starts.
+		if (!IsStabilizationCompatible(*stabilizedField, variant))
+			throw std::invalid_argument("RunSurfaceEvolutionSweep: variant " + variant.ProcedureName + " differs in stabilization from " + variants.front().ProcedureName + "!\n");
+	}
+
+	EvolutionJobScheduler scheduler(schedulerSettings);
+	for (const auto& variant : variants)
+		scheduler.SubmitSurfaceEvolution(stabilizedField, variant);
+	return scheduler.WaitAll();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "geometry/Grid.h"
+
+#include "SurfaceEvolver.h"
+#include "EvolutionJobScheduler.h"
+
+#include <vector>
+
+/**
+ * \brief Creates variants of surface evolution settings for all combinations of given advection-diffusion parameters
+ *        and mesh topology settings.
+ * \param baseSettings           settings shared by all variants.
+ * \param adParamsVariants       advection-diffusion parameters to be combined (if empty, baseSettings.ADParams is used).
+ * \param topoParamsVariants     mesh topology settings to be combined (if empty, baseSettings.TopoParams is used).
+ * \return variants named baseSettings.ProcedureName + "_AD<i>_Topo<j>".
+ */
+[[nodiscard]] std::vector<SurfaceEvolutionSettings> CreateSurfaceEvolutionVariants(const SurfaceEvolutionSettings& baseSettings,
+	const std::vector<AdvectionDiffusionParameters>& adParamsVariants, const std::vector<MeshTopologySettings>& topoParamsVariants);
+
+/**
+ * \brief Evolves surfaces for multiple variants of settings within the same field.
+ * \param field                   pre-computed or loaded scalar field environment.
+ * \param fieldExpansionFactor    the factor by which target bounds are expanded (multiplying original bounds min dimension).
+ * \param variants                surface evolution settings of all variants.
+ * \param schedulerSettings       settings of the scheduler running the variants in parallel.
+ * \return results of all variants (in the order of variants).
+ * \throw std::invalid_argument if variants is empty or if a variant differs in the stabilization (TimeStep,
+ *        IcoSphereSubdivisionLevel, MinTargetSize, MaxTargetSize, TargetOrigin).
+ *
+ * The field is repaired, stabilized and its gradient computed only once, and the resulting immutable field is shared
+ * by all variants, so that each variant only pays for its own surface.
+ */
+[[nodiscard]] std::vector<EvolutionJobResult> RunSurfaceEvolutionSweep(const Geometry::ScalarGrid& field, const float& fieldExpansionFactor,
+	const std::vector<SurfaceEvolutionSettings>& variants, const EvolutionSchedulerSettings& schedulerSettings);
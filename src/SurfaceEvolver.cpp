@@ -9,6 +9,8 @@
 #include "geometry/IcoSphereBuilder.h"
 #include "geometry/MeshAnalysis.h"
 
+#include "EvolutionEngine.h"
+
 //#include "ConversionUtils.h"
 #include <fstream>
 
@@ -20,9 +22,6 @@ constexpr float ICO_SPHERE_RADIUS_FACTOR = 0.4f;
 /// \brief if true individual steps of surface evolution will be printed out into a given stream.
 #define REPORT_EVOL_STEPS false // Note: may affect performance
 
-/// \brief if true, upon computing trilinear system solution, new vertices are verified for belonging in the field bounds.
-#define VERIFY_SOLUTION_WITHIN_BOUNDS false // Note: useful for detecting numerical explosions of the solution.
-
 /// \brief repairs infinities and nan values of the input grid.
 #define REPAIR_INPUT_GRID true //Note: very useful! You never know what field we use! Infinities and nans lead to the Eigen::NoConvergence error code whose cause is difficult to find!
 
@@ -67,29 +66,124 @@ size_t SurfaceEvolver::DetectFeatures(const FeatureDetectionType& type) const
 
 // ================================================================================================
 
-SurfaceEvolver::SurfaceEvolver(const Geometry::ScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
-	: m_EvolSettings(settings), m_Field(std::make_shared<Geometry::ScalarGrid>(field)), m_ExpansionFactor(fieldExpansionFactor)
+namespace
 {
+	/// \brief The stabilization of the numerical method determined by surface evolution settings.
+	struct Stabilization
+	{
+		pmp::Scalar StartingSurfaceRadius{ 1.0f };
+		pmp::Scalar ScalingFactor{ 1.0f };
+		pmp::vec3 TargetOrigin{};
+	};
+
+	[[nodiscard]] Stabilization ComputeStabilization(const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
+	{
+		const float icoSphereRadius = ICO_SPHERE_RADIUS_FACTOR *
+			(settings.MinTargetSize + (0.5f + fieldExpansionFactor) * settings.MaxTargetSize);
+		// >>> scaling factor value is intended for stabilization of the numerical method.
+		const float scalingFactor = GetStabilizationScalingFactor(settings.TimeStep, icoSphereRadius, settings.IcoSphereSubdivisionLevel);
+		return { icoSphereRadius, scalingFactor, settings.TargetOrigin };
+	}
+
+	/// \brief Repairs, transforms and scales a given field (taking its ownership), and computes its normalized negative gradient.
+	[[nodiscard]] std::shared_ptr<const StabilizedEvolutionField> StabilizeField(
+		Geometry::ScalarGrid&& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
+	{
+		if (!field.IsValid())
+			throw std::invalid_argument("PrepareStabilizedEvolutionField: field is invalid! Terminating!\n");
 #if REPAIR_INPUT_GRID
-	Geometry::RepairScalarGrid(*m_Field); // repair needed in case of invalid cell values.
+		Geometry::RepairScalarGrid(field); // repair needed in case of invalid cell values.
+#endif
+
+		// transform grid
+		// >>> uniform scale to ensure numerical method's stability.
+		// >>> translation to origin for fields not centered at (0,0,0).
+		const auto stabilization = ComputeStabilization(fieldExpansionFactor, settings);
+		const float scalingFactor = stabilization.ScalingFactor;
+		const auto& origin = stabilization.TargetOrigin;
+#if REPORT_EVOL_STEPS
+		std::cout << "Stabilization Scaling Factor: " << scalingFactor << ",\n";
+		std::cout << "Target Origin: {" << origin[0] << ", " << origin[1] << ", " << origin[2] << "},\n";
 #endif
-	m_ImplicitLaplacianFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::laplace_implicit_barycentric : pmp::laplace_implicit_voronoi);
-	m_LaplacianAreaFunction =
-		(m_EvolSettings.LaplacianType == MeshLaplacian::Barycentric ?
-			pmp::voronoi_area_barycentric : pmp::voronoi_area);	
+		const pmp::mat4 transfMatrixGeomScale{
+			scalingFactor, 0.0f, 0.0f, 0.0f,
+			0.0f, scalingFactor, 0.0f, 0.0f,
+			0.0f, 0.0f, scalingFactor, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		};
+		const pmp::mat4 transfMatrixGeomMove{
+			1.0f, 0.0f, 0.0f, -origin[0],
+			0.0f, 1.0f, 0.0f, -origin[1],
+			0.0f, 0.0f, 1.0f, -origin[2],
+			0.0f, 0.0f, 0.0f, 1.0f
+		};
+		const auto transfMatrixFull = transfMatrixGeomScale * transfMatrixGeomMove;
+
+		field *= transfMatrixFull; // field needs to be moved to (0,0,0) and also scaled.
+		field *= static_cast<double>(scalingFactor); // scale also distance values.
+
+		auto result = std::make_shared<StabilizedEvolutionField>();
+		result->NegGradient = std::make_shared<const Geometry::VectorGrid>(Geometry::ComputeNormalizedNegativeGradient(field));
+		result->Field = std::make_shared<const Geometry::ScalarGrid>(std::move(field));
+		result->ExpansionFactor = fieldExpansionFactor;
+		result->StartingSurfaceRadius = stabilization.StartingSurfaceRadius;
+		result->ScalingFactor = scalingFactor;
+		result->TargetOrigin = origin;
+		result->TransformToOriginal = inverse(transfMatrixFull);
+
+		// >>>>> Scaled field (use when debugging) <<<<<<
+		//ExportToVTI(settings.OutputPath + settings.ProcedureName + "_scaledField", *result->Field);
+		return result;
+	}
+} // anonymous namespace
+
+std::shared_ptr<const StabilizedEvolutionField> PrepareStabilizedEvolutionField(
+	const Geometry::ScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
+{
+	Geometry::ScalarGrid fieldCopy = field;
+	return StabilizeField(std::move(fieldCopy), fieldExpansionFactor, settings);
+}
+
+bool IsStabilizationCompatible(const StabilizedEvolutionField& field, const SurfaceEvolutionSettings& settings)
+{
+	// the same computation from the same inputs yields bitwise identical values.
+	const auto stabilization = ComputeStabilization(field.ExpansionFactor, settings);
+	return stabilization.StartingSurfaceRadius == field.StartingSurfaceRadius &&
+		stabilization.ScalingFactor == field.ScalingFactor &&
+		stabilization.TargetOrigin == field.TargetOrigin;
+}
+
+// ================================================================================================
+
+SurfaceEvolver::SurfaceEvolver(const Geometry::ScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings)
+	: m_EvolSettings(settings), m_InputField(std::make_shared<Geometry::ScalarGrid>(field)), m_ExpansionFactor(fieldExpansionFactor)
+{
+}
+
+SurfaceEvolver::SurfaceEvolver(const std::shared_ptr<const StabilizedEvolutionField>& field, const SurfaceEvolutionSettings& settings)
+	: m_EvolSettings(settings), m_StabilizedField(field)
+{
+	if (!m_StabilizedField || !m_StabilizedField->Field || !m_StabilizedField->NegGradient)
+		throw std::invalid_argument("SurfaceEvolver::SurfaceEvolver: stabilized field not set!\n");
+	if (!IsStabilizationCompatible(*m_StabilizedField, m_EvolSettings))
+		throw std::invalid_argument("SurfaceEvolver::SurfaceEvolver: settings of " + m_EvolSettings.ProcedureName + " are not compatible with the stabilization of the shared field!\n");
+	m_ExpansionFactor = m_StabilizedField->ExpansionFactor;
 }
 
 // ================================================================================================
 
 void SurfaceEvolver::Preprocess()
 {
-	auto& field = *m_Field;
+	if (!m_StabilizedField)
+	{
+		// the evolver owns its field copy, so it is stabilized in place.
+		m_StabilizedField = StabilizeField(std::move(*m_InputField), m_ExpansionFactor, m_EvolSettings);
+		m_InputField.reset();
+	}
+	const auto& stabilizedField = *m_StabilizedField;
 
 	// build ico-sphere
-	const float icoSphereRadius = ICO_SPHERE_RADIUS_FACTOR * 
-		(m_EvolSettings.MinTargetSize + (0.5f + m_ExpansionFactor) * m_EvolSettings.MaxTargetSize);
+	const float icoSphereRadius = stabilizedField.StartingSurfaceRadius;
 	m_StartingSurfaceRadius = icoSphereRadius;
 #if REPORT_EVOL_STEPS
 	std::cout << "Ico-Sphere Radius: " << icoSphereRadius << ",\n";
@@ -100,41 +194,22 @@ void SurfaceEvolver::Preprocess()
 	icoBuilder.BuildPMPSurfaceMesh();
 	m_EvolvingSurface = std::make_shared<pmp::SurfaceMesh>(icoBuilder.GetPMPSurfaceMeshResult());
 
-	// transform mesh and grid
-	// >>> uniform scale to ensure numerical method's stability.
-	// >>> translation to origin for fields not centered at (0,0,0).
-	// >>> scaling factor value is intended for stabilization of the numerical method.
-	const float scalingFactor = GetStabilizationScalingFactor(m_EvolSettings.TimeStep, icoSphereRadius, icoSphereSubdiv);
+	// transform mesh (the field is already transformed)
+	const float scalingFactor = stabilizedField.ScalingFactor;
 	m_ScalingFactor = scalingFactor;
 	m_EvolSettings.FieldIsoLevel *= static_cast<double>(scalingFactor);
-	const auto origin = m_EvolSettings.TargetOrigin;
-#if REPORT_EVOL_STEPS
-	std::cout << "Stabilization Scaling Factor: " << scalingFactor << ",\n";
-	std::cout << "Target Origin: {" << origin[0] << ", " << origin[1] << ", " << origin[2] << "},\n";
-#endif
+	m_TransformToOriginal = stabilizedField.TransformToOriginal;
 	const pmp::mat4 transfMatrixGeomScale{
 		scalingFactor, 0.0f, 0.0f, 0.0f,
 		0.0f, scalingFactor, 0.0f, 0.0f,
 		0.0f, 0.0f, scalingFactor, 0.0f,
 		0.0f, 0.0f, 0.0f, 1.0f
 	};
-	const pmp::mat4 transfMatrixGeomMove{
-		1.0f, 0.0f, 0.0f, -origin[0],
-		0.0f, 1.0f, 0.0f, -origin[1],
-		0.0f, 0.0f, 1.0f, -origin[2],
-		0.0f, 0.0f, 0.0f, 1.0f
-	};
-	const auto transfMatrixFull = transfMatrixGeomScale * transfMatrixGeomMove;
-	m_TransformToOriginal = inverse(transfMatrixFull);
-
 	(*m_EvolvingSurface) *= transfMatrixGeomScale; // ico sphere is already centered at (0,0,0).
-	field *= transfMatrixFull; // field needs to be moved to (0,0,0) and also scaled.
-	field *= static_cast<double>(scalingFactor); // scale also distance values.
 
-	// >>>>> Scaled geometry & field (use when debugging) <<<<<<
-	//ExportToVTI(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_scaledField", *m_Field);
+	// >>>>> Scaled geometry (use when debugging) <<<<<<
 	//pmp::SurfaceMesh scaledTargetMesh = *m_EvolSettings.DO_NOT_KEEP_ptrTargetSurface;
-	//scaledTargetMesh *= transfMatrixFull;
+	//scaledTargetMesh *= inverse(m_TransformToOriginal);
 	//scaledTargetMesh.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_stableScale.obj");
 }
 
@@ -162,237 +237,180 @@ double SurfaceEvolver::AdvectionDistanceWeightFunction(const double& distanceAtV
 
 void SurfaceEvolver::ExportSurface(const unsigned int& tId, const bool& isResult, const bool& transformToOriginal) const
 {
+	m_DerivedProperties.UpdateAll(*m_EvolvingSurface);
 	const std::string connectingName = (isResult ? "_Result" : "_Evol_" + std::to_string(tId));
+	if (m_AsyncExporter)
+	{
+		const std::optional<pmp::mat4> transform = (transformToOriginal ? std::optional<pmp::mat4>(m_TransformToOriginal) : std::nullopt);
+		m_AsyncExporter->Submit(*m_EvolvingSurface, m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, transform, m_OutputMeshIOFlags);
+		return;
+	}
 	if (!transformToOriginal)
 	{
-		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
+		m_EvolvingSurface->write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 	    return;
 	}
 	auto exportedSurface = *m_EvolvingSurface;
 	exportedSurface *= m_TransformToOriginal;
-	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension);
-}
-
-void SurfaceEvolver::ComputeTriangleMetrics() const
-{
-	for (const auto& metricName : m_EvolSettings.TriMetrics)
-	{
-		if (!Geometry::IsMetricRegistered(metricName))
-			continue;
-
-		const auto metricFunction = Geometry::IdentifyMetricFunction(metricName);
-
-		if (!metricFunction(*m_EvolvingSurface))
-		{
-			std::cerr << "SurfaceEvolver::ComputeTriangleMetrics: [WARNING] Computation of metric " << metricName << " finished with errors!\n";
-		}
-	}
+	exportedSurface.write(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + connectingName + m_OutputMeshExtension, m_OutputMeshIOFlags);
 }
 
 // ================================================================================================
+// .................................. EvolutionEngine policies ....................................
 
-void SurfaceEvolver::Evolve()
+/// \brief Validates the input field and generates the stabilized starting ico-sphere.
+class SurfaceEvolver::InitialSurfacePolicy
 {
-	if (!m_Field)
-		throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
-	if (!m_Field->IsValid())
-		throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
-
-	const auto& field = *m_Field;
+public:
+	explicit InitialSurfacePolicy(SurfaceEvolver& evolver) : m_Evolver(evolver) {}
 
-	Preprocess();
+	pmp::SurfaceMesh& Prepare()
+	{
+		if (!m_Evolver.m_InputField && !m_Evolver.m_StabilizedField)
+			throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field not set! Terminating!\n");
+		if (m_Evolver.m_InputField && !m_Evolver.m_InputField->IsValid())
+			throw std::invalid_argument("SurfaceEvolver::Evolve: m_Field is invalid! Terminating!\n");
 
-	if (!m_EvolvingSurface)
-		throw std::invalid_argument("SurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+		m_Evolver.Preprocess();
 
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-	const auto& fieldBox = field.Box();
-#endif
-	const auto fieldNegGradient = Geometry::ComputeNormalizedNegativeGradient(field);
-
-	const auto& NSteps = m_EvolSettings.NSteps;
-	auto tStep = m_EvolSettings.TimeStep;
-
-	// ........ evaluate edge lengths for remeshing ....................
-	const auto subdiv = static_cast<float>(m_EvolSettings.IcoSphereSubdivisionLevel);
-	const float r = m_StartingSurfaceRadius * m_ScalingFactor;
-	constexpr float baseIcoHalfAngle = 2.0f * M_PI / 10.0f;
-	const float minEdgeMultiplier = m_EvolSettings.TopoParams.MinEdgeMultiplier;
-	//const float phi = (1.0f + sqrt(5.0f)) / 2.0f; /// golden ratio.
-	//auto minEdgeLength = minEdgeMultiplier * (2.0f * r / (sqrt(phi * sqrt(5.0f)) * subdiv)); // from icosahedron edge length
-	auto minEdgeLength = minEdgeMultiplier * 2.0f * r * sin(baseIcoHalfAngle * pow(2.0f, -subdiv)); // from icosahedron edge length
-	auto maxEdgeLength = 4.0f * minEdgeLength;
-	auto approxError = 0.25f * (minEdgeLength + maxEdgeLength);
-	//auto approxError = 2.0f * minEdgeLength;
-#if REPORT_EVOL_STEPS
-	std::cout << "minEdgeLength for remeshing: " << minEdgeLength << "\n";
-#endif
-	// .................................................................
+		if (!m_Evolver.m_EvolvingSurface)
+			throw std::invalid_argument("SurfaceEvolver::Evolve: m_EvolvingSurface not set! Terminating!\n");
+		return *m_Evolver.m_EvolvingSurface;
+	}
 
-	// DISCLAIMER: the dimensionality of the system depends on the number of mesh vertices which can change if remeshing is used.
-	auto NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-	SparseMatrix sysMat(NVertices, NVertices);
-	Eigen::MatrixXd sysRhs(NVertices, 3);
-	auto vDistance = m_EvolvingSurface->add_vertex_property<pmp::Scalar>("v:distance"); // vertex property for distance field values.
-	auto vFeature = m_EvolvingSurface->vertex_property<bool>("v:feature", false);
-	auto vIsFeatureVal = m_EvolvingSurface->vertex_property<pmp::Scalar>("v:isFeature", -1.0f);
+	[[nodiscard]] pmp::BoundingBox SolutionBounds() const { return m_Evolver.m_StabilizedField->Field->Box(); }
 
-	// property container for surface vertex normals
-	pmp::VertexProperty<pmp::Point> vNormalsProp{};
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetMatrix("TransformToOriginal", m_Evolver.m_TransformToOriginal);
+		checkpoint.SetValue("ScalingFactor", static_cast<double>(m_Evolver.m_ScalingFactor));
+	}
 
-	// ----------- System fill function --------------------------------
-	const auto fillMatrixAndRHSTriplesFromMesh = [&]()
+	void LoadState(const EvolutionCheckpoint& checkpoint)
 	{
-		std::vector<Eigen::Triplet<double>> tripletList;
-		tripletList.reserve(static_cast<size_t>(NVertices) * 6);  // Assuming an average of 6 entries per vertex
+		m_Evolver.m_TransformToOriginal = checkpoint.GetMatrix("TransformToOriginal");
+		m_Evolver.m_ScalingFactor = static_cast<pmp::Scalar>(checkpoint.GetValue("ScalingFactor"));
+	}
 
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPosToUpdate = m_EvolvingSurface->position(v);
-
-			if ((m_EvolSettings.IdentityForBoundaryVertices && m_EvolvingSurface->is_boundary(v)) ||
-				(m_EvolSettings.IdentityForFeatureVertices && vFeature[v]))
-			{
-				// freeze boundary/feature vertices
-				const Eigen::Vector3d vertexRhs = vPosToUpdate;
-				sysRhs.row(v.idx()) = vertexRhs;
-				tripletList.emplace_back(Eigen::Triplet<double>(v.idx(), v.idx(), 1.0));
-				continue;
-			}
-
-			const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, fieldNegGradient);
-			const auto vNormal = vNormalsProp[v]; // vertex unit normal
-
-			const double epsilonCtrlWeight = LaplacianDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel);
-			const double etaCtrlWeight = AdvectionDistanceWeightFunction(static_cast<double>(vDistance[v]) - m_EvolSettings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
-
-			const Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
-			sysRhs.row(v.idx()) = vertexRhs;
-			const float tanRedistWeight = static_cast<double>(m_EvolSettings.TangentialVelocityWeight) * epsilonCtrlWeight;
-			if (tanRedistWeight > 0.0f)
-			{
-				// compute tangential velocity
-				const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(*m_EvolvingSurface, v, vNormal, tanRedistWeight);
-				sysRhs.row(v.idx()) += tStep * Eigen::Vector3d(vTanVelocity);
-			}
-
-			const auto laplaceWeightInfo = m_ImplicitLaplacianFunction(*m_EvolvingSurface, v); // Laplacian weights
-			tripletList.emplace_back(Eigen::Triplet<double>(v.idx(), v.idx(), 1.0 + tStep * epsilonCtrlWeight * static_cast<double>(laplaceWeightInfo.weightSum)));
-
-			for (const auto& [w, weight] : laplaceWeightInfo.vertexWeights)
-			{
-				tripletList.emplace_back(Eigen::Triplet<double>(v.idx(), w.idx(), -1.0 * tStep * epsilonCtrlWeight * static_cast<double>(weight)));
-			}
-		}
+private:
+	SurfaceEvolver& m_Evolver;
+};
 
-		// After the loop
-		sysMat.setFromTriplets(tripletList.begin(), tripletList.end());
-	};
-	// -----------------------------------------------------------------
+/// \brief Evaluates distance-weighted advection-diffusion rows of the evolution system.
+class SurfaceEvolver::WeightPolicy
+{
+public:
+	explicit WeightPolicy(const SurfaceEvolver& evolver) : m_Evolver(evolver) {}
 
-	// write initial surface
-	auto coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
-#if REPORT_EVOL_STEPS
-	std::ofstream fileOStreamMins(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMins.txt");
-	std::ofstream fileOStreamMeans(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMeans.txt");
-	std::ofstream fileOStreamMaxes(m_EvolSettings.OutputPath + m_EvolSettings.ProcedureName + "_CoVolMaxes.txt");
-	std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-	fileOStreamMins << coVolStats.Min << ", ";
-	fileOStreamMeans << coVolStats.Mean << ", ";
-	fileOStreamMaxes << coVolStats.Max << ", ";
-#endif
-	// set initial surface vertex properties
-	for (const auto v : m_EvolvingSurface->vertices())
+	void Initialize(pmp::SurfaceMesh& mesh)
 	{
-		const auto vPos = m_EvolvingSurface->position(v);
-		const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-		vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-		vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
+		m_FieldNegGradient = m_Evolver.m_StabilizedField->NegGradient; // computed once per (possibly shared) field.
+		m_VDistance = mesh.vertex_property<pmp::Scalar>(vertexDistancePropertyKey); // vertex property for distance field values (restored if resuming).
+		m_VFeature = mesh.vertex_property<bool>(vertexFeaturePropertyKey, false);
+		m_VIsFeatureVal = mesh.vertex_property<pmp::Scalar>("v:isFeature", -1.0f);
 	}
-	Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-	Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface, m_EvolSettings.TopoParams.PrincipalCurvatureFactor);
-	ComputeTriangleMetrics();
-	if (m_EvolSettings.ExportSurfacePerTimeStep)
-		ExportSurface(0);
-
-	bool shouldDetectFeatures = false; // a changeable flag evaluated by ShouldDetectFeatures function.
-
-	// -------------------------------------------------------------------------------------------------------------
-	// ........................................ main loop ..........................................................
-	// -------------------------------------------------------------------------------------------------------------
-	for (unsigned int ti = 1; ti <= NSteps; ti++)
+
+	void PrepareStep(const pmp::SurfaceMesh& mesh)
 	{
-#if REPORT_EVOL_STEPS
-		std::cout << "time step id: " << ti << "/" << NSteps << ", time: " << tStep * ti << " "
-		<< ", Procedure Name: " << m_EvolSettings.ProcedureName << "\n";
-		std::cout << "pmp::Normals::compute_vertex_normals ... ";
-#endif
-		pmp::Normals::compute_vertex_normals(*m_EvolvingSurface);
-		vNormalsProp = m_EvolvingSurface->vertex_property<pmp::Point>("v:normal");
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "fillMatrixAndRHSTriplesFromMesh for " << NVertices << " vertices ... ";
-#endif
+		m_VNormals = mesh.get_vertex_property<pmp::Point>(vertexNormalPropertyKey);
+	}
 
-		// prepare matrix & rhs
-		fillMatrixAndRHSTriplesFromMesh();
+	[[nodiscard]] EvolutionSystemRow EvaluateRow(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& tStep) const
+	{
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto vPosToUpdate = mesh.position(v);
 
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Solving linear system ... ";
-#endif
-		// solve
-		Eigen::BiCGSTAB<SparseMatrix, Eigen::IncompleteLUT<double>> solver(sysMat);
-		Eigen::MatrixXd x = solver.solve(sysRhs);
-		if (solver.info() != Eigen::Success)
+		if ((settings.IdentityForBoundaryVertices && mesh.is_boundary(v)) ||
+			(settings.IdentityForFeatureVertices && m_VFeature[v]))
 		{
-			const std::string msg = "\nSurfaceEvolver::Evolve: solver.info() != Eigen::Success for time step id: "
-				+ std::to_string(ti) + ", Error code: " + InterpretSolverErrorCode(solver.info()) + "\n";
-			std::cerr << msg;
-			throw std::runtime_error(msg);
+			// freeze boundary/feature vertices
+			const Eigen::Vector3d vertexRhs = vPosToUpdate;
+			return { vertexRhs, 0.0, true };
 		}
-#if REPORT_EVOL_STEPS
-		std::cout << "done\n";
-		std::cout << "Updating vertex positions ... ";
-#endif
 
-		// update vertex positions & verify mesh within bounds
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		size_t nVertsOutOfBounds = 0;
-#endif
-		for (unsigned int i = 0; i < NVertices; i++)
+		const auto vNegGradDistanceToTarget = Geometry::TrilinearInterpolateVectorValue(vPosToUpdate, *m_FieldNegGradient);
+		const auto vNormal = m_VNormals[v]; // vertex unit normal
+
+		const double epsilonCtrlWeight = m_Evolver.LaplacianDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel);
+		const double etaCtrlWeight = m_Evolver.AdvectionDistanceWeightFunction(static_cast<double>(m_VDistance[v]) - settings.FieldIsoLevel, vNegGradDistanceToTarget, vNormal);
+
+		Eigen::Vector3d vertexRhs = vPosToUpdate + tStep * etaCtrlWeight * vNormal;
+		const float tanRedistWeight = static_cast<double>(settings.TangentialVelocityWeight) * epsilonCtrlWeight;
+		if (tanRedistWeight > 0.0f)
 		{
-			const auto newPos = x.row(i);
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-			if (!fieldBox.Contains(newPos))
-			{
-				if (nVertsOutOfBounds == 0) std::cerr << "\n";
-				std::cerr << "SurfaceEvolver::Evolve: vertex " << i << " out of field bounds!\n";
-				nVertsOutOfBounds++;
-			}
-#endif
-			m_EvolvingSurface->position(pmp::Vertex(i)) = x.row(i);
+			// compute tangential velocity
+			const auto vTanVelocity = ComputeTangentialUpdateVelocityAtVertex(mesh, v, vNormal, tanRedistWeight);
+			vertexRhs += tStep * Eigen::Vector3d(vTanVelocity);
 		}
-#if VERIFY_SOLUTION_WITHIN_BOUNDS
-		if ((m_EvolSettings.DoRemeshing && nVertsOutOfBounds > static_cast<double>(NVertices) * m_EvolSettings.MaxFractionOfVerticesOutOfBounds) ||
-			(!m_EvolSettings.DoRemeshing && nVertsOutOfBounds > 0))
+		return { vertexRhs, epsilonCtrlWeight, false };
+	}
+
+	void UpdateVertexProperties(pmp::SurfaceMesh& mesh)
+	{
+		const auto& field = *m_Evolver.m_StabilizedField->Field;
+		for (const auto v : mesh.vertices())
 		{
-			std::cerr << "SurfaceEvolver::Evolve: found " << nVertsOutOfBounds << " vertices out of bounds! Terminating!\n";
-			break;
+			const auto vPos = mesh.position(v);
+			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
+			m_VDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
+			m_VIsFeatureVal[v] = (m_VFeature[v] ? 1.0f : -1.0f);
 		}
-#endif
+	}
+
+private:
+	const SurfaceEvolver& m_Evolver;
+	std::shared_ptr<const Geometry::VectorGrid> m_FieldNegGradient{ nullptr }; //>! normalized negative gradient of the distance field.
+	pmp::VertexProperty<pmp::Scalar> m_VDistance{};
+	pmp::VertexProperty<bool> m_VFeature{};
+	pmp::VertexProperty<pmp::Scalar> m_VIsFeatureVal{};
+	pmp::VertexProperty<pmp::Point> m_VNormals{};
+};
+
+/// \brief Performs feature detection, quality-triggered remeshing and the decay of remeshing lengths and time step.
+class SurfaceEvolver::TopologyPolicy : public DerivedPropertiesTopologyPolicy
+{
+public:
+	explicit TopologyPolicy(SurfaceEvolver& evolver)
+		: DerivedPropertiesTopologyPolicy(evolver.m_DerivedProperties), m_Evolver(evolver) {}
+
+	void Initialize(const pmp::SurfaceMesh& /*mesh*/)
+	{
+		// ........ derived properties (computed only when consumed) .......
+		auto& properties = m_Evolver.m_DerivedProperties;
+		properties.Clear();
+		properties.Register("dihedralAngles", MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {}, Geometry::ComputeEdgeDihedralAngles);
+		properties.Register("curvatures", MeshPropertyInput::Positions | MeshPropertyInput::Connectivity, {},
+			[factor = m_Evolver.m_EvolSettings.TopoParams.PrincipalCurvatureFactor](pmp::SurfaceMesh& m) { Geometry::ComputeVertexCurvaturesAndRelatedProperties(m, factor); });
+		RegisterTriangleMetrics(properties, m_Evolver.m_EvolSettings.TriMetrics);
+
+		// ........ evaluate edge lengths for remeshing ....................
+		const auto& settings = m_Evolver.m_EvolSettings;
+		const auto subdiv = static_cast<float>(settings.IcoSphereSubdivisionLevel);
+		const float r = m_Evolver.m_StartingSurfaceRadius * m_Evolver.m_ScalingFactor;
+		constexpr float baseIcoHalfAngle = 2.0f * M_PI / 10.0f;
+		const float minEdgeMultiplier = settings.TopoParams.MinEdgeMultiplier;
+		//const float phi = (1.0f + sqrt(5.0f)) / 2.0f; /// golden ratio.
+		//m_MinEdgeLength = minEdgeMultiplier * (2.0f * r / (sqrt(phi * sqrt(5.0f)) * subdiv)); // from icosahedron edge length
+		m_MinEdgeLength = minEdgeMultiplier * 2.0f * r * sin(baseIcoHalfAngle * pow(2.0f, -subdiv)); // from icosahedron edge length
+		m_MaxEdgeLength = 4.0f * m_MinEdgeLength;
+		m_ApproxError = 0.25f * (m_MinEdgeLength + m_MaxEdgeLength);
+		//m_ApproxError = 2.0f * m_MinEdgeLength;
 #if REPORT_EVOL_STEPS
-		std::cout << "done\n";
+		std::cout << "minEdgeLength for remeshing: " << m_MinEdgeLength << "\n";
 #endif
+		m_ShouldDetectFeatures = false;
+	}
 
-		// --------------------------------------------------------------------
-
-		if (m_EvolSettings.DoFeatureDetection && shouldDetectFeatures)
+	bool Apply(pmp::SurfaceMesh& mesh, const unsigned int& ti, double& tStep)
+	{
+		auto& settings = m_Evolver.m_EvolSettings;
+		if (settings.DoFeatureDetection && m_ShouldDetectFeatures)
 		{
 #if REPORT_EVOL_STEPS
 			std::cout << "Detecting Features ...";
 #endif
-			const auto nEdges = DetectFeatures(m_EvolSettings.TopoParams.FeatureType);
+			const ScopedPhaseTrace featureTrace("FeatureDetection");
+			const auto nEdges = m_Evolver.DetectFeatures(settings.TopoParams.FeatureType);
 #if REPORT_EVOL_STEPS
 			std::cout << "done. " << nEdges << " feature edges detected.\n";
 #endif
@@ -400,22 +418,31 @@ void SurfaceEvolver::Evolve()
 
 		// --------------------------------------------------------------------
 
-		const auto meshQualityProp = m_EvolvingSurface->get_vertex_property<float>("v:equilateralJacobianCondition");
-		if (m_EvolSettings.DoRemeshing && IsRemeshingNecessary(meshQualityProp.vector()))
+		bool isRemeshed = false;
+		if (settings.DoRemeshing)
+			m_Evolver.m_DerivedProperties.Update("equilateralJacobianCondition", mesh);
+		const auto meshQualityProp = mesh.get_vertex_property<float>("v:equilateralJacobianCondition");
+		if (settings.DoRemeshing && IsRemeshingNecessary(meshQualityProp.vector()))
 		{
 			// remeshing
 #if REPORT_EVOL_STEPS
-			std::cout << "Remeshing ...";
+			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << m_MinEdgeLength << ", maxEdgeLength: " << m_MaxEdgeLength << ", approxError: " << m_ApproxError << ") ... ";
 #endif
-#if REPORT_EVOL_STEPS
-			std::cout << "pmp::Remeshing::adaptive_remeshing(minEdgeLength: " << minEdgeLength << ", maxEdgeLength: " << maxEdgeLength << ", approxError: " << approxError << ") ... ";
-#endif
-			pmp::Remeshing remeshing(*m_EvolvingSurface);
-			remeshing.adaptive_remeshing({
-				minEdgeLength, maxEdgeLength, approxError,
-				m_EvolSettings.TopoParams.NRemeshingIters,
-				m_EvolSettings.TopoParams.NTanSmoothingIters,
-				m_EvolSettings.TopoParams.UseBackProjection });
+			const ScopedPhaseTrace remeshingTrace("Remeshing");
+			pmp::Remeshing remeshing(mesh, m_RemeshingReference);
+			const pmp::AdaptiveRemeshingSettings remeshingSettings{
+				m_MinEdgeLength, m_MaxEdgeLength, m_ApproxError,
+				settings.TopoParams.NRemeshingIters,
+				settings.TopoParams.NTanSmoothingIters,
+				settings.TopoParams.UseBackProjection };
+			const auto region = (settings.TopoParams.UseLocalRemeshing ?
+				GetLowQualityRegion(mesh, settings.TopoParams.LocalRemeshingRings) : std::vector<pmp::Vertex>{});
+			if (!region.empty() && region.size() < settings.TopoParams.MaxLocalRemeshingFraction * mesh.n_vertices())
+				remeshing.local_adaptive_remeshing(remeshingSettings, region);
+			else
+				remeshing.adaptive_remeshing(remeshingSettings);
+			isRemeshed = true;
+			m_Evolver.m_DerivedProperties.Invalidate(MeshPropertyInput::Connectivity);
 #if REPORT_EVOL_STEPS
 			std::cout << "done\n";
 #endif
@@ -426,80 +453,103 @@ void SurfaceEvolver::Evolve()
 		if (ShouldAdjustRemeshingLengths(ti))
 		{
 			// shorter edges are needed for features close to the target.
-			AdjustRemeshingLengths(m_EvolSettings.TopoParams.EdgeLengthDecayFactor, minEdgeLength, maxEdgeLength, approxError);
+			AdjustRemeshingLengths(settings.TopoParams.EdgeLengthDecayFactor, m_MinEdgeLength, m_MaxEdgeLength, m_ApproxError);
 #if REPORT_EVOL_STEPS
 			std::cout << "vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv\n";
 			std::cout << "Lengths for adaptive remeshing adjusted to:\n";
-			std::cout << "min: " << minEdgeLength << ", max: " << maxEdgeLength << ", error: " << approxError << "\n";
-			std::cout << "by a factor of " << m_EvolSettings.TopoParams.EdgeLengthDecayFactor << ".\n";
+			std::cout << "min: " << m_MinEdgeLength << ", max: " << m_MaxEdgeLength << ", error: " << m_ApproxError << "\n";
+			std::cout << "by a factor of " << settings.TopoParams.EdgeLengthDecayFactor << ".\n";
 			std::cout << "time step adjustment: " << tStep << " -> ";
 #endif
-			tStep *= pow(m_EvolSettings.TopoParams.EdgeLengthDecayFactor, 2);
+			tStep *= pow(settings.TopoParams.EdgeLengthDecayFactor, 2);
 #if REPORT_EVOL_STEPS
 			std::cout << tStep << ".\n";
-			std::cout << "AdvectionMultiplier adjustment: " << m_EvolSettings.ADParams.AdvectionMultiplier << " -> ";
+			std::cout << "AdvectionMultiplier adjustment: " << settings.ADParams.AdvectionMultiplier << " -> ";
 #endif
-			m_EvolSettings.ADParams.AdvectionMultiplier /= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
-			//m_EvolSettings.ADParams.AdvectionSineMultiplier /= m_EvolSettings.TopoParams.EdgeLengthDecayFactor;
+			settings.ADParams.AdvectionMultiplier /= settings.TopoParams.EdgeLengthDecayFactor;
+			//settings.ADParams.AdvectionSineMultiplier /= settings.TopoParams.EdgeLengthDecayFactor;
 #if REPORT_EVOL_STEPS
-			std::cout << m_EvolSettings.ADParams.AdvectionMultiplier << "\n";
+			std::cout << settings.ADParams.AdvectionMultiplier << "\n";
 			std::cout << "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\n";
 #endif
 		}
+		return isRemeshed;
+	}
 
-		// --------------------------------------------------------------------
+	void UpdateMeshProperties(pmp::SurfaceMesh& mesh, const unsigned int& ti)
+	{
+		DerivedPropertiesTopologyPolicy::UpdateMeshProperties(mesh, ti);
 
-		coVolStats = AnalyzeMeshCoVolumes(*m_EvolvingSurface, m_LaplacianAreaFunction);
+		// one-time feature detection flag
+		if (!m_ShouldDetectFeatures)
+			m_ShouldDetectFeatures = ti >= 7; //ShouldDetectFeatures(vDistance.vector());
+	}
 
-#if REPORT_EVOL_STEPS
-		std::cout << "Co-Volume Measure Stats: { Mean: " << coVolStats.Mean << ", Min: " << coVolStats.Min << ", Max: " << coVolStats.Max << "},\n";
-		fileOStreamMins << coVolStats.Min << (ti < NSteps ? ", " : "");
-		fileOStreamMeans << coVolStats.Mean << (ti < NSteps ? ", " : "");
-		fileOStreamMaxes << coVolStats.Max << (ti < NSteps ? ", " : "");
-#endif
-		// set surface vertex properties
-		for (const auto v : m_EvolvingSurface->vertices())
-		{
-			const auto vPos = m_EvolvingSurface->position(v);
-			const double vDistanceToTarget = Geometry::TrilinearInterpolateScalarValue(vPos, field);
-			vDistance[v] = static_cast<pmp::Scalar>(vDistanceToTarget);
-			vIsFeatureVal[v] = (vFeature[v] ? 1.0f : -1.0f);
-		}
-		Geometry::ComputeEdgeDihedralAngles(*m_EvolvingSurface);
-		Geometry::ComputeVertexCurvaturesAndRelatedProperties(*m_EvolvingSurface, m_EvolSettings.TopoParams.PrincipalCurvatureFactor);
-		ComputeTriangleMetrics();
+	void SaveState(EvolutionCheckpoint& checkpoint) const
+	{
+		checkpoint.SetValue("MinEdgeLength", static_cast<double>(m_MinEdgeLength));
+		checkpoint.SetValue("MaxEdgeLength", static_cast<double>(m_MaxEdgeLength));
+		checkpoint.SetValue("ApproxError", static_cast<double>(m_ApproxError));
+		checkpoint.SetValue("ShouldDetectFeatures", m_ShouldDetectFeatures ? 1.0 : 0.0);
+		checkpoint.SetValue("ADParams.AdvectionMultiplier", m_Evolver.m_EvolSettings.ADParams.AdvectionMultiplier); // adjusted with remeshing lengths.
+	}
 
-		// one-time feature detection flag
-		if (!shouldDetectFeatures)
-			shouldDetectFeatures = ti >= 7; //ShouldDetectFeatures(vDistance.vector());
+	void LoadState(const EvolutionCheckpoint& checkpoint)
+	{
+		m_MinEdgeLength = static_cast<float>(checkpoint.GetValue("MinEdgeLength"));
+		m_MaxEdgeLength = static_cast<float>(checkpoint.GetValue("MaxEdgeLength"));
+		m_ApproxError = static_cast<float>(checkpoint.GetValue("ApproxError"));
+		m_ShouldDetectFeatures = checkpoint.GetValue("ShouldDetectFeatures") > 0.0;
+		m_Evolver.m_EvolSettings.ADParams.AdvectionMultiplier = checkpoint.GetValue("ADParams.AdvectionMultiplier");
+	}
 
-		if (m_EvolSettings.ExportSurfacePerTimeStep)
-			ExportSurface(ti);
+private:
+	SurfaceEvolver& m_Evolver;
+	std::shared_ptr<pmp::RemeshingReference> m_RemeshingReference{ std::make_shared<pmp::RemeshingReference>() }; //>! back-projection reference reused by subsequent remeshing calls.
+	float m_MinEdgeLength{ 0.0f };
+	float m_MaxEdgeLength{ 0.0f };
+	float m_ApproxError{ 0.0f };
+	bool m_ShouldDetectFeatures{ false }; //>! a changeable flag evaluated by ShouldDetectFeatures function.
+};
 
-		// update linear system dims for next time step:
-		if (ti < NSteps && NVertices != m_EvolvingSurface->n_vertices())
-		{
-			NVertices = static_cast<unsigned int>(m_EvolvingSurface->n_vertices());
-			sysMat = SparseMatrix(NVertices, NVertices);
-			sysRhs = Eigen::MatrixXd(NVertices, 3);
-		}
+// ================================================================================================
 
-#if REPORT_EVOL_STEPS
-		std::cout << ">>> Time step " << ti << " finished.\n";
-		std::cout << "----------------------------------------------------------------------\n";
-#endif
+void SurfaceEvolver::RunEvolution(const EvolutionCheckpoint* checkpoint)
+{
+	InitialSurfacePolicy initialSurface(*this);
+	WeightPolicy weights(*this);
+	TopologyPolicy topology(*this);
 
-	} // end main loop
-	// -------------------------------------------------------------------------------------------------------------
+	if (m_EvolSettings.ExportSurfacePerTimeStep && m_EvolSettings.AsyncExport.Enabled)
+		m_AsyncExporter = std::make_shared<AsyncSurfaceExporter>(m_EvolSettings.AsyncExport);
 
-	if (m_EvolSettings.ExportResultSurface)
-		ExportSurface(NSteps, true);
+	DispatchLaplacianPolicy(m_EvolSettings.LaplacianType, [&](auto laplacianPolicy)
+	{
+		using LaplacianPolicy = decltype(laplacianPolicy);
+		EvolutionEngine<InitialSurfacePolicy, WeightPolicy, LaplacianPolicy, TopologyPolicy> engine(
+			GetEvolutionEngineSettings(m_EvolSettings), initialSurface, weights, topology);
+		engine.Run([this](const unsigned int& tId, const bool& isResult) { ExportSurface(tId, isResult); }, checkpoint);
+		m_PhaseStatistics = engine.GetPhaseStatistics();
+		m_ConvergenceReport = engine.GetConvergenceReport();
+	});
+	m_DerivedProperties.UpdateAll(*m_EvolvingSurface); // GetResultSurface returns the surface with up-to-date properties.
+
+	if (m_AsyncExporter)
+	{
+		m_AsyncExporter->Flush(); // all exported files need to be complete when Evolve returns.
+		m_AsyncExporter.reset();
+	}
+}
 
-#if REPORT_EVOL_STEPS
-	fileOStreamMins.close();
-	fileOStreamMaxes.close();
-	fileOStreamMeans.close();
-#endif
+void SurfaceEvolver::Evolve()
+{
+	RunEvolution(nullptr);
+}
+
+void SurfaceEvolver::Resume(const std::string& checkpointPath)
+{
+	const auto checkpoint = ReadCheckpoint(checkpointPath);
+	RunEvolution(&checkpoint);
 }
 
 pmp::SurfaceMesh SurfaceEvolver::GetResultSurface(const bool& transformToOriginal) const
@@ -535,6 +585,13 @@ void ReportInput(const SurfaceEvolutionSettings& evolSettings, std::ostream& os)
 	os << "Max. Target Size: " << evolSettings.MaxTargetSize << ",\n";
 	os << "Export Surface per Time Step: " << (evolSettings.ExportSurfacePerTimeStep ? "true" : "false") << ",\n";
 	os << "Output Path: " << evolSettings.OutputPath << ",\n";
+	os << "Linear Solver: " << LinearSolverTypeToString(evolSettings.LinearSolverParams.Type) << " (preconditioner reused for " << evolSettings.LinearSolverParams.PreconditionerReuseSteps << " steps),\n";
+	os << "Adaptive Time Stepping: " << (evolSettings.TimeStepControl.Enabled ? "true" : "false") << ",\n";
+	os << "Convergence Criterion: " << (evolSettings.Convergence.Enabled ? ConvergenceMeasureToString(evolSettings.Convergence.Measure) + " < " + std::to_string(evolSettings.Convergence.Tolerance) : std::string("none")) << ",\n";
+	os << "Checkpoints: " << (evolSettings.Checkpoint.Enabled ? "every " + std::to_string(evolSettings.Checkpoint.StepStride) + " steps" : std::string("none")) << ",\n";
+	os << "Phase Tracing: " << (evolSettings.Tracing.Enabled ? "true" : "false") << ",\n";
+	os << "Self-Intersection Detection: " << (evolSettings.SelfIntersections.Enabled ? "every " + std::to_string(evolSettings.SelfIntersections.StepStride) + " steps" + (evolSettings.SelfIntersections.TerminateOnDetection ? " (terminating on detection)" : "") : std::string("none")) << ",\n";
+	os << "Mesh Reordering: " << MeshReorderingTypeToString(evolSettings.MeshReordering) << ",\n";
 	os << "Do Remeshing: " << (evolSettings.DoRemeshing ? "true" : "false") << ",\n";
 	os << "Do Feature Detection: " << (evolSettings.DoFeatureDetection ? "true" : "false") << ",\n";
 	os << "----------------------------------------------------------------------\n";
@@ -6,6 +6,14 @@
 #include "geometry/Grid.h"
 
 #include "EvolverUtilsCommon.h"
+#include "AsyncSurfaceExporter.h"
+#include "EvolutionSystemSolver.h"
+#include "TimeStepController.h"
+#include "ConvergenceMonitor.h"
+#include "EvolutionCheckpoint.h"
+#include "EvolutionTracer.h"
+#include "SelfIntersectionMonitor.h"
+#include "DerivedMeshProperties.h"
 
 /**
  * \brief A wrapper for surface evolution settings.
@@ -40,8 +48,55 @@ struct SurfaceEvolutionSettings
 	bool IdentityForBoundaryVertices{ true }; //>! if true, boundary vertices give rise to: updated vertex = previous vertex.
 	bool IdentityForFeatureVertices{ false }; //>! if true, feature vertices give rise to: updated vertex = previous vertex.
 	double MaxFractionOfVerticesOutOfBounds{ 0.02 }; //>! fraction of vertices allowed to be out of bounds (because it will be decimated).
+
+	AsyncExportSettings AsyncExport{}; //>! settings for background export of per-step surfaces.
+	LinearSolverSettings LinearSolverParams{}; //>! settings of the linear solver for the evolution system.
+	TimeStepControlSettings TimeStepControl{}; //>! settings of adaptive time stepping (disabled by default).
+	ConvergenceSettings Convergence{}; //>! settings of convergence-based early termination (disabled by default).
+	CheckpointSettings Checkpoint{}; //>! settings of periodic checkpoints of the evolution state (disabled by default).
+	TracingSettings Tracing{}; //>! settings of phase tracing into a Chrome trace file (disabled by default).
+	SelfIntersectionSettings SelfIntersections{}; //>! settings of per-step self-intersection detection (disabled by default).
+	MeshReorderingType MeshReordering{ MeshReorderingType::ReverseCuthillMcKee }; //>! renumbering of the evolving surface after remeshing.
 };
 
+/**
+ * \brief A repaired distance field transformed for the stabilization of the numerical method, together with its
+ *        normalized negative gradient. It is immutable once prepared, so that it can be shared by multiple SurfaceEvolver
+ *        instances whose settings lead to the same stabilization (see IsStabilizationCompatible).
+ * \struct StabilizedEvolutionField
+ */
+struct StabilizedEvolutionField
+{
+	std::shared_ptr<const Geometry::ScalarGrid> Field{ nullptr }; //>! repaired field moved to (0,0,0) and scaled (including its values).
+	std::shared_ptr<const Geometry::VectorGrid> NegGradient{ nullptr }; //>! normalized negative gradient of Field.
+
+	float ExpansionFactor{ 0.0f }; //>! the factor by which target bounds are expanded (multiplying original bounds min dimension).
+	pmp::Scalar StartingSurfaceRadius{ 1.0f }; //>! radius of the starting surface (before scaling).
+	pmp::Scalar ScalingFactor{ 1.0f }; //>! stabilization scaling factor value.
+	pmp::vec3 TargetOrigin{}; //>! origin of the evolution's target (moved to (0,0,0)).
+	pmp::mat4 TransformToOriginal{}; //>! transformation matrix from stabilized geometry to original size.
+};
+
+/**
+ * \brief Repairs, transforms and scales a copy of a given field, and computes its normalized negative gradient.
+ * \param field                    pre-computed or loaded scalar field environment.
+ * \param fieldExpansionFactor     the factor by which target bounds are expanded (multiplying original bounds min dimension).
+ * \param settings                 surface evolution settings determining the stabilization (TimeStep, IcoSphereSubdivisionLevel,
+ *                                 MinTargetSize, MaxTargetSize, TargetOrigin).
+ * \return the stabilized field shareable by SurfaceEvolver instances with compatible settings.
+ * \throw std::invalid_argument if the field is invalid.
+ */
+[[nodiscard]] std::shared_ptr<const StabilizedEvolutionField> PrepareStabilizedEvolutionField(
+	const Geometry::ScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings);
+
+/**
+ * \brief Verifies whether given settings lead to the same stabilization as the one of a prepared field.
+ * \param field       stabilized field.
+ * \param settings    surface evolution settings.
+ * \return true if a SurfaceEvolver with the given settings can evolve within the field.
+ */
+[[nodiscard]] bool IsStabilizationCompatible(const StabilizedEvolutionField& field, const SurfaceEvolutionSettings& settings);
+
 /**
  * \brief A utility for evolving surfaces within a scalar field.
  * \class SurfaceEvolver
@@ -57,16 +112,36 @@ public:
 	 */
 	SurfaceEvolver(const Geometry::ScalarGrid& field, const float& fieldExpansionFactor, const SurfaceEvolutionSettings& settings);
 
+	/**
+	 * \brief Constructor. Initialize with a shared stabilized field (no copy of the field is made).
+	 * \param field       stabilized field prepared by PrepareStabilizedEvolutionField.
+	 * \param settings    surface evolution settings (need to be compatible with the stabilization of the field).
+	 * \throw std::invalid_argument if field is nullptr or its stabilization is not compatible with the settings.
+	 */
+	SurfaceEvolver(const std::shared_ptr<const StabilizedEvolutionField>& field, const SurfaceEvolutionSettings& settings);
+
 	/**
 	 * \brief Main functionality.
 	 */
 	void Evolve();
 
+	/**
+	 * \brief Resumes the evolution from a checkpoint file written by a previous run with the same settings.
+	 * \param checkpointPath    full name of the checkpoint file.
+	 */
+	void Resume(const std::string& checkpointPath);
+
+	/// \brief Per-phase aggregates of the last evolution (empty unless Tracing is enabled).
+	[[nodiscard]] const std::vector<PhaseStatistics>& GetPhaseStatistics() const { return m_PhaseStatistics; }
+
+	/// \brief Convergence of the last evolution (IsConverged is false unless it stopped early by the convergence criterion).
+	[[nodiscard]] const ConvergenceReport& GetConvergenceReport() const { return m_ConvergenceReport; }
+
 	/// \brief Result getter.
 	[[nodiscard]] pmp::SurfaceMesh GetResultSurface(const bool& transformToOriginal = true) const;
 private:
 	/**
-	 * \brief Preprocess for evolution, i.e.: generate m_EvolvingSurface, and transform both m_Field and m_EvolvingSurface for stabilization.
+	 * \brief Preprocess for evolution, i.e.: stabilize m_InputField (unless a stabilized field is given), generate m_EvolvingSurface, and transform it for stabilization.
 	 */
 	void Preprocess();
 
@@ -106,28 +181,42 @@ private:
 	 */
 	void ExportSurface(const unsigned int& tId, const bool& isResult = false, const bool& transformToOriginal = true) const;
 
+	// ----------------------------------------------------------------
+
 	/**
-	 * \brief Computes triangle metrics interpolated to vertices according to list m_EvolSettings.TriMetrics.
+	 * \brief Runs the evolution engine from the initial surface or, if given, from a checkpoint.
+	 * \param checkpoint    checkpoint to resume from (nullptr for a new evolution).
 	 */
-	void ComputeTriangleMetrics() const;
+	void RunEvolution(const EvolutionCheckpoint* checkpoint);
+
+	// ----------------------------------------------------------------
+
+	// policies specializing EvolutionEngine for SurfaceEvolver (defined in SurfaceEvolver.cpp).
+	class InitialSurfacePolicy;
+	class WeightPolicy;
+	class TopologyPolicy;
 
 	// ----------------------------------------------------------------
 
 	SurfaceEvolutionSettings m_EvolSettings{}; //>! settings.
 
-	std::shared_ptr<Geometry::ScalarGrid> m_Field{ nullptr }; //>! scalar field environment.
+	std::shared_ptr<Geometry::ScalarGrid> m_InputField{ nullptr }; //>! copy of the input scalar field (released once stabilized).
+	std::shared_ptr<const StabilizedEvolutionField> m_StabilizedField{ nullptr }; //>! stabilized scalar field environment (possibly shared).
 	std::shared_ptr<pmp::SurfaceMesh> m_EvolvingSurface{ nullptr }; //>! (stabilized) evolving surface.
 
 	float m_ExpansionFactor{ 0.0f }; //>! the factor by which target bounds are expanded (multiplying original bounds min dimension).
 	pmp::Scalar m_StartingSurfaceRadius{ 1.0f }; //>! radius of the starting surface.
 	pmp::Scalar m_ScalingFactor{ 1.0f }; //>! stabilization scaling factor value.
 
-	std::function<pmp::ImplicitLaplaceInfo(const pmp::SurfaceMesh&, pmp::Vertex)> m_ImplicitLaplacianFunction{}; //>! a Laplacian function chosen from parameter MeshLaplacian.
-	std::function<double(const pmp::SurfaceMesh&, pmp::Vertex)> m_LaplacianAreaFunction{}; //>! a Laplacian area function chosen from parameter MeshLaplacian.
 	std::function<size_t(const pmp::Scalar&, const bool&)> m_FeatureFunction{}; //>! a function for detecting mesh features.
 
 	// export
 	std::string m_OutputMeshExtension = ".vtk"; //>! extension of the exported mesh geometry.
+	pmp::IOFlags m_OutputMeshIOFlags{ .use_binary = true }; //>! flags of the exported mesh geometry (binary, with all scalar vertex and face properties).
+	std::shared_ptr<AsyncSurfaceExporter> m_AsyncExporter{ nullptr }; //>! background writer for per-step surface export (if enabled).
+	std::vector<PhaseStatistics> m_PhaseStatistics{}; //>! per-phase aggregates of the last evolution (if traced).
+	ConvergenceReport m_ConvergenceReport{}; //>! convergence of the last evolution.
+	mutable DerivedMeshProperties m_DerivedProperties{}; //>! lazily updated curvatures, dihedral angles and triangle metrics of m_EvolvingSurface.
 	pmp::mat4 m_TransformToOriginal{}; //>! transformation matrix from stabilized surface to original size (for export).
 
 };
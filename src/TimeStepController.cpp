@@ -0,0 +1,76 @@
+#include "TimeStepController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+TimeStepController::TimeStepController(const TimeStepControlSettings& settings, const double& initialTimeStep)
+	: m_Settings(settings)
+{
+	if (m_Settings.ShrinkFactor <= 0.0 || m_Settings.ShrinkFactor >= 1.0)
+		throw std::invalid_argument("TimeStepController::TimeStepController: ShrinkFactor must be in (0, 1)!\n");
+	if (m_Settings.GrowthFactor < 1.0)
+		throw std::invalid_argument("TimeStepController::TimeStepController: GrowthFactor < 1.0!\n");
+	if (m_Settings.MinTimeStepFactor > m_Settings.MaxTimeStepFactor)
+		throw std::invalid_argument("TimeStepController::TimeStepController: MinTimeStepFactor > MaxTimeStepFactor!\n");
+
+	SetReferenceTimeStep(initialTimeStep);
+}
+
+void TimeStepController::SetReferenceTimeStep(const double& referenceTimeStep)
+{
+	m_ReferenceTimeStep = referenceTimeStep;
+	m_MinTimeStep = m_Settings.MinTimeStepFactor * referenceTimeStep;
+	m_MaxTimeStep = m_Settings.MaxTimeStepFactor * referenceTimeStep;
+}
+
+double TimeStepController::Clamp(const double& timeStep) const
+{
+	return std::clamp(timeStep, m_MinTimeStep, m_MaxTimeStep);
+}
+
+TimeStepDecision TimeStepController::Evaluate(const double& timeStep, const TimeStepEvaluation& evaluation, const unsigned int& nRetries) const
+{
+	if (!m_Settings.Enabled)
+		return { evaluation.IsSolverConverged, timeStep };
+
+	if (!evaluation.IsSolverConverged)
+		return { false, Clamp(m_Settings.ShrinkFactor * timeStep) };
+
+	// characteristic length of the finest co-volume.
+	const double charLength = std::sqrt(std::max(evaluation.CoVolumeMinBefore, 0.0));
+	const double displacementRatio = (charLength > 0.0 ? evaluation.MaxDisplacement / charLength : 0.0);
+
+	const bool isDisplacementTooLarge = displacementRatio > m_Settings.MaxDisplacementRatio;
+	const bool isCoVolumeCollapsed = evaluation.CoVolumeMinAfter < m_Settings.MinCoVolumeRatio * evaluation.CoVolumeMinBefore;
+	const bool canShrink = timeStep > m_MinTimeStep && nRetries < m_Settings.MaxRetries;
+	if ((isDisplacementTooLarge || isCoVolumeCollapsed) && canShrink)
+	{
+		double factor = m_Settings.ShrinkFactor;
+		if (isDisplacementTooLarge)
+		{
+			// displacement is approximately proportional to the time step.
+			factor = std::min(factor, m_Settings.SafetyFactor * m_Settings.TargetDisplacementRatio / displacementRatio);
+		}
+		return { false, Clamp(factor * timeStep) };
+	}
+
+	// accepted: propose the next time step from the target displacement
+	double factor = (displacementRatio > 0.0 ?
+		m_Settings.SafetyFactor * m_Settings.TargetDisplacementRatio / displacementRatio : m_Settings.GrowthFactor);
+	factor = std::clamp(factor, m_Settings.ShrinkFactor, m_Settings.GrowthFactor);
+	if (isCoVolumeCollapsed)
+		factor = std::min(factor, m_Settings.ShrinkFactor);
+	if (m_Settings.MaxSolverIterationsForGrowth > 0 && evaluation.NSolverIterations > m_Settings.MaxSolverIterationsForGrowth)
+		factor = std::min(factor, 1.0);
+
+	return { true, Clamp(factor * timeStep) };
+}
+
+double ComputeMaxDisplacement(const Eigen::MatrixXd& oldPositions, const Eigen::MatrixXd& newPositions)
+{
+	const auto nRows = std::min(oldPositions.rows(), newPositions.rows());
+	if (nRows == 0)
+		return 0.0;
+	return (newPositions.topRows(nRows) - oldPositions.topRows(nRows)).rowwise().norm().maxCoeff();
+}
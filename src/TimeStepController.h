@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Eigen/Dense>
+
+/**
+ * \brief A wrapper for settings of adaptive time stepping of the evolution.
+ * \struct TimeStepControlSettings
+ *
+ * All time step bounds are relative to the initial time step (e.g.: SurfaceEvolutionSettings::TimeStep),
+ * because the stabilization scaling factor of each evolver is derived from it. If the time step is rescaled
+ * outside of the controller (e.g.: by the decay of remeshing lengths), the bounds are rescaled along with it.
+ */
+struct TimeStepControlSettings
+{
+	bool Enabled{ false }; //>! if true, the time step is adapted after each step, otherwise the initial time step is kept (up to remeshing adjustments).
+
+	double MinTimeStepFactor{ 0.05 }; //>! the smallest allowed time step as a multiple of the initial time step.
+	double MaxTimeStepFactor{ 20.0 }; //>! the largest allowed time step as a multiple of the initial time step.
+
+	double TargetDisplacementRatio{ 0.25 }; //>! desired max vertex displacement per step relative to the characteristic co-volume length sqrt(min co-volume).
+	double MaxDisplacementRatio{ 0.75 }; //>! a step whose max vertex displacement exceeds this ratio of the characteristic co-volume length is rejected.
+	double MinCoVolumeRatio{ 0.2 }; //>! a step after which min co-volume drops below this fraction of its value before the step is rejected.
+
+	double GrowthFactor{ 1.5 }; //>! the largest factor by which the time step grows after an accepted step.
+	double ShrinkFactor{ 0.5 }; //>! the factor by which the time step shrinks after a rejected step (and the smallest factor after an accepted one).
+	double SafetyFactor{ 0.9 }; //>! a multiplier of the proposed time step keeping it slightly below the displacement estimate.
+
+	unsigned int MaxRetries{ 5 }; //>! the maximum number of rejected attempts of a single time step.
+	unsigned int MaxSolverIterationsForGrowth{ 0 }; //>! if > 0, the time step does not grow after a solve with more iterations (slow convergence indicates stiffness).
+};
+
+/**
+ * \brief Measurements of a single attempted time step used by TimeStepController.
+ * \struct TimeStepEvaluation
+ */
+struct TimeStepEvaluation
+{
+	bool IsSolverConverged{ true }; //>! false if the linear solver did not succeed.
+	unsigned int NSolverIterations{ 0 }; //>! the number of linear solver iterations (0 for direct solvers).
+	double MaxDisplacement{ 0.0 }; //>! max distance between old and new vertex positions.
+	double CoVolumeMinBefore{ 0.0 }; //>! min co-volume measure before the step.
+	double CoVolumeMinAfter{ 0.0 }; //>! min co-volume measure after the step.
+};
+
+/**
+ * \brief The decision of TimeStepController about an attempted time step.
+ * \struct TimeStepDecision
+ */
+struct TimeStepDecision
+{
+	bool IsAccepted{ true }; //>! if false, the step needs to be discarded and re-attempted with NextTimeStep.
+	double NextTimeStep{ 0.0 }; //>! time step for the next attempt (or the next step if accepted).
+};
+
+/**
+ * \brief An adaptive time step controller which grows or shrinks the time step according to the max vertex displacement
+ *        relative to the smallest co-volume, the change of the smallest co-volume and the convergence of the linear solver.
+ * \class TimeStepController
+ *
+ * A step is rejected if the solver fails, if a vertex moves by more than MaxDisplacementRatio * sqrt(min co-volume),
+ * or if the min co-volume collapses below MinCoVolumeRatio of its previous value. Rejected steps are retried with
+ * a shrunk time step. Accepted steps propose the next time step from TargetDisplacementRatio, so that steps grow
+ * far from the target (small relative motion) and shrink near it.
+ */
+class TimeStepController
+{
+public:
+	/**
+	 * \brief Constructor.
+	 * \param settings           time step control settings.
+	 * \param initialTimeStep    initial time step (the reference for the time step bounds).
+	 */
+	TimeStepController(const TimeStepControlSettings& settings, const double& initialTimeStep);
+
+	/**
+	 * \brief Evaluates an attempted time step.
+	 * \param timeStep       the time step of the attempt.
+	 * \param evaluation     measurements of the attempt.
+	 * \param nRetries       the number of already rejected attempts of this step.
+	 * \return decision about the attempt.
+	 */
+	[[nodiscard]] TimeStepDecision Evaluate(const double& timeStep, const TimeStepEvaluation& evaluation, const unsigned int& nRetries) const;
+
+	/// \brief Clamps a given time step into the allowed bounds.
+	[[nodiscard]] double Clamp(const double& timeStep) const;
+
+	/**
+	 * \brief Rebases the time step bounds on a new reference time step.
+	 * \param referenceTimeStep    the time step the bounds are relative to (the initial time step rescaled by all external adjustments).
+	 */
+	void SetReferenceTimeStep(const double& referenceTimeStep);
+
+	/// \brief the time step the bounds are relative to.
+	[[nodiscard]] double ReferenceTimeStep() const { return m_ReferenceTimeStep; }
+
+	/// \brief Enabled flag getter.
+	[[nodiscard]] bool IsEnabled() const { return m_Settings.Enabled; }
+
+	/// \brief the number of retries getter.
+	[[nodiscard]] unsigned int MaxRetries() const { return m_Settings.MaxRetries; }
+
+private:
+	TimeStepControlSettings m_Settings{}; //>! settings.
+	double m_ReferenceTimeStep{ 0.0 }; //>! the time step the bounds are relative to.
+	double m_MinTimeStep{ 0.0 }; //>! the smallest allowed time step.
+	double m_MaxTimeStep{ 0.0 }; //>! the largest allowed time step.
+};
+
+/**
+ * \brief Computes the max distance between rows of two (NVertices x 3) position matrices.
+ * \param oldPositions    positions before the step.
+ * \param newPositions    positions after the step.
+ * \return max displacement.
+ */
+[[nodiscard]] double ComputeMaxDisplacement(const Eigen::MatrixXd& oldPositions, const Eigen::MatrixXd& newPositions);
@@ -2,323 +2,72 @@
 
 #include "utils/StringUtils.h"
 
+#include <algorithm>
 #include <set>
 #include <fstream>
 #include <random>
-#include <thread>
 #include <unordered_set>
 
 #include <nanoflann.hpp>
 
+#include "pmp/Exceptions.h"
+#include "pmp/MappedFile.h"
+#include "pmp/PolygonSoupParser.h"
 #include "pmp/algorithms/Normals.h"
 #include "quickhull/QuickHull.hpp"
 
-#ifdef _WINDOWS
-// Windows-specific headers
-#include <windows.h>
-#include <fcntl.h>
-#else
-// Unsupported platform
-#error "Unsupported platform"
-#endif
-
-
-namespace
+namespace Geometry
 {
-
-	// TODO: different representations, e.g.: ProgressiveMeshData which would then be exported into a disk file
-	/**
-	 * \brief a thread-specific wrapper for mesh data.
-	 */
-	struct ChunkData
-	{
-		std::vector<pmp::vec3> Vertices;
-		std::vector<pmp::vec3> VertexNormals;
-		std::vector<std::vector<unsigned int>> PolyIndices;
-	};
-
-	/**
-	 * \brief Parses a chunk of OBJ data. This function is run for each thread.
-	 * \param start     start address for this thread.
-	 * \param end       end address for this thread.
-	 * \param data      preallocated chunk data.
-	 */
-	void ParseChunk(const char* start, const char* end, ChunkData& data)
+	pmp::SurfaceMesh ConvertBufferGeomToPMPSurfaceMesh(const BaseMeshGeometryData& geomData)
 	{
-		const char* cursor = start;
+		pmp::SurfaceMesh result;
 
-		while (cursor < end)
+		const bool isTriangleMesh = std::all_of(geomData.PolyIndices.begin(), geomData.PolyIndices.end(),
+			[](const auto& indexTuple) { return indexTuple.size() == 3; });
+		if (isTriangleMesh)
 		{
-			// If the current line is incomplete, skip to the next line
-			if (*cursor == '\n')
+			// bulk construction: twin halfedges are found without per-face add_face searches.
+			std::vector<pmp::IndexType> indices(3 * geomData.PolyIndices.size());
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < static_cast<int>(geomData.PolyIndices.size()); i++)
 			{
-				cursor++;
-				continue;
-			}
-
-			// If it's a vertex or normal, parse the three floats
-			if (strncmp(cursor, "v ", 2) == 0 || strncmp(cursor, "vn ", 3) == 0)
-			{
-				const bool isNormal = strncmp(cursor, "vn ", 3) == 0;
-				cursor += isNormal ? 3 : 2; // skip "v " or "vn "
-
-				pmp::vec3 vec;
-				char* tempCursor;
-				vec[0] = std::strtof(cursor, &tempCursor);
-				cursor = tempCursor;
-
-				vec[1] = std::strtof(cursor, &tempCursor);
-				cursor = tempCursor;
-
-				vec[2] = std::strtof(cursor, &tempCursor);
-				cursor = tempCursor;
-
-				if (isNormal)
-					data.VertexNormals.push_back(vec);
-				else
-					data.Vertices.push_back(vec);
-			}
-			// If it's a face, parse the vertex indices
-			else if (strncmp(cursor, "f ", 2) == 0)
-			{
-				cursor += 2; // skip "f "
-				std::vector<unsigned int> faceIndices;
-
-				while (*cursor != '\n' && cursor < end)
-				{
-					char* tempCursor;
-					// Parse the vertex index
-					const unsigned int vertexIndex = std::strtoul(cursor, &tempCursor, 10);
-					if (cursor == tempCursor) // No progress in parsing, break to avoid infinite loop
-						break;
-
-					cursor = tempCursor;
-					if (vertexIndex == 0) {
-						// Underflow occurred, meaning strtoul failed to parse a valid number
-						break;
-					}
-					faceIndices.push_back(vertexIndex - 1);
-
-					if (*cursor == '/') // Check for additional indices
-					{
-						cursor++; // Skip the first '/'
-						if (*cursor != '/') // Texture coordinate index is present
-						{
-							std::strtoul(cursor, &tempCursor, 10); // Parse and discard the texture index
-							cursor = tempCursor;
-						}
-
-						if (*cursor == '/') // Normal index is present
-						{
-							cursor++; // Skip the second '/'
-							std::strtoul(cursor, &tempCursor, 10); // Parse and discard the normal index
-							cursor = tempCursor;
-						}
-					}
-
-					// Skip to next index, newline, or end
-					while (*cursor != ' ' && *cursor != '\n' && cursor < end)
-						cursor++;
-
-					if (*cursor == ' ')
-						cursor++; // Skip space to start of next index
-				}
-
-				if (!faceIndices.empty())
-					data.PolyIndices.push_back(faceIndices);
-
-				// Move to the next line
-				while (*cursor != '\n' && cursor < end)
-					cursor++;
-				if (cursor < end)
-					cursor++; // Move past the newline character
-			}
-			else
-			{
-				// Skip to the next line if the current line isn't recognized
-				while (*cursor != '\n' && cursor < end)
-					cursor++;
+				for (unsigned int j = 0; j < 3; j++)
+					indices[3 * i + j] = geomData.PolyIndices[i][j];
 			}
+			result.build_from_triangles(geomData.Vertices, indices);
 		}
-	}
-
-	// Assume average bytes per vertex and face line (these are just example values)
-	//constexpr size_t avgBytesPerVertex = 13; // Example average size of a vertex line in bytes
-	//constexpr size_t avgBytesPerFace = 7; // Example average size of a face line in bytes
-
-	/**
-	 * \brief A simple estimation utility for large OBJ files
-	 * \param fileSize        file size in bytes.
-	 * \param expectNormals   if true we expect the OBJ file to also contain vertex normals.
-	 * \return pair { # of estimated vertices, # of estimated faces }.
-	 */
-	//std::pair<size_t, size_t> EstimateVertexAndFaceCapacitiesFromOBJFileSize(const size_t& fileSize, const bool& expectNormals = false)
-	//{
-
-	//	// Estimate total number of vertex and face lines
-	//	const size_t estimatedTotalLines = fileSize / (((expectNormals ? 2 : 1) * avgBytesPerVertex + avgBytesPerFace) / 2);
-
-	//	// Estimate number of vertices based on Botsch 2010 ratio N_F = 2 * N_V
-	//	size_t estimatedVertices = estimatedTotalLines / (expectNormals ? 4 : 3); // Since N_F + N_V = 3 * N_V and N_V = N_N
-	//	size_t estimatedFaces = 2 * estimatedVertices;
-
-	//	return std::make_pair(estimatedVertices, estimatedFaces);
-	//}
-
-	/**
-	 * \brief Parses a chunk of PLY point data. This function is run for each thread.
-	 * \param start     start address for this thread.
-	 * \param end       end address for this thread.
-	 * \param data      preallocated chunk data.
-	 */
-	void ParsePointCloudChunk(const char* start, const char* end, std::vector<pmp::vec3>& data) {
-		const char* cursor = start;
-
-		while (cursor < end) 
-		{
-			// Skip any leading whitespace
-			while ((*cursor == ' ' || *cursor == '\n') && cursor < end)
-			{
-				cursor++;
-			}
-
-			if (cursor >= end)
-			{
-				break; // Reached the end of the chunk
-			}
-
-			// Start of a new line
-			const char* lineStart = cursor;
-
-			// Find the end of the line
-			while (*cursor != '\n' && cursor < end) 
-			{
-				cursor++;
-			}
-
-			// Check if the end of the line is within the chunk
-			if (*cursor != '\n' && cursor == end) 
-			{
-				break; // The line is incomplete, so stop parsing
-			}
-
-			// Extract the line
-			std::string line(lineStart, cursor);
-
-			// Remove carriage return if present
-			if (!line.empty() && line.back() == '\r') 
-			{
-				line.pop_back();
-			}
-
-			// Increment cursor to start the next line in the next iteration
-			if (cursor < end) 
-			{
-				cursor++;
-			}
-
-			// Parse the line to extract vertex coordinates
-			std::istringstream iss(line);
-			pmp::vec3 vertex;
-			if (!(iss >> vertex[0] >> vertex[1] >> vertex[2])) 
-			{
-				std::cerr << "ParsePointCloudChunk: Error parsing line: " << line << std::endl;
-				continue;
-			}
-
-			data.push_back(vertex);
-		}
-	}
-
-	/**
-	 * \brief Reads the header of the PLY file for vertices.
-	 * \param start     header start position in memory.
-	 * \return pair { number of vertices read from the header, the memory position where the point data starts }
-	 */
-	[[nodiscard]] std::pair<size_t, char*> ReadPLYVertexHeader(const char* start)
-	{
-		const char* cursor = start;
-		std::string line;
-		size_t vertexCount = 0;
-
-		while (*cursor != '\0') 
+		else
 		{
-			// Extract the line
-			const char* lineStart = cursor;
-			while (*cursor != '\n' && *cursor != '\0') 
-			{
-				cursor++;
-			}
-			line.assign(lineStart, cursor);
-
-			// Trim trailing carriage return if present
-			if (!line.empty() && line.back() == '\r') 
+			// count edges
+			std::set<std::pair<unsigned int, unsigned int>> edgeIdsSet;
+			for (const auto& indexTuple : geomData.PolyIndices)
 			{
-				line.pop_back();
-			}
+				for (unsigned int i = 0; i < indexTuple.size(); i++)
+				{
+					unsigned int vertId0 = indexTuple[i];
+					unsigned int vertId1 = indexTuple[(static_cast<size_t>(i) + 1) % indexTuple.size()];
 
-			// Move to the start of the next line
-			if (*cursor != '\0') 
-			{
-				cursor++;
-			}
+					if (vertId0 > vertId1) std::swap(vertId0, vertId1);
 
-			// Check for the vertex count line
-			if (line.rfind("element vertex", 0) == 0) 
-			{
-				std::istringstream iss(line);
-				std::string element, vertex;
-				if (!(iss >> element >> vertex >> vertexCount))
-				{
-					std::cerr << "ReadPLYVertexHeader [WARNING]: Failed to parse vertex count line: " << line << "\n";
-					continue;
+					edgeIdsSet.insert({ vertId0, vertId1 });
 				}
-				// Successfully parsed the vertex count line. Continue to look for the end of the header.
 			}
 
-			// Check for the end of the header
-			if (line == "end_header") 
-			{
-				break;
-			}
-		}
-
-		if (vertexCount == 0) 
-		{
-			std::cerr << "ReadPLYVertexHeader [ERROR]: Vertex count not found in the header.\n";
-		}
-
-		return { vertexCount, const_cast<char*>(cursor) }; // Return the vertex count and the cursor position
-	}
-
-
-} // anonymous namespace
-
-namespace Geometry
-{
-	pmp::SurfaceMesh ConvertBufferGeomToPMPSurfaceMesh(const BaseMeshGeometryData& geomData)
-	{
-		pmp::SurfaceMesh result;
+			result.reserve(geomData.Vertices.size(), edgeIdsSet.size(), geomData.PolyIndices.size());
+			for (const auto& v : geomData.Vertices)
+				result.add_vertex(pmp::Point(v[0], v[1], v[2]));
 
-		// count edges
-		std::set<std::pair<unsigned int, unsigned int>> edgeIdsSet;
-		for (const auto& indexTuple : geomData.PolyIndices)
-		{
-			for (unsigned int i = 0; i < indexTuple.size(); i++)
+			for (const auto& indexTuple : geomData.PolyIndices)
 			{
-				unsigned int vertId0 = indexTuple[i];
-				unsigned int vertId1 = indexTuple[(static_cast<size_t>(i) + 1) % indexTuple.size()];
-
-				if (vertId0 > vertId1) std::swap(vertId0, vertId1);
+				std::vector<pmp::Vertex> vertices;
+				vertices.reserve(indexTuple.size());
+				for (const auto& vId : indexTuple)
+					vertices.emplace_back(pmp::Vertex(vId));
 
-				edgeIdsSet.insert({ vertId0, vertId1 });
+				result.add_face(vertices);
 			}
 		}
 
-		result.reserve(geomData.Vertices.size(), edgeIdsSet.size(), geomData.PolyIndices.size());
-		for (const auto& v : geomData.Vertices)
-			result.add_vertex(pmp::Point(v[0], v[1], v[2]));
-
 		if (!geomData.VertexNormals.empty())
 		{
 			auto vNormal = result.vertex_property<pmp::Normal>("v:normal");
@@ -326,16 +75,6 @@ namespace Geometry
 				vNormal[v] = geomData.VertexNormals[v.idx()];
 		}
 
-        for (const auto& indexTuple : geomData.PolyIndices)
-        {
-			std::vector<pmp::Vertex> vertices;
-			vertices.reserve(indexTuple.size());
-			for (const auto& vId : indexTuple)
-				vertices.emplace_back(pmp::Vertex(vId));
-
-			result.add_face(vertices);	        
-        }
-
 		return result;
 	}
 
@@ -372,35 +111,28 @@ namespace Geometry
 
 	pmp::SurfaceMesh ConvertMCMeshToPMPSurfaceMesh(const MarchingCubes::MC_Mesh& mcMesh)
 	{
-		pmp::SurfaceMesh result;
-
-		// count edges
-		std::set<std::pair<unsigned int, unsigned int>> edgeIdsSet;
-		for (unsigned int i = 0; i < mcMesh.faceCount * 3; i += 3)
+		std::vector<pmp::Point> positions(mcMesh.vertexCount);
+		std::vector<pmp::IndexType> indices(mcMesh.faceCount * 3);
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < static_cast<int>(mcMesh.vertexCount); i++)
 		{
-			for (unsigned int j = 0; j < 3; j++)
-			{
-				unsigned int vertId0 = mcMesh.faces[i + j];
-				unsigned int vertId1 = mcMesh.faces[i + (j + 1) % 3];
-
-				if (vertId0 > vertId1) std::swap(vertId0, vertId1);
-
-				edgeIdsSet.insert({ vertId0, vertId1 });
-			}
+			positions[i] = pmp::Point(
+				mcMesh.vertices[i][0],
+				mcMesh.vertices[i][1],
+				mcMesh.vertices[i][2]);
 		}
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < static_cast<int>(mcMesh.faceCount * 3); i++)
+			indices[i] = static_cast<pmp::IndexType>(mcMesh.faces[i]);
+
+		pmp::SurfaceMesh result;
+		result.build_from_triangles(positions, indices);
 
-		result.reserve(mcMesh.vertexCount, edgeIdsSet.size(), mcMesh.faceCount);
 		// MC produces normals by default
 		auto vNormal = result.vertex_property<pmp::Normal>("v:normal");
-
-		for (unsigned int i = 0; i < mcMesh.vertexCount; i++)
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < static_cast<int>(mcMesh.vertexCount); i++)
 		{
-			result.add_vertex(
-			   pmp::Point(
-				   mcMesh.vertices[i][0],
-				   mcMesh.vertices[i][1],
-				   mcMesh.vertices[i][2]
-			));
 			vNormal[pmp::Vertex(i)] = pmp::Normal{
 				mcMesh.normals[i][0],
 				mcMesh.normals[i][1],
@@ -408,18 +140,6 @@ namespace Geometry
 			};
 		}
 
-		for (unsigned int i = 0; i < mcMesh.faceCount * 3; i += 3)
-		{
-			std::vector<pmp::Vertex> vertices;
-			vertices.reserve(3);
-			for (unsigned int j = 0; j < 3; j++)
-			{
-				vertices.emplace_back(pmp::Vertex(mcMesh.faces[i + j]));
-			}
-
-			result.add_face(vertices);
-		}
-
 		return result;
 	}
 
@@ -523,93 +243,38 @@ namespace Geometry
 		if (extension != "obj")
 			return {};
 
-		const char* file_path = absFileName.c_str();
-
-		const HANDLE file_handle = CreateFile(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-
-		if (file_handle == INVALID_HANDLE_VALUE) 
+		pmp::PolygonSoup soup;
+		try
 		{
-			std::cerr << "ImportOBJMeshGeometryData [ERROR]: Failed to open the file.\n";
-			return {};
+			const pmp::MappedFile file(absFileName);
+			soup = pmp::PolygonSoupParser::parse_obj(file.view(), importInParallel);
 		}
-
-		// Get the file size
-		const DWORD file_size = GetFileSize(file_handle, nullptr);
-
-		// Create a file mapping object
-		const HANDLE file_mapping = CreateFileMapping(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
-		if (file_mapping == nullptr) 
+		catch (const pmp::IOException& e)
 		{
-			std::cerr << "ImportOBJMeshGeometryData [ERROR]: Failed to create file mapping.\n";
-			CloseHandle(file_handle);
-			return {};
-		}
-
-		// Map the file into memory
-		const LPVOID file_memory = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
-		if (file_memory == nullptr) 
-		{
-			std::cerr << "ImportOBJMeshGeometryData [ERROR]: Failed to map the file.\n";
-			CloseHandle(file_mapping);
-			CloseHandle(file_handle);
+			std::cerr << "ImportOBJMeshGeometryData [ERROR]: " << e.what() << "\n";
 			return {};
 		}
 
 		BaseMeshGeometryData resultData;
-
-		// Determine the number of threads
-		const size_t thread_count = importInParallel ? std::thread::hardware_concurrency() : 1;
-		const size_t chunk_size = file_size / thread_count;
-		std::vector<std::thread> threads(thread_count);
-		std::vector<ChunkData> threadResults(thread_count);
-
-		char* file_start = static_cast<char*>(file_memory);
-		char* file_end = file_start + file_size;
-
-		for (size_t i = 0; i < thread_count; ++i) {
-			char* chunk_start = file_start + (i * chunk_size);
-			char* chunk_end = (i == thread_count - 1) ? file_end : chunk_start + chunk_size;
-
-			// Adjust chunk_end to point to the end of a line
-			while (*chunk_end != '\n' && chunk_end < file_end) {
-				chunk_end++;
-			}
-			if (chunk_end != file_end) {
-				chunk_end++;  // move past the newline character
-			}
-
-			// Start a thread to process this chunk
-			threads[i] = std::thread(ParseChunk, chunk_start, chunk_end, std::ref(threadResults[i]));
-		}
-
-		// Wait for all threads to finish
-		for (auto& t : threads) {
-			t.join();
-		}
-
-		if (chunkIdsVertexPropPtrOpt.has_value() && !chunkIdsVertexPropPtrOpt.value()->empty())
+		resultData.Vertices = std::move(soup.positions);
+		resultData.VertexNormals = std::move(soup.normals);
+		resultData.PolyIndices.resize(soup.polygon_sizes.size());
+		for (size_t i = 0, offset = 0; i < soup.polygon_sizes.size(); i++)
 		{
-			chunkIdsVertexPropPtrOpt.value()->clear();
+			const auto polyIndicesBegin = soup.polygon_indices.begin() + static_cast<std::ptrdiff_t>(offset);
+			resultData.PolyIndices[i].assign(polyIndicesBegin, polyIndicesBegin + soup.polygon_sizes[i]);
+			offset += soup.polygon_sizes[i];
 		}
-		for (int threadId = 0; const auto& result : threadResults)
-		{
-			if (chunkIdsVertexPropPtrOpt.has_value())
-			{
-				const auto nVertsPerChunk = result.Vertices.size();
-				chunkIdsVertexPropPtrOpt.value()->insert(chunkIdsVertexPropPtrOpt.value()->end(), nVertsPerChunk, static_cast<float>(threadId));
-			}
-			resultData.Vertices.insert(resultData.Vertices.end(), result.Vertices.begin(), result.Vertices.end());
-			resultData.PolyIndices.insert(resultData.PolyIndices.end(), result.PolyIndices.begin(), result.PolyIndices.end());
-			resultData.VertexNormals.insert(resultData.VertexNormals.end(), result.VertexNormals.begin(), result.VertexNormals.end());
 
-			++threadId;
+		if (chunkIdsVertexPropPtrOpt.has_value())
+		{
+			auto& chunkIds = *chunkIdsVertexPropPtrOpt.value();
+			chunkIds.clear();
+			chunkIds.reserve(resultData.Vertices.size());
+			for (size_t chunkId = 0; chunkId < soup.chunk_n_positions.size(); chunkId++)
+				chunkIds.insert(chunkIds.end(), soup.chunk_n_positions[chunkId], static_cast<float>(chunkId));
 		}
 
-		// Clean up
-		UnmapViewOfFile(file_memory);
-		CloseHandle(file_mapping);
-		CloseHandle(file_handle);
-
 		return std::move(resultData);
 	}
 
@@ -619,125 +284,22 @@ namespace Geometry
 		if (extension != "ply")
 			return {};
 
-		const char* file_path = absFileName.c_str();
-
-		const HANDLE file_handle = CreateFile(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-
-		if (file_handle == INVALID_HANDLE_VALUE)
-		{
-			std::cerr << "ImportPLYPointCloudData [ERROR]: Failed to open the file.\n";
-			return {};
-		}
-
-		// Get the file size
-		const DWORD file_size = GetFileSize(file_handle, nullptr);
-
-		// Create a file mapping object
-		const HANDLE file_mapping = CreateFileMapping(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
-		if (file_mapping == nullptr)
-		{
-			std::cerr << "ImportPLYPointCloudData [ERROR]: Failed to create file mapping.\n";
-			CloseHandle(file_handle);
-			return {};
-		}
-
-		// Map the file into memory
-		const LPVOID file_memory = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
-		if (file_memory == nullptr)
-		{
-			std::cerr << "ImportPLYPointCloudData [ERROR]: Failed to map the file.\n";
-			CloseHandle(file_mapping);
-			CloseHandle(file_handle);
-			return {};
-		}
-
-		std::vector<pmp::vec3> resultData;
-
-		char* file_start = static_cast<char*>(file_memory);
-		char* file_end = file_start + file_size;
-
-		// Read the PLY header to get the number of vertices and start position of vertex data
-		const auto [vertexCount, vertexDataStart] = ReadPLYVertexHeader(file_start);
-		if (vertexDataStart == 0)
+		try
 		{
-			std::cerr << "ImportPLYPointCloudData [ERROR]: Failed to read PLY header or no vertices found.\n";
-			UnmapViewOfFile(file_memory);
-			CloseHandle(file_mapping);
-			CloseHandle(file_handle);
-			return {};
-		}
-
-		// Adjust file_start to point to the beginning of vertex data
-		file_start = vertexDataStart;
-
-		// Ensure there is vertex data to process
-		if (file_start >= file_end) 
-		{
-			std::cerr << "ImportPLYPointCloudData [ERROR]: No vertex data to process.\n";
-			UnmapViewOfFile(file_memory);
-			CloseHandle(file_mapping);
-			CloseHandle(file_handle);
-			return {};
-		}
-
-		// Adjust the file size for chunk calculation
-		const size_t adjusted_file_size = file_end - file_start;
-
-		// Determine the number of threads and chunk size
-		const size_t thread_count = importInParallel ? std::thread::hardware_concurrency() : 1;
-		const size_t chunk_size = std::max<size_t>(adjusted_file_size / thread_count, 1ul); // Ensure chunk size is at least 1
-		std::vector<std::thread> threads(thread_count);
-		std::vector<std::vector<pmp::vec3>> threadResults(thread_count);
-
-		for (size_t i = 0; i < thread_count; ++i) 
-		{
-			char* chunk_start = file_start + (i * chunk_size);
-			char* chunk_end = (i == thread_count - 1) ? file_end : chunk_start + chunk_size;
-
-			// Adjust chunk_start to the beginning of a line (for all chunks except the first)
-			if (i > 0) 
-			{
-				while (*chunk_start != '\n' && chunk_start < file_end) 
-				{
-					chunk_start++;
-				}
-				if (chunk_start < file_end)
-				{
-					chunk_start++;  // Move past the newline character
-				}
-			}
-
-			// Adjust chunk_end to the end of a line
-			while (*chunk_end != '\n' && chunk_end < file_end)
+			const pmp::MappedFile file(absFileName);
+			auto soup = pmp::PolygonSoupParser::parse_ply(file.view(), nullptr, nullptr, importInParallel);
+			if (soup.positions.empty())
 			{
-				chunk_end++;
+				std::cerr << "ImportPLYPointCloudData [ERROR]: No vertex data to process.\n";
+				return {};
 			}
-			if (chunk_end < file_end)
-			{
-				chunk_end++;  // Move past the newline character
-			}
-
-			// Start a thread to process this chunk
-			threads[i] = std::thread(ParsePointCloudChunk, chunk_start, chunk_end, std::ref(threadResults[i]));
-		}
-
-		// Wait for all threads to finish
-		for (auto& t : threads) 
-		{
-			t.join();
+			return std::move(soup.positions);
 		}
-
-		for (const auto& result : threadResults)
+		catch (const pmp::IOException& e)
 		{
-			resultData.insert(resultData.end(), result.begin(), result.end());
+			std::cerr << "ImportPLYPointCloudData [ERROR]: " << e.what() << "\n";
+			return {};
 		}
-
-		// Clean up
-		UnmapViewOfFile(file_memory);
-		CloseHandle(file_mapping);
-		CloseHandle(file_handle);
-
-		return std::move(resultData);
 	}
 
 	std::optional<std::vector<pmp::vec3>> ImportPLYPointCloudDataMainThread(const std::string& absFileName)
@@ -749,56 +311,22 @@ namespace Geometry
 			return {};
 		}
 
-		std::ifstream file(absFileName);
-		if (!file.is_open()) 
-		{
-			std::cerr << "Failed to open the file." << std::endl;
-			return {};
-		}
-
-		std::string line;
-		size_t vertexCount = 0;
-		bool headerEnded = false;
-
-		// Read header to find the vertex count
-		while (std::getline(file, line) && !headerEnded) 
+		try
 		{
-			std::istringstream iss(line);
-			std::string token;
-			iss >> token;
-
-			if (token == "element") {
-				iss >> token;
-				if (token == "vertex") {
-					iss >> vertexCount;
-				}
-			}
-			else if (token == "end_header") {
-				headerEnded = true;
+			const pmp::MappedFile file(absFileName);
+			auto soup = pmp::PolygonSoupParser::parse_ply(file.view(), nullptr, nullptr, false);
+			if (soup.positions.empty())
+			{
+				std::cerr << "Invalid PLY header or no vertices found." << std::endl;
+				return {};
 			}
+			return std::move(soup.positions);
 		}
-
-		if (!headerEnded || vertexCount == 0) {
-			std::cerr << "Invalid PLY header or no vertices found." << std::endl;
+		catch (const pmp::IOException& e)
+		{
+			std::cerr << "ImportPLYPointCloudDataMainThread [ERROR]: " << e.what() << "\n";
 			return {};
 		}
-
-		std::vector<pmp::vec3> vertices;
-		vertices.reserve(vertexCount);
-
-		// Read vertex data
-		while (std::getline(file, line)) {
-			std::istringstream iss(line);
-			pmp::vec3 vertex;
-			if (!(iss >> vertex[0] >> vertex[1] >> vertex[2])) {
-				std::cerr << "Error parsing vertex data: " << line << std::endl;
-				continue;
-			}
-
-			vertices.push_back(vertex);
-		}
-
-		return vertices;
 	}
 
 	bool ExportSampledVerticesToPLY(const BaseMeshGeometryData& meshData, size_t nVerts, const std::string& absFileName, const std::optional<unsigned int>& seed)
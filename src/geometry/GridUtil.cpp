@@ -4,6 +4,9 @@
 #include "pmp/algorithms/BarycentricCoordinates.h"
 #include "pmp/algorithms/TriangleKdTree.h"
 
+#include <limits>
+#include <stdexcept>
+
 namespace Geometry
 {
 	/// \brief constant for kernel radius of a "narrow" kernel.
@@ -1275,4 +1278,118 @@ namespace Geometry
 		return result;
 	}
 
+	/// \brief the number of probes sampled together by the SIMD loops of SampleGridAlongProbes.
+	constexpr size_t GRID_PROBE_BATCH_SIZE = 8;
+
+	void SampleGridAlongProbes(const ScalarGrid& grid, const std::vector<pmp::Point>& origins, const std::vector<pmp::Point>& directions,
+		const GridProbeSettings& settings, std::vector<double>& minValues, std::vector<double>& maxValues)
+	{
+		if (origins.size() != directions.size())
+		{
+			throw std::invalid_argument("SampleGridAlongProbes: origins.size() != directions.size()!\n");
+		}
+
+		const size_t nProbes = origins.size();
+		minValues.assign(nProbes, std::numeric_limits<double>::quiet_NaN());
+		maxValues.assign(nProbes, std::numeric_limits<double>::quiet_NaN());
+		const auto& dims = grid.Dimensions();
+		if (nProbes == 0 || settings.NSamples == 0 || dims.Nx < 2 || dims.Ny < 2 || dims.Nz < 2)
+			return;
+
+		const auto& values = grid.Values();
+		const auto Nx = static_cast<int>(dims.Nx);
+		const auto Ny = static_cast<int>(dims.Ny);
+		const auto Nz = static_cast<int>(dims.Nz);
+		const size_t NxNy = dims.Nx * dims.Ny;
+		const float invCellSize = 1.0f / grid.CellSize();
+		const auto& gridOrigin = grid.Box().min();
+		const unsigned int nMaxSamples = std::min(settings.NMaxSamples, settings.NSamples);
+		const auto nBatches = static_cast<int>((nProbes + GRID_PROBE_BATCH_SIZE - 1) / GRID_PROBE_BATCH_SIZE);
+
+#pragma omp parallel for schedule(static)
+		for (int bi = 0; bi < nBatches; bi++)
+		{
+			const size_t firstProbe = static_cast<size_t>(bi) * GRID_PROBE_BATCH_SIZE;
+			const size_t nLanes = std::min(GRID_PROBE_BATCH_SIZE, nProbes - firstProbe);
+
+			// probes of the batch in grid index space (structure of arrays)
+			alignas(32) float startX[GRID_PROBE_BATCH_SIZE], startY[GRID_PROBE_BATCH_SIZE], startZ[GRID_PROBE_BATCH_SIZE];
+			alignas(32) float stepX[GRID_PROBE_BATCH_SIZE], stepY[GRID_PROBE_BATCH_SIZE], stepZ[GRID_PROBE_BATCH_SIZE];
+			alignas(32) float weightX[GRID_PROBE_BATCH_SIZE], weightY[GRID_PROBE_BATCH_SIZE], weightZ[GRID_PROBE_BATCH_SIZE];
+			alignas(32) size_t cellIds[GRID_PROBE_BATCH_SIZE];
+			alignas(32) int isActive[GRID_PROBE_BATCH_SIZE];
+			alignas(32) int nSampled[GRID_PROBE_BATCH_SIZE];
+			alignas(32) double laneMin[GRID_PROBE_BATCH_SIZE], laneMax[GRID_PROBE_BATCH_SIZE];
+			for (size_t l = 0; l < GRID_PROBE_BATCH_SIZE; l++)
+			{
+				// unused lanes of the last batch repeat its first probe and stay inactive.
+				const auto& probeOrigin = origins[firstProbe + (l < nLanes ? l : 0)];
+				const auto& probeDir = directions[firstProbe + (l < nLanes ? l : 0)];
+				startX[l] = (probeOrigin[0] + settings.Offset * probeDir[0] - gridOrigin[0]) * invCellSize;
+				startY[l] = (probeOrigin[1] + settings.Offset * probeDir[1] - gridOrigin[1]) * invCellSize;
+				startZ[l] = (probeOrigin[2] + settings.Offset * probeDir[2] - gridOrigin[2]) * invCellSize;
+				stepX[l] = settings.StepLength * probeDir[0] * invCellSize;
+				stepY[l] = settings.StepLength * probeDir[1] * invCellSize;
+				stepZ[l] = settings.StepLength * probeDir[2] * invCellSize;
+				isActive[l] = (l < nLanes ? 1 : 0);
+				nSampled[l] = 0;
+				laneMin[l] = std::numeric_limits<double>::max();
+				laneMax[l] = std::numeric_limits<double>::lowest();
+			}
+
+			for (unsigned int si = 0; si < settings.NSamples; si++)
+			{
+				const auto sampleId = static_cast<float>(si);
+				int nActive = 0;
+
+				// cell indices and interpolation weights
+#pragma omp simd reduction(+:nActive)
+				for (size_t l = 0; l < GRID_PROBE_BATCH_SIZE; l++)
+				{
+					const float x = startX[l] + sampleId * stepX[l];
+					const float y = startY[l] + sampleId * stepY[l];
+					const float z = startZ[l] + sampleId * stepZ[l];
+					const float fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+					const int ix = static_cast<int>(fx), iy = static_cast<int>(fy), iz = static_cast<int>(fz);
+					const bool isInside = ix >= 0 && iy >= 0 && iz >= 0 && ix < Nx - 1 && iy < Ny - 1 && iz < Nz - 1;
+					isActive[l] = (isActive[l] && isInside ? 1 : 0);
+					cellIds[l] = (isActive[l] ? NxNy * iz + dims.Nx * iy + ix : 0);
+					weightX[l] = x - fx;
+					weightY[l] = y - fy;
+					weightZ[l] = z - fz;
+					nActive += isActive[l];
+				}
+				if (nActive == 0)
+					break;
+
+				// gathers of the surrounding values and trilinear interpolation
+#pragma omp simd
+				for (size_t l = 0; l < GRID_PROBE_BATCH_SIZE; l++)
+				{
+					const size_t c = cellIds[l];
+					const double wx = weightX[l], wy = weightY[l], wz = weightZ[l];
+					const double v00 = values[c] + wx * (values[c + 1] - values[c]);
+					const double v10 = values[c + Nx] + wx * (values[c + Nx + 1] - values[c + Nx]);
+					const double v01 = values[c + NxNy] + wx * (values[c + NxNy + 1] - values[c + NxNy]);
+					const double v11 = values[c + NxNy + Nx] + wx * (values[c + NxNy + Nx + 1] - values[c + NxNy + Nx]);
+					const double v0 = v00 + wy * (v10 - v00);
+					const double v1 = v01 + wy * (v11 - v01);
+					const double value = v0 + wz * (v1 - v0);
+					laneMin[l] = (isActive[l] && value < laneMin[l] ? value : laneMin[l]);
+					laneMax[l] = (isActive[l] && si < nMaxSamples && value > laneMax[l] ? value : laneMax[l]);
+					nSampled[l] += isActive[l];
+				}
+			}
+
+			for (size_t l = 0; l < nLanes; l++)
+			{
+				if (nSampled[l] == 0)
+					continue;
+				minValues[firstProbe + l] = laneMin[l];
+				if (nMaxSamples > 0)
+					maxValues[firstProbe + l] = laneMax[l];
+			}
+		}
+	}
+
 } // namespace Geometry
@@ -256,4 +256,34 @@ namespace Geometry
 	 */
 	[[nodiscard]] ScalarGrid ExtractReSampledGrid(const float& newCellSize, const ScalarGrid& origGrid);
 
+	// ==================================================================================================================
+
+	/**
+	 * \brief A parameter container for sampling a scalar grid along straight probes (e.g.: along surface normals).
+	 * \struct GridProbeSettings
+	 */
+	struct GridProbeSettings
+	{
+		float Offset{ 1.0f }; //! distance of the first sample from the probe origin.
+		float StepLength{ 1.0f }; //! distance between two consecutive samples of a probe.
+		unsigned int NSamples{ 1 }; //! the number of samples of each probe (for the min value).
+		unsigned int NMaxSamples{ 1 }; //! the number of leading samples of each probe used for the max value.
+	};
+
+	/**
+	 * \brief Trilinearly samples a scalar grid along a batch of probes, and evaluates the min and max sampled value of each probe.
+	 * \param grid          sampled scalar grid.
+	 * \param origins       origins of the probes.
+	 * \param directions    (unit) directions of the probes.
+	 * \param settings      sampling parameters.
+	 * \param minValues     min of the first settings.NSamples values of each probe.
+	 * \param maxValues     max of the first settings.NMaxSamples values of each probe.
+	 *
+	 * Probes are processed in parallel in fixed-size batches whose lanes are evaluated by SIMD loops (index and weight
+	 * evaluation followed by gathers of the 8 surrounding grid values). A probe stops at its first sample outside of the grid.
+	 * DISCLAIMER: If the first sample of a probe is outside of the grid, both its min and max values are NaN.
+	 */
+	void SampleGridAlongProbes(const ScalarGrid& grid, const std::vector<pmp::Point>& origins, const std::vector<pmp::Point>& directions,
+		const GridProbeSettings& settings, std::vector<double>& minValues, std::vector<double>& maxValues);
+
 } // namespace Geometry
\ No newline at end of file
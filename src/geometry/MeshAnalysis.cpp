@@ -4,6 +4,7 @@
 #include "GeometryUtil.h"
 #include "GridUtil.h"
 #include "MeshSelfIntersection.h"
+#include "SurfaceMeshBVH.h"
 
 #include "sdf/SDF.h"
 
@@ -743,22 +744,15 @@ namespace Geometry
 		}
 	}
 
-	static [[nodiscard]] double GaussianWeight(const pmp::SurfaceMesh& mesh, const pmp::Vertex& v, const double& sigma)
+	static [[nodiscard]] double GaussianWeight(const pmp::SurfaceMesh& mesh, const pmp::VertexProperty<pmp::Scalar>& vCurvature, const pmp::Vertex& v, const double& sigma)
 	{
-		if (!mesh.has_vertex_property("v:meanCurvature"))
-		{
-			throw std::invalid_argument("Geometry::GaussianWeight: input mesh has no vertex property called \"v:meanCurvature\"\n");
-		}
-
-		auto vCurvature = mesh.get_vertex_property<pmp::Scalar>("v:meanCurvature");
-		auto positions = mesh.get_vertex_property<pmp::Point>("v:point");
 		double weightSum = 0.0;
 		double curvatureSum = 0.0;
-		const pmp::Point p = positions[v];
+		const pmp::Point p = mesh.position(v);
 
 		for (const auto u : mesh.vertices(v))
 		{
-			pmp::Point q = positions[u];
+			pmp::Point q = mesh.position(u);
 			const pmp::Scalar distance = pmp::norm(p - q);
 			const pmp::Scalar weight = exp(-pow(distance, 2) / (2 * pow(sigma, 2)));
 			curvatureSum += vCurvature[u] * weight;
@@ -770,6 +764,12 @@ namespace Geometry
 
 	static void ComputeSaliency(pmp::SurfaceMesh& mesh, const std::vector<double>& sigmas)
 	{
+		// property handles are resolved once, not per vertex and sigma.
+		const auto vCurvature = mesh.get_vertex_property<pmp::Scalar>("v:meanCurvature");
+		if (!vCurvature)
+		{
+			throw std::invalid_argument("Geometry::ComputeSaliency: input mesh has no vertex property called \"v:meanCurvature\"\n");
+		}
 		auto saliency = mesh.vertex_property<pmp::Scalar>("v:saliency", 0.0f);
 
 		for (auto v : mesh.vertices()) 
@@ -777,8 +777,8 @@ namespace Geometry
 			pmp::Scalar saliencyValue = 0.0f;
 			for (double sigma : sigmas) 
 			{
-				const double fine = GaussianWeight(mesh, v, sigma);
-				const double coarse = GaussianWeight(mesh, v, 2 * sigma);
+				const double fine = GaussianWeight(mesh, vCurvature, v, sigma);
+				const double coarse = GaussianWeight(mesh, vCurvature, v, 2 * sigma);
 				saliencyValue += std::abs(fine - coarse);
 			}
 			saliency[v] = saliencyValue;
@@ -954,63 +954,8 @@ namespace Geometry
 			throw std::invalid_argument("CountPMPSurfaceMeshSelfIntersectingFaces: non-triangle SurfaceMesh not supported for this function!\n");
 		}
 
-		pmp::FaceProperty<bool> fIsSelfIntersecting;
-		if (setFaceProperty)
-		{
-			fIsSelfIntersecting = mesh.add_face_property<bool>("f:isSelfIntersecting", false);
-		}
-
-		const PMPSurfaceMeshAdapter meshAdapter(std::make_shared<pmp::SurfaceMesh>(mesh));
-		const auto ptrMeshCollisionKdTree = std::make_unique<CollisionKdTree>(meshAdapter, CenterSplitFunction);
-		size_t nSelfIntFaceCountResult = 0;
-		for (const auto f : mesh.faces())
-		{
-			pmp::BoundingBox fBBox;
-			std::vector<pmp::Point> vertices0;
-			vertices0.reserve(3);
-			std::unordered_set<unsigned int> neighboringFaceIds;
-			for (const auto v : mesh.vertices(f))
-			{
-				for (const auto nf : mesh.faces(v))
-					neighboringFaceIds.insert(nf.idx());
-				const auto& vPos = mesh.position(v);
-				vertices0.push_back(vPos);
-				fBBox += vPos;
-			}
-
-			// Query the kd-tree for candidates
-			std::vector<unsigned int> candidateIds;
-			ptrMeshCollisionKdTree->GetTrianglesInABox(fBBox, candidateIds);
-
-			for (const auto ci : candidateIds)
-			{
-				const auto cf = pmp::Face(ci);
-				if (cf == f || neighboringFaceIds.contains(ci))
-				{
-					continue; // Skip self and neighboring faces
-				}
-
-				std::vector<pmp::Point> vertices1;
-				vertices1.reserve(3);
-				for (const auto cv : mesh.vertices(cf))
-				{
-					vertices1.push_back(mesh.position(cv));
-				}
-
-				if (TriangleIntersectsTriangle(vertices0, vertices1))
-				{
-					++nSelfIntFaceCountResult; // Found an intersection
-					if (setFaceProperty) 
-					{
-						fIsSelfIntersecting[f] = true;
-						fIsSelfIntersecting[cf] = true;
-					}
-					break; // Only count once per face
-				}
-			}
-		}
-
-		return nSelfIntFaceCountResult;
+		const SurfaceMeshBVH bvh(mesh);
+		return CountSelfIntersectingFaces(mesh, bvh, setFaceProperty);
 	}
 
 	bool PMPSurfaceMeshHasSelfIntersections(const pmp::SurfaceMesh& mesh)
@@ -130,7 +130,9 @@ namespace Geometry
 	/// \brief Counts self-intersecting faces of the input mesh.
 	/// \param[in] mesh               the evaluated SurfaceMesh.
 	///	\param[in] setFaceProperty    if true, the evaluated mesh will be given a face property identifying the self-intersecting faces.
-	///	\return the total number of faces which intersect another face.
+	///	\return the total number of faces which intersect another face. Both faces of each intersecting pair are counted
+	///	        (each face once), matching the faces marked by setFaceProperty. The former CollisionKdTree-based
+	///	        implementation under-counted, so results are typically higher than before.
 	[[nodiscard]] size_t CountPMPSurfaceMeshSelfIntersectingFaces(pmp::SurfaceMesh& mesh, const bool& setFaceProperty = false);
 
 	/// \brief A fast verification for the presence of self-intersecting faces of the input mesh.
@@ -0,0 +1,318 @@
+#include "SurfaceMeshBVH.h"
+
+#include "GeometryUtil.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Geometry
+{
+	/// \brief max number of faces per leaf.
+	constexpr unsigned int MAX_FACES_PER_LEAF = 4;
+
+	/// \brief the number of node pairs generated before the parallel self-collision traversal (enough to balance the threads).
+	constexpr size_t MIN_COLLISION_FRONT_SIZE = 256;
+
+	SurfaceMeshBVH::SurfaceMeshBVH(const pmp::SurfaceMesh& mesh)
+	{
+		if (!mesh.is_triangle_mesh())
+		{
+			throw std::invalid_argument("SurfaceMeshBVH::SurfaceMeshBVH: non-triangle SurfaceMesh not supported!\n");
+		}
+
+		CopyPositions(mesh);
+		m_FaceVertexIds.resize(mesh.faces_size(), { 0, 0, 0 });
+		m_FaceIds.reserve(mesh.n_faces());
+		std::vector<pmp::Point> centroids(mesh.faces_size(), pmp::Point(0, 0, 0));
+		for (const auto f : mesh.faces())
+		{
+			unsigned int i = 0;
+			for (const auto v : mesh.vertices(f))
+			{
+				m_FaceVertexIds[f.idx()][i++] = v.idx();
+				centroids[f.idx()] += m_Positions[v.idx()];
+			}
+			centroids[f.idx()] /= 3.0f;
+			m_FaceIds.push_back(f.idx());
+		}
+		if (m_FaceIds.empty())
+			return;
+
+		// a binary tree with leaves of up to MAX_FACES_PER_LEAF faces has less than 2 * NFaces nodes.
+		m_Nodes.reserve(2 * m_FaceIds.size());
+		BuildRecurse(centroids, 0, static_cast<unsigned int>(m_FaceIds.size()));
+	}
+
+	unsigned int SurfaceMeshBVH::BuildRecurse(const std::vector<pmp::Point>& centroids, const unsigned int& first, const unsigned int& count)
+	{
+		const auto nodeId = static_cast<unsigned int>(m_Nodes.size());
+		m_Nodes.emplace_back();
+		if (count <= MAX_FACES_PER_LEAF)
+		{
+			auto& leaf = m_Nodes[nodeId];
+			leaf.FirstFace = first;
+			leaf.NFaces = count;
+			for (unsigned int i = first; i < first + count; i++)
+				leaf.Box += FaceBox(m_FaceIds[i]);
+			return nodeId;
+		}
+
+		// median split along the longest axis of the centroid bounds.
+		pmp::BoundingBox centroidBox;
+		for (unsigned int i = first; i < first + count; i++)
+			centroidBox += centroids[m_FaceIds[i]];
+		const pmp::Point extent = centroidBox.max() - centroidBox.min();
+		const int axis = (extent[0] > extent[1] ? (extent[0] > extent[2] ? 0 : 2) : (extent[1] > extent[2] ? 1 : 2));
+		const unsigned int nLeft = count / 2;
+		std::nth_element(m_FaceIds.begin() + first, m_FaceIds.begin() + first + nLeft, m_FaceIds.begin() + first + count,
+			[&centroids, axis](const unsigned int& a, const unsigned int& b) { return centroids[a][axis] < centroids[b][axis]; });
+
+		const auto leftId = BuildRecurse(centroids, first, nLeft);
+		const auto rightId = BuildRecurse(centroids, first + nLeft, count - nLeft);
+		auto& node = m_Nodes[nodeId];
+		node.RightChild = rightId;
+		node.Box = m_Nodes[leftId].Box;
+		node.Box += m_Nodes[rightId].Box;
+		return nodeId;
+	}
+
+	void SurfaceMeshBVH::CopyPositions(const pmp::SurfaceMesh& mesh)
+	{
+		m_Positions.resize(mesh.vertices_size());
+		for (size_t i = 0; i < m_Positions.size(); i++)
+			m_Positions[i] = mesh.position(pmp::Vertex(static_cast<pmp::IndexType>(i)));
+	}
+
+	pmp::BoundingBox SurfaceMeshBVH::FaceBox(const unsigned int& faceId) const
+	{
+		pmp::BoundingBox box;
+		for (const auto vId : m_FaceVertexIds[faceId])
+			box += m_Positions[vId];
+		return box;
+	}
+
+	bool SurfaceMeshBVH::IsCompatible(const pmp::SurfaceMesh& mesh) const
+	{
+		if (mesh.faces_size() != m_FaceVertexIds.size() || mesh.n_faces() != m_FaceIds.size() || mesh.vertices_size() != m_Positions.size())
+			return false;
+
+		for (const auto f : mesh.faces())
+		{
+			unsigned int i = 0;
+			for (const auto v : mesh.vertices(f))
+			{
+				if (i > 2 || m_FaceVertexIds[f.idx()][i++] != v.idx())
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void SurfaceMeshBVH::Refit(const pmp::SurfaceMesh& mesh)
+	{
+		if (!IsCompatible(mesh))
+		{
+			throw std::invalid_argument("SurfaceMeshBVH::Refit: mesh connectivity differs from the connectivity the hierarchy was built from!\n");
+		}
+
+		CopyPositions(mesh);
+
+		// leaves are independent of each other.
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < static_cast<int>(m_Nodes.size()); i++)
+		{
+			auto& node = m_Nodes[i];
+			if (node.NFaces == 0)
+				continue;
+			node.Box = pmp::BoundingBox();
+			for (unsigned int j = node.FirstFace; j < node.FirstFace + node.NFaces; j++)
+				node.Box += FaceBox(m_FaceIds[j]);
+		}
+
+		// children are stored after their parents, so a reverse sweep visits them first.
+		for (auto i = static_cast<int>(m_Nodes.size()) - 1; i >= 0; i--)
+		{
+			auto& node = m_Nodes[i];
+			if (node.NFaces > 0)
+				continue;
+			node.Box = m_Nodes[i + 1].Box;
+			node.Box += m_Nodes[node.RightChild].Box;
+		}
+	}
+
+	bool SurfaceMeshBVH::AreAdjacent(const unsigned int& faceId0, const unsigned int& faceId1) const
+	{
+		const auto& vIds0 = m_FaceVertexIds[faceId0];
+		const auto& vIds1 = m_FaceVertexIds[faceId1];
+		for (const auto vId0 : vIds0)
+		{
+			if (vId0 == vIds1[0] || vId0 == vIds1[1] || vId0 == vIds1[2])
+				return true;
+		}
+		return false;
+	}
+
+	void SurfaceMeshBVH::CollideLeaves(const unsigned int& nodeId0, const unsigned int& nodeId1, std::vector<FacePair>& result) const
+	{
+		const auto& leaf0 = m_Nodes[nodeId0];
+		const auto& leaf1 = m_Nodes[nodeId1];
+		std::vector<pmp::vec3> vertices0(3);
+		std::vector<pmp::vec3> vertices1(3);
+		for (unsigned int i = leaf0.FirstFace; i < leaf0.FirstFace + leaf0.NFaces; i++)
+		{
+			const auto faceId0 = m_FaceIds[i];
+			const auto faceBox0 = FaceBox(faceId0);
+			for (unsigned int k = 0; k < 3; k++)
+				vertices0[k] = m_Positions[m_FaceVertexIds[faceId0][k]];
+
+			// a leaf colliding with itself tests each pair of its faces once.
+			const unsigned int firstJ = (nodeId0 == nodeId1 ? i + 1 : leaf1.FirstFace);
+			for (unsigned int j = firstJ; j < leaf1.FirstFace + leaf1.NFaces; j++)
+			{
+				const auto faceId1 = m_FaceIds[j];
+				if (AreAdjacent(faceId0, faceId1) || !faceBox0.Intersects(FaceBox(faceId1)))
+					continue;
+
+				for (unsigned int k = 0; k < 3; k++)
+					vertices1[k] = m_Positions[m_FaceVertexIds[faceId1][k]];
+				if (!TriangleIntersectsTriangle(vertices0, vertices1))
+					continue;
+
+				result.emplace_back(std::min(faceId0, faceId1), std::max(faceId0, faceId1));
+			}
+		}
+	}
+
+	void SurfaceMeshBVH::CollideRecurse(const unsigned int& nodeId0, const unsigned int& nodeId1, std::vector<FacePair>& result) const
+	{
+		const auto& node0 = m_Nodes[nodeId0];
+		const auto& node1 = m_Nodes[nodeId1];
+		if (nodeId0 == nodeId1)
+		{
+			if (node0.NFaces > 0)
+			{
+				CollideLeaves(nodeId0, nodeId0, result);
+				return;
+			}
+			CollideRecurse(nodeId0 + 1, nodeId0 + 1, result);
+			CollideRecurse(node0.RightChild, node0.RightChild, result);
+			CollideRecurse(nodeId0 + 1, node0.RightChild, result);
+			return;
+		}
+
+		if (!node0.Box.Intersects(node1.Box))
+			return;
+
+		if (node0.NFaces > 0 && node1.NFaces > 0)
+		{
+			CollideLeaves(nodeId0, nodeId1, result);
+			return;
+		}
+
+		// descend into the larger inner node.
+		if (node1.NFaces > 0 || (node0.NFaces == 0 && node0.Box.size() >= node1.Box.size()))
+		{
+			CollideRecurse(nodeId0 + 1, nodeId1, result);
+			CollideRecurse(node0.RightChild, nodeId1, result);
+			return;
+		}
+		CollideRecurse(nodeId0, nodeId1 + 1, result);
+		CollideRecurse(nodeId0, node1.RightChild, result);
+	}
+
+	std::vector<FacePair> SurfaceMeshBVH::FindSelfIntersections() const
+	{
+		if (m_Nodes.empty())
+			return {};
+
+		// expand the root self-collision breadth-first into a front of independent node pairs ...
+		std::vector<std::pair<unsigned int, unsigned int>> front{ { 0, 0 } };
+		std::vector<std::pair<unsigned int, unsigned int>> nextFront;
+		while (front.size() < MIN_COLLISION_FRONT_SIZE)
+		{
+			bool isExpanded = false;
+			nextFront.clear();
+			for (const auto& [nodeId0, nodeId1] : front)
+			{
+				const auto& node0 = m_Nodes[nodeId0];
+				const auto& node1 = m_Nodes[nodeId1];
+				if (nodeId0 == nodeId1)
+				{
+					if (node0.NFaces > 0)
+					{
+						nextFront.emplace_back(nodeId0, nodeId1);
+						continue;
+					}
+					nextFront.emplace_back(nodeId0 + 1, nodeId0 + 1);
+					nextFront.emplace_back(node0.RightChild, node0.RightChild);
+					nextFront.emplace_back(nodeId0 + 1, node0.RightChild);
+					isExpanded = true;
+					continue;
+				}
+				if (!node0.Box.Intersects(node1.Box))
+					continue;
+				if (node0.NFaces > 0 && node1.NFaces > 0)
+				{
+					nextFront.emplace_back(nodeId0, nodeId1);
+					continue;
+				}
+				if (node1.NFaces > 0 || (node0.NFaces == 0 && node0.Box.size() >= node1.Box.size()))
+				{
+					nextFront.emplace_back(nodeId0 + 1, nodeId1);
+					nextFront.emplace_back(node0.RightChild, nodeId1);
+				}
+				else
+				{
+					nextFront.emplace_back(nodeId0, nodeId1 + 1);
+					nextFront.emplace_back(nodeId0, node1.RightChild);
+				}
+				isExpanded = true;
+			}
+			std::swap(front, nextFront);
+			if (!isExpanded)
+				break;
+		}
+
+		// ... whose subtrees are traversed concurrently.
+		std::vector<FacePair> result;
+#pragma omp parallel
+		{
+			std::vector<FacePair> threadResult;
+#pragma omp for schedule(dynamic, 1) nowait
+			for (int i = 0; i < static_cast<int>(front.size()); i++)
+				CollideRecurse(front[i].first, front[i].second, threadResult);
+#pragma omp critical
+			result.insert(result.end(), threadResult.begin(), threadResult.end());
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	size_t CountSelfIntersectingFaces(pmp::SurfaceMesh& mesh, const SurfaceMeshBVH& bvh, const bool& setFaceProperty)
+	{
+		const auto facePairs = bvh.FindSelfIntersections();
+		std::vector<bool> isIntersecting(mesh.faces_size(), false);
+		for (const auto& [faceId0, faceId1] : facePairs)
+		{
+			isIntersecting[faceId0] = true;
+			isIntersecting[faceId1] = true;
+		}
+
+		pmp::FaceProperty<bool> fIsSelfIntersecting;
+		if (setFaceProperty)
+		{
+			fIsSelfIntersecting = mesh.face_property<bool>("f:isSelfIntersecting", false);
+		}
+
+		size_t nSelfIntFaceCountResult = 0;
+		for (const auto f : mesh.faces())
+		{
+			if (setFaceProperty)
+				fIsSelfIntersecting[f] = isIntersecting[f.idx()];
+			if (isIntersecting[f.idx()])
+				++nSelfIntFaceCountResult;
+		}
+		return nSelfIntFaceCountResult;
+	}
+
+} // namespace Geometry
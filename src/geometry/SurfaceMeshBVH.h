@@ -0,0 +1,100 @@
+#pragma once
+
+#include "pmp/SurfaceMesh.h"
+#include "pmp/BoundingBox.h"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace Geometry
+{
+	//! \brief a pair of face indices (first < second).
+	using FacePair = std::pair<unsigned int, unsigned int>;
+
+	/**
+	 * \brief A bounding volume hierarchy over the faces of a triangle SurfaceMesh, intended for repeated
+	 *        self-intersection queries on an evolving surface.
+	 * \class SurfaceMeshBVH
+	 *
+	 * The hierarchy is built once (median splits along the longest axis of face centroids) and, as long as the mesh
+	 * connectivity stays unchanged, only the boxes are recomputed from new vertex positions by Refit in O(n).
+	 * Refitted boxes are looser than rebuilt ones when vertices move far, but they remain conservative, so the
+	 * detected intersections are exact regardless of the hierarchy quality.
+	 */
+	class SurfaceMeshBVH
+	{
+	public:
+		/**
+		 * \brief Constructor. Builds the hierarchy over the faces of a given mesh.
+		 * \param mesh    a triangle mesh.
+		 * \throw std::invalid_argument if mesh is not a triangle mesh.
+		 */
+		explicit SurfaceMeshBVH(const pmp::SurfaceMesh& mesh);
+
+		/**
+		 * \brief Returns true if the hierarchy can be refitted to a given mesh, i.e.: the mesh has the same faces
+		 *        with the same vertex indices as the mesh the hierarchy was built from.
+		 */
+		[[nodiscard]] bool IsCompatible(const pmp::SurfaceMesh& mesh) const;
+
+		/**
+		 * \brief Recomputes all boxes from the current vertex positions of a compatible mesh.
+		 * \param mesh    a mesh compatible with the hierarchy (see IsCompatible).
+		 * \throw std::invalid_argument if mesh is not compatible.
+		 */
+		void Refit(const pmp::SurfaceMesh& mesh);
+
+		/**
+		 * \brief Finds all pairs of intersecting faces (in parallel). Pairs of faces sharing a vertex are skipped.
+		 * \return sorted pairs of intersecting face indices.
+		 */
+		[[nodiscard]] std::vector<FacePair> FindSelfIntersections() const;
+
+		/// \brief the number of faces in the hierarchy.
+		[[nodiscard]] size_t NFaces() const { return m_FaceIds.size(); }
+
+	private:
+		/// \brief a node of the hierarchy. Nodes are stored in depth-first order, so the left child of node i is i + 1.
+		struct Node
+		{
+			pmp::BoundingBox Box{};
+			unsigned int FirstFace{ 0 }; //>! index of the first face of a leaf into m_FaceIds.
+			unsigned int NFaces{ 0 }; //>! the number of faces of a leaf (0 for inner nodes).
+			unsigned int RightChild{ 0 }; //>! index of the right child of an inner node.
+		};
+
+		/// \brief Builds the subtree over m_FaceIds[first, first + count) from face centroids, returns its node index.
+		unsigned int BuildRecurse(const std::vector<pmp::Point>& centroids, const unsigned int& first, const unsigned int& count);
+
+		/// \brief Copies vertex positions of mesh into m_Positions.
+		void CopyPositions(const pmp::SurfaceMesh& mesh);
+
+		/// \brief Computes the box of a face from m_Positions.
+		[[nodiscard]] pmp::BoundingBox FaceBox(const unsigned int& faceId) const;
+
+		/// \brief Returns true if two faces share a vertex.
+		[[nodiscard]] bool AreAdjacent(const unsigned int& faceId0, const unsigned int& faceId1) const;
+
+		/// \brief Tests all face pairs of two nodes (or all distinct face pairs of a single node) and appends intersecting pairs.
+		void CollideLeaves(const unsigned int& nodeId0, const unsigned int& nodeId1, std::vector<FacePair>& result) const;
+
+		/// \brief Depth-first self-collision of a subtree (nodeId0 == nodeId1) or collision of two subtrees.
+		void CollideRecurse(const unsigned int& nodeId0, const unsigned int& nodeId1, std::vector<FacePair>& result) const;
+
+		std::vector<Node> m_Nodes{}; //>! nodes in depth-first order (m_Nodes[0] is the root).
+		std::vector<unsigned int> m_FaceIds{}; //>! face indices ordered by leaves.
+		std::vector<std::array<unsigned int, 3>> m_FaceVertexIds{}; //>! vertex indices of each face (indexed by face index).
+		std::vector<pmp::Point> m_Positions{}; //>! vertex positions (indexed by vertex index) the boxes were computed from.
+	};
+
+	/**
+	 * \brief Counts faces intersecting at least one non-adjacent face of a mesh.
+	 * \param mesh               a triangle mesh.
+	 * \param bvh                a hierarchy built from (or refitted to) mesh.
+	 * \param setFaceProperty    if true, the "f:isSelfIntersecting" face property is set for the intersecting faces.
+	 * \return the number of self-intersecting faces.
+	 */
+	[[nodiscard]] size_t CountSelfIntersectingFaces(pmp::SurfaceMesh& mesh, const SurfaceMeshBVH& bvh, const bool& setFaceProperty = false);
+
+} // namespace Geometry
@@ -0,0 +1,106 @@
+// Copyright 2011-2021 the Polygon Mesh Processing Library developers.
+// Distributed under a MIT-style license, see LICENSE.txt for details.
+
+#include "pmp/MappedFile.h"
+
+#include "pmp/Exceptions.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pmp {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    const HANDLE file =
+        CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw IOException("Failed to open file: " + filename);
+    file_handle_ = file;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        throw IOException("Failed to get file size: " + filename);
+    }
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    if (size_ == 0)
+        return;
+
+    const HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        throw IOException("Failed to map file: " + filename);
+    }
+    mapping_handle_ = mapping;
+
+    data_ = static_cast<const char*>(
+        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data_)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw IOException("Failed to map file: " + filename);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_handle_)
+        CloseHandle(mapping_handle_);
+    CloseHandle(file_handle_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    file_descriptor_ = open(filename.c_str(), O_RDONLY);
+    if (file_descriptor_ < 0)
+        throw IOException("Failed to open file: " + filename);
+
+    struct stat file_status;
+    if (fstat(file_descriptor_, &file_status) != 0)
+    {
+        close(file_descriptor_);
+        throw IOException("Failed to get file size: " + filename);
+    }
+    size_ = static_cast<size_t>(file_status.st_size);
+    if (size_ == 0)
+        return;
+
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE,
+                      file_descriptor_, 0);
+    if (data == MAP_FAILED)
+    {
+        close(file_descriptor_);
+        throw IOException("Failed to map file: " + filename);
+    }
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        munmap(const_cast<char*>(data_), size_);
+    close(file_descriptor_);
+}
+
+#endif
+
+} // namespace pmp
@@ -0,0 +1,50 @@
+// Copyright 2011-2021 the Polygon Mesh Processing Library developers.
+// Distributed under a MIT-style license, see LICENSE.txt for details.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace pmp {
+
+//! \brief A read-only memory mapping of a whole file.
+//! \details The contents are accessed in place, without copying them into
+//! a buffer first. Mapping an empty file yields an empty view.
+//! \ingroup core
+class MappedFile
+{
+public:
+    //! \brief Map the file \p filename into memory.
+    //! \throw IOException if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& filename);
+
+    //! Unmap the file.
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //! \return the first byte of the file contents
+    const char* data() const { return data_; }
+
+    //! \return the file size in bytes
+    size_t size() const { return size_; }
+
+    //! \return a view of the whole file contents
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    const char* data_{nullptr};
+    size_t size_{0};
+
+#ifdef _WIN32
+    void* file_handle_{nullptr};
+    void* mapping_handle_{nullptr};
+#else
+    int file_descriptor_{-1};
+#endif
+};
+
+} // namespace pmp
@@ -0,0 +1,991 @@
+// Copyright 2011-2021 the Polygon Mesh Processing Library developers.
+// Distributed under a MIT-style license, see LICENSE.txt for details.
+
+#include "pmp/PolygonSoupParser.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "pmp/Exceptions.h"
+
+namespace pmp {
+
+namespace {
+
+// text smaller than this is parsed as a single chunk
+constexpr size_t min_chunk_size = 1 << 20;
+
+bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' ||
+           c == '\v';
+}
+
+const char* skip_spaces(const char* p, const char* end)
+{
+    while (p < end && is_space(*p))
+        ++p;
+    return p;
+}
+
+// end of the line starting at p (the '\n' or end)
+const char* line_end(const char* p, const char* end)
+{
+    const void* newline = std::memchr(p, '\n', end - p);
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+const char* next_line(const char* p, const char* end)
+{
+    const char* e = line_end(p, end);
+    return e < end ? e + 1 : end;
+}
+
+// parses a number after optional white-space. Values out of the range of
+// T are clamped like strtof does: to 0 on underflow and to the largest value
+// of the same sign on overflow.
+template <typename T>
+bool parse_number(const char*& p, const char* end, T& value)
+{
+    p = skip_spaces(p, end);
+    if (p < end && *p == '+')
+        ++p;
+    const auto [next, ec] = std::from_chars(p, end, value);
+    if (ec == std::errc::result_out_of_range)
+    {
+        const bool is_negative = *p == '-';
+        bool is_underflow = false;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // rare, so the magnitude is simply re-parsed with more range
+            const std::string token(p, next);
+            is_underflow = std::fabs(std::strtold(token.c_str(), nullptr)) < 1;
+        }
+        if (is_underflow)
+            value = is_negative ? -T(0) : T(0);
+        else
+            value = is_negative ? std::numeric_limits<T>::lowest()
+                                : std::numeric_limits<T>::max();
+    }
+    else if (ec != std::errc{})
+        return false;
+    p = next;
+    return true;
+}
+
+// true for lines with data, i.e. not empty and not a comment
+bool is_data_line(const char* first, const char* e)
+{
+    return first < e && *first != '#';
+}
+
+// skips n_lines data lines
+const char* skip_data_lines(const char* p, const char* end, size_t n_lines)
+{
+    for (size_t i = 0; i < n_lines && p < end;)
+    {
+        const char* e = line_end(p, end);
+        if (is_data_line(skip_spaces(p, e), e))
+            ++i;
+        p = e < end ? e + 1 : end;
+    }
+    return p;
+}
+
+// calls parse_line(first, end) for each data line of chunk
+template <typename ParseLine>
+void for_each_data_line(std::string_view chunk, ParseLine&& parse_line)
+{
+    const char* p = chunk.data();
+    const char* end = p + chunk.size();
+    while (p < end)
+    {
+        const char* e = line_end(p, end);
+        const char* first = skip_spaces(p, e);
+        if (is_data_line(first, e))
+            parse_line(first, e);
+        p = e < end ? e + 1 : end;
+    }
+}
+
+// splits text into chunks ending at line ends, one per thread
+std::vector<std::string_view> split_at_lines(std::string_view text,
+                                             bool in_parallel)
+{
+    size_t n_chunks = 1;
+#ifdef _OPENMP
+    if (in_parallel)
+        n_chunks = std::clamp<size_t>(
+            text.size() / min_chunk_size, 1,
+            static_cast<size_t>(std::max(omp_get_max_threads(), 1)));
+#endif
+
+    std::vector<std::string_view> chunks;
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    for (size_t i = 1; i <= n_chunks && begin < end; ++i)
+    {
+        const char* chunk_end =
+            i == n_chunks ? end
+                          : next_line(std::max(begin, text.data() +
+                                                          i * text.size() /
+                                                              n_chunks),
+                                      end);
+        chunks.emplace_back(begin, chunk_end - begin);
+        begin = chunk_end;
+    }
+    return chunks;
+}
+
+// parses the chunks of text in parallel, returns chunk results in order
+template <typename Result, typename ParseChunk>
+std::vector<Result> parse_chunks(std::string_view text, bool in_parallel,
+                                 ParseChunk&& parse_chunk)
+{
+    const auto chunks = split_at_lines(text, in_parallel);
+    const auto n_chunks = static_cast<int>(chunks.size());
+    std::vector<Result> results(chunks.size());
+    std::vector<std::exception_ptr> errors(chunks.size());
+
+#pragma omp parallel for schedule(dynamic, 1) if (n_chunks > 1)
+    for (int i = 0; i < n_chunks; ++i)
+    {
+        try
+        {
+            parse_chunk(chunks[i], results[i]);
+        }
+        catch (...)
+        {
+            errors[i] = std::current_exception();
+        }
+    }
+
+    for (const auto& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+    return results;
+}
+
+template <typename T>
+void append(std::vector<T>& to, const std::vector<T>& from)
+{
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+template <typename T>
+double load_binary_value(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return static_cast<double>(value);
+}
+
+// a value type of binary VTK or PLY data
+struct BinaryValueType
+{
+    size_t size{0}; // 0 for unsupported types
+    double (*load)(const char*){nullptr};
+};
+
+// the value type of a VTK or PLY type name
+BinaryValueType binary_value_type(const std::string& name)
+{
+    if (name == "char" || name == "int8")
+        return {1, load_binary_value<std::int8_t>};
+    if (name == "unsigned_char" || name == "uchar" || name == "uint8")
+        return {1, load_binary_value<std::uint8_t>};
+    if (name == "short" || name == "int16")
+        return {2, load_binary_value<std::int16_t>};
+    if (name == "unsigned_short" || name == "ushort" || name == "uint16")
+        return {2, load_binary_value<std::uint16_t>};
+    if (name == "int" || name == "int32")
+        return {4, load_binary_value<std::int32_t>};
+    if (name == "unsigned_int" || name == "uint" || name == "uint32")
+        return {4, load_binary_value<std::uint32_t>};
+    if (name == "float" || name == "float32")
+        return {4, load_binary_value<float>};
+    if (name == "double" || name == "float64")
+        return {8, load_binary_value<double>};
+    return {};
+}
+
+// loads a binary value stored in the given byte order
+double load_value(const char* data, const BinaryValueType& type,
+                  bool big_endian_file)
+{
+    if (big_endian_file == (std::endian::native == std::endian::big))
+        return type.load(data);
+    std::array<char, 8> swapped;
+    std::reverse_copy(data, data + type.size, swapped.begin());
+    return type.load(swapped.data());
+}
+
+// ----------------------------------------------------------------------------
+// OBJ
+
+struct ObjChunk
+{
+    PolygonSoup soup;
+
+    // corners with relative indices: (corner, 0-based index relative to
+    // the first position or texcoord of the chunk)
+    std::vector<std::pair<size_t, std::int64_t>> relative_indices;
+    std::vector<std::pair<size_t, std::int64_t>> relative_tex_indices;
+};
+
+bool has_obj_keyword(const char* first, const char* e, const char* keyword,
+                     size_t length)
+{
+    return static_cast<size_t>(e - first) > length &&
+           std::strncmp(first, keyword, length) == 0 &&
+           is_space(first[length]);
+}
+
+void parse_obj_face(const char* p, const char* e, ObjChunk& chunk)
+{
+    auto& soup = chunk.soup;
+    IndexType n_corners = 0;
+    while (true)
+    {
+        p = skip_spaces(p, e);
+        std::int64_t idx = 0;
+        const auto [next, ec] = std::from_chars(p, e, idx);
+        if (ec != std::errc{})
+            break;
+        p = next;
+
+        // optional texcoord and normal indices: v/vt/vn, v//vn, v/vt
+        std::int64_t tex_idx = 0;
+        if (p < e && *p == '/')
+        {
+            ++p;
+            if (p < e && *p != '/')
+            {
+                const auto [tex_next, tex_ec] = std::from_chars(p, e, tex_idx);
+                if (tex_ec == std::errc{})
+                    p = tex_next;
+            }
+            if (p < e && *p == '/')
+            {
+                ++p;
+                std::int64_t normal_idx = 0;
+                const auto [normal_next, normal_ec] =
+                    std::from_chars(p, e, normal_idx);
+                if (normal_ec == std::errc{})
+                    p = normal_next;
+            }
+        }
+        while (p < e && !is_space(*p))
+            ++p;
+
+        const size_t corner = soup.polygon_indices.size();
+        soup.polygon_indices.push_back(
+            idx > 0 ? static_cast<IndexType>(idx - 1) : PMP_MAX_INDEX);
+        if (idx < 0)
+            chunk.relative_indices.emplace_back(
+                corner,
+                static_cast<std::int64_t>(soup.positions.size()) + idx);
+
+        if (tex_idx != 0 && soup.polygon_tex_indices.size() < corner)
+            soup.polygon_tex_indices.resize(corner, PMP_MAX_INDEX);
+        if (tex_idx != 0 || !soup.polygon_tex_indices.empty())
+        {
+            soup.polygon_tex_indices.push_back(
+                tex_idx > 0 ? static_cast<IndexType>(tex_idx - 1)
+                            : PMP_MAX_INDEX);
+            if (tex_idx < 0)
+                chunk.relative_tex_indices.emplace_back(
+                    corner,
+                    static_cast<std::int64_t>(soup.tex_coords.size()) +
+                        tex_idx);
+        }
+        ++n_corners;
+    }
+    if (n_corners > 0)
+        soup.polygon_sizes.push_back(n_corners);
+}
+
+void parse_obj_chunk(std::string_view text, ObjChunk& chunk)
+{
+    auto& soup = chunk.soup;
+    for_each_data_line(text, [&](const char* p, const char* e) {
+        if (has_obj_keyword(p, e, "v", 1))
+        {
+            Point pos(0, 0, 0);
+            p += 1;
+            if (!parse_number(p, e, pos[0]) || !parse_number(p, e, pos[1]) ||
+                !parse_number(p, e, pos[2]))
+                throw IOException("Failed to parse OBJ vertex!");
+            soup.positions.push_back(pos);
+        }
+        else if (has_obj_keyword(p, e, "vn", 2))
+        {
+            Normal n(0, 0, 0);
+            p += 2;
+            if (!parse_number(p, e, n[0]) || !parse_number(p, e, n[1]) ||
+                !parse_number(p, e, n[2]))
+                throw IOException("Failed to parse OBJ vertex normal!");
+            soup.normals.push_back(n);
+        }
+        else if (has_obj_keyword(p, e, "vt", 2))
+        {
+            TexCoord t(0, 0);
+            p += 2;
+            // the v coordinate is optional
+            if (!parse_number(p, e, t[0]) ||
+                (skip_spaces(p, e) < e && !parse_number(p, e, t[1])))
+                throw IOException("Failed to parse OBJ texture coordinate!");
+            soup.tex_coords.push_back(t);
+        }
+        else if (has_obj_keyword(p, e, "f", 1))
+        {
+            parse_obj_face(p + 1, e, chunk);
+        }
+    });
+}
+
+// ----------------------------------------------------------------------------
+// PLY
+
+struct PlyProperty
+{
+    std::string name;
+    std::string type;
+    bool is_list{false};
+    std::string count_type;
+};
+
+struct PlyElement
+{
+    std::string name;
+    size_t count{0};
+    std::vector<PlyProperty> properties;
+};
+
+struct PlyHeader
+{
+    std::string format;
+    std::vector<PlyElement> elements;
+    const char* data{nullptr}; // first byte after the header
+};
+
+PlyHeader parse_ply_header(std::string_view text)
+{
+    const char* p = text.data();
+    const char* end = p + text.size();
+    if (text.substr(0, 3) != "ply")
+        throw IOException("Failed to read PLY header!");
+
+    PlyHeader header;
+    while (p < end)
+    {
+        const char* e = line_end(p, end);
+        std::istringstream tokens(std::string(p, e));
+        p = e < end ? e + 1 : end;
+
+        std::string keyword;
+        tokens >> keyword;
+        if (keyword == "format")
+        {
+            tokens >> header.format;
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element;
+            tokens >> element.name >> element.count;
+            header.elements.push_back(element);
+        }
+        else if (keyword == "property" && !header.elements.empty())
+        {
+            PlyProperty prop;
+            tokens >> prop.type;
+            if (prop.type == "list")
+            {
+                prop.is_list = true;
+                tokens >> prop.count_type >> prop.type;
+                if (binary_value_type(prop.count_type).size == 0)
+                    throw IOException("Unsupported PLY type: " +
+                                      prop.count_type);
+            }
+            tokens >> prop.name;
+            if (binary_value_type(prop.type).size == 0)
+                throw IOException("Unsupported PLY type: " + prop.type);
+            header.elements.back().properties.push_back(prop);
+        }
+        else if (keyword == "end_header")
+        {
+            header.data = p;
+            break;
+        }
+    }
+
+    if (!header.data)
+        throw IOException("Failed to read PLY header!");
+    if (header.format != "ascii" && header.format != "binary_little_endian" &&
+        header.format != "binary_big_endian")
+        throw IOException("Unsupported PLY format: " + header.format);
+    return header;
+}
+
+// destination of an element property: a coordinate (0-2), the vertex
+// indices of faces (3), a scalar array (4 + array index), or none (-1)
+constexpr int ply_target_indices = 3;
+constexpr int ply_target_arrays = 4;
+
+std::vector<int> ply_property_targets(const PlyElement& element,
+                                      std::vector<ScalarArray>* arrays)
+{
+    const bool is_vertex = element.name == "vertex";
+    const bool is_face = element.name == "face";
+    std::vector<int> targets;
+    int n_arrays = 0;
+    for (const auto& prop : element.properties)
+    {
+        int target = -1;
+        if (is_vertex && !prop.is_list && prop.name.size() == 1 &&
+            prop.name[0] >= 'x' && prop.name[0] <= 'z')
+            target = prop.name[0] - 'x';
+        else if (is_face && prop.is_list &&
+                 (prop.name == "vertex_indices" ||
+                  prop.name == "vertex_index"))
+            target = ply_target_indices;
+        else if ((is_vertex || is_face) && !prop.is_list && arrays)
+            target = ply_target_arrays + n_arrays++;
+        targets.push_back(target);
+    }
+    return targets;
+}
+
+// the records of an element
+struct PlyRecords
+{
+    std::vector<Point> positions;
+    std::vector<IndexType> polygon_sizes;
+    std::vector<IndexType> polygon_indices;
+    std::vector<std::vector<double>> array_values;
+};
+
+// parses the properties of a record with load(j, is_count) returning each
+// value (or list size) of property j
+template <typename Load>
+void parse_ply_record(const PlyElement& element,
+                      const std::vector<int>& targets, Load&& load,
+                      PlyRecords& records)
+{
+    Point pos(0, 0, 0);
+    for (size_t j = 0; j < element.properties.size(); ++j)
+    {
+        const auto& prop = element.properties[j];
+        const int target = targets[j];
+        if (prop.is_list)
+        {
+            const auto n = static_cast<size_t>(load(j, true));
+            if (target == ply_target_indices)
+                records.polygon_sizes.push_back(static_cast<IndexType>(n));
+            for (size_t k = 0; k < n; ++k)
+            {
+                const double value = load(j, false);
+                if (target == ply_target_indices)
+                    records.polygon_indices.push_back(
+                        static_cast<IndexType>(value));
+            }
+            continue;
+        }
+        const double value = load(j, false);
+        if (target >= ply_target_arrays)
+            records.array_values[target - ply_target_arrays].push_back(value);
+        else if (target >= 0)
+            pos[target] = static_cast<Scalar>(value);
+    }
+    if (element.name == "vertex")
+        records.positions.push_back(pos);
+}
+
+// ----------------------------------------------------------------------------
+// VTK
+
+// true for lines starting with a keyword (and not with a number like "nan")
+bool is_keyword_line(const char* first, const char* e)
+{
+    if (first >= e || !std::isalpha(static_cast<unsigned char>(*first)))
+        return false;
+    double value;
+    return std::from_chars(first, e, value).ec != std::errc{};
+}
+
+// the first line starting with a keyword
+const char* find_keyword_line(const char* p, const char* end)
+{
+    while (p < end)
+    {
+        const char* e = line_end(p, end);
+        if (is_keyword_line(skip_spaces(p, e), e))
+            return p;
+        p = e < end ? e + 1 : end;
+    }
+    return end;
+}
+
+// reads count values of a section starting at p: big-endian binary values
+// of the given type, or white-space separated numbers up to the next line
+// starting with a keyword
+template <typename T>
+std::vector<T> read_vtk_values(const char*& p, const char* end, size_t count,
+                               const std::string& type, bool is_binary,
+                               bool in_parallel)
+{
+    std::vector<T> values;
+    if (is_binary)
+    {
+        const auto value_type = binary_value_type(type);
+        if (value_type.size == 0)
+            throw IOException("Unsupported VTK type: " + type);
+        if (static_cast<size_t>(end - p) / value_type.size < count)
+            throw IOException("Truncated VTK data!");
+        values.resize(count);
+        const auto n = static_cast<std::int64_t>(count);
+        const char* data = p;
+#pragma omp parallel for schedule(static) if (in_parallel && n > (1 << 16))
+        for (std::int64_t i = 0; i < n; ++i)
+            values[i] = static_cast<T>(
+                load_value(data + i * value_type.size, value_type, true));
+        p += count * value_type.size;
+        return values;
+    }
+
+    const char* section_end = find_keyword_line(p, end);
+    const auto chunks = parse_chunks<std::vector<T>>(
+        std::string_view(p, section_end - p), in_parallel,
+        [](std::string_view text, std::vector<T>& chunk_values) {
+            const char* q = text.data();
+            const char* e = q + text.size();
+            T value;
+            while (parse_number(q, e, value))
+                chunk_values.push_back(value);
+        });
+    values.reserve(count);
+    for (const auto& chunk_values : chunks)
+        append(values, chunk_values);
+    if (values.size() < count)
+        throw IOException("Truncated VTK data!");
+    values.resize(count);
+    p = section_end;
+    return values;
+}
+
+} // namespace
+
+PolygonSoup PolygonSoupParser::parse_obj(std::string_view text,
+                                         bool in_parallel)
+{
+    const auto chunks = parse_chunks<ObjChunk>(text, in_parallel,
+                                               parse_obj_chunk);
+
+    PolygonSoup result;
+    size_t n_positions = 0, n_normals = 0, n_tex_coords = 0, n_polygons = 0,
+           n_corners = 0;
+    bool has_tex_indices = false;
+    for (const auto& chunk : chunks)
+    {
+        n_positions += chunk.soup.positions.size();
+        n_normals += chunk.soup.normals.size();
+        n_tex_coords += chunk.soup.tex_coords.size();
+        n_polygons += chunk.soup.polygon_sizes.size();
+        n_corners += chunk.soup.polygon_indices.size();
+        has_tex_indices |= !chunk.soup.polygon_tex_indices.empty();
+    }
+    result.positions.reserve(n_positions);
+    result.normals.reserve(n_normals);
+    result.tex_coords.reserve(n_tex_coords);
+    result.polygon_sizes.reserve(n_polygons);
+    result.polygon_indices.reserve(n_corners);
+    if (has_tex_indices)
+        result.polygon_tex_indices.reserve(n_corners);
+
+    for (const auto& chunk : chunks)
+    {
+        const auto& soup = chunk.soup;
+        const auto position_offset =
+            static_cast<std::int64_t>(result.positions.size());
+        const auto tex_coord_offset =
+            static_cast<std::int64_t>(result.tex_coords.size());
+        const size_t corner_offset = result.polygon_indices.size();
+
+        append(result.positions, soup.positions);
+        append(result.normals, soup.normals);
+        append(result.tex_coords, soup.tex_coords);
+        append(result.polygon_sizes, soup.polygon_sizes);
+        append(result.polygon_indices, soup.polygon_indices);
+        for (const auto& [corner, idx] : chunk.relative_indices)
+            result.polygon_indices[corner_offset + corner] =
+                position_offset + idx >= 0
+                    ? static_cast<IndexType>(position_offset + idx)
+                    : PMP_MAX_INDEX;
+
+        if (has_tex_indices)
+        {
+            append(result.polygon_tex_indices, soup.polygon_tex_indices);
+            result.polygon_tex_indices.resize(result.polygon_indices.size(),
+                                              PMP_MAX_INDEX);
+            for (const auto& [corner, idx] : chunk.relative_tex_indices)
+                result.polygon_tex_indices[corner_offset + corner] =
+                    tex_coord_offset + idx >= 0
+                        ? static_cast<IndexType>(tex_coord_offset + idx)
+                        : PMP_MAX_INDEX;
+        }
+        result.chunk_n_positions.push_back(soup.positions.size());
+    }
+    return result;
+}
+
+PolygonSoup PolygonSoupParser::parse_off(std::string_view text,
+                                         bool in_parallel)
+{
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    // header: [ST][C][N]OFF
+    bool has_tex_coords = false, has_colors = false, has_normals = false;
+    if (text.substr(0, 2) == "ST")
+    {
+        has_tex_coords = true;
+        p += 2;
+    }
+    if (p < end && *p == 'C')
+    {
+        has_colors = true;
+        ++p;
+    }
+    if (p < end && *p == 'N')
+    {
+        has_normals = true;
+        ++p;
+    }
+    if (p < end && (*p == '4' || *p == 'n'))
+        throw IOException("Error: Homogeneous coordinates and vertex "
+                          "dimension != 3 not supported.");
+    if (end - p < 3 || std::strncmp(p, "OFF", 3) != 0)
+        throw IOException("Failed to parse OFF header");
+    p += 3;
+
+    // #Vertices, #Faces, #Edges (possibly after comment lines)
+    size_t nv = 0, nf = 0, ne = 0;
+    while ((p = skip_spaces(p, end)) < end && *p == '#')
+        p = next_line(p, end);
+    if (!parse_number(p, end, nv) || !parse_number(p, end, nf))
+        throw IOException("Failed to parse OFF header");
+    parse_number(p, end, ne);
+    p = next_line(p, end);
+
+    // vertex and face records are one per line
+    const char* faces_begin = skip_data_lines(p, end, nv);
+    const char* faces_end = skip_data_lines(faces_begin, end, nf);
+
+    // vertices: pos [normal] [color] [texcoord]
+    const auto vertex_chunks = parse_chunks<PolygonSoup>(
+        std::string_view(p, faces_begin - p), in_parallel,
+        [&](std::string_view chunk_text, PolygonSoup& chunk) {
+            for_each_data_line(chunk_text, [&](const char* q, const char* e) {
+                Point pos;
+                if (!parse_number(q, e, pos[0]) ||
+                    !parse_number(q, e, pos[1]) ||
+                    !parse_number(q, e, pos[2]))
+                    throw IOException("Failed to parse OFF vertex!");
+                chunk.positions.push_back(pos);
+
+                if (has_normals)
+                {
+                    Normal n(0, 0, 0);
+                    if (!parse_number(q, e, n[0]) ||
+                        !parse_number(q, e, n[1]) ||
+                        !parse_number(q, e, n[2]))
+                        throw IOException("Failed to parse OFF vertex normal!");
+                    chunk.normals.push_back(n);
+                }
+                if (has_colors)
+                {
+                    Color c(0, 0, 0);
+                    if (!parse_number(q, e, c[0]) ||
+                        !parse_number(q, e, c[1]) ||
+                        !parse_number(q, e, c[2]))
+                        throw IOException("Failed to parse OFF vertex color!");
+                    if (c[0] > 1.0f || c[1] > 1.0f || c[2] > 1.0f)
+                        c /= 255.0f;
+                    chunk.colors.push_back(c);
+                }
+                if (has_tex_coords)
+                {
+                    TexCoord t(0, 0);
+                    if (!parse_number(q, e, t[0]) ||
+                        !parse_number(q, e, t[1]))
+                        throw IOException(
+                            "Failed to parse OFF vertex texcoord!");
+                    chunk.vertex_tex_coords.push_back(t);
+                }
+            });
+        });
+
+    // faces: #N v[1] v[2] ... v[n-1]
+    const auto face_chunks = parse_chunks<PolygonSoup>(
+        std::string_view(faces_begin, faces_end - faces_begin), in_parallel,
+        [](std::string_view chunk_text, PolygonSoup& chunk) {
+            for_each_data_line(chunk_text, [&](const char* q, const char* e) {
+                IndexType n = 0, idx = 0;
+                if (!parse_number(q, e, n))
+                    throw IOException("Failed to parse OFF face!");
+                for (IndexType j = 0; j < n; ++j)
+                {
+                    if (!parse_number(q, e, idx))
+                        throw IOException("Failed to parse OFF face!");
+                    chunk.polygon_indices.push_back(idx);
+                }
+                chunk.polygon_sizes.push_back(n);
+            });
+        });
+
+    PolygonSoup result;
+    result.positions.reserve(nv);
+    result.polygon_sizes.reserve(nf);
+    for (const auto& chunk : vertex_chunks)
+    {
+        append(result.positions, chunk.positions);
+        append(result.normals, chunk.normals);
+        append(result.colors, chunk.colors);
+        append(result.vertex_tex_coords, chunk.vertex_tex_coords);
+        result.chunk_n_positions.push_back(chunk.positions.size());
+    }
+    for (const auto& chunk : face_chunks)
+    {
+        append(result.polygon_sizes, chunk.polygon_sizes);
+        append(result.polygon_indices, chunk.polygon_indices);
+    }
+    if (result.positions.size() != nv || result.polygon_sizes.size() != nf)
+        throw IOException("Unexpected end of OFF file!");
+    return result;
+}
+
+PolygonSoup PolygonSoupParser::parse_ply(std::string_view text,
+                                         std::vector<ScalarArray>* vertex_arrays,
+                                         std::vector<ScalarArray>* face_arrays,
+                                         bool in_parallel)
+{
+    const auto header = parse_ply_header(text);
+    const bool is_ascii = header.format == "ascii";
+    const bool is_big_endian = header.format == "binary_big_endian";
+    const char* p = header.data;
+    const char* end = text.data() + text.size();
+
+    PolygonSoup result;
+    for (const auto& element : header.elements)
+    {
+        const bool is_vertex = element.name == "vertex";
+        auto* arrays = is_vertex ? vertex_arrays
+                       : element.name == "face" ? face_arrays
+                                                : nullptr;
+        const auto targets = ply_property_targets(element, arrays);
+        const size_t first_array = arrays ? arrays->size() : 0;
+        if (arrays)
+            for (size_t j = 0; j < targets.size(); ++j)
+                if (targets[j] >= ply_target_arrays)
+                    arrays->push_back({element.properties[j].name,
+                                       element.properties[j].type, {}});
+        const size_t n_arrays = arrays ? arrays->size() - first_array : 0;
+
+        std::vector<PlyRecords> chunks;
+        if (is_ascii)
+        {
+            // one record per line
+            const char* records_end = skip_data_lines(p, end, element.count);
+            chunks = parse_chunks<PlyRecords>(
+                std::string_view(p, records_end - p), in_parallel,
+                [&](std::string_view chunk_text, PlyRecords& records) {
+                    records.array_values.resize(n_arrays);
+                    for_each_data_line(chunk_text, [&](const char* q,
+                                                       const char* e) {
+                        const auto load = [&q, e](size_t, bool) {
+                            double value = 0.0;
+                            if (!parse_number(q, e, value))
+                                throw IOException("Failed to read PLY data!");
+                            return value;
+                        };
+                        parse_ply_record(element, targets, load, records);
+                    });
+                });
+            p = records_end;
+        }
+        else
+        {
+            // records of variable size are read sequentially
+            chunks.resize(1);
+            auto& records = chunks.front();
+            records.array_values.resize(n_arrays);
+            std::vector<BinaryValueType> value_types, count_types;
+            for (const auto& prop : element.properties)
+            {
+                value_types.push_back(binary_value_type(prop.type));
+                count_types.push_back(binary_value_type(prop.count_type));
+            }
+            const auto load = [&](size_t j, bool is_count) {
+                const auto& value_type =
+                    is_count ? count_types[j] : value_types[j];
+                if (static_cast<size_t>(end - p) < value_type.size)
+                    throw IOException("Truncated PLY data!");
+                const double value = load_value(p, value_type, is_big_endian);
+                p += value_type.size;
+                return value;
+            };
+            if (is_vertex)
+                records.positions.reserve(element.count);
+            for (size_t i = 0; i < element.count; ++i)
+                parse_ply_record(element, targets, load, records);
+        }
+
+        for (const auto& records : chunks)
+        {
+            append(result.positions, records.positions);
+            append(result.polygon_sizes, records.polygon_sizes);
+            append(result.polygon_indices, records.polygon_indices);
+            for (size_t j = 0; j < n_arrays; ++j)
+                append((*arrays)[first_array + j].values,
+                       records.array_values[j]);
+            if (is_vertex)
+                result.chunk_n_positions.push_back(records.positions.size());
+        }
+        if (is_vertex && result.positions.size() != element.count)
+            throw IOException("Unexpected end of PLY file!");
+    }
+    return result;
+}
+
+PolygonSoup PolygonSoupParser::parse_vtk(std::string_view text,
+                                         std::vector<ScalarArray>* vertex_arrays,
+                                         std::vector<ScalarArray>* face_arrays,
+                                         bool in_parallel)
+{
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    PolygonSoup result;
+    bool is_binary = false;
+    std::vector<ScalarArray>* arrays = nullptr;
+    size_t n_attribute_values = 0;
+
+    while (p < end)
+    {
+        const char* e = line_end(p, end);
+        const char* first = skip_spaces(p, e);
+        p = e < end ? e + 1 : end;
+        if (!is_keyword_line(first, e))
+            continue;
+
+        std::istringstream tokens(std::string(first, e));
+        std::string keyword, type;
+        tokens >> keyword;
+
+        if (keyword == "BINARY")
+        {
+            is_binary = true;
+        }
+
+        // vertex positions
+        else if (keyword == "POINTS")
+        {
+            size_t n_points = 0;
+            tokens >> n_points >> type;
+            const auto values = read_vtk_values<Scalar>(
+                p, end, 3 * n_points, type, is_binary, in_parallel);
+            result.positions.resize(n_points);
+            for (size_t i = 0; i < n_points; ++i)
+                result.positions[i] = Point(values[3 * i], values[3 * i + 1],
+                                            values[3 * i + 2]);
+            result.chunk_n_positions.assign(1, n_points);
+        }
+
+        // polygons, each given by its size and vertex indices
+        else if (keyword == "POLYGONS")
+        {
+            size_t n_polygons = 0, n_entries = 0;
+            tokens >> n_polygons >> n_entries;
+            const auto values = read_vtk_values<IndexType>(
+                p, end, n_entries, "int", is_binary, in_parallel);
+            result.polygon_sizes.reserve(n_polygons);
+            result.polygon_indices.reserve(n_entries - n_polygons);
+            for (size_t i = 0; i < n_entries;)
+            {
+                const auto n = values[i++];
+                if (i + n > n_entries)
+                    throw IOException("Failed to read VTK polygons!");
+                result.polygon_sizes.push_back(n);
+                result.polygon_indices.insert(result.polygon_indices.end(),
+                                              values.begin() + i,
+                                              values.begin() + i + n);
+                i += n;
+            }
+        }
+
+        // attribute sections
+        else if (keyword == "POINT_DATA" || keyword == "CELL_DATA")
+        {
+            arrays = keyword == "POINT_DATA" ? vertex_arrays : face_arrays;
+            tokens >> n_attribute_values;
+        }
+
+        // scalar attributes, followed by a lookup table name
+        else if (keyword == "SCALARS")
+        {
+            std::string name;
+            size_t n_components = 1;
+            tokens >> name >> type >> n_components;
+            if (std::strncmp(p, "LOOKUP_TABLE", std::min<size_t>(12, end - p)) != 0)
+                throw IOException("Missing VTK lookup table!");
+            p = next_line(p, end);
+            auto values = read_vtk_values<double>(
+                p, end, n_components * n_attribute_values, type, is_binary,
+                in_parallel);
+            if (arrays && n_components == 1)
+                arrays->push_back({name, type, std::move(values)});
+        }
+
+        // binary data of other sections is skipped if its size is known
+        else if (is_binary && (keyword == "NORMALS" || keyword == "VECTORS"))
+        {
+            std::string name;
+            tokens >> name >> type;
+            read_vtk_values<double>(p, end, 3 * n_attribute_values, type,
+                                    true, in_parallel);
+        }
+        else if (is_binary &&
+                 (keyword == "VERTICES" || keyword == "LINES" ||
+                  keyword == "TRIANGLE_STRIPS"))
+        {
+            size_t n_cells = 0, n_entries = 0;
+            tokens >> n_cells >> n_entries;
+            read_vtk_values<double>(p, end, n_entries, "int", true,
+                                    in_parallel);
+        }
+        else if (is_binary && keyword != "DATASET")
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+} // namespace pmp
@@ -0,0 +1,91 @@
+// Copyright 2011-2021 the Polygon Mesh Processing Library developers.
+// Distributed under a MIT-style license, see LICENSE.txt for details.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pmp/Types.h"
+
+namespace pmp {
+
+//! \brief Vertices and polygons parsed from a mesh file, before a mesh is
+//! built from them.
+//! \ingroup core
+struct PolygonSoup
+{
+    std::vector<Point> positions; //!< vertex positions
+
+    //! vertex normals (OFF), or all "vn" records (OBJ)
+    std::vector<Normal> normals;
+
+    std::vector<Color> colors;               //!< vertex colors (OFF)
+    std::vector<TexCoord> vertex_tex_coords; //!< vertex texcoords (OFF)
+
+    std::vector<IndexType> polygon_sizes;   //!< vertex counts of polygons
+    std::vector<IndexType> polygon_indices; //!< concatenated vertex indices
+
+    std::vector<TexCoord> tex_coords; //!< all "vt" records (OBJ)
+
+    //! index into tex_coords for each polygon corner (PMP_MAX_INDEX for
+    //! corners without one), or empty if there are none (OBJ)
+    std::vector<IndexType> polygon_tex_indices;
+
+    //! the number of positions parsed by each chunk of the file
+    std::vector<size_t> chunk_n_positions;
+};
+
+//! \brief A scalar data array of vertices or faces parsed from a mesh file.
+//! \ingroup core
+struct ScalarArray
+{
+    std::string name; //!< array name in the file
+    std::string type; //!< value type name in the file
+    std::vector<double> values;
+};
+
+//! \brief Parsers of mesh file contents into polygon soups.
+//! \details Files are parsed in place (e.g., from a MappedFile). Text data
+//! is split into chunks at line ends which are parsed in parallel with
+//! std::from_chars if \p in_parallel is set, and the chunk results are
+//! concatenated in order. All parsers throw IOException on malformed input.
+//! \ingroup core
+class PolygonSoupParser
+{
+public:
+    // delete default and copy constructor
+    PolygonSoupParser() = delete;
+    PolygonSoupParser(const PolygonSoupParser&) = delete;
+
+    //! \brief Parse "v", "vn", "vt" and "f" records of an OBJ file.
+    //! \details Negative (relative) indices are resolved.
+    static PolygonSoup parse_obj(std::string_view text,
+                                 bool in_parallel = true);
+
+    //! \brief Parse an ASCII OFF file with optional vertex normals, colors
+    //! and texcoords as declared by its [ST][C][N]OFF header.
+    static PolygonSoup parse_off(std::string_view text,
+                                 bool in_parallel = true);
+
+    //! \brief Parse an ASCII or binary PLY file.
+    //! \details Vertex positions are read from the "x", "y" and "z"
+    //! properties, polygons from the "vertex_indices" (or "vertex_index")
+    //! list. Other scalar vertex and face properties are appended to
+    //! \p vertex_arrays and \p face_arrays if given.
+    static PolygonSoup parse_ply(std::string_view text,
+                                 std::vector<ScalarArray>* vertex_arrays = nullptr,
+                                 std::vector<ScalarArray>* face_arrays = nullptr,
+                                 bool in_parallel = true);
+
+    //! \brief Parse an ASCII or binary legacy VTK polydata file.
+    //! \details Single-component SCALARS of the POINT_DATA and CELL_DATA
+    //! sections are appended to \p vertex_arrays and \p face_arrays if given.
+    static PolygonSoup parse_vtk(std::string_view text,
+                                 std::vector<ScalarArray>* vertex_arrays = nullptr,
+                                 std::vector<ScalarArray>* face_arrays = nullptr,
+                                 bool in_parallel = true);
+};
+
+} // namespace pmp
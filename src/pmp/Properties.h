@@ -6,7 +6,10 @@
 
 #include <cassert>
 
+#include <deque>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -15,11 +18,67 @@
 
 namespace pmp {
 
+//! \brief An interned property name.
+//! \details Names are interned into a global table once, when the key is
+//! constructed. Property containers index their arrays by the key id, so a
+//! keyed lookup is an array access instead of a scan with string compares.
+//! Keys are meant to be constructed once (e.g. as static constants) and
+//! reused in hot code.
+class PropertyKey
+{
+public:
+    //! intern \p name (thread-safe)
+    explicit PropertyKey(const std::string& name) : id_(intern(name)) {}
+
+    //! \return the id of the interned name
+    size_t id() const { return id_; }
+
+    //! \return the interned name
+    const std::string& name() const
+    {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return t.names[id_];
+    }
+
+    bool operator==(const PropertyKey& rhs) const { return id_ == rhs.id_; }
+    bool operator!=(const PropertyKey& rhs) const { return id_ != rhs.id_; }
+
+private:
+    struct Table
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, size_t> ids;
+        std::deque<std::string> names; // stable references
+    };
+
+    static Table& table()
+    {
+        static Table t;
+        return t;
+    }
+
+    static size_t intern(const std::string& name)
+    {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        const auto [it, is_new] = t.ids.try_emplace(name, t.names.size());
+        if (is_new)
+            t.names.push_back(name);
+        return it->second;
+    }
+
+    size_t id_;
+};
+
 class BasePropertyArray
 {
 public:
     //! Default constructor
-    explicit BasePropertyArray(std::string name) : name_(std::move(name)) {}
+    explicit BasePropertyArray(std::string name)
+        : name_(std::move(name)), key_id_(PropertyKey(name_).id())
+    {
+    }
 
     //! Destructor.
     virtual ~BasePropertyArray() = default;
@@ -39,6 +98,9 @@ public:
     //! Let two elements swap their storage place.
     virtual void swap(size_t i0, size_t i1) = 0;
 
+    //! Reorder the elements: element i becomes the former element new_to_old[i].
+    virtual void permute(const std::vector<size_t>& new_to_old) = 0;
+
     //! Return a deep copy of self.
     virtual BasePropertyArray* clone() const = 0;
 
@@ -48,8 +110,12 @@ public:
     //! Return the name of the property
     const std::string& name() const { return name_; }
 
+    //! Return the id of the interned name (see PropertyKey)
+    size_t key_id() const { return key_id_; }
+
 protected:
     std::string name_;
+    size_t key_id_;
 };
 
 template <class T>
@@ -81,6 +147,15 @@ public:
         data_[i1] = d;
     }
 
+    void permute(const std::vector<size_t>& new_to_old) override
+    {
+        VectorType data;
+        data.reserve(new_to_old.size());
+        for (const auto i : new_to_old)
+            data.push_back(data_[i]);
+        data_.swap(data);
+    }
+
     BasePropertyArray* clone() const override
     {
         auto* p = new PropertyArray<T>(name_, value_);
@@ -206,7 +281,10 @@ public:
             parrays_.resize(rhs.n_properties());
             size_ = rhs.size();
             for (size_t i = 0; i < parrays_.size(); ++i)
+            {
                 parrays_[i] = rhs.parrays_[i]->clone();
+                index(parrays_[i]);
+            }
         }
         return *this;
     }
@@ -246,9 +324,17 @@ public:
         auto* p = new PropertyArray<T>(name, t);
         p->resize(size_);
         parrays_.push_back(p);
+        index(p);
         return Property<T>(p);
     }
 
+    // add a property with key \p key and default value \p t
+    template <class T>
+    Property<T> add(const PropertyKey& key, const T t = T())
+    {
+        return add<T>(key.name(), t);
+    }
+
     // do we have a property with a given name?
     bool exists(const std::string& name) const
     {
@@ -278,6 +364,30 @@ public:
         return p;
     }
 
+    // do we have a property with a given key? (no string compares)
+    bool exists(const PropertyKey& key) const { return find(key) != nullptr; }
+
+    // get a property by its key (no string compares). returns invalid
+    // property if it does not exist or if the type does not match.
+    template <class T>
+    Property<T> get(const PropertyKey& key) const
+    {
+        auto* parray = find(key);
+        if (parray == nullptr || parray->type() != typeid(T))
+            return Property<T>();
+        return Property<T>(static_cast<PropertyArray<T>*>(parray));
+    }
+
+    // returns a keyed property if it exists, otherwise it creates it first.
+    template <class T>
+    Property<T> get_or_add(const PropertyKey& key, const T t = T())
+    {
+        Property<T> p = get<T>(key);
+        if (!p)
+            p = add<T>(key, t);
+        return p;
+    }
+
     // get the type of property by its name. returns typeid(void) if it does not exist.
     const std::type_info& get_type(const std::string& name)
     {
@@ -296,6 +406,7 @@ public:
         {
             if (*it == h.parray_)
             {
+                keyed_parrays_[(*it)->key_id()] = nullptr;
                 delete *it;
                 parrays_.erase(it);
                 h.reset();
@@ -310,6 +421,7 @@ public:
         for (auto& parray : parrays_)
             delete parray;
         parrays_.clear();
+        keyed_parrays_.clear();
         size_ = 0;
     }
 
@@ -343,6 +455,13 @@ public:
         ++size_;
     }
 
+    // reorder all arrays: element i becomes the former element new_to_old[i]
+    void permute(const std::vector<size_t>& new_to_old) const
+    {
+        for (auto parray : parrays_)
+            parray->permute(new_to_old);
+    }
+
     // swap elements i0 and i1 in all arrays
     void swap(size_t i0, size_t i1) const
     {
@@ -351,7 +470,23 @@ public:
     }
 
 private:
+    // register a property array in the keyed lookup table
+    void index(BasePropertyArray* parray)
+    {
+        if (parray->key_id() >= keyed_parrays_.size())
+            keyed_parrays_.resize(parray->key_id() + 1, nullptr);
+        keyed_parrays_[parray->key_id()] = parray;
+    }
+
+    // find a property array by key, nullptr if it does not exist
+    BasePropertyArray* find(const PropertyKey& key) const
+    {
+        return key.id() < keyed_parrays_.size() ? keyed_parrays_[key.id()]
+                                                : nullptr;
+    }
+
     std::vector<BasePropertyArray*> parrays_;
+    std::vector<BasePropertyArray*> keyed_parrays_; // indexed by key id
     size_t size_{0};
 };
 
@@ -4,7 +4,9 @@
 
 #include "pmp/SurfaceMesh.h"
 
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 #include "pmp/SurfaceMeshIO.h"
 
@@ -452,6 +454,250 @@ Face SurfaceMesh::add_face(const std::vector<Vertex>& vertices)
     return f;
 }
 
+void SurfaceMesh::build_from_triangles(const std::vector<Point>& positions,
+                                       const std::vector<IndexType>& indices)
+{
+    if (indices.size() % 3 != 0)
+    {
+        auto what = "SurfaceMesh::build_from_triangles: The number of indices "
+                    "is not a multiple of 3.";
+        throw InvalidInputException(what);
+    }
+
+    const auto n_vertices = static_cast<IndexType>(positions.size());
+    const auto n_faces = static_cast<IndexType>(indices.size() / 3);
+    const auto n_corners = static_cast<int>(indices.size());
+
+    // the corner c = 3 * f + k of face f is the directed edge from
+    // indices[c] to the next vertex of f.
+    const auto to_corner = [](IndexType c) {
+        return c % 3 == 2 ? c - 2 : c + 1;
+    };
+    const auto from_corner = [](IndexType c) {
+        return c % 3 == 0 ? c + 2 : c - 1;
+    };
+
+    bool out_of_range = false;
+    bool degenerate = false;
+#pragma omp parallel for schedule(static) reduction(|| : out_of_range, degenerate)
+    for (int f = 0; f < static_cast<int>(n_faces); ++f)
+    {
+        const IndexType* t = &indices[3 * static_cast<size_t>(f)];
+        if (t[0] >= n_vertices || t[1] >= n_vertices || t[2] >= n_vertices)
+            out_of_range = true;
+        else if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0])
+            degenerate = true;
+    }
+    if (out_of_range)
+    {
+        auto what =
+            "SurfaceMesh::build_from_triangles: Vertex index out of range.";
+        throw InvalidInputException(what);
+    }
+    if (degenerate)
+    {
+        auto what = "SurfaceMesh::build_from_triangles: Degenerate face.";
+        throw TopologyException(what);
+    }
+
+    // bucket the corners at the smaller vertex of their edge (counting sort,
+    // so the corners of a bucket are in buffer order)
+    std::vector<IndexType> bucket_start(static_cast<size_t>(n_vertices) + 1,
+                                        0);
+    for (IndexType c = 0; c < static_cast<IndexType>(n_corners); ++c)
+        ++bucket_start[std::min(indices[c], indices[to_corner(c)]) + 1];
+    for (IndexType v = 0; v < n_vertices; ++v)
+        bucket_start[v + 1] += bucket_start[v];
+    std::vector<IndexType> bucket_corners(n_corners);
+    {
+        std::vector<IndexType> cursor(bucket_start.begin(),
+                                      bucket_start.end() - 1);
+        for (IndexType c = 0; c < static_cast<IndexType>(n_corners); ++c)
+            bucket_corners[cursor[std::min(indices[c],
+                                           indices[to_corner(c)])]++] = c;
+    }
+
+    // pair twin corners within each bucket. The first corner of an edge in
+    // buffer order owns it (as with add_face(), which creates the edge).
+    constexpr IndexType no_corner = PMP_MAX_INDEX;
+    std::vector<IndexType> twin(n_corners, no_corner);
+    std::vector<IndexType> edge_owner(n_corners, 0);
+    bool complex_edge = false;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(|| : complex_edge)
+    for (int v = 0; v < static_cast<int>(n_vertices); ++v)
+    {
+        const auto begin = bucket_corners.begin() + bucket_start[v];
+        const auto end = bucket_corners.begin() + bucket_start[v + 1];
+        const auto max_vertex = [&](IndexType c) {
+            return std::max(indices[c], indices[to_corner(c)]);
+        };
+        // (stable) insertion sort, buckets only hold a few corners
+        for (auto it = begin; it != end; ++it)
+        {
+            const IndexType c = *it;
+            auto jt = it;
+            for (; jt != begin && max_vertex(*(jt - 1)) > max_vertex(c); --jt)
+                *jt = *(jt - 1);
+            *jt = c;
+        }
+
+        for (auto it = begin; it != end;)
+        {
+            auto group_end = it + 1;
+            while (group_end != end && max_vertex(*group_end) == max_vertex(*it))
+                ++group_end;
+
+            edge_owner[*it] = 1;
+            if (group_end - it == 2)
+            {
+                const IndexType c0 = *it;
+                const IndexType c1 = *(it + 1);
+                if (indices[c0] == indices[c1])
+                    complex_edge = true; // inconsistent orientation
+                twin[c0] = c1;
+                twin[c1] = c0;
+            }
+            else if (group_end - it > 2)
+                complex_edge = true;
+            it = group_end;
+        }
+    }
+    if (complex_edge)
+    {
+        auto what = "SurfaceMesh::build_from_triangles: Complex edge.";
+        throw TopologyException(what);
+    }
+
+    // number the edges in the order of their owners
+    std::vector<IndexType>& edge_of_corner = edge_owner;
+    IndexType n_edges = 0;
+    for (IndexType c = 0; c < static_cast<IndexType>(n_corners); ++c)
+    {
+        const bool is_owner = edge_owner[c] != 0;
+        edge_of_corner[c] = is_owner ? n_edges++ : no_corner;
+    }
+    if (2 * static_cast<size_t>(n_edges) >= PMP_MAX_INDEX - 1)
+    {
+        auto what = "SurfaceMesh::build_from_triangles: cannot allocate "
+                    "edges, max. index reached";
+        throw AllocationException(what);
+    }
+
+    // halfedge of each corner: the owner gets the first halfedge of its edge
+    std::vector<Halfedge> corner_halfedge(n_corners);
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < n_corners; ++c)
+    {
+        const IndexType e = edge_of_corner[c];
+        if (e == no_corner)
+            continue;
+        corner_halfedge[c] = Halfedge(2 * e);
+        if (twin[c] != no_corner)
+            corner_halfedge[twin[c]] = Halfedge(2 * e + 1);
+    }
+
+    // allocate all elements (keeping the existing properties)
+    vprops_.resize(0);
+    hprops_.resize(0);
+    eprops_.resize(0);
+    fprops_.resize(0);
+    vprops_.resize(n_vertices);
+    hprops_.resize(2 * static_cast<size_t>(n_edges));
+    eprops_.resize(n_edges);
+    fprops_.resize(n_faces);
+    deleted_vertices_ = 0;
+    deleted_edges_ = 0;
+    deleted_faces_ = 0;
+    has_garbage_ = false;
+
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < static_cast<int>(n_vertices); ++v)
+        vpoint_[Vertex(v)] = positions[v];
+
+    // inner halfedges, and the vertices of boundary halfedges
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < n_corners; ++c)
+    {
+        const Halfedge h = corner_halfedge[c];
+        auto& hc = hconn_[h];
+        hc.face_ = Face(static_cast<IndexType>(c / 3));
+        hc.vertex_ = Vertex(indices[to_corner(c)]);
+        hc.next_halfedge_ = corner_halfedge[to_corner(c)];
+        hc.prev_halfedge_ = corner_halfedge[from_corner(c)];
+        if (c % 3 == 2)
+            fconn_[hc.face_].halfedge_ = h;
+        if (twin[c] == no_corner)
+            hconn_[opposite_halfedge(h)].vertex_ = Vertex(indices[c]);
+    }
+
+    // outgoing halfedges (boundary halfedges for boundary vertices), and the
+    // number of incident faces of each vertex
+    std::vector<IndexType> vertex_faces(n_vertices, 0);
+    for (IndexType c = 0; c < static_cast<IndexType>(n_corners); ++c)
+    {
+        ++vertex_faces[indices[c]];
+        if (!vconn_[Vertex(indices[c])].halfedge_.is_valid())
+            vconn_[Vertex(indices[c])].halfedge_ = corner_halfedge[c];
+    }
+    for (IndexType c = 0; c < static_cast<IndexType>(n_corners); ++c)
+    {
+        if (twin[c] == no_corner)
+            vconn_[Vertex(indices[to_corner(c)])].halfedge_ =
+                opposite_halfedge(corner_halfedge[c]);
+    }
+
+    // link the boundary halfedges: the next boundary halfedge of b starts
+    // where the fan of inner halfedges around the end vertex of b ends.
+    std::vector<IndexType> fan_faces(n_vertices, 0);
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < n_corners; ++c)
+    {
+        if (twin[c] != no_corner)
+            continue;
+        const Halfedge b = opposite_halfedge(corner_halfedge[c]);
+        Halfedge h = corner_halfedge[c];
+        IndexType n_fan_faces = 1;
+        Halfedge o = opposite_halfedge(hconn_[h].prev_halfedge_);
+        while (hconn_[o].face_.is_valid())
+        {
+            h = o;
+            ++n_fan_faces;
+            o = opposite_halfedge(hconn_[h].prev_halfedge_);
+        }
+        hconn_[b].next_halfedge_ = o;
+        hconn_[o].prev_halfedge_ = b;
+#pragma omp atomic
+        fan_faces[indices[c]] += n_fan_faces;
+    }
+
+    // all faces of a vertex have to be in its open fans, or in one closed fan
+    bool complex_vertex = false;
+#pragma omp parallel for schedule(static) reduction(|| : complex_vertex)
+    for (int i = 0; i < static_cast<int>(n_vertices); ++i)
+    {
+        const Vertex v(static_cast<IndexType>(i));
+        const Halfedge h0 = vconn_[v].halfedge_;
+        if (!h0.is_valid() || !hconn_[h0].face_.is_valid())
+        {
+            complex_vertex = complex_vertex || fan_faces[i] != vertex_faces[i];
+            continue;
+        }
+        IndexType n_fan_faces = 0;
+        Halfedge h = h0;
+        do
+        {
+            ++n_fan_faces;
+            h = opposite_halfedge(hconn_[h].prev_halfedge_);
+        } while (h != h0 && n_fan_faces <= vertex_faces[i]);
+        complex_vertex = complex_vertex || n_fan_faces != vertex_faces[i];
+    }
+    if (complex_vertex)
+    {
+        auto what = "SurfaceMesh::build_from_triangles: Complex vertex.";
+        throw TopologyException(what);
+    }
+}
+
 size_t SurfaceMesh::valence(Vertex v) const
 {
     auto vv = vertices(v);
@@ -1306,4 +1552,126 @@ void SurfaceMesh::garbage_collection()
     has_garbage_ = false;
 }
 
+void SurfaceMesh::reorder(const std::vector<IndexType>& vertex_order,
+                          const std::vector<IndexType>& face_order)
+{
+    if (has_garbage_)
+    {
+        auto what = "SurfaceMesh::reorder: The mesh has garbage, call "
+                    "garbage_collection() first.";
+        throw InvalidInputException(what);
+    }
+
+    const auto nV = static_cast<IndexType>(vertices_size());
+    const auto nE = static_cast<IndexType>(edges_size());
+    const auto nF = static_cast<IndexType>(faces_size());
+
+    // invert a new-to-old order, checking that it is a permutation
+    const auto inverse = [](const std::vector<IndexType>& order, IndexType n,
+                            const char* what) {
+        if (order.size() != n)
+            throw InvalidInputException(what);
+        std::vector<IndexType> old_to_new(n, PMP_MAX_INDEX);
+        for (IndexType i = 0; i < n; ++i)
+        {
+            if (order[i] >= n || old_to_new[order[i]] != PMP_MAX_INDEX)
+                throw InvalidInputException(what);
+            old_to_new[order[i]] = i;
+        }
+        return old_to_new;
+    };
+
+    const auto vmap =
+        inverse(vertex_order, nV,
+                "SurfaceMesh::reorder: vertex_order is not a permutation of "
+                "the vertices.");
+
+    // default face order: by the smallest new index of their vertices
+    // (a stable counting sort, since the keys are vertex indices)
+    std::vector<IndexType> forder = face_order;
+    if (forder.empty() && nF > 0)
+    {
+        std::vector<IndexType> fkey(nF, PMP_MAX_INDEX);
+        std::vector<IndexType> bucket_begin(static_cast<size_t>(nV) + 1, 0);
+        for (auto f : faces())
+        {
+            for (auto v : vertices(f))
+                fkey[f.idx()] = std::min(fkey[f.idx()], vmap[v.idx()]);
+            ++bucket_begin[fkey[f.idx()] + 1];
+        }
+        std::partial_sum(bucket_begin.begin(), bucket_begin.end(),
+                         bucket_begin.begin());
+        forder.resize(nF);
+        for (IndexType fIdx = 0; fIdx < nF; ++fIdx)
+            forder[bucket_begin[fkey[fIdx]]++] = fIdx;
+    }
+    const auto fmap = inverse(
+        forder, nF,
+        "SurfaceMesh::reorder: face_order is not a permutation of the faces.");
+
+    // edges in the order of their first use by the reordered faces,
+    // followed by edges without faces (if any)
+    std::vector<IndexType> eorder;
+    eorder.reserve(nE);
+    std::vector<IndexType> emap(nE, PMP_MAX_INDEX);
+    for (const auto fIdx : forder)
+    {
+        for (auto h : halfedges(Face(fIdx)))
+        {
+            const auto eIdx = edge(h).idx();
+            if (emap[eIdx] != PMP_MAX_INDEX)
+                continue;
+            emap[eIdx] = static_cast<IndexType>(eorder.size());
+            eorder.push_back(eIdx);
+        }
+    }
+    for (IndexType eIdx = 0; eIdx < nE; ++eIdx)
+    {
+        if (emap[eIdx] != PMP_MAX_INDEX)
+            continue;
+        emap[eIdx] = static_cast<IndexType>(eorder.size());
+        eorder.push_back(eIdx);
+    }
+
+    // permute all property arrays (including connectivity)
+    const auto to_size_t = [](const std::vector<IndexType>& order) {
+        return std::vector<size_t>(order.begin(), order.end());
+    };
+    std::vector<size_t> horder(2 * static_cast<size_t>(nE));
+    for (size_t i = 0; i < nE; ++i)
+    {
+        horder[2 * i] = 2 * static_cast<size_t>(eorder[i]);
+        horder[2 * i + 1] = 2 * static_cast<size_t>(eorder[i]) + 1;
+    }
+    vprops_.permute(to_size_t(vertex_order));
+    hprops_.permute(horder);
+    eprops_.permute(to_size_t(eorder));
+    fprops_.permute(to_size_t(forder));
+
+    // the orientation of halfedges within their edge is kept
+    const auto hmap = [&emap](Halfedge h) {
+        return Halfedge(2 * emap[h.idx() >> 1] + (h.idx() & 1));
+    };
+
+    // update vertex connectivity
+    for (auto v : vertices())
+    {
+        if (!is_isolated(v))
+            set_halfedge(v, hmap(halfedge(v)));
+    }
+
+    // update halfedge connectivity
+    for (auto h : halfedges())
+    {
+        set_vertex(h, Vertex(vmap[to_vertex(h).idx()]));
+        set_next_halfedge(h, hmap(next_halfedge(h)));
+        if (!is_boundary(h))
+            set_face(h, Face(fmap[face(h).idx()]));
+    }
+
+    // update handles of faces
+    for (auto f : faces())
+        set_halfedge(f, hmap(halfedge(f)));
+}
+
 } // namespace pmp
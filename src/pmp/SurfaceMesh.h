@@ -1141,9 +1141,13 @@ public:
     //! PMP    | no    | yes    | no      | no     | no
     //! XYZ    | yes   | no     | a       | no     | no
     //! AGI    | yes   | no     | a       | a      | no
+    //! VTK    | yes   | yes    | no      | no     | no
     //!
     //! In addition, the OBJ and PMP formats support reading per-halfedge
-    //! texture coordinates.
+    //! texture coordinates. Scalar vertex and face properties of VTK and PLY
+    //! files are read as float, double, unsigned int, or int properties
+    //! (other integer types, including exported bool properties, become
+    //! int properties).
     void read(const std::string& filename, const IOFlags& flags = IOFlags());
 
     //! \brief Write mesh to file \p filename controlled by \p flags
@@ -1158,9 +1162,12 @@ public:
     //! PLY    | yes   | yes    | no      | no     | no
     //! PMP    | no    | yes    | no      | no     | no
     //! XYZ    | yes   | no     | a       | no     | no
+    //! VTK    | yes   | yes    | no      | no     | no
     //!
     //! In addition, the OBJ and PMP formats support writing per-halfedge
-    //! texture coordinates.
+    //! texture coordinates. The VTK and PLY formats support writing vertex
+    //! and face properties of type bool, int, unsigned int, float, or double
+    //! (selected by IOFlags::vertex_properties and IOFlags::face_properties).
     void write(const std::string& filename,
                const IOFlags& flags = IOFlags()) const;
 
@@ -1187,6 +1194,24 @@ public:
     //! \sa add_triangle, add_face
     Face add_quad(Vertex v0, Vertex v1, Vertex v2, Vertex v3);
 
+    //! \brief Replace all elements by the triangles of an index buffer.
+    //! \details Instead of a per-face add_face(), which searches the
+    //! halfedges around the face vertices, the directed edges are bucketed at
+    //! their smaller vertex index to find twin halfedges, and the connectivity
+    //! is written directly (in parallel). Vertices, edges, and faces get the
+    //! same indices as with add_vertex() and add_triangle() in buffer order.
+    //! Existing properties are kept (resized and reset to default values).
+    //! \param positions vertex positions.
+    //! \param indices three vertex indices per triangle.
+    //! \throw InvalidInputException if the size of \p indices is not a
+    //! multiple of 3 or an index is out of range.
+    //! \throw TopologyException if the triangles are degenerate or do not form
+    //! a manifold surface: an edge shared by more than two triangles or by
+    //! inconsistently oriented triangles, or a vertex with a closed fan of
+    //! triangles and further incident triangles.
+    void build_from_triangles(const std::vector<Point>& positions,
+                              const std::vector<IndexType>& indices);
+
     //!@}
     //! \name Memory Management
     //!@{
@@ -1244,6 +1269,23 @@ public:
     //! remove deleted elements
     void garbage_collection();
 
+    //! \brief Renumber the vertices and faces, e.g. for the memory locality of
+    //! neighboring elements.
+    //! \details All vertex, halfedge, edge, and face property arrays are
+    //! permuted consistently, and the connectivity is remapped. Edges are
+    //! renumbered in the order of their first use by the reordered faces.
+    //! Handles stored as values of custom properties are not remapped.
+    //! \param vertex_order vertex \c i of the reordered mesh is vertex
+    //! \c vertex_order[i] of the current mesh.
+    //! \param face_order face \c i of the reordered mesh is face
+    //! \c face_order[i] of the current mesh. If empty, faces are ordered by
+    //! their smallest new vertex index.
+    //! \throw InvalidInputException if the mesh has garbage, or if an order
+    //! is not a permutation.
+    //! \sa Reordering
+    void reorder(const std::vector<IndexType>& vertex_order,
+                 const std::vector<IndexType>& face_order = {});
+
     //! \return whether vertex \p v is deleted
     //! \sa garbage_collection()
     bool is_deleted(Vertex v) const { return vdeleted_[v]; }
@@ -1707,6 +1749,106 @@ public:
     //! prints the names of all properties
     void property_stats() const;
 
+    //!@}
+    //! \name Keyed property access
+    //! \details Overloads taking an interned PropertyKey instead of a name.
+    //! A keyed lookup indexes a per-mesh table by the key id, so it does not
+    //! compare strings. Use these (with keys constructed once) in code that
+    //! runs per vertex, or at least per time step.
+    //!@{
+
+    //! get the vertex property with key \p key of type \p T. returns an
+    //! invalid VertexProperty if the property does not exist or if the type
+    //! does not match.
+    template <class T>
+    VertexProperty<T> get_vertex_property(const PropertyKey& key) const
+    {
+        return VertexProperty<T>(vprops_.get<T>(key));
+    }
+
+    //! if a vertex property of type \p T with key \p key exists, it is
+    //! returned. otherwise this property is added (with default value \p t)
+    template <class T>
+    VertexProperty<T> vertex_property(const PropertyKey& key, const T t = T())
+    {
+        return VertexProperty<T>(vprops_.get_or_add<T>(key, t));
+    }
+
+    //! does the mesh have a vertex property with key \p key?
+    bool has_vertex_property(const PropertyKey& key) const
+    {
+        return vprops_.exists(key);
+    }
+
+    //! get the halfedge property with key \p key of type \p T. returns an
+    //! invalid HalfedgeProperty if the property does not exist or if the type
+    //! does not match.
+    template <class T>
+    HalfedgeProperty<T> get_halfedge_property(const PropertyKey& key) const
+    {
+        return HalfedgeProperty<T>(hprops_.get<T>(key));
+    }
+
+    //! if a halfedge property of type \p T with key \p key exists, it is
+    //! returned. otherwise this property is added (with default value \p t)
+    template <class T>
+    HalfedgeProperty<T> halfedge_property(const PropertyKey& key, const T t = T())
+    {
+        return HalfedgeProperty<T>(hprops_.get_or_add<T>(key, t));
+    }
+
+    //! does the mesh have a halfedge property with key \p key?
+    bool has_halfedge_property(const PropertyKey& key) const
+    {
+        return hprops_.exists(key);
+    }
+
+    //! get the edge property with key \p key of type \p T. returns an
+    //! invalid EdgeProperty if the property does not exist or if the type
+    //! does not match.
+    template <class T>
+    EdgeProperty<T> get_edge_property(const PropertyKey& key) const
+    {
+        return EdgeProperty<T>(eprops_.get<T>(key));
+    }
+
+    //! if a edge property of type \p T with key \p key exists, it is
+    //! returned. otherwise this property is added (with default value \p t)
+    template <class T>
+    EdgeProperty<T> edge_property(const PropertyKey& key, const T t = T())
+    {
+        return EdgeProperty<T>(eprops_.get_or_add<T>(key, t));
+    }
+
+    //! does the mesh have a edge property with key \p key?
+    bool has_edge_property(const PropertyKey& key) const
+    {
+        return eprops_.exists(key);
+    }
+
+    //! get the face property with key \p key of type \p T. returns an
+    //! invalid FaceProperty if the property does not exist or if the type
+    //! does not match.
+    template <class T>
+    FaceProperty<T> get_face_property(const PropertyKey& key) const
+    {
+        return FaceProperty<T>(fprops_.get<T>(key));
+    }
+
+    //! if a face property of type \p T with key \p key exists, it is
+    //! returned. otherwise this property is added (with default value \p t)
+    template <class T>
+    FaceProperty<T> face_property(const PropertyKey& key, const T t = T())
+    {
+        return FaceProperty<T>(fprops_.get_or_add<T>(key, t));
+    }
+
+    //! does the mesh have a face property with key \p key?
+    bool has_face_property(const PropertyKey& key) const
+    {
+        return fprops_.exists(key);
+    }
+
     //!@}
     //! \name Iterators and circulators
     //!@{
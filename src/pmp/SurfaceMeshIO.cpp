@@ -9,11 +9,17 @@
 #include <cctype>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <map>
 #include <fstream>
 #include <limits>
+#include <tuple>
+#include <type_traits>
 
-#include <rply.h>
+#include "pmp/MappedFile.h"
+#include "pmp/PolygonSoupParser.h"
 
 // helper function
 template <typename T>
@@ -33,6 +39,475 @@ void tfwrite(FILE* out, const T& t)
 
 namespace pmp {
 
+namespace {
+
+// property value types stored in binary snapshots (the index is the type tag)
+using SnapshotTypes = std::tuple<bool, int, unsigned int, float, double, vec2,
+                                 vec3, dvec2, dvec3>;
+
+template <typename T>
+void write_snapshot_value(std::ostream& out, const T& t)
+{
+    out.write(reinterpret_cast<const char*>(&t), sizeof(T));
+}
+
+template <typename T>
+void read_snapshot_value(std::istream& in, T& t)
+{
+    if (!in.read(reinterpret_cast<char*>(&t), sizeof(T)))
+        throw IOException("Truncated binary mesh snapshot");
+}
+
+template <typename T>
+void write_snapshot_array(std::ostream& out, const std::vector<T>& values)
+{
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+void write_snapshot_array(std::ostream& out, const std::vector<bool>& values)
+{
+    const std::vector<std::uint8_t> bytes(values.begin(), values.end());
+    write_snapshot_array(out, bytes);
+}
+
+template <typename T>
+void read_snapshot_array(std::istream& in, std::vector<T>& values)
+{
+    if (!in.read(reinterpret_cast<char*>(values.data()),
+                 static_cast<std::streamsize>(values.size() * sizeof(T))))
+        throw IOException("Truncated binary mesh snapshot");
+}
+
+void read_snapshot_array(std::istream& in, std::vector<bool>& values)
+{
+    std::vector<std::uint8_t> bytes(values.size());
+    read_snapshot_array(in, bytes);
+    std::copy(bytes.begin(), bytes.end(), values.begin());
+}
+
+void write_snapshot_string(std::ostream& out, const std::string& str)
+{
+    write_snapshot_value(out, static_cast<std::uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+std::string read_snapshot_string(std::istream& in)
+{
+    std::uint32_t size(0);
+    read_snapshot_value(in, size);
+    std::string str(size, '\0');
+    if (size > 0 && !in.read(str.data(), size))
+        throw IOException("Truncated binary mesh snapshot");
+    return str;
+}
+
+// writes property \p name if its type is one of SnapshotTypes
+template <size_t I = 0>
+void write_snapshot_property(const PropertyContainer& props,
+                             const std::string& name, std::ostream& out)
+{
+    if constexpr (I < std::tuple_size_v<SnapshotTypes>)
+    {
+        using T = std::tuple_element_t<I, SnapshotTypes>;
+        const auto prop = props.get<T>(name);
+        if (!prop)
+        {
+            write_snapshot_property<I + 1>(props, name, out);
+            return;
+        }
+        write_snapshot_string(out, name);
+        write_snapshot_value(out, static_cast<std::uint8_t>(I));
+        write_snapshot_array(out, prop.vector());
+    }
+}
+
+template <size_t I = 0>
+void read_snapshot_property(PropertyContainer& props, const std::string& name,
+                            std::uint8_t tag, std::istream& in)
+{
+    if constexpr (I < std::tuple_size_v<SnapshotTypes>)
+    {
+        if (tag != I)
+        {
+            read_snapshot_property<I + 1>(props, name, tag, in);
+            return;
+        }
+        using T = std::tuple_element_t<I, SnapshotTypes>;
+        auto prop = props.get_or_add<T>(name);
+        if (!prop)
+            throw IOException("Type mismatch of property " + name +
+                              " in binary mesh snapshot");
+        read_snapshot_array(in, prop.vector());
+    }
+    else
+    {
+        throw IOException("Unknown type of property " + name +
+                          " in binary mesh snapshot");
+    }
+}
+
+// properties of a container followed by an empty name as a terminator
+void write_snapshot_properties(const PropertyContainer& props,
+                               std::ostream& out)
+{
+    for (const auto& name : props.properties())
+        write_snapshot_property(props, name, out);
+    write_snapshot_string(out, std::string());
+}
+
+void read_snapshot_properties(PropertyContainer& props, std::istream& in)
+{
+    while (true)
+    {
+        const auto name = read_snapshot_string(in);
+        if (name.empty())
+            break;
+        std::uint8_t tag(0);
+        read_snapshot_value(in, tag);
+        read_snapshot_property(props, name, tag, in);
+    }
+}
+
+// property value types written to VTK and PLY files (the index is the type
+// tag). bool values are written as unsigned bytes.
+using ExportTypes = std::tuple<bool, int, unsigned int, float, double>;
+constexpr std::array<const char*, 5> vtk_export_type_names{
+    "unsigned_char", "int", "unsigned_int", "float", "double"};
+constexpr std::array<const char*, 5> ply_export_type_names{
+    "uchar", "int", "uint", "float", "double"};
+constexpr std::array<size_t, 5> export_type_sizes{1, 4, 4, 4, 8};
+
+template <typename T>
+using ExportStorage =
+    std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>;
+
+// values of a property of all valid elements in native byte order
+struct ExportedProperty
+{
+    std::string name; // without the "v:" or "f:" prefix
+    size_t type{0};   // index into ExportTypes
+    std::vector<char> values;
+};
+
+// copies the values of the valid elements of property \p name if its type
+// is one of ExportTypes
+template <size_t I = 0, typename GetProperty, typename Elements>
+bool gather_exported_property(GetProperty&& get_property,
+                              const Elements& elements, size_t n_elements,
+                              ExportedProperty& result)
+{
+    if constexpr (I < std::tuple_size_v<ExportTypes>)
+    {
+        using T = std::tuple_element_t<I, ExportTypes>;
+        using S = ExportStorage<T>;
+        const auto prop = get_property(T{});
+        if (!prop)
+            return gather_exported_property<I + 1>(get_property, elements,
+                                                   n_elements, result);
+
+        result.type = I;
+        result.values.resize(n_elements * sizeof(S));
+        const auto& values = prop.vector();
+        if constexpr (!std::is_same_v<T, bool>)
+        {
+            // without garbage, the array is copied at once
+            if (values.size() == n_elements)
+            {
+                std::memcpy(result.values.data(), values.data(),
+                            result.values.size());
+                return true;
+            }
+        }
+        char* out = result.values.data();
+        for (auto e : elements)
+        {
+            const auto value = static_cast<S>(values[e.idx()]);
+            std::memcpy(out, &value, sizeof(S));
+            out += sizeof(S);
+        }
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+// properties of the valid elements named in \p selected (all properties
+// in \p names except deleted flags if \p select_all is set). Properties of
+// other types than ExportTypes are skipped.
+template <typename GetProperty, typename Elements>
+std::vector<ExportedProperty> gather_exported_properties(
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& selected, bool select_all,
+    GetProperty&& get_property, const Elements& elements, size_t n_elements)
+{
+    std::vector<ExportedProperty> result;
+    for (const auto& name : (select_all ? names : selected))
+    {
+        if (name == "v:deleted" || name == "f:deleted")
+            continue;
+        ExportedProperty prop;
+        prop.name = name.substr(name.find(':') + 1);
+        if (prop.name.empty())
+            continue;
+        const auto get_named_property = [&](auto tag) {
+            return get_property(name, tag);
+        };
+        if (gather_exported_property(get_named_property, elements,
+                                     n_elements, prop))
+            result.push_back(std::move(prop));
+    }
+    return result;
+}
+
+std::vector<ExportedProperty> gather_exported_vertex_properties(
+    const SurfaceMesh& mesh, const IOFlags& flags)
+{
+    const bool select_all =
+        flags.vertex_properties.empty() && flags.face_properties.empty();
+    return gather_exported_properties(
+        mesh.vertex_properties(), flags.vertex_properties, select_all,
+        [&mesh](const std::string& name, auto tag) {
+            return mesh.get_vertex_property<decltype(tag)>(name);
+        },
+        mesh.vertices(), mesh.n_vertices());
+}
+
+std::vector<ExportedProperty> gather_exported_face_properties(
+    const SurfaceMesh& mesh, const IOFlags& flags)
+{
+    const bool select_all =
+        flags.vertex_properties.empty() && flags.face_properties.empty();
+    return gather_exported_properties(
+        mesh.face_properties(), flags.face_properties, select_all,
+        [&mesh](const std::string& name, auto tag) {
+            return mesh.get_face_property<decltype(tag)>(name);
+        },
+        mesh.faces(), mesh.n_faces());
+}
+
+// prints value \p i of an exported property as ASCII
+void print_exported_value(FILE* out, const ExportedProperty& prop, size_t i)
+{
+    const char* data = prop.values.data() + i * export_type_sizes[prop.type];
+    switch (prop.type)
+    {
+        case 0: {
+            std::uint8_t value;
+            std::memcpy(&value, data, sizeof(value));
+            fprintf(out, "%u", static_cast<unsigned int>(value));
+            break;
+        }
+        case 1: {
+            int value;
+            std::memcpy(&value, data, sizeof(value));
+            fprintf(out, "%d", value);
+            break;
+        }
+        case 2: {
+            unsigned int value;
+            std::memcpy(&value, data, sizeof(value));
+            fprintf(out, "%u", value);
+            break;
+        }
+        case 3: {
+            float value;
+            std::memcpy(&value, data, sizeof(value));
+            fprintf(out, "%.9g", value);
+            break;
+        }
+        default: {
+            double value;
+            std::memcpy(&value, data, sizeof(value));
+            fprintf(out, "%.17g", value);
+            break;
+        }
+    }
+}
+
+// reverses the byte order of \p n_values consecutive values of
+// \p value_size bytes each
+void swap_byte_order(char* data, size_t n_values, size_t value_size)
+{
+    if (value_size < 2)
+        return;
+    for (size_t i = 0; i < n_values; ++i, data += value_size)
+        std::reverse(data, data + value_size);
+}
+
+// writes values given in native byte order in the byte order of the file
+void write_values(FILE* out, std::vector<char>& data, size_t value_size,
+                  bool big_endian_file)
+{
+    const bool big_endian_host = std::endian::native == std::endian::big;
+    if (big_endian_file != big_endian_host)
+        swap_byte_order(data.data(), data.size() / value_size, value_size);
+    fwrite(data.data(), 1, data.size(), out);
+    if (big_endian_file != big_endian_host)
+        swap_byte_order(data.data(), data.size() / value_size, value_size);
+}
+
+// appends a value to a binary little-endian record
+template <typename T>
+void append_little_endian(std::vector<char>& record, const T& value)
+{
+    const auto offset = record.size();
+    record.resize(offset + sizeof(T));
+    std::memcpy(record.data() + offset, &value, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big)
+        std::reverse(record.begin() + offset, record.end());
+}
+
+// builds \p mesh from the vertices and polygons of \p soup, and per-corner
+// texture coordinates as "h:tex" if there are any. Triangle meshes are
+// built in bulk.
+void build_mesh_from_polygon_soup(SurfaceMesh& mesh, const PolygonSoup& soup)
+{
+    const auto& sizes = soup.polygon_sizes;
+    const auto& indices = soup.polygon_indices;
+    if (std::all_of(sizes.begin(), sizes.end(),
+                    [](IndexType n) { return n == 3; }))
+    {
+        mesh.build_from_triangles(soup.positions, indices);
+    }
+    else
+    {
+        mesh.reserve(soup.positions.size(), 3 * soup.positions.size(),
+                     sizes.size());
+        for (const auto& p : soup.positions)
+            mesh.add_vertex(p);
+        std::vector<Vertex> vertices;
+        size_t offset = 0;
+        for (const auto n : sizes)
+        {
+            vertices.clear();
+            for (size_t k = 0; k < n; ++k)
+            {
+                const auto idx = indices[offset + k];
+                if (idx >= soup.positions.size())
+                    throw IOException("Vertex index out of range!");
+                vertices.emplace_back(idx);
+            }
+            mesh.add_face(vertices);
+            offset += n;
+        }
+    }
+
+    if (soup.polygon_tex_indices.empty() || mesh.n_faces() != sizes.size())
+        return;
+
+    // faces are in the order of polygons, the halfedge of corner k points
+    // to vertex k of the polygon
+    auto tex_coords = mesh.halfedge_property<TexCoord>("h:tex");
+    size_t offset = 0;
+    for (size_t i = 0; i < sizes.size(); offset += sizes[i++])
+    {
+        const Face f(static_cast<IndexType>(i));
+        Halfedge h = mesh.halfedge(f);
+        while (mesh.to_vertex(h).idx() != indices[offset])
+            h = mesh.next_halfedge(h);
+        for (size_t k = 0; k < sizes[i]; ++k, h = mesh.next_halfedge(h))
+        {
+            const auto tex_idx = soup.polygon_tex_indices[offset + k];
+            if (tex_idx < soup.tex_coords.size())
+                tex_coords[h] = soup.tex_coords[tex_idx];
+        }
+    }
+}
+
+// adds a property read from a file: float, double and unsigned int values
+// keep their type, other integer values become int
+template <typename GetOrAddProperty>
+void add_imported_property(const std::string& name, const ScalarArray& array,
+                           GetOrAddProperty&& get_or_add_property)
+{
+    const auto copy_values = [&array](auto prop) {
+        if (!prop)
+            return;
+        using T = typename std::decay_t<decltype(prop.vector())>::value_type;
+        auto& values = prop.vector();
+        const auto n = std::min(values.size(), array.values.size());
+        for (size_t i = 0; i < n; ++i)
+            values[i] = static_cast<T>(array.values[i]);
+    };
+
+    const auto& type = array.type;
+    if (type == "float" || type == "float32")
+        copy_values(get_or_add_property(name, float{}));
+    else if (type == "double" || type == "float64")
+        copy_values(get_or_add_property(name, double{}));
+    else if (type == "unsigned_int" || type == "uint" || type == "uint32")
+        copy_values(get_or_add_property(name, 0u));
+    else
+        copy_values(get_or_add_property(name, int{}));
+}
+
+// adds vertex and face properties read from a file. \p to_property_name
+// maps array names in the file to names without the "v:" or "f:" prefix.
+template <typename ToPropertyName>
+void add_imported_properties(SurfaceMesh& mesh,
+                             const std::vector<ScalarArray>& vertex_arrays,
+                             const std::vector<ScalarArray>& face_arrays,
+                             ToPropertyName&& to_property_name)
+{
+    for (const auto& array : vertex_arrays)
+    {
+        if (array.values.size() != mesh.vertices_size())
+            continue;
+        add_imported_property(
+            "v:" + to_property_name(array.name), array,
+            [&mesh](const std::string& name, auto tag) {
+                return mesh.vertex_property<decltype(tag)>(name);
+            });
+    }
+    for (const auto& array : face_arrays)
+    {
+        if (array.values.size() != mesh.faces_size())
+            continue;
+        add_imported_property(
+            "f:" + to_property_name(array.name), array,
+            [&mesh](const std::string& name, auto tag) {
+                return mesh.face_property<decltype(tag)>(name);
+            });
+    }
+}
+
+// writes a POINT_DATA or CELL_DATA section of a legacy VTK file
+void write_vtk_attributes(FILE* out, const char* section, size_t n_elements,
+                          std::vector<ExportedProperty>& props, bool binary)
+{
+    if (props.empty())
+        return;
+
+    fprintf(out, "\n%s %zu\n", section, n_elements);
+    for (auto& prop : props)
+    {
+        // upper case first letter, as in "v:distance" -> "Distance"
+        auto name = prop.name;
+        name[0] = static_cast<char>(std::toupper(name[0]));
+        fprintf(out, "\nSCALARS %s %s 1\n", name.c_str(),
+                vtk_export_type_names[prop.type]);
+        fprintf(out, "LOOKUP_TABLE default\n");
+
+        if (binary)
+        {
+            write_values(out, prop.values, export_type_sizes[prop.type],
+                         true);
+            fprintf(out, "\n");
+            continue;
+        }
+        for (size_t i = 0; i < n_elements; ++i)
+        {
+            print_exported_value(out, prop, i);
+            fprintf(out, "\n");
+        }
+    }
+}
+
+} // namespace
+
 void SurfaceMeshIO::read(SurfaceMesh& mesh)
 {
     std::setlocale(LC_NUMERIC, "C");
@@ -100,233 +575,27 @@ void SurfaceMeshIO::write(const SurfaceMesh& mesh)
 
 void SurfaceMeshIO::read_obj(SurfaceMesh& mesh) const
 {
-    std::array<char, 200> s;
-    float x, y, z;
-    std::vector<Vertex> vertices;
-    std::vector<TexCoord> all_tex_coords; //individual texture coordinates
-    std::vector<int>
-        halfedge_tex_idx; //texture coordinates sorted for halfedges
-    HalfedgeProperty<TexCoord> tex_coords =
-        mesh.halfedge_property<TexCoord>("h:tex");
-    bool with_tex_coord = false;
-
-    // open file (in ASCII mode)
-    FILE* in = fopen(filename_.c_str(), "r");
-    if (!in)
-        throw IOException("Failed to open file: " + filename_);
-
-    // clear line once
-    memset(s.data(), 0, 200);
-
-    // parse line by line (currently only supports vertex positions & faces
-    while (in && !feof(in) && fgets(s.data(), 200, in))
-    {
-        // comment
-        if (s[0] == '#' || isspace(s[0]))
-            continue;
-
-        // vertex
-        else if (strncmp(s.data(), "v ", 2) == 0)
-        {
-            if (sscanf(s.data(), "v %f %f %f", &x, &y, &z))
-            {
-                mesh.add_vertex(Point(x, y, z));
-            }
-        }
-
-        // normal
-        else if (strncmp(s.data(), "vn ", 3) == 0)
-        {
-            if (sscanf(s.data(), "vn %f %f %f", &x, &y, &z))
-            {
-                // problematic as it can be either a vertex property when interpolated
-                // or a halfedge property for hard edges
-            }
-        }
-
-        // texture coordinate
-        else if (strncmp(s.data(), "vt ", 3) == 0)
-        {
-            if (sscanf(s.data(), "vt %f %f", &x, &y))
-            {
-                all_tex_coords.emplace_back(x, y);
-            }
-        }
-
-        // face
-        else if (strncmp(s.data(), "f ", 2) == 0)
-        {
-            int component(0), nv(0);
-            bool end_of_vertex(false);
-            char *p0, *p1(s.data() + 1);
-
-            vertices.clear();
-            halfedge_tex_idx.clear();
-
-            // skip white-spaces
-            while (*p1 == ' ')
-                ++p1;
-
-            while (p1)
-            {
-                p0 = p1;
-
-                // overwrite next separator
-
-                // skip '/', '\n', ' ', '\0', '\r' <-- don't forget Windows
-                while (*p1 != '/' && *p1 != '\r' && *p1 != '\n' && *p1 != ' ' &&
-                       *p1 != '\0')
-                    ++p1;
-
-                // detect end of vertex
-                if (*p1 != '/')
-                {
-                    end_of_vertex = true;
-                }
-
-                // replace separator by '\0'
-                if (*p1 != '\0')
-                {
-                    *p1 = '\0';
-                    p1++; // point to next token
-                }
-
-                // detect end of line and break
-                if (*p1 == '\0' || *p1 == '\n')
-                {
-                    p1 = nullptr;
-                }
-
-                // read next vertex component
-                if (*p0 != '\0')
-                {
-                    switch (component)
-                    {
-                        case 0: // vertex
-                        {
-                            int idx = atoi(p0);
-                            if (idx < 0)
-                                idx = mesh.n_vertices() + idx + 1;
-                            vertices.emplace_back(idx - 1);
-                            break;
-                        }
-                        case 1: // texture coord
-                        {
-                            int idx = atoi(p0) - 1;
-                            halfedge_tex_idx.push_back(idx);
-                            with_tex_coord = true;
-                            break;
-                        }
-                        case 2: // normal
-                            break;
-                    }
-                }
-
-                ++component;
-
-                if (end_of_vertex)
-                {
-                    component = 0;
-                    nv++;
-                    end_of_vertex = false;
-                }
-            }
-
-            Face f = mesh.add_face(vertices);
-
-            // add texture coordinates
-            if (with_tex_coord && f.is_valid())
-            {
-                auto h_fit = mesh.halfedges(f);
-                auto h_end = h_fit;
-                unsigned v_idx = 0;
-                do
-                {
-                    tex_coords[*h_fit] =
-                        all_tex_coords.at(halfedge_tex_idx.at(v_idx));
-                    ++v_idx;
-                    ++h_fit;
-                } while (h_fit != h_end);
-            }
-        }
-        // clear line
-        memset(s.data(), 0, 200);
-    }
-
-    // if there are no textures, delete texture property!
-    if (!with_tex_coord)
-    {
-        mesh.remove_halfedge_property(tex_coords);
-    }
-
-    fclose(in);
+    // vertex normals are ignored, as they can be either a vertex property
+    // when interpolated or a halfedge property for hard edges
+    const MappedFile file(filename_);
+    build_mesh_from_polygon_soup(mesh, PolygonSoupParser::parse_obj(file.view()));
 }
 
 void SurfaceMeshIO::read_vtk(SurfaceMesh& mesh) const
 {
-    std::array<char, 1024> s;
-    FILE* in = fopen(filename_.c_str(), "r");
-    if (!in)
-        throw IOException("Failed to open file: " + filename_);
-
-    // Clear line once
-    memset(s.data(), 0, s.size());
-
-    // Temporary storage for parsing the file
-    std::vector<Vertex> vertices;
-
-    // Parse line by line
-    while (in && !feof(in) && fgets(s.data(), s.size(), in))
-    {
-        // Skip comments and empty lines
-        if (s[0] == '#' || isspace(s[0]))
-            continue;
-
-        // Read vertex positions
-        if (strncmp(s.data(), "POINTS", 6) == 0)
-        {
-            int nPoints;
-            sscanf(s.data() + 6, "%d", &nPoints); // Assumes "POINTS" is followed by the number of points
-            vertices.reserve(nPoints);
-            for (int i = 0; i < nPoints; ++i)
-            {
-                float x, y, z;
-                if (fscanf(in, "%f %f %f", &x, &y, &z) == 3)
-                {
-                    auto v = mesh.add_vertex(Point(x, y, z));
-                    vertices.push_back(v);
-                }
-            }
-        }
-
-        // Read polygons
-        else if (strncmp(s.data(), "POLYGONS", 8) == 0)
-        {
-            int nPolygons, totalIndices;
-            sscanf(s.data() + 8, "%d %d", &nPolygons, &totalIndices); // Assumes "POLYGONS" is followed by the number of polygons and total indices
-
-            for (int i = 0; i < nPolygons; ++i)
-            {
-                int nVerts;
-                fscanf(in, "%d", &nVerts); // Read the number of vertices for this polygon
-
-                std::vector<Vertex> faceVertices;
-                faceVertices.reserve(nVerts);
-                for (int j = 0; j < nVerts; ++j)
-                {
-                    int idx;
-                    fscanf(in, "%d", &idx); // Read vertex index
-                    faceVertices.push_back(vertices.at(idx));
-                }
-                mesh.add_face(faceVertices);
-            }
-        }
-
-        // Clear line for next read
-        memset(s.data(), 0, s.size());
-    }
-
-    fclose(in);
+    const MappedFile file(filename_);
+    std::vector<ScalarArray> vertex_arrays, face_arrays;
+    build_mesh_from_polygon_soup(
+        mesh, PolygonSoupParser::parse_vtk(file.view(), &vertex_arrays,
+                                           &face_arrays));
+
+    // lower case first letter, as in "Distance" -> "v:distance"
+    add_imported_properties(mesh, vertex_arrays, face_arrays,
+                            [](std::string name) {
+                                name[0] = static_cast<char>(
+                                    std::tolower(name[0]));
+                                return name;
+                            });
 }
 
 void SurfaceMeshIO::write_obj(const SurfaceMesh& mesh) const
@@ -398,13 +667,14 @@ void SurfaceMeshIO::write_obj(const SurfaceMesh& mesh) const
 //-----------------------------------------------------------------------------
 /*! \brief Generates a polydata points header based on point count.
  *  \param[in] mesh           exported mesh.
+ *  \param[in] type           value type name of point coordinates.
  *  \return polydata points header string
 */
 //-----------------------------------------------------------------------------
-[[nodiscard]] std::string GenerateVTKPolydataPointsHeaderFromData(const SurfaceMesh& mesh)
+[[nodiscard]] std::string GenerateVTKPolydataPointsHeaderFromData(const SurfaceMesh& mesh, const char* type = "double")
 {
     std::string result;
-    result += "\nPOINTS " + std::to_string(mesh.n_vertices()) + " double\n";
+    result += "\nPOINTS " + std::to_string(mesh.n_vertices()) + " " + type + "\n";
     return result;
 }
 
@@ -435,180 +705,95 @@ const auto VTK_Polydata_Header_Str =
 	"ASCII\n" +
 	"DATASET POLYDATA\n";
 
+//!> \brief Header string for binary VTK polydata file.
+const auto VTK_Polydata_Binary_Header_Str =
+	std::string("# vtk DataFile Version 4.2\n") +
+	"vtk output\n" +
+	"BINARY\n" +
+	"DATASET POLYDATA\n";
+
 void SurfaceMeshIO::write_vtk(const SurfaceMesh& mesh) const
 {
-    FILE* out = fopen(filename_.c_str(), "w");
+    const bool binary = flags_.use_binary;
+    FILE* out = fopen(filename_.c_str(), binary ? "wb" : "w");
     if (!out)
         throw IOException("Failed to open file: " + filename_);
 
     // header
-    fprintf(out, "%s", VTK_Polydata_Header_Str.c_str());
+    fprintf(out, "%s", (binary ? VTK_Polydata_Binary_Header_Str : VTK_Polydata_Header_Str).c_str());
 
     // points header
-    fprintf(out, "%s", GenerateVTKPolydataPointsHeaderFromData(mesh).c_str());
+    constexpr auto point_type = std::is_same_v<Scalar, float> ? "float" : "double";
+    fprintf(out, "%s", GenerateVTKPolydataPointsHeaderFromData(mesh, binary ? point_type : "double").c_str());
 
     // write vertices
     auto points = mesh.get_vertex_property<Point>("v:point");
-    for (const auto v : mesh.vertices())
-    {
-        const Point& p = points[v];
-        fprintf(out, "%.10f %.10f %.10f\n", p[0], p[1], p[2]);
-    }
-
-    // polygons header
-    fprintf(out, "%s", GenerateVTKPolydataPolygonsHeaderFromData(mesh).c_str());
-
-    // write faces
-    for (const auto f : mesh.faces())
+    if (binary)
     {
-        const auto nFaceVerts = static_cast<IndexType>(std::distance(mesh.vertices(f).begin(), mesh.vertices(f).end()));
-        fprintf(out, "%d", nFaceVerts);
-        for (auto v : mesh.vertices(f))
+        std::vector<char> data(3 * sizeof(Scalar) * mesh.n_vertices());
+        char* ptr = data.data();
+        for (const auto v : mesh.vertices())
         {
-            const auto idx = v.idx();
-            fprintf(out, " %d", idx);
+            std::memcpy(ptr, points[v].data(), 3 * sizeof(Scalar));
+            ptr += 3 * sizeof(Scalar);
         }
+        write_values(out, data, sizeof(Scalar), true);
         fprintf(out, "\n");
     }
-
-    if (mesh.vertex_properties().size() > 3)
+    else
     {
-	    // write additional vertex properties as scalar lookup table
-
-        fprintf(out, "\nPOINT_DATA %d\n", static_cast<int>(mesh.n_vertices()));
-
-        for (const auto& propName : mesh.vertex_properties())
+        for (const auto v : mesh.vertices())
         {
-            if (propName == "v:point")
-                continue;
-            if (propName == "v:connectivity")
-                continue;
-            if (propName == "v:normal")
-                continue;
-            if (propName == "v:deleted")
-                continue;
-
-            const auto vPropScalar = mesh.get_vertex_property<Scalar>(propName);
-            if (!vPropScalar)
-                continue;
-
-            auto propNameToExport = propName.substr(propName.find(":") + 1);
-            propNameToExport[0] = std::toupper(propNameToExport[0]); // make first letter upper case
-
-            fprintf(out, "\nSCALARS %s double 1\n", propNameToExport.c_str());
-            fprintf(out, "LOOKUP_TABLE default\n");
- 
-            for (const auto& propVal : vPropScalar.vector())
-            {
-                fprintf(out, "%f\n", propVal);
-            }
+            const Point& p = points[v];
+            fprintf(out, "%.10f %.10f %.10f\n", p[0], p[1], p[2]);
         }
     }
 
-    fclose(out);
-}
-
-void read_off_ascii(SurfaceMesh& mesh, FILE* in, const bool has_normals,
-                    const bool has_texcoords, const bool has_colors)
-{
-    std::array<char, 1000> line;
-    int nc;
-    unsigned int i, j, items, idx;
-    unsigned int nv, nf, ne;
-    float x, y, z, r, g, b;
-    Vertex v;
-
-    // properties
-    VertexProperty<Normal> normals;
-    VertexProperty<TexCoord> texcoords;
-    VertexProperty<Color> colors;
-    if (has_normals)
-        normals = mesh.vertex_property<Normal>("v:normal");
-    if (has_texcoords)
-        texcoords = mesh.vertex_property<TexCoord>("v:tex");
-    if (has_colors)
-        colors = mesh.vertex_property<Color>("v:color");
-
-    // #Vertice, #Faces, #Edges
-    items = fscanf(in, "%d %d %d\n", (int*)&nv, (int*)&nf, (int*)&ne);
-    PMP_ASSERT(items);
+    // polygons header
+    fprintf(out, "%s", GenerateVTKPolydataPolygonsHeaderFromData(mesh).c_str());
 
-    mesh.reserve(nv, std::max(3 * nv, ne), nf);
+    // write faces (with indices of valid vertices only)
+    std::vector<std::int32_t> vertex_ids(mesh.vertices_size(), -1);
+    std::int32_t vertex_id = 0;
+    for (const auto v : mesh.vertices())
+        vertex_ids[v.idx()] = vertex_id++;
 
-    // read vertices: pos [normal] [color] [texcoord]
-    for (i = 0; i < nv && !feof(in); ++i)
+    if (binary)
     {
-        // read line
-        auto lp = fgets(line.data(), 1000, in);
-        lp = line.data();
-
-        // position
-        items = sscanf(lp, "%f %f %f%n", &x, &y, &z, &nc);
-        assert(items == 3);
-        v = mesh.add_vertex(Point(x, y, z));
-        lp += nc;
-
-        // normal
-        if (has_normals)
+        std::vector<std::int32_t> polygons;
+        polygons.reserve(4 * mesh.n_faces());
+        for (const auto f : mesh.faces())
         {
-            if (sscanf(lp, "%f %f %f%n", &x, &y, &z, &nc) == 3)
-            {
-                normals[v] = Normal(x, y, z);
-            }
-            lp += nc;
+            polygons.push_back(static_cast<std::int32_t>(mesh.valence(f)));
+            for (auto v : mesh.vertices(f))
+                polygons.push_back(vertex_ids[v.idx()]);
         }
-
-        // color
-        if (has_colors)
+        std::vector<char> data(polygons.size() * sizeof(std::int32_t));
+        std::memcpy(data.data(), polygons.data(), data.size());
+        write_values(out, data, sizeof(std::int32_t), true);
+        fprintf(out, "\n");
+    }
+    else
+    {
+        for (const auto f : mesh.faces())
         {
-            if (sscanf(lp, "%f %f %f%n", &r, &g, &b, &nc) == 3)
+            const auto nFaceVerts = static_cast<IndexType>(std::distance(mesh.vertices(f).begin(), mesh.vertices(f).end()));
+            fprintf(out, "%d", nFaceVerts);
+            for (auto v : mesh.vertices(f))
             {
-                if (r > 1.0f || g > 1.0f || b > 1.0f)
-                {
-                    r /= 255.0f;
-                    g /= 255.0f;
-                    b /= 255.0f;
-                }
-                colors[v] = Color(r, g, b);
+                fprintf(out, " %d", vertex_ids[v.idx()]);
             }
-            lp += nc;
-        }
-
-        // tex coord
-        if (has_texcoords)
-        {
-            items = sscanf(lp, "%f %f%n", &x, &y, &nc);
-            assert(items == 2);
-            texcoords[v][0] = x;
-            texcoords[v][1] = y;
-            lp += nc;
+            fprintf(out, "\n");
         }
     }
 
-    // read faces: #N v[1] v[2] ... v[n-1]
-    std::vector<Vertex> vertices;
-    for (i = 0; i < nf; ++i)
-    {
-        // read line
-        auto lp = fgets(line.data(), 1000, in);
-        lp = line.data();
-
-        // #vertices
-        items = sscanf(lp, "%d%n", (int*)&nv, &nc);
-        assert(items == 1);
-        vertices.resize(nv);
-        lp += nc;
+    // write vertex and face properties as scalar lookup tables
+    auto vprops = gather_exported_vertex_properties(mesh, flags_);
+    write_vtk_attributes(out, "POINT_DATA", mesh.n_vertices(), vprops, binary);
+    auto fprops = gather_exported_face_properties(mesh, flags_);
+    write_vtk_attributes(out, "CELL_DATA", mesh.n_faces(), fprops, binary);
 
-        // indices
-        for (j = 0; j < nv; ++j)
-        {
-            items = sscanf(lp, "%d%n", (int*)&idx, &nc);
-            assert(items == 1);
-            vertices[j] = Vertex(idx);
-            lp += nc;
-        }
-        mesh.add_face(vertices);
-    }
+    fclose(out);
 }
 
 void read_off_binary(SurfaceMesh& mesh, FILE* in, const bool has_normals,
@@ -781,13 +966,25 @@ void SurfaceMeshIO::read_off(SurfaceMesh& mesh) const
         assert(c != nullptr);
     }
 
-    // read as ASCII or binary
+    // read binary, or parse ASCII in place
     if (is_binary)
+    {
         read_off_binary(mesh, in, has_normals, has_texcoords, has_colors);
-    else
-        read_off_ascii(mesh, in, has_normals, has_texcoords, has_colors);
-
+        fclose(in);
+        return;
+    }
     fclose(in);
+
+    const MappedFile file(filename_);
+    const auto soup = PolygonSoupParser::parse_off(file.view());
+    build_mesh_from_polygon_soup(mesh, soup);
+    if (has_normals)
+        mesh.vertex_property<Normal>("v:normal").vector() = soup.normals;
+    if (has_colors)
+        mesh.vertex_property<Color>("v:color").vector() = soup.colors;
+    if (has_texcoords)
+        mesh.vertex_property<TexCoord>("v:tex").vector() =
+            soup.vertex_tex_coords;
 }
 
 void SurfaceMeshIO::write_off(const SurfaceMesh& mesh) const
@@ -1042,113 +1239,127 @@ void SurfaceMeshIO::write_pmp(const SurfaceMesh& mesh) const
     fclose(out);
 }
 
-// helper to assemble vertex data
-static int vertexCallback(p_ply_argument argument)
-{
-    long idx;
-    void* pdata;
-    ply_get_argument_user_data(argument, &pdata, &idx);
-
-    auto* mesh = (pmp::SurfaceMesh*)pdata;
-    auto point = mesh->get_object_property<pmp::Point>("g:point");
-    point[0][idx] = ply_get_argument_value(argument);
-
-    if (idx == 2)
-        mesh->add_vertex(point[0]);
-
-    return 1;
-}
-
-// helper to assemble face data
-static int faceCallback(p_ply_argument argument)
+void SurfaceMeshIO::read_ply(SurfaceMesh& mesh) const
 {
-    long length, value_index;
-    void* pdata;
-    long idata;
-    ply_get_argument_user_data(argument, &pdata, &idata);
-    ply_get_argument_property(argument, nullptr, &length, &value_index);
-
-    auto* mesh = (pmp::SurfaceMesh*)pdata;
-    auto vertices =
-        mesh->get_object_property<std::vector<pmp::Vertex>>("g:vertices");
-
-    if (value_index == 0)
-        vertices[0].clear();
-
-    auto idx = (IndexType)ply_get_argument_value(argument);
-    vertices[0].push_back(pmp::Vertex(idx));
-
-    if (value_index == length - 1)
-        mesh->add_face(vertices[0]);
-
-    return 1;
+    const MappedFile file(filename_);
+    std::vector<ScalarArray> vertex_arrays, face_arrays;
+    build_mesh_from_polygon_soup(
+        mesh, PolygonSoupParser::parse_ply(file.view(), &vertex_arrays,
+                                           &face_arrays));
+    add_imported_properties(mesh, vertex_arrays, face_arrays,
+                            [](const std::string& name) { return name; });
 }
 
-void SurfaceMeshIO::read_ply(SurfaceMesh& mesh) const
+void SurfaceMeshIO::write_ply(const SurfaceMesh& mesh) const
 {
-    // add object properties to hold temporary data
-    auto point = mesh.add_object_property<Point>("g:point");
-    auto vertices = mesh.add_object_property<std::vector<Vertex>>("g:vertices");
-
-    // open file, read header
-    p_ply ply = ply_open(filename_.c_str(), nullptr, 0, nullptr);
-
-    if (!ply)
+    const bool binary = flags_.use_binary;
+    FILE* out = fopen(filename_.c_str(), binary ? "wb" : "w");
+    if (!out)
         throw IOException("Failed to open file: " + filename_);
 
-    if (!ply_read_header(ply))
-        throw IOException("Failed to read PLY header!");
-
-    // setup callbacks for basic properties
-    ply_set_read_cb(ply, "vertex", "x", vertexCallback, &mesh, 0);
-    ply_set_read_cb(ply, "vertex", "y", vertexCallback, &mesh, 1);
-    ply_set_read_cb(ply, "vertex", "z", vertexCallback, &mesh, 2);
+    const auto vprops = gather_exported_vertex_properties(mesh, flags_);
+    const auto fprops = gather_exported_face_properties(mesh, flags_);
 
-    ply_set_read_cb(ply, "face", "vertex_indices", faceCallback, &mesh, 0);
+    // header
+    constexpr auto point_type = std::is_same_v<Scalar, float> ? "float" : "double";
+    fprintf(out, "ply\n");
+    fprintf(out, "format %s 1.0\n", binary ? "binary_little_endian" : "ascii");
+    fprintf(out, "comment File written with pmp-library\n");
+    fprintf(out, "element vertex %zu\n", mesh.n_vertices());
+    fprintf(out, "property %s x\n", point_type);
+    fprintf(out, "property %s y\n", point_type);
+    fprintf(out, "property %s z\n", point_type);
+    for (const auto& prop : vprops)
+        fprintf(out, "property %s %s\n", ply_export_type_names[prop.type], prop.name.c_str());
+    fprintf(out, "element face %zu\n", mesh.n_faces());
+    fprintf(out, "property list uchar int vertex_indices\n");
+    for (const auto& prop : fprops)
+        fprintf(out, "property %s %s\n", ply_export_type_names[prop.type], prop.name.c_str());
+    fprintf(out, "end_header\n");
+
+    // indices of valid vertices
+    std::vector<std::int32_t> vertex_ids(mesh.vertices_size(), -1);
+    std::int32_t vertex_id = 0;
+    for (const auto v : mesh.vertices())
+        vertex_ids[v.idx()] = vertex_id++;
 
-    // read the data
-    if (!ply_read(ply))
-        throw IOException("Failed to read PLY data!");
+    auto points = mesh.get_vertex_property<Point>("v:point");
+    if (!binary)
+    {
+        size_t i = 0;
+        for (const auto v : mesh.vertices())
+        {
+            const Point& p = points[v];
+            fprintf(out, "%.9g %.9g %.9g", p[0], p[1], p[2]);
+            for (const auto& prop : vprops)
+            {
+                fprintf(out, " ");
+                print_exported_value(out, prop, i);
+            }
+            fprintf(out, "\n");
+            ++i;
+        }
 
-    ply_close(ply);
+        i = 0;
+        for (const auto f : mesh.faces())
+        {
+            fprintf(out, "%zu", mesh.valence(f));
+            for (auto v : mesh.vertices(f))
+                fprintf(out, " %d", vertex_ids[v.idx()]);
+            for (const auto& prop : fprops)
+            {
+                fprintf(out, " ");
+                print_exported_value(out, prop, i);
+            }
+            fprintf(out, "\n");
+            ++i;
+        }
 
-    // clean-up properties
-    mesh.remove_object_property(point);
-    mesh.remove_object_property(vertices);
-}
+        fclose(out);
+        return;
+    }
 
-void SurfaceMeshIO::write_ply(const SurfaceMesh& mesh) const
-{
-    e_ply_storage_mode mode = flags_.use_binary ? PLY_LITTLE_ENDIAN : PLY_ASCII;
-    p_ply ply = ply_create(filename_.c_str(), mode, nullptr, 0, nullptr);
-
-    ply_add_comment(ply, "File written with pmp-library");
-    ply_add_element(ply, "vertex", mesh.n_vertices());
-    ply_add_scalar_property(ply, "x", PLY_FLOAT);
-    ply_add_scalar_property(ply, "y", PLY_FLOAT);
-    ply_add_scalar_property(ply, "z", PLY_FLOAT);
-    ply_add_element(ply, "face", mesh.n_faces());
-    ply_add_property(ply, "vertex_indices", PLY_LIST, PLY_UCHAR, PLY_INT);
-    ply_write_header(ply);
+    // binary vertex and face records are assembled in a buffer
+    // and written at once
+    std::vector<char> records;
+    const auto append_properties = [&records](const std::vector<ExportedProperty>& props, size_t i) {
+        for (const auto& prop : props)
+        {
+            const auto size = export_type_sizes[prop.type];
+            const auto offset = records.size();
+            records.insert(records.end(), prop.values.begin() + i * size, prop.values.begin() + (i + 1) * size);
+            if constexpr (std::endian::native == std::endian::big)
+                std::reverse(records.begin() + offset, records.end());
+        }
+    };
 
-    // write vertices
-    auto points = mesh.get_vertex_property<Point>("v:point");
-    for (auto v : mesh.vertices())
+    size_t vertex_record_size = 3 * sizeof(Scalar);
+    for (const auto& prop : vprops)
+        vertex_record_size += export_type_sizes[prop.type];
+    records.reserve(vertex_record_size * mesh.n_vertices());
+    size_t i = 0;
+    for (const auto v : mesh.vertices())
     {
-        ply_write(ply, points[v][0]);
-        ply_write(ply, points[v][1]);
-        ply_write(ply, points[v][2]);
+        const Point& p = points[v];
+        append_little_endian(records, p[0]);
+        append_little_endian(records, p[1]);
+        append_little_endian(records, p[2]);
+        append_properties(vprops, i++);
     }
+    fwrite(records.data(), 1, records.size(), out);
 
-    // write faces
-    for (auto f : mesh.faces())
+    records.clear();
+    i = 0;
+    for (const auto f : mesh.faces())
     {
-        ply_write(ply, mesh.valence(f));
-        for (auto fv : mesh.vertices(f))
-            ply_write(ply, fv.idx());
+        append_little_endian(records, static_cast<std::uint8_t>(mesh.valence(f)));
+        for (auto v : mesh.vertices(f))
+            append_little_endian(records, vertex_ids[v.idx()]);
+        append_properties(fprops, i++);
     }
+    fwrite(records.data(), 1, records.size(), out);
 
-    ply_close(ply);
+    fclose(out);
 }
 
 // helper class for STL reader
@@ -1371,4 +1582,68 @@ void SurfaceMeshIO::write_xyz(const SurfaceMesh& mesh) const
     ofs.close();
 }
 
+void SurfaceMeshIO::write_binary_snapshot(const SurfaceMesh& mesh,
+                                          std::ostream& out)
+{
+    // sizes including deleted elements
+    write_snapshot_value(out, static_cast<std::uint64_t>(mesh.vertices_size()));
+    write_snapshot_value(out, static_cast<std::uint64_t>(mesh.halfedges_size()));
+    write_snapshot_value(out, static_cast<std::uint64_t>(mesh.edges_size()));
+    write_snapshot_value(out, static_cast<std::uint64_t>(mesh.faces_size()));
+
+    // connectivity
+    write_snapshot_array(out, mesh.vconn_.vector());
+    write_snapshot_array(out, mesh.hconn_.vector());
+    write_snapshot_array(out, mesh.fconn_.vector());
+
+    // positions, deleted flags and custom properties
+    write_snapshot_properties(mesh.vprops_, out);
+    write_snapshot_properties(mesh.hprops_, out);
+    write_snapshot_properties(mesh.eprops_, out);
+    write_snapshot_properties(mesh.fprops_, out);
+
+    if (!out)
+        throw IOException("Failed to write binary mesh snapshot");
+}
+
+void SurfaceMeshIO::read_binary_snapshot(SurfaceMesh& mesh, std::istream& in)
+{
+    mesh.clear();
+
+    std::uint64_t nv(0), nh(0), ne(0), nf(0);
+    read_snapshot_value(in, nv);
+    read_snapshot_value(in, nh);
+    read_snapshot_value(in, ne);
+    read_snapshot_value(in, nf);
+    if (nh != 2 * ne)
+        throw IOException("Inconsistent element counts in binary mesh snapshot");
+
+    mesh.vprops_.resize(nv);
+    mesh.hprops_.resize(nh);
+    mesh.eprops_.resize(ne);
+    mesh.fprops_.resize(nf);
+
+    read_snapshot_array(in, mesh.vconn_.vector());
+    read_snapshot_array(in, mesh.hconn_.vector());
+    read_snapshot_array(in, mesh.fconn_.vector());
+
+    read_snapshot_properties(mesh.vprops_, in);
+    read_snapshot_properties(mesh.hprops_, in);
+    read_snapshot_properties(mesh.eprops_, in);
+    read_snapshot_properties(mesh.fprops_, in);
+
+    // restore the counters of deleted elements
+    const auto& vdeleted = mesh.vdeleted_.vector();
+    const auto& edeleted = mesh.edeleted_.vector();
+    const auto& fdeleted = mesh.fdeleted_.vector();
+    mesh.deleted_vertices_ = static_cast<IndexType>(
+        std::count(vdeleted.begin(), vdeleted.end(), true));
+    mesh.deleted_edges_ = static_cast<IndexType>(
+        std::count(edeleted.begin(), edeleted.end(), true));
+    mesh.deleted_faces_ = static_cast<IndexType>(
+        std::count(fdeleted.begin(), fdeleted.end(), true));
+    mesh.has_garbage_ = mesh.deleted_vertices_ > 0 ||
+                        mesh.deleted_edges_ > 0 || mesh.deleted_faces_ > 0;
+}
+
 } // namespace pmp
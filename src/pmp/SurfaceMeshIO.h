@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <string>
 #include <utility>
 
@@ -24,6 +25,21 @@ public:
 
     void write(const SurfaceMesh& mesh);
 
+    //! \brief Write connectivity, deleted flags and all properties of \p mesh
+    //! to a binary stream.
+    //! \details Vertex, halfedge, edge and face properties of type bool, int,
+    //! unsigned int, float, double, vec2, vec3, dvec2 and dvec3 are written,
+    //! properties of other types are skipped. Element indices (including
+    //! deleted elements) are preserved, so the snapshot restores the mesh
+    //! exactly. The data is written in native byte order.
+    static void write_binary_snapshot(const SurfaceMesh& mesh,
+                                      std::ostream& out);
+
+    //! \brief Read \p mesh from a binary stream written by
+    //! write_binary_snapshot(). Clears \p mesh first.
+    //! \throw IOException in case of a corrupt or truncated stream.
+    static void read_binary_snapshot(SurfaceMesh& mesh, std::istream& in);
+
 private:
     void read_off(SurfaceMesh& mesh) const;
     void read_obj(SurfaceMesh& mesh) const;
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "pmp/MatVec.h"
 
@@ -67,6 +69,13 @@ struct IOFlags
     bool use_face_normals = false;       //!< read / write face normals
     bool use_face_colors = false;        //!< read / write face colors
     bool use_halfedge_texcoords = false; //!< read / write halfedge texcoords
+
+    //! names of scalar vertex properties written to VTK and PLY files
+    //! (all supported vertex properties if both lists are empty)
+    std::vector<std::string> vertex_properties{};
+    //! names of scalar face properties written to VTK and PLY files
+    //! (all supported face properties if both lists are empty)
+    std::vector<std::string> face_properties{};
 };
 
 //! @}
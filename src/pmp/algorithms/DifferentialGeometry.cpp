@@ -334,6 +334,64 @@ ImplicitLaplaceInfo laplace_implicit_barycentric(const SurfaceMesh& mesh, Vertex
     return result;
 }
 
+namespace {
+
+template <typename AreaFunction>
+void laplace_implicit_weights(const SurfaceMesh& mesh,
+                              ImplicitLaplaceWeights& weights,
+                              AreaFunction area_function)
+{
+    const auto n_edges = static_cast<int>(mesh.edges_size());
+    const auto n_vertices = static_cast<int>(mesh.vertices_size());
+    weights.edgeWeights.resize(n_edges);
+    weights.vertexAreaNorms.resize(n_vertices);
+    weights.vertexWeightSums.resize(n_vertices);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n_edges; ++i)
+    {
+        const Edge e(static_cast<IndexType>(i));
+        weights.edgeWeights[i] =
+            mesh.is_deleted(e) ? Scalar(0.0)
+                               : static_cast<Scalar>(cotan_weight(mesh, e));
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n_vertices; ++i)
+    {
+        const Vertex v(static_cast<IndexType>(i));
+        if (mesh.is_deleted(v) || mesh.is_isolated(v))
+        {
+            weights.vertexAreaNorms[i] = Scalar(1.0);
+            weights.vertexWeightSums[i] = Scalar(0.0);
+            continue;
+        }
+
+        Scalar sum_weights(0.0);
+        for (const auto h : mesh.halfedges(v))
+            sum_weights += weights.edgeWeights[mesh.edge(h).idx()];
+
+        const Scalar areaNorm =
+            2.0f * static_cast<Scalar>(area_function(mesh, v));
+        weights.vertexAreaNorms[i] = areaNorm;
+        weights.vertexWeightSums[i] = sum_weights / areaNorm;
+    }
+}
+
+} // namespace
+
+void laplace_implicit_weights_voronoi(const SurfaceMesh& mesh,
+                                      ImplicitLaplaceWeights& weights)
+{
+    laplace_implicit_weights(mesh, weights, voronoi_area);
+}
+
+void laplace_implicit_weights_barycentric(const SurfaceMesh& mesh,
+                                          ImplicitLaplaceWeights& weights)
+{
+    laplace_implicit_weights(mesh, weights, voronoi_area_barycentric);
+}
+
 Scalar angle_sum(const SurfaceMesh& mesh, Vertex v)
 {
     Scalar angles(0.0);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include "pmp/Types.h"
 #include "pmp/SurfaceMesh.h"
@@ -103,6 +104,26 @@ struct ImplicitLaplaceInfo
 //! compute weights for implicit Laplacian (normalized by Barycentric Voronoi area).
 [[nodiscard]] ImplicitLaplaceInfo laplace_implicit_barycentric(const SurfaceMesh& mesh, Vertex v);
 
+//! flat whole-mesh weights for implicit Laplacian assembly. The weight of neighbor
+//! w = to_vertex(h) in the row of v = from_vertex(h) is
+//! edgeWeights[edge(h).idx()] / vertexAreaNorms[v.idx()].
+struct ImplicitLaplaceWeights
+{
+    std::vector<Scalar> edgeWeights{};      //!< cotan weight of each edge.
+    std::vector<Scalar> vertexAreaNorms{};  //!< twice the co-volume area of each vertex.
+    std::vector<Scalar> vertexWeightSums{}; //!< sum of normalized neighbor weights of each vertex.
+};
+
+//! compute implicit Laplacian weights of all vertices (normalized by Voronoi area).
+//! Cotan weights are evaluated once per edge, areas once per vertex, both in parallel.
+//! The buffers of \p weights are reused between calls.
+void laplace_implicit_weights_voronoi(const SurfaceMesh& mesh, ImplicitLaplaceWeights& weights);
+
+//! compute implicit Laplacian weights of all vertices (normalized by Barycentric Voronoi area).
+//! Cotan weights are evaluated once per edge, areas once per vertex, both in parallel.
+//! The buffers of \p weights are reused between calls.
+void laplace_implicit_weights_barycentric(const SurfaceMesh& mesh, ImplicitLaplaceWeights& weights);
+
 //! compute the sum of angles around vertex v (used for Gaussian curvature)
 Scalar angle_sum(const SurfaceMesh& mesh, Vertex v);
 
@@ -17,8 +17,109 @@
 
 namespace pmp {
 
+void RemeshingReference::update(const SurfaceMesh& mesh, VertexProperty<Scalar> sizing)
+{
+    if (refmesh_ && has_connectivity_of(mesh))
+    {
+        // copy positions and refit the kd-tree
+        for (auto v : refmesh_->vertices())
+        {
+            refpoints_[v] = mesh.position(v);
+        }
+        kd_tree_->refit(*refmesh_);
+        ++n_refits_;
+    }
+    else
+    {
+        // build reference mesh
+        refmesh_ = std::make_shared<SurfaceMesh>();
+        refmesh_->assign(mesh);
+        refpoints_ = refmesh_->vertex_property<Point>("v:point");
+        refsizing_ = refmesh_->add_vertex_property<Scalar>("v:sizing");
+
+        // build kd-tree
+        kd_tree_ = std::make_unique<TriangleKdTree>(refmesh_, 0);
+        ++n_rebuilds_;
+    }
+
+    Normals::compute_vertex_normals(*refmesh_);
+    refnormals_ = refmesh_->vertex_property<Point>("v:normal");
+
+    // copy sizing field from mesh
+    for (auto v : refmesh_->vertices())
+    {
+        refsizing_[v] = sizing[v];
+    }
+}
+
+bool RemeshingReference::has_connectivity_of(const SurfaceMesh& mesh) const
+{
+    // element indices need to coincide, so meshes with garbage are rejected
+    if (mesh.vertices_size() != refmesh_->vertices_size() ||
+        mesh.faces_size() != refmesh_->faces_size() ||
+        mesh.n_vertices() != mesh.vertices_size() ||
+        mesh.n_faces() != mesh.faces_size() ||
+        refmesh_->n_vertices() != refmesh_->vertices_size() ||
+        refmesh_->n_faces() != refmesh_->faces_size())
+        return false;
+
+    for (auto f : mesh.faces())
+    {
+        auto fv = mesh.vertices(f);
+        auto ref_fv = refmesh_->vertices(f);
+        for (int i = 0; i < 3; ++i, ++fv, ++ref_fv)
+        {
+            if (*fv != *ref_fv)
+                return false;
+        }
+    }
+    return true;
+}
+
+void RemeshingReference::project(const Point& p, Point& nearest, Point& normal, Scalar& sizing) const
+{
+    // find closest triangle of reference mesh
+    auto nn = kd_tree_->nearest(p);
+    nearest = nn.nearest;
+    const Face f = nn.face;
+
+    // get face data
+    auto fvIt = refmesh_->vertices(f);
+    const Point p0 = refpoints_[*fvIt];
+    const Point n0 = refnormals_[*fvIt];
+    const Scalar s0 = refsizing_[*fvIt];
+    ++fvIt;
+    const Point p1 = refpoints_[*fvIt];
+    const Point n1 = refnormals_[*fvIt];
+    const Scalar s1 = refsizing_[*fvIt];
+    ++fvIt;
+    const Point p2 = refpoints_[*fvIt];
+    const Point n2 = refnormals_[*fvIt];
+    const Scalar s2 = refsizing_[*fvIt];
+
+    // get barycentric coordinates
+    Point b = barycentric_coordinates(nearest, p0, p1, p2);
+
+    // interpolate normal
+    normal = (n0 * b[0]);
+    normal += (n1 * b[1]);
+    normal += (n2 * b[2]);
+    normal.normalize();
+    assert(!std::isnan(normal[0]));
+
+    // interpolate sizing field
+    sizing = (s0 * b[0]);
+    sizing += (s1 * b[1]);
+    sizing += (s2 * b[2]);
+}
+
 Remeshing::Remeshing(SurfaceMesh& mesh)
-    : mesh_(mesh), refmesh_(nullptr), kd_tree_(nullptr)
+    : Remeshing(mesh, std::make_shared<RemeshingReference>())
+{
+}
+
+Remeshing::Remeshing(SurfaceMesh& mesh, std::shared_ptr<RemeshingReference> reference)
+    : mesh_(mesh), reference_(std::move(reference))
 {
     if (!mesh_.is_triangle_mesh())
         throw InvalidInputException("Input is not a pure triangle mesh!");
@@ -45,7 +146,7 @@ void Remeshing::uniform_remeshing(Scalar edge_length, unsigned int iterations,
     {
         split_long_edges();
 
-        Normals::compute_vertex_normals(mesh_);
+        update_vertex_normals();
 
         collapse_short_edges();
 
@@ -73,7 +174,7 @@ void Remeshing::adaptive_remeshing(const AdaptiveRemeshingSettings& settings, co
     {
         split_long_edges();
 
-        Normals::compute_vertex_normals(mesh_);
+        update_vertex_normals();
 
         collapse_short_edges();
 
@@ -101,6 +202,35 @@ void Remeshing::convex_hull_adaptive_remeshing(const AdaptiveRemeshingSettings&
     convex_hull_postprocessing();
 }
 
+void Remeshing::local_adaptive_remeshing(const AdaptiveRemeshingSettings& settings,
+                                         const std::vector<Vertex>& region)
+{
+    uniform_ = false;
+    min_edge_length_ = settings.MinEdgeLength;
+    max_edge_length_ = settings.MaxEdgeLength;
+    approx_error_ = settings.ApproxError;
+    use_projection_ = settings.UseProjection;
+
+    local_preprocessing(region);
+
+    for (unsigned int i = 0; i < settings.NRemeshingIterations; ++i)
+    {
+        split_long_edges();
+
+        update_vertex_normals();
+
+        collapse_short_edges();
+
+        flip_edges();
+
+        tangential_smoothing(settings.NTangentialSmoothingIters);
+    }
+
+    remove_caps();
+
+    local_postprocessing();
+}
+
 
 void Remeshing::preprocessing()
 {
@@ -171,106 +301,11 @@ void Remeshing::preprocessing()
     }
     else
     {
-        // compute curvature for all mesh vertices, using cotan or Cohen-Steiner
-        // don't use two-ring neighborhood, since we otherwise compute
-        // curvature over sharp features edges, leading to high curvatures.
-        // prefer tensor analysis over cotan-Laplace, since the former is more
-        // robust and gives better results on the boundary.
-        Curvature curv(mesh_);
-        curv.analyze_tensor(1);
-
-        // use vsizing_ to store/smooth curvatures to avoid another vertex property
-
-        // curvature values for feature vertices and boundary vertices
-        // are not meaningful. mark them as negative values.
-        for (auto v : mesh_.vertices())
-        {
-            if (mesh_.is_boundary(v) || (vfeature_ && vfeature_[v]))
-                vsizing_[v] = -1.0;
-            else
-                vsizing_[v] = curv.max_abs_curvature(v);
-        }
-
-        // curvature values might be noisy. smooth them.
-        // don't consider feature vertices' curvatures.
-        // don't consider boundary vertices' curvatures.
-        // do this for two iterations, to propagate curvatures
-        // from non-feature regions to feature vertices.
-        for (int iters = 0; iters < 2; ++iters)
-        {
-            for (auto v : mesh_.vertices())
-            {
-                Scalar w, ww = 0.0;
-                Scalar c, cc = 0.0;
-
-                for (auto h : mesh_.halfedges(v))
-                {
-                    c = vsizing_[mesh_.to_vertex(h)];
-                    if (c > 0.0)
-                    {
-                        w = std::max(0.0, cotan_weight(mesh_, mesh_.edge(h)));
-                        ww += w;
-                        cc += w * c;
-                    }
-                }
-
-                if (ww)
-                    cc /= ww;
-                vsizing_[v] = cc;
-            }
-        }
-
-        // now convert per-vertex curvature into target edge length
-        for (auto v : mesh_.vertices())
-        {
-            Scalar c = vsizing_[v];
-
-            // get edge length from curvature
-            const Scalar r = 1.0 / c;
-            const Scalar e = approx_error_;
-            Scalar h;
-            if (e < r)
-            {
-                // see mathworld: "circle segment" and "equilateral triangle"
-                //h = sqrt(2.0*r*e-e*e) * 3.0 / sqrt(3.0);
-                h = sqrt(6.0 * e * r - 3.0 * e * e); // simplified...
-            }
-            else
-            {
-                // this does not really make sense
-                h = e * 3.0 / sqrt(3.0);
-            }
-
-            // clamp to min. and max. edge length
-            if (h < min_edge_length_)
-                h = min_edge_length_;
-            else if (h > max_edge_length_)
-                h = max_edge_length_;
-
-            // store target edge length
-            vsizing_[v] = h;
-        }
+        compute_sizing_field(mesh_, vsizing_);
     }
 
     if (use_projection_)
-    {
-        // build reference mesh
-        refmesh_ = std::make_shared<SurfaceMesh>();
-        refmesh_->assign(mesh_);
-        Normals::compute_vertex_normals(*refmesh_);
-        refpoints_ = refmesh_->vertex_property<Point>("v:point");
-        refnormals_ = refmesh_->vertex_property<Point>("v:normal");
-
-        // copy sizing field from mesh_
-        refsizing_ = refmesh_->add_vertex_property<Scalar>("v:sizing");
-        for (auto v : refmesh_->vertices())
-        {
-            refsizing_[v] = vsizing_[v];
-        }
-
-        // build kd-tree
-        kd_tree_ = std::make_unique<TriangleKdTree>(refmesh_, 0);
-    }
+        build_reference(mesh_, vsizing_);
 }
 
 void Remeshing::postprocessing()
@@ -316,24 +351,150 @@ void Remeshing::convex_hull_preprocessing()
     }
 
     if (use_projection_)
+        build_reference(mesh_, vsizing_);
+}
+
+void Remeshing::local_preprocessing(const std::vector<Vertex>& region)
+{
+    // properties
+    if (!vfeature_)
+        vfeature_ = mesh_.vertex_property<bool>("v:feature", false);
+    if (!efeature_)
+        efeature_ = mesh_.edge_property<bool>("e:feature", false);
+    if (!vlocked_)
+        vlocked_ = mesh_.add_vertex_property<bool>("v:locked", false);
+    if (!elocked_)
+        elocked_ = mesh_.add_edge_property<bool>("e:locked", false);
+    if (!vsizing_)
+        vsizing_ = mesh_.add_vertex_property<Scalar>("v:sizing");
+    vregion_ = mesh_.add_vertex_property<bool>("v:region", false);
+
+    local_ = true;
+    region_.clear();
+    region_.reserve(region.size());
+    for (auto v : region)
     {
-        // build reference mesh
-        refmesh_ = std::make_shared<SurfaceMesh>();
-        refmesh_->assign(mesh_);
-        Normals::compute_vertex_normals(*refmesh_);
-        refpoints_ = refmesh_->vertex_property<Point>("v:point");
-        refnormals_ = refmesh_->vertex_property<Point>("v:normal");
+        if (!mesh_.is_valid(v) || mesh_.is_deleted(v) || vregion_[v])
+            continue;
+        vregion_[v] = true;
+        region_.push_back(v);
+    }
 
-        // copy sizing field from mesh_
-        refsizing_ = refmesh_->add_vertex_property<Scalar>("v:sizing");
-        for (auto v : refmesh_->vertices())
+    // lock the one-ring of the region, so that the rest of the mesh stays unchanged
+    std::vector<Vertex> ring;
+    for (auto v : region_)
+    {
+        for (auto vv : mesh_.vertices(v))
         {
-            refsizing_[v] = vsizing_[v];
+            if (!vregion_[vv])
+                ring.push_back(vv);
         }
+    }
+    std::sort(ring.begin(), ring.end());
+    ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+    for (auto v : ring)
+    {
+        vlocked_[v] = true;
+    }
 
-        // build kd-tree
-        kd_tree_ = std::make_unique<TriangleKdTree>(refmesh_, 0);
+    // lock an edge if one of its vertices is locked
+    for (auto e : active_edges())
+    {
+        if (vlocked_[mesh_.vertex(e, 0)] || vlocked_[mesh_.vertex(e, 1)])
+            elocked_[e] = true;
+    }
+
+    // lock feature corners
+    for (auto v : region_)
+    {
+        if (vfeature_[v])
+        {
+            int c = 0;
+            for (auto h : mesh_.halfedges(v))
+                if (efeature_[mesh_.edge(h)])
+                    ++c;
+
+            if (c != 2)
+                vlocked_[v] = true;
+        }
+    }
+
+    // copy the faces around the region and its one-ring, so that the sizing
+    // field and the reference surface are evaluated only locally.
+    SurfaceMesh local_mesh;
+    auto local_feature = local_mesh.vertex_property<bool>("v:feature", false);
+    auto local_vertex = mesh_.add_vertex_property<Vertex>("v:local_vertex");
+    auto fcopied = mesh_.add_face_property<bool>("f:copied", false);
+    std::vector<Vertex> copied;
+    bool is_local_mesh_ok = true;
+    try
+    {
+        std::vector<Vertex> face_vertices;
+        for (const auto* vertices : {&region_, &ring})
+        {
+            for (auto v : *vertices)
+            {
+                for (auto f : mesh_.faces(v))
+                {
+                    if (fcopied[f])
+                        continue;
+                    fcopied[f] = true;
+
+                    face_vertices.clear();
+                    for (auto fv : mesh_.vertices(f))
+                    {
+                        if (!local_vertex[fv].is_valid())
+                        {
+                            local_vertex[fv] = local_mesh.add_vertex(points_[fv]);
+                            local_feature[local_vertex[fv]] = vfeature_[fv];
+                            copied.push_back(fv);
+                        }
+                        face_vertices.push_back(local_vertex[fv]);
+                    }
+                    local_mesh.add_face(face_vertices);
+                }
+            }
+        }
+    }
+    catch (const TopologyException&)
+    {
+        // the copied faces do not form a manifold patch.
+        is_local_mesh_ok = false;
+    }
+    mesh_.remove_face_property(fcopied);
+
+    if (!is_local_mesh_ok)
+    {
+        // fall back to the sizing field and reference of the whole mesh
+        mesh_.remove_vertex_property(local_vertex);
+        compute_sizing_field(mesh_, vsizing_);
+        if (use_projection_)
+            build_reference(mesh_, vsizing_);
+        return;
     }
+
+    auto local_sizing = local_mesh.add_vertex_property<Scalar>("v:sizing");
+    compute_sizing_field(local_mesh, local_sizing);
+    for (auto v : copied)
+    {
+        vsizing_[v] = local_sizing[local_vertex[v]];
+    }
+    mesh_.remove_vertex_property(local_vertex);
+
+    if (use_projection_)
+        build_reference(local_mesh, local_sizing);
+}
+
+void Remeshing::local_postprocessing()
+{
+    mesh_.remove_vertex_property(vregion_);
+    region_.clear();
+    local_ = false;
+
+    // collapsed elements are only removed now, so that region_ stays valid
+    mesh_.garbage_collection();
+
+    postprocessing();
 }
 
 void Remeshing::convex_hull_postprocessing()
@@ -350,49 +511,170 @@ void Remeshing::convex_hull_postprocessing()
     postprocessing();
 }
 
+void Remeshing::compute_sizing_field(SurfaceMesh& mesh, VertexProperty<Scalar> sizing) const
+{
+    auto feature = mesh.get_vertex_property<bool>("v:feature");
 
-void Remeshing::project_to_reference(Vertex v)
+    // compute curvature for all mesh vertices, using cotan or Cohen-Steiner
+    // don't use two-ring neighborhood, since we otherwise compute
+    // curvature over sharp features edges, leading to high curvatures.
+    // prefer tensor analysis over cotan-Laplace, since the former is more
+    // robust and gives better results on the boundary.
+    Curvature curv(mesh);
+    curv.analyze_tensor(1);
+
+    // use sizing to store/smooth curvatures to avoid another vertex property
+
+    // curvature values for feature vertices and boundary vertices
+    // are not meaningful. mark them as negative values.
+    for (auto v : mesh.vertices())
+    {
+        if (mesh.is_boundary(v) || (feature && feature[v]))
+            sizing[v] = -1.0;
+        else
+            sizing[v] = curv.max_abs_curvature(v);
+    }
+
+    // curvature values might be noisy. smooth them.
+    // don't consider feature vertices' curvatures.
+    // don't consider boundary vertices' curvatures.
+    // do this for two iterations, to propagate curvatures
+    // from non-feature regions to feature vertices.
+    for (int iters = 0; iters < 2; ++iters)
+    {
+        for (auto v : mesh.vertices())
+        {
+            Scalar w, ww = 0.0;
+            Scalar c, cc = 0.0;
+
+            for (auto h : mesh.halfedges(v))
+            {
+                c = sizing[mesh.to_vertex(h)];
+                if (c > 0.0)
+                {
+                    w = std::max(0.0, cotan_weight(mesh, mesh.edge(h)));
+                    ww += w;
+                    cc += w * c;
+                }
+            }
+
+            if (ww)
+                cc /= ww;
+            sizing[v] = cc;
+        }
+    }
+
+    // now convert per-vertex curvature into target edge length
+    for (auto v : mesh.vertices())
+    {
+        Scalar c = sizing[v];
+
+        // get edge length from curvature
+        const Scalar r = 1.0 / c;
+        const Scalar e = approx_error_;
+        Scalar h;
+        if (e < r)
+        {
+            // see mathworld: "circle segment" and "equilateral triangle"
+            //h = sqrt(2.0*r*e-e*e) * 3.0 / sqrt(3.0);
+            h = sqrt(6.0 * e * r - 3.0 * e * e); // simplified...
+        }
+        else
+        {
+            // this does not really make sense
+            h = e * 3.0 / sqrt(3.0);
+        }
+
+        // clamp to min. and max. edge length
+        if (h < min_edge_length_)
+            h = min_edge_length_;
+        else if (h > max_edge_length_)
+            h = max_edge_length_;
+
+        // store target edge length
+        sizing[v] = h;
+    }
+}
+
+void Remeshing::build_reference(const SurfaceMesh& mesh, VertexProperty<Scalar> sizing)
 {
-    if (!use_projection_)
+    if (!reference_)
+        reference_ = std::make_shared<RemeshingReference>();
+    reference_->update(mesh, sizing);
+}
+
+std::vector<Edge> Remeshing::active_edges() const
+{
+    std::vector<Edge> edges;
+    if (!local_)
     {
-        return;
+        edges.reserve(mesh_.n_edges());
+        for (auto e : mesh_.edges())
+            edges.push_back(e);
+        return edges;
     }
 
-    // find closest triangle of reference mesh
-    auto nn = kd_tree_->nearest(points_[v]);
-    const Point p = nn.nearest;
-    const Face f = nn.face;
+    for (auto v : region_)
+    {
+        if (mesh_.is_deleted(v))
+            continue;
 
-    // get face data
-    auto fvIt = refmesh_->vertices(f);
-    const Point p0 = refpoints_[*fvIt];
-    const Point n0 = refnormals_[*fvIt];
-    const Scalar s0 = refsizing_[*fvIt];
-    ++fvIt;
-    const Point p1 = refpoints_[*fvIt];
-    const Point n1 = refnormals_[*fvIt];
-    const Scalar s1 = refsizing_[*fvIt];
-    ++fvIt;
-    const Point p2 = refpoints_[*fvIt];
-    const Point n2 = refnormals_[*fvIt];
-    const Scalar s2 = refsizing_[*fvIt];
+        for (auto h : mesh_.halfedges(v))
+        {
+            // edges within the region are collected from their lower index vertex
+            const auto vv = mesh_.to_vertex(h);
+            if (!vregion_[vv] || v < vv)
+                edges.push_back(mesh_.edge(h));
+        }
+    }
+    return edges;
+}
 
-    // get barycentric coordinates
-    Point b = barycentric_coordinates(p, p0, p1, p2);
+std::vector<Vertex> Remeshing::active_vertices() const
+{
+    std::vector<Vertex> vertices;
+    if (!local_)
+    {
+        vertices.reserve(mesh_.n_vertices());
+        for (auto v : mesh_.vertices())
+            vertices.push_back(v);
+        return vertices;
+    }
 
-    // interpolate normal
-    Point n;
-    n = (n0 * b[0]);
-    n += (n1 * b[1]);
-    n += (n2 * b[2]);
-    n.normalize();
-    assert(!std::isnan(n[0]));
+    vertices.reserve(region_.size());
+    for (auto v : region_)
+    {
+        if (!mesh_.is_deleted(v))
+            vertices.push_back(v);
+    }
+    return vertices;
+}
 
-    // interpolate sizing field
+void Remeshing::update_vertex_normals()
+{
+    if (!local_)
+    {
+        Normals::compute_vertex_normals(mesh_);
+        return;
+    }
+
+    for (auto v : region_)
+    {
+        if (!mesh_.is_deleted(v))
+            vnormal_[v] = Normals::compute_vertex_normal(mesh_, v);
+    }
+}
+
+void Remeshing::project_to_reference(Vertex v)
+{
+    if (!use_projection_)
+    {
+        return;
+    }
+
+    Point p, n;
     Scalar s;
-    s = (s0 * b[0]);
-    s += (s1 * b[1]);
-    s += (s2 * b[2]);
+    reference_->project(points_[v], p, n, s);
 
     // set result
     points_[v] = p;
@@ -411,7 +693,7 @@ void Remeshing::split_long_edges(unsigned int nIterations)
     {
         ok = true;
 
-        for (auto e : mesh_.edges())
+        for (auto e : active_edges())
         {
             v0 = mesh_.vertex(e, 0);
             v1 = mesh_.vertex(e, 1);
@@ -431,10 +713,16 @@ void Remeshing::split_long_edges(unsigned int nIterations)
                 vnormal_[vnew] = Normals::compute_vertex_normal(mesh_, vnew);
                 vsizing_[vnew] = 0.5f * (vsizing_[v0] + vsizing_[v1]);
 
+                if (local_)
+                {
+                    vregion_[vnew] = true;
+                    region_.push_back(vnew);
+                }
+
                 if (is_feature)
                 {
-                    enew = is_boundary ? Edge(mesh_.n_edges() - 2)
-                                       : Edge(mesh_.n_edges() - 3);
+                    enew = is_boundary ? Edge(mesh_.edges_size() - 2)
+                                       : Edge(mesh_.edges_size() - 3);
                     efeature_[enew] = true;
                     vfeature_[vnew] = true;
                 }
@@ -461,7 +749,7 @@ void Remeshing::collapse_short_edges()
     {
         ok = true;
 
-        for (auto e : mesh_.edges())
+        for (auto e : active_edges())
         {
             if (!mesh_.is_deleted(e) && !elocked_[e])
             {
@@ -586,7 +874,9 @@ void Remeshing::collapse_short_edges()
         }
     }
 
-    mesh_.garbage_collection();
+    // for local remeshing, garbage collection is postponed to postprocessing
+    if (!local_)
+        mesh_.garbage_collection();
 }
 
 void Remeshing::flip_edges()
@@ -601,7 +891,7 @@ void Remeshing::flip_edges()
 
     // precompute valences
     auto valence = mesh_.add_vertex_property<int>("valence");
-    for (auto v : mesh_.vertices())
+    for (auto v : active_vertices())
     {
         valence[v] = mesh_.valence(v);
     }
@@ -610,7 +900,7 @@ void Remeshing::flip_edges()
     {
         ok = true;
 
-        for (auto e : mesh_.edges())
+        for (auto e : active_edges())
         {
             if (!elocked_[e] && !efeature_[e])
             {
@@ -689,12 +979,13 @@ void Remeshing::tangential_smoothing(unsigned int iterations)
 
     // add property
     auto update = mesh_.add_vertex_property<Point>("v:update");
+    const auto vertices = active_vertices();
 
     // project at the beginning to get valid sizing values and normal vectors
     // for vertices introduced by splitting
     if (use_projection_)
     {
-        for (auto v : mesh_.vertices())
+        for (auto v : vertices)
         {
             if (!mesh_.is_boundary(v) && !vlocked_[v])
             {
@@ -705,7 +996,7 @@ void Remeshing::tangential_smoothing(unsigned int iterations)
 
     for (unsigned int iters = 0; iters < iterations; ++iters)
     {
-        for (auto v : mesh_.vertices())
+        for (auto v : vertices)
         {
             if (!mesh_.is_boundary(v) && !vlocked_[v])
             {
@@ -775,7 +1066,7 @@ void Remeshing::tangential_smoothing(unsigned int iterations)
         }
 
         // update vertex positions
-        for (auto v : mesh_.vertices())
+        for (auto v : vertices)
         {
             if (!mesh_.is_boundary(v) && !vlocked_[v])
             {
@@ -784,13 +1075,13 @@ void Remeshing::tangential_smoothing(unsigned int iterations)
         }
 
         // update normal vectors (if not done so through projection)
-        Normals::compute_vertex_normals(mesh_);
+        update_vertex_normals();
     }
 
     // project at the end
     if (use_projection_)
     {
-        for (auto v : mesh_.vertices())
+        for (auto v : vertices)
         {
             if (!mesh_.is_boundary(v) && !vlocked_[v])
             {
@@ -811,7 +1102,7 @@ void Remeshing::remove_caps()
     Scalar a0, a1, amin, aa(::cos(170.0 * M_PI / 180.0));
     Point a, b, c, d;
 
-    for (auto e : mesh_.edges())
+    for (auto e : active_edges())
     {
         if (!elocked_[e] && mesh_.is_flip_ok(e))
         {
@@ -848,6 +1139,11 @@ void Remeshing::remove_caps()
                 if (efeature_[e] && vfeature_[v])
                     continue;
 
+                // locked region-boundary vertices must not be moved onto
+                // the feature edge
+                if (local_ && efeature_[e] && vlocked_[v])
+                    continue;
+
                 // project v onto feature edge
                 if (efeature_[e])
                     points_[v] = (a + c) * 0.5f;
@@ -7,6 +7,7 @@
 #include "pmp/algorithms/TriangleKdTree.h"
 
 #include <memory>
+#include <vector>
 
 namespace pmp {
 /**
@@ -23,6 +24,49 @@ struct AdaptiveRemeshingSettings
     bool UseProjection{ true };
 };
 
+//! \brief A reference surface for the back-projection of remeshed vertices.
+//! \details Keeps a copy of the mesh with its vertex normals and sizing field,
+//! and a TriangleKdTree for closest point queries. If a reference is shared by
+//! repeated remeshing calls (see Remeshing::Remeshing()), update() only copies
+//! the vertex positions and refits the kd-tree as long as the connectivity of
+//! the remeshed mesh matches the reference (e.g., if the previous remeshing did
+//! not change the connectivity), instead of copying the whole mesh and
+//! rebuilding the kd-tree.
+//! \note A reference must not be used by concurrent remeshing calls.
+//! \ingroup algorithms
+class RemeshingReference
+{
+public:
+    //! \brief Update the reference to a mesh and its sizing field.
+    void update(const SurfaceMesh& mesh, VertexProperty<Scalar> sizing);
+
+    //! \brief Find the closest point on the reference surface.
+    //! \param p           the query point.
+    //! \param nearest     the closest point.
+    //! \param normal      the vertex normal interpolated at the closest point.
+    //! \param sizing      the sizing field interpolated at the closest point.
+    void project(const Point& p, Point& nearest, Point& normal, Scalar& sizing) const;
+
+    //! \brief The number of updates which rebuilt the reference.
+    size_t n_rebuilds() const { return n_rebuilds_; }
+
+    //! \brief The number of updates which only refitted the reference.
+    size_t n_refits() const { return n_refits_; }
+
+private:
+    bool has_connectivity_of(const SurfaceMesh& mesh) const;
+
+    std::shared_ptr<SurfaceMesh> refmesh_;
+    std::unique_ptr<TriangleKdTree> kd_tree_;
+
+    VertexProperty<Point> refpoints_;
+    VertexProperty<Point> refnormals_;
+    VertexProperty<Scalar> refsizing_;
+
+    size_t n_rebuilds_{0};
+    size_t n_refits_{0};
+};
+
 //! \brief A class for uniform and adaptive surface remeshing.
 //! \details The algorithm implemented here performs incremental remeshing based
 //! on edge collapse, split, flip, and tangential relaxation.
@@ -37,6 +81,12 @@ public:
     //! \throw InvalidInputException if the input precondition is violated.
     Remeshing(SurfaceMesh& mesh);
 
+    //! \brief Construct with mesh to be remeshed and a reference for
+    //! back-projection shared by repeated remeshing calls.
+    //! \pre Input mesh needs to be a pure triangle mesh.
+    //! \throw InvalidInputException if the input precondition is violated.
+    Remeshing(SurfaceMesh& mesh, std::shared_ptr<RemeshingReference> reference);
+
     //! \brief Perform uniform remeshing.
     //! \param edge_length the target edge length.
     //! \param iterations the number of iterations
@@ -53,11 +103,35 @@ public:
     //! \param settings      input settings.
     void convex_hull_adaptive_remeshing(const AdaptiveRemeshingSettings& settings);
 
+    //! \brief Perform adaptive remeshing restricted to a region of the mesh.
+    //! \details Only edges between unlocked region vertices are split, collapsed,
+    //! and flipped, and only region vertices are smoothed and projected. The
+    //! one-ring of the region is locked, so the mesh outside of it stays
+    //! unchanged. The sizing field and the reference surface for back-projection
+    //! are evaluated on a local copy of the faces around the region, so the cost
+    //! scales with the size of the region rather than with the size of the mesh.
+    //! \param settings      input settings.
+    //! \param region        vertices of the region (e.g., low quality vertices and their k-ring).
+    void local_adaptive_remeshing(const AdaptiveRemeshingSettings& settings,
+                                  const std::vector<Vertex>& region);
+
 private:
     void preprocessing();
     void postprocessing();
     void convex_hull_preprocessing();
     void convex_hull_postprocessing();
+    void local_preprocessing(const std::vector<Vertex>& region);
+    void local_postprocessing();
+
+    // curvature-based sizing field of a mesh with "v:feature" property
+    void compute_sizing_field(SurfaceMesh& mesh, VertexProperty<Scalar> sizing) const;
+    // update the reference for back-projection to a mesh and its sizing field
+    void build_reference(const SurfaceMesh& mesh, VertexProperty<Scalar> sizing);
+
+    // edges and vertices subject to remeshing (those of the region for local remeshing)
+    std::vector<Edge> active_edges() const;
+    std::vector<Vertex> active_vertices() const;
+    void update_vertex_normals();
 
     void split_long_edges(unsigned int nIterations = 10);
     void collapse_short_edges();
@@ -82,12 +156,13 @@ private:
     }
 
     SurfaceMesh& mesh_;
-    std::shared_ptr<SurfaceMesh> refmesh_;
+    std::shared_ptr<RemeshingReference> reference_;
 
     bool use_projection_;
-    std::unique_ptr<TriangleKdTree> kd_tree_;
 
     bool uniform_;
+    bool local_{false};
+    std::vector<Vertex> region_;
     Scalar target_edge_length_;
     Scalar min_edge_length_;
     Scalar max_edge_length_;
@@ -102,10 +177,7 @@ private:
     VertexProperty<bool> vlocked_;
     EdgeProperty<bool> elocked_;
     VertexProperty<Scalar> vsizing_;
-
-    VertexProperty<Point> refpoints_;
-    VertexProperty<Point> refnormals_;
-    VertexProperty<Scalar> refsizing_;
+    VertexProperty<bool> vregion_;
 };
 
 } // namespace pmp
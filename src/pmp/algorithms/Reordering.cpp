@@ -0,0 +1,173 @@
+// Copyright 2011-2021 the Polygon Mesh Processing Library developers.
+// Distributed under a MIT-style license, see LICENSE.txt for details.
+
+#include "pmp/algorithms/Reordering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace pmp {
+
+namespace {
+
+// spread the lower 21 bits of x so that there are two zero bits between
+// each pair of consecutive bits.
+uint64_t spread_bits(uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x << 8) & 0x100f00f00f00f00f;
+    x = (x | x << 4) & 0x10c30c30c30c30c3;
+    x = (x | x << 2) & 0x1249249249249249;
+    return x;
+}
+
+// breadth-first traversal of the component of seed, visiting neighbors by
+// increasing valence (given per vertex). Visited vertices are appended to
+// order, and their breadth-first level is stored in level (unvisited
+// vertices are marked by PMP_MAX_INDEX). Returns the index into order where
+// the last level starts.
+size_t cuthill_mckee_traversal(const SurfaceMesh& mesh, Vertex seed,
+                               const std::vector<IndexType>& valence,
+                               std::vector<IndexType>& order,
+                               std::vector<IndexType>& level)
+{
+    const size_t begin = order.size();
+    order.push_back(seed.idx());
+    level[seed.idx()] = 0;
+
+    size_t last_level_begin = begin;
+    std::vector<Vertex> neighbors;
+    for (size_t i = begin; i < order.size(); ++i)
+    {
+        const Vertex v(order[i]);
+        if (level[v.idx()] != level[order[last_level_begin]])
+            last_level_begin = i;
+
+        neighbors.clear();
+        for (auto w : mesh.vertices(v))
+        {
+            if (level[w.idx()] == PMP_MAX_INDEX)
+            {
+                level[w.idx()] = level[v.idx()] + 1;
+                neighbors.push_back(w);
+            }
+        }
+        // stable insertion sort (neighbor lists are short)
+        for (size_t j = 1; j < neighbors.size(); ++j)
+        {
+            const Vertex w = neighbors[j];
+            size_t k = j;
+            for (; k > 0 && valence[neighbors[k - 1].idx()] > valence[w.idx()];
+                 --k)
+                neighbors[k] = neighbors[k - 1];
+            neighbors[k] = w;
+        }
+        for (auto w : neighbors)
+            order.push_back(w.idx());
+    }
+    return last_level_begin;
+}
+
+} // namespace
+
+std::vector<IndexType> Reordering::morton_vertex_order(const SurfaceMesh& mesh)
+{
+    const auto n_vertices = static_cast<IndexType>(mesh.vertices_size());
+    const auto bounds = mesh.bounds();
+    const Point origin = bounds.is_empty() ? Point(0, 0, 0) : bounds.min();
+    const Point extent =
+        bounds.is_empty() ? Point(0, 0, 0) : bounds.max() - bounds.min();
+
+    constexpr Scalar max_cell = static_cast<Scalar>(0x1fffff);
+    Point scale;
+    for (int i = 0; i < 3; ++i)
+        scale[i] = extent[i] > 0 ? max_cell / extent[i] : 0;
+
+    auto points = mesh.get_vertex_property<Point>("v:point");
+    std::vector<std::pair<uint64_t, IndexType>> codes(n_vertices);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(n_vertices); ++i)
+    {
+        const Point& p = points[Vertex(i)];
+        uint64_t code = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            const Scalar q = std::clamp((p[k] - origin[k]) * scale[k],
+                                        Scalar(0), max_cell);
+            code |= spread_bits(static_cast<uint64_t>(q)) << k;
+        }
+        codes[i] = {code, static_cast<IndexType>(i)};
+    }
+    std::sort(codes.begin(), codes.end());
+
+    std::vector<IndexType> order(n_vertices);
+    for (IndexType i = 0; i < n_vertices; ++i)
+        order[i] = codes[i].second;
+    return order;
+}
+
+std::vector<IndexType> Reordering::reverse_cuthill_mckee_vertex_order(
+    const SurfaceMesh& mesh)
+{
+    const auto n_vertices = static_cast<IndexType>(mesh.vertices_size());
+
+    std::vector<IndexType> order;
+    order.reserve(n_vertices);
+    std::vector<IndexType> level(n_vertices, PMP_MAX_INDEX);
+    std::vector<IndexType> component;
+
+    std::vector<IndexType> valence(n_vertices, 0);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(n_vertices); ++i)
+        valence[i] = static_cast<IndexType>(mesh.valence(Vertex(i)));
+
+    // components are started from their last vertex, and a seed is only
+    // replaced by a vertex of strictly larger eccentricity. Since the seed
+    // becomes the last vertex of the reversed order, reordering an already
+    // reordered mesh reproduces its order.
+    for (auto i = n_vertices; i-- > 0;)
+    {
+        if (level[i] != PMP_MAX_INDEX)
+            continue;
+
+        // find a pseudo-peripheral seed: move to a vertex of minimum valence
+        // in the last level while this increases the eccentricity.
+        Vertex seed(i);
+        Vertex next = seed;
+        IndexType eccentricity = PMP_MAX_INDEX;
+        while (true)
+        {
+            component.clear();
+            const auto last_level_begin =
+                cuthill_mckee_traversal(mesh, next, valence, component, level);
+            const auto next_eccentricity = level[component.back()];
+            auto candidate = Vertex(component[last_level_begin]);
+            for (size_t k = last_level_begin + 1; k < component.size(); ++k)
+            {
+                if (valence[component[k]] < valence[candidate.idx()])
+                    candidate = Vertex(component[k]);
+            }
+            for (const auto w : component)
+                level[w] = PMP_MAX_INDEX;
+
+            if (eccentricity != PMP_MAX_INDEX &&
+                next_eccentricity <= eccentricity)
+                break;
+            seed = next;
+            eccentricity = next_eccentricity;
+            if (candidate == seed)
+                break;
+            next = candidate;
+        }
+
+        cuthill_mckee_traversal(mesh, seed, valence, order, level);
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+} // namespace pmp
@@ -0,0 +1,46 @@
+// Copyright 2011-2021 the Polygon Mesh Processing Library developers.
+// Distributed under a MIT-style license, see LICENSE.txt for details.
+
+#pragma once
+
+#include <vector>
+
+#include "pmp/SurfaceMesh.h"
+
+namespace pmp {
+
+//! \brief A class for computing vertex orders with a better memory locality.
+//! \details Mesh operations such as remeshing leave vertices in the order
+//! in which splits and collapses created them, so that neighboring vertices
+//! are scattered in memory, and the sparse matrices assembled over the mesh
+//! have a large bandwidth. The orders computed here are meant to be passed
+//! to SurfaceMesh::reorder():
+//!
+//! \li morton_vertex_order(): spatial (Z-order) sorting of vertex positions,
+//! \li reverse_cuthill_mckee_vertex_order(): bandwidth reduction of the
+//! vertex adjacency graph.
+//!
+//! All orders map new indices to old ones, i.e.: vertex \c i of the reordered
+//! mesh is vertex \c order[i] of the input mesh.
+//! \pre The mesh has no garbage.
+//! \ingroup algorithms
+class Reordering
+{
+public:
+    // delete default and copy constructor
+    Reordering() = delete;
+    Reordering(const Reordering&) = delete;
+
+    //! \brief Order vertices along the Morton (Z-order) curve of their
+    //! positions quantized to 21 bits per coordinate within the mesh bounds.
+    static std::vector<IndexType> morton_vertex_order(const SurfaceMesh& mesh);
+
+    //! \brief Order vertices by the reverse Cuthill-McKee algorithm on the
+    //! vertex adjacency graph of the mesh.
+    //! \details Each connected component is traversed breadth-first from a
+    //! pseudo-peripheral vertex, visiting neighbors by increasing valence.
+    static std::vector<IndexType> reverse_cuthill_mckee_vertex_order(
+        const SurfaceMesh& mesh);
+};
+
+} // namespace pmp
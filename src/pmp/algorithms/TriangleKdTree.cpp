@@ -3,6 +3,8 @@
 
 #include "pmp/algorithms/TriangleKdTree.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 #include "pmp/algorithms/DistancePointTriangle.h"
@@ -131,6 +133,10 @@ void TriangleKdTree::build_recurse(Node* node, unsigned int max_faces,
         // store internal data
         node->axis = axis;
         node->split = split;
+        // faces on both sides are stored in both children, so the split
+        // plane bounds the faces found only in the farther child.
+        node->left_max = split;
+        node->right_min = split;
         node->left_child = left;
         node->right_child = right;
 
@@ -140,6 +146,55 @@ void TriangleKdTree::build_recurse(Node* node, unsigned int max_faces,
     }
 }
 
+void TriangleKdTree::refit(const SurfaceMesh& mesh)
+{
+    if (build_points_.empty())
+        build_points_ = face_points_;
+
+    // update face points and their displacement since construction
+    std::vector<Point> face_shifts(face_points_.size(), Point(0));
+    auto points = mesh.get_vertex_property<Point>("v:point");
+    for (const auto& f : mesh.faces())
+    {
+        auto v = mesh.vertices(f);
+        auto& pos = face_points_[f.idx()];
+        const auto& build_pos = build_points_[f.idx()];
+        auto& shift = face_shifts[f.idx()];
+        for (int i = 0; i < 3; ++i, ++v)
+        {
+            pos[i] = points[*v];
+            for (int j = 0; j < 3; ++j)
+                shift[j] = std::max(shift[j], std::fabs(pos[i][j] - build_pos[i][j]));
+        }
+    }
+
+    // widen node bounds bottom-up
+    refit_recurse(root_, face_shifts);
+}
+
+Point TriangleKdTree::refit_recurse(Node* node, const std::vector<Point>& face_shifts)
+{
+    Point shift(0);
+
+    // terminal node?
+    if (!node->left_child)
+    {
+        for (const auto& f : *node->faces)
+            shift = max(shift, face_shifts[f.idx()]);
+        return shift;
+    }
+
+    // faces only in one child were on its side of the split plane at
+    // construction, so they are bounded by the plane shifted by their
+    // displacement.
+    const auto left_shift = refit_recurse(node->left_child, face_shifts);
+    const auto right_shift = refit_recurse(node->right_child, face_shifts);
+    node->left_max = node->split + left_shift[node->axis];
+    node->right_min = node->split - right_shift[node->axis];
+
+    return max(left_shift, right_shift);
+}
+
 TriangleKdTree::NearestNeighbor TriangleKdTree::nearest(const Point& p) const
 {
     NearestNeighbor data;
@@ -176,13 +231,13 @@ void TriangleKdTree::nearest_recurse(Node* node, const Point& point,
         if (dist <= 0.0)
         {
             nearest_recurse(node->left_child, point, data);
-            if (fabs(dist) < data.dist)
+            if (node->right_min - point[node->axis] < data.dist)
                 nearest_recurse(node->right_child, point, data);
         }
         else
         {
             nearest_recurse(node->right_child, point, data);
-            if (fabs(dist) < data.dist)
+            if (point[node->axis] - node->left_max < data.dist)
                 nearest_recurse(node->left_child, point, data);
         }
     }
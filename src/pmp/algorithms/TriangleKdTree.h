@@ -40,6 +40,14 @@ public:
     //! Return handle of the nearest neighbor
     NearestNeighbor nearest(const Point& p) const;
 
+    //! \brief Refit the tree to changed vertex positions of the mesh it was built from.
+    //! \details The tree structure is kept and the bounds of its nodes are
+    //! widened by the displacement of their faces since the construction, so
+    //! that queries stay exact, but get slower as the positions drift away
+    //! from those the tree was built for.
+    //! \pre The faces of \p mesh are those the tree was built for.
+    void refit(const SurfaceMesh& mesh);
+
 private:
     // vector of Faces
     using Faces = std::vector<Face>;
@@ -58,6 +66,8 @@ private:
 
         unsigned char axis;
         Scalar split;
+        Scalar left_max;  // upper bound of faces only in the left child along axis
+        Scalar right_min; // lower bound of faces only in the right child along axis
         Faces* faces{nullptr};
         Node* left_child{nullptr};
         Node* right_child{nullptr};
@@ -67,6 +77,9 @@ private:
     void build_recurse(Node* node, unsigned int max_faces,
                        unsigned int depth);
 
+    // Recursive part of refit(), returns the max. displacement of node faces along each axis
+    Point refit_recurse(Node* node, const std::vector<Point>& face_shifts);
+
     // Recursive part of nearest()
     void nearest_recurse(Node* node, const Point& point,
                          NearestNeighbor& data) const;
@@ -74,6 +87,7 @@ private:
     Node* root_;
 
     std::vector<std::array<Point, 3>> face_points_;
+    std::vector<std::array<Point, 3>> build_points_; // face points at construction (kept after the first refit)
 };
 
 } // namespace pmp